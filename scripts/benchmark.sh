@@ -42,12 +42,15 @@ show_help() {
     echo "  -o, --output DIR    Directorio de salida (por defecto: benchmarks/)"
     echo "  -i, --iterations N  Número de iteraciones (por defecto: 100)"
     echo "  -t, --timeout SEC   Timeout en segundos (por defecto: 300)"
+    echo "  -c, --comparar DIR  Comparar con los resultados .jsonl de una ejecución anterior"
+    echo "                      (falla si mpi_comparar detecta regresiones)"
     echo ""
     echo "Ejemplos:"
     echo "  $0                  # Ejecutar benchmark con 4 procesos"
     echo "  $0 -p 8             # Ejecutar benchmark con 8 procesos"
     echo "  $0 -a               # Ejecutar todas las configuraciones"
     echo "  $0 -v -o results/   # Ejecutar con output detallado y directorio personalizado"
+    echo "  $0 -o nuevo/ -c base/  # Comparar con una ejecución anterior guardada en base/"
 }
 
 # Variables por defecto
@@ -57,6 +60,7 @@ VERBOSE=false
 OUTPUT_DIR="benchmarks"
 ITERATIONS=100
 TIMEOUT=300
+COMPARE_DIR=""
 
 # Parsear argumentos
 while [[ $# -gt 0 ]]; do
@@ -89,6 +93,10 @@ while [[ $# -gt 0 ]]; do
             TIMEOUT="$2"
             shift 2
             ;;
+        -c|--comparar)
+            COMPARE_DIR="$2"
+            shift 2
+            ;;
         *)
             print_error "Opción desconocida: $1"
             show_help
@@ -138,6 +146,12 @@ run_benchmark_with_timeout() {
         local end_time=$(date +%s)
         local duration=$((end_time - start_time))
         print_success "$benchmark_name completado exitosamente en ${duration}s"
+        # mpi_benchmark escribe el CSV y el JSON lines en el directorio actual
+        for result_file in benchmark_results_${num_procs}procs.csv benchmark_results_${num_procs}procs.jsonl; do
+            if [[ -f "$result_file" ]]; then
+                mv "$result_file" "$OUTPUT_DIR/"
+            fi
+        done
         print_info "Resultados guardados en: $output_file"
         return 0
     else
@@ -250,6 +264,18 @@ if [[ "$RUN_ALL" == true ]]; then
         # Pausa entre benchmarks
         sleep 5
     done
+    
+    # El estudio de escalabilidad mide todos los tamaños en un solo lanzamiento
+    # con subcomunicadores, así que basta con el mayor número de procesos
+    max_procs=${TEST_CONFIGS[${#TEST_CONFIGS[@]}-1]}
+    TOTAL_BENCHMARKS=$((TOTAL_BENCHMARKS + 1))
+    print_info "Ejecutando estudio de escalabilidad con hasta $max_procs procesos..."
+    if timeout $TIMEOUT mpirun -np $max_procs ./build/mpi_analysis --iteraciones $ITERATIONS 2>&1 | \
+        tee "$OUTPUT_DIR/escalabilidad_${max_procs}procs_$(date +%Y%m%d_%H%M%S).log"; then
+        PASSED_BENCHMARKS=$((PASSED_BENCHMARKS + 1))
+    else
+        FAILED_BENCHMARKS=$((FAILED_BENCHMARKS + 1))
+    fi
 else
     TOTAL_BENCHMARKS=1
     if run_benchmark_with_timeout $NUM_PROCESSES "Benchmark con $NUM_PROCESSES procesos"; then
@@ -264,6 +290,23 @@ if [[ $PASSED_BENCHMARKS -gt 0 ]]; then
     generate_benchmark_report
 fi
 
+# Comparar con una ejecución anterior (mismo nombre de archivo = mismo número de procesos)
+REGRESSIONS=false
+if [[ -n "$COMPARE_DIR" ]]; then
+    for new_file in "$OUTPUT_DIR"/benchmark_results_*procs.jsonl; do
+        base_file="$COMPARE_DIR/$(basename "$new_file")"
+        if [[ ! -f "$new_file" || ! -f "$base_file" ]]; then
+            continue
+        fi
+        print_info "Comparando $(basename "$new_file") con $COMPARE_DIR..."
+        comparison_file="${new_file%.jsonl}_comparacion.txt"
+        if ! ./build/mpi_comparar "$base_file" "$new_file" > "$comparison_file"; then
+            REGRESSIONS=true
+        fi
+        cat "$comparison_file"
+    done
+fi
+
 # Mostrar resumen
 print_info ""
 print_info "=== RESUMEN DE BENCHMARKS ==="
@@ -272,11 +315,17 @@ print_info "Benchmarks exitosos: $PASSED_BENCHMARKS"
 print_info "Benchmarks fallidos: $FAILED_BENCHMARKS"
 print_info "Resultados guardados en: $OUTPUT_DIR"
 
+if [[ "$REGRESSIONS" == true ]]; then
+    print_error "mpi_comparar detectó regresiones respecto a $COMPARE_DIR."
+    exit 1
+fi
+
 if [[ $FAILED_BENCHMARKS -eq 0 ]]; then
     print_success "¡Todos los benchmarks se completaron exitosamente!"
     print_info ""
     print_info "Para analizar los resultados:"
     print_info "  - Revisar archivos CSV en $OUTPUT_DIR"
+    print_info "  - Comparar dos ejecuciones: ./build/mpi_comparar base.jsonl nuevo.jsonl"
     print_info "  - Ver reporte generado: $OUTPUT_DIR/benchmark_report_*.md"
     print_info "  - Usar herramientas como gnuplot o matplotlib para visualizar datos"
     exit 0
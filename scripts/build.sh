@@ -167,7 +167,7 @@ fi
 # Verificar que los ejecutables se crearon
 print_info "Verificando ejecutables..."
 
-EXECUTABLES=("mpi_promedio" "mpi_benchmark" "mpi_test")
+EXECUTABLES=("mpi_promedio" "mpi_benchmark" "mpi_analysis" "mpi_test")
 MISSING_EXECUTABLES=()
 
 for exec in "${EXECUTABLES[@]}"; do
@@ -204,4 +204,7 @@ print_info "Para ejecutar las pruebas:"
 print_info "  mpirun -np 4 ./mpi_test"
 print_info ""
 print_info "Para ejecutar benchmarks:"
-print_info "  mpirun -np 4 ./mpi_benchmark" 
\ No newline at end of file
+print_info "  mpirun -np 4 ./mpi_benchmark"
+print_info ""
+print_info "Para el estudio de escalabilidad (1, 2, 4... procesos en un lanzamiento):"
+print_info "  mpirun -np 4 ./mpi_analysis" 
\ No newline at end of file
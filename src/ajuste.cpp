@@ -0,0 +1,229 @@
+/**
+ * @file ajuste.cpp
+ * @brief Implementación de la tabla de decisión de algoritmos colectivos
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "ajuste.h"
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+static_assert(std::is_trivially_copyable<EntradaDecision>::value,
+              "EntradaDecision se difunde como bytes");
+
+namespace {
+
+/**
+ * @brief Tabla usada por las funciones *Ajustado
+ */
+TablaDecision& tablaGlobal() {
+    static TablaDecision tabla;
+    return tabla;
+}
+
+/**
+ * @brief Tamaño en bytes de count elementos del tipo dado
+ */
+int64_t bytesMensaje(int64_t count, MPI_Datatype datatype) {
+    int tamano = 0;
+    MPI_Type_size(datatype, &tamano);
+    return count * static_cast<int64_t>(tamano);
+}
+
+/**
+ * @brief Comprueba que un algoritmo existe para la colectiva
+ */
+bool algoritmoAplicable(OperacionColectiva operacion, AlgoritmoColectiva algoritmo) {
+    for (AlgoritmoColectiva candidato : algoritmosDe(operacion)) {
+        if (candidato == algoritmo) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void TablaDecision::agregar(const EntradaDecision& entrada) {
+    entradas_.push_back(entrada);
+}
+
+void TablaDecision::agregarBarrido(OperacionColectiva operacion, int procesos, const std::vector<int64_t>& bytes,
+                                   const std::vector<AlgoritmoColectiva>& mejores) {
+    for (size_t i = 0; i < mejores.size(); ++i) {
+        bool ultimo = (i + 1 == mejores.size());
+        if (!ultimo && mejores[i + 1] == mejores[i]) {
+            continue;
+        }
+        EntradaDecision entrada;
+        entrada.operacion = operacion;
+        entrada.procesos = procesos;
+        entrada.algoritmo = mejores[i];
+        entrada.bytesHasta = ultimo ? 0 : static_cast<int64_t>(std::sqrt(static_cast<double>(bytes[i]) *
+                                                                         static_cast<double>(bytes[i + 1])));
+        agregar(entrada);
+    }
+}
+
+AlgoritmoColectiva TablaDecision::elegir(OperacionColectiva operacion, int procesos, int64_t bytes) const {
+    // Número de procesos medido más cercano por debajo (o el menor de todos)
+    int32_t elegidos = -1;
+    int32_t menor = -1;
+    for (const EntradaDecision& entrada : entradas_) {
+        if (entrada.operacion != operacion) {
+            continue;
+        }
+        if (menor < 0 || entrada.procesos < menor) {
+            menor = entrada.procesos;
+        }
+        if (entrada.procesos <= procesos && entrada.procesos > elegidos) {
+            elegidos = entrada.procesos;
+        }
+    }
+    if (menor < 0) {
+        return AlgoritmoColectiva::Biblioteca;
+    }
+    if (elegidos < 0) {
+        elegidos = menor;
+    }
+    
+    for (const EntradaDecision& entrada : entradas_) {
+        if (entrada.operacion == operacion && entrada.procesos == elegidos &&
+            (entrada.bytesHasta == 0 || bytes <= entrada.bytesHasta)) {
+            return entrada.algoritmo;
+        }
+    }
+    return AlgoritmoColectiva::Biblioteca;
+}
+
+void TablaDecision::escribir(std::ostream& salida) const {
+    salida << "# colectiva procesos bytes_hasta algoritmo (bytes_hasta 0 = sin límite)" << std::endl;
+    for (const EntradaDecision& entrada : entradas_) {
+        salida << nombreOperacion(entrada.operacion) << " " << entrada.procesos << " " << entrada.bytesHasta
+               << " " << nombreAlgoritmo(entrada.algoritmo) << std::endl;
+    }
+}
+
+bool TablaDecision::leer(std::istream& entrada, TablaDecision& tabla, std::string& error) {
+    tabla = TablaDecision();
+    // Último bytes_hasta leído por (colectiva, procesos): elegir() toma la
+    // primera entrada que cubre el mensaje, así que los umbrales deben crecer
+    std::map<std::pair<int, int32_t>, int64_t> ultimoUmbral;
+    std::string linea;
+    int numeroLinea = 0;
+    while (std::getline(entrada, linea)) {
+        ++numeroLinea;
+        size_t comentario = linea.find('#');
+        if (comentario != std::string::npos) {
+            linea.erase(comentario);
+        }
+        std::istringstream campos(linea);
+        std::string operacion;
+        if (!(campos >> operacion)) {
+            continue;
+        }
+        
+        EntradaDecision leida;
+        std::string algoritmo;
+        std::string sobrante;
+        if (!(campos >> leida.procesos >> leida.bytesHasta >> algoritmo) || (campos >> sobrante) ||
+            leida.procesos < 1 || leida.bytesHasta < 0) {
+            error = "línea " + std::to_string(numeroLinea) + ": se esperaba 'colectiva procesos bytes_hasta algoritmo'";
+            return false;
+        }
+        if (!operacionPorNombre(operacion.c_str(), leida.operacion)) {
+            error = "línea " + std::to_string(numeroLinea) + ": colectiva desconocida '" + operacion + "'";
+            return false;
+        }
+        if (!algoritmoPorNombre(algoritmo.c_str(), leida.algoritmo) ||
+            !algoritmoAplicable(leida.operacion, leida.algoritmo)) {
+            error = "línea " + std::to_string(numeroLinea) + ": algoritmo '" + algoritmo + "' no válido para " +
+                    operacion;
+            return false;
+        }
+        auto clave = std::make_pair(static_cast<int>(leida.operacion), leida.procesos);
+        auto anterior = ultimoUmbral.find(clave);
+        if (anterior != ultimoUmbral.end() &&
+            (anterior->second == 0 || (leida.bytesHasta != 0 && leida.bytesHasta <= anterior->second))) {
+            error = "línea " + std::to_string(numeroLinea) + ": bytes_hasta debe crecer para " + operacion + " con " +
+                    std::to_string(leida.procesos) + " procesos (0 = sin límite va al final)";
+            return false;
+        }
+        ultimoUmbral[clave] = leida.bytesHasta;
+        tabla.agregar(leida);
+    }
+    return true;
+}
+
+bool cargarTablaDecision(const std::string& ruta, int root, MPI_Comm comm, std::string& error) {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+    
+    TablaDecision tabla;
+    int64_t numEntradas = -1;
+    if (rank == root) {
+        std::ifstream archivo(ruta);
+        if (!archivo) {
+            error = "no se puede abrir " + ruta;
+        } else if (TablaDecision::leer(archivo, tabla, error)) {
+            numEntradas = static_cast<int64_t>(tabla.entradas().size());
+        }
+    }
+    MPI_Bcast(&numEntradas, 1, MPI_INT64_T, root, comm);
+    if (numEntradas < 0) {
+        return false;
+    }
+    
+    std::vector<EntradaDecision> entradas = tabla.entradas();
+    entradas.resize(static_cast<size_t>(numEntradas));
+    MPI_Bcast(entradas.data(), static_cast<int>(numEntradas * sizeof(EntradaDecision)), MPI_BYTE, root, comm);
+    TablaDecision difundida;
+    for (const EntradaDecision& entrada : entradas) {
+        difundida.agregar(entrada);
+    }
+    establecerTablaDecision(difundida);
+    return true;
+}
+
+void establecerTablaDecision(const TablaDecision& tabla) {
+    tablaGlobal() = tabla;
+}
+
+const TablaDecision& tablaDecisionActiva() {
+    return tablaGlobal();
+}
+
+AlgoritmoColectiva algoritmoAjustado(OperacionColectiva operacion, int64_t count, MPI_Datatype datatype,
+                                     MPI_Comm comm) {
+    const TablaDecision& tabla = tablaGlobal();
+    if (tabla.vacia()) {
+        return AlgoritmoColectiva::Biblioteca;
+    }
+    int numProcs = 1;
+    MPI_Comm_size(comm, &numProcs);
+    return tabla.elegir(operacion, numProcs, bytesMensaje(count, datatype));
+}
+
+int bcastAjustado(void* buffer, int64_t count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+    AlgoritmoColectiva algoritmo = algoritmoAjustado(OperacionColectiva::Bcast, count, datatype, comm);
+    return bcastAlgoritmo(algoritmo, buffer, count, datatype, root, comm);
+}
+
+int reduceAjustado(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                   MPI_Op op, int root, MPI_Comm comm) {
+    AlgoritmoColectiva algoritmo = algoritmoAjustado(OperacionColectiva::Reduce, count, datatype, comm);
+    return reduceAlgoritmo(algoritmo, sendbuf, recvbuf, count, datatype, op, root, comm);
+}
+
+int allreduceAjustado(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                      MPI_Op op, MPI_Comm comm) {
+    AlgoritmoColectiva algoritmo = algoritmoAjustado(OperacionColectiva::Allreduce, count, datatype, comm);
+    return allreduceAlgoritmo(algoritmo, sendbuf, recvbuf, count, datatype, op, comm);
+}
@@ -0,0 +1,143 @@
+/**
+ * @file ajuste.h
+ * @brief Tabla de decisión de algoritmos colectivos por tamaño de mensaje y número de procesos
+ * @author Emil M
+ * @date 2025
+ *
+ * El barrido de ajuste de mpi_benchmark (--ajustar) mide cada algoritmo de
+ * algoritmos.h con varios tamaños de mensaje y de comunicador y escribe, para
+ * cada colectiva y número de procesos, qué algoritmo fue el más rápido en cada
+ * rango de tamaños. mpi_promedio y mpi_benchmark cargan ese archivo al
+ * arrancar (--tabla) y las funciones *Ajustado despachan al algoritmo elegido.
+ *
+ * Formato del archivo (una entrada por línea, '#' inicia un comentario):
+ *
+ *     colectiva procesos bytes_hasta algoritmo
+ *     bcast     4        65536       binomial
+ *     bcast     4        0           scatter-allgather
+ *
+ * Las entradas de una misma colectiva y número de procesos van en orden
+ * creciente de bytes_hasta; 0 significa sin límite y solo puede ser la
+ * última. TablaDecision::leer rechaza las tablas que no cumplen ese orden.
+ */
+
+#ifndef MPI_AVANZADO_AJUSTE_H
+#define MPI_AVANZADO_AJUSTE_H
+
+#include "algoritmos.h"
+
+#include <mpi.h>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Entrada de la tabla de decisión
+ *
+ * Trivialmente copiable para difundirse como bytes.
+ */
+struct EntradaDecision {
+    OperacionColectiva operacion = OperacionColectiva::Bcast;
+    int32_t procesos = 1;   ///< Número de procesos con el que se midió
+    int64_t bytesHasta = 0; ///< Mayor tamaño de mensaje cubierto (0 = sin límite)
+    AlgoritmoColectiva algoritmo = AlgoritmoColectiva::Biblioteca;
+};
+
+/**
+ * @brief Tabla de decisión de algoritmos colectivos
+ */
+class TablaDecision {
+public:
+    /**
+     * @brief Añade una entrada (en orden creciente de bytesHasta por colectiva y procesos)
+     */
+    void agregar(const EntradaDecision& entrada);
+    
+    /**
+     * @brief Añade las entradas de un barrido comprimiendo los tramos consecutivos
+     * @param operacion Colectiva medida
+     * @param procesos Número de procesos del barrido
+     * @param bytes Tamaños medidos, en orden creciente
+     * @param mejores Algoritmo más rápido para cada tamaño
+     *
+     * El límite entre dos tramos es la media geométrica de los tamaños medidos
+     * a cada lado; el último tramo no tiene límite.
+     */
+    void agregarBarrido(OperacionColectiva operacion, int procesos, const std::vector<int64_t>& bytes,
+                        const std::vector<AlgoritmoColectiva>& mejores);
+    
+    /**
+     * @brief Algoritmo para una colectiva, número de procesos y tamaño de mensaje
+     * @return Se usan las entradas del mayor número de procesos medido que no
+     *         supera el actual (o del menor medido si todos lo superan); sin
+     *         entradas de esa colectiva, la biblioteca
+     */
+    AlgoritmoColectiva elegir(OperacionColectiva operacion, int procesos, int64_t bytes) const;
+    
+    bool vacia() const { return entradas_.empty(); }
+    const std::vector<EntradaDecision>& entradas() const { return entradas_; }
+    
+    /**
+     * @brief Escribe la tabla en el formato de archivo
+     */
+    void escribir(std::ostream& salida) const;
+    
+    /**
+     * @brief Lee una tabla en el formato de archivo
+     * @param entrada Flujo de entrada
+     * @param tabla Tabla leída
+     * @param error Descripción del primer error encontrado
+     * @return true si toda la tabla es válida
+     */
+    static bool leer(std::istream& entrada, TablaDecision& tabla, std::string& error);
+
+private:
+    std::vector<EntradaDecision> entradas_;
+};
+
+/**
+ * @brief Carga la tabla de un archivo y la activa en todos los procesos
+ * @param ruta Archivo de la tabla (solo lo lee la raíz)
+ * @param root Proceso que lee el archivo
+ * @param comm Comunicador (operación colectiva)
+ * @param error Descripción del error (solo en la raíz)
+ * @return true en todos los procesos si la tabla se cargó
+ */
+bool cargarTablaDecision(const std::string& ruta, int root, MPI_Comm comm, std::string& error);
+
+/**
+ * @brief Activa una tabla para las funciones *Ajustado
+ */
+void establecerTablaDecision(const TablaDecision& tabla);
+
+/**
+ * @brief Tabla activa (vacía si no se ha cargado ninguna)
+ */
+const TablaDecision& tablaDecisionActiva();
+
+/**
+ * @brief Algoritmo que usan las funciones *Ajustado para una colectiva sobre comm
+ * @return La biblioteca si no hay tabla activa
+ */
+AlgoritmoColectiva algoritmoAjustado(OperacionColectiva operacion, int64_t count, MPI_Datatype datatype,
+                                     MPI_Comm comm);
+
+/**
+ * @brief MPI_Bcast con el algoritmo que indica la tabla activa
+ */
+int bcastAjustado(void* buffer, int64_t count, MPI_Datatype datatype, int root, MPI_Comm comm);
+
+/**
+ * @brief MPI_Reduce con el algoritmo que indica la tabla activa
+ */
+int reduceAjustado(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                   MPI_Op op, int root, MPI_Comm comm);
+
+/**
+ * @brief MPI_Allreduce con el algoritmo que indica la tabla activa
+ */
+int allreduceAjustado(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                      MPI_Op op, MPI_Comm comm);
+
+#endif // MPI_AVANZADO_AJUSTE_H
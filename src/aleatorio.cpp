@@ -0,0 +1,117 @@
+/**
+ * @file aleatorio.cpp
+ * @brief Implementación del generador Philox4x32-10
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "aleatorio.h"
+
+namespace {
+
+const uint32_t PHILOX_M0 = 0xD2511F53u;
+const uint32_t PHILOX_M1 = 0xCD9E8D57u;
+const uint32_t PHILOX_W0 = 0x9E3779B9u;
+const uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+/**
+ * @brief Número de contadores procesados a la vez para que el compilador
+ *        pueda vectorizar las rondas de Philox
+ */
+const int LOTE_CONTADORES = 8;
+
+inline void mulhilo(uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo) {
+    uint64_t producto = static_cast<uint64_t>(a) * b;
+    hi = static_cast<uint32_t>(producto >> 32);
+    lo = static_cast<uint32_t>(producto);
+}
+
+/**
+ * @brief Convierte 64 bits aleatorios en un double uniforme en [0, 1)
+ */
+inline double aUniforme(uint32_t alto, uint32_t bajo) {
+    uint64_t bits = (static_cast<uint64_t>(alto) << 32) | bajo;
+    return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0); // 2^-53
+}
+
+} // namespace
+
+GeneradorPhilox::GeneradorPhilox(uint64_t semilla, uint64_t flujo)
+    : clave_{static_cast<uint32_t>(semilla), static_cast<uint32_t>(semilla >> 32)},
+      flujoBajo_(static_cast<uint32_t>(flujo)),
+      flujoAlto_(static_cast<uint32_t>(flujo >> 32)) {}
+
+GeneradorPhilox::Contador GeneradorPhilox::philox(Contador c, Clave k) {
+    for (int ronda = 0; ronda < 10; ++ronda) {
+        if (ronda > 0) {
+            k[0] += PHILOX_W0;
+            k[1] += PHILOX_W1;
+        }
+        uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(PHILOX_M0, c[0], hi0, lo0);
+        mulhilo(PHILOX_M1, c[2], hi1, lo1);
+        c = {hi1 ^ c[1] ^ k[0], lo1, hi0 ^ c[3] ^ k[1], lo0};
+    }
+    return c;
+}
+
+double GeneradorPhilox::uniforme(uint64_t indice) const {
+    uint64_t contador = indice >> 1;
+    Contador salida = philox({static_cast<uint32_t>(contador), static_cast<uint32_t>(contador >> 32),
+                              flujoBajo_, flujoAlto_}, clave_);
+    return (indice & 1) ? aUniforme(salida[2], salida[3]) : aUniforme(salida[0], salida[1]);
+}
+
+void GeneradorPhilox::generar(uint64_t inicio, int64_t n, double* destino,
+                              double minimo, double maximo) const {
+    const double escala = maximo - minimo;
+    int64_t i = 0;
+    
+    // Alinear al inicio de un contador si el índice inicial es impar
+    if (n > 0 && (inicio & 1)) {
+        destino[i++] = minimo + escala * uniforme(inicio);
+    }
+    
+    // Lotes de contadores consecutivos en formato SoA: cada ronda se aplica a
+    // todos los carriles a la vez, sin dependencias entre ellos
+    while (n - i >= 2 * LOTE_CONTADORES) {
+        uint64_t base = (inicio + i) >> 1;
+        uint32_t c0[LOTE_CONTADORES], c1[LOTE_CONTADORES], c2[LOTE_CONTADORES], c3[LOTE_CONTADORES];
+        for (int j = 0; j < LOTE_CONTADORES; ++j) {
+            uint64_t contador = base + j;
+            c0[j] = static_cast<uint32_t>(contador);
+            c1[j] = static_cast<uint32_t>(contador >> 32);
+            c2[j] = flujoBajo_;
+            c3[j] = flujoAlto_;
+        }
+        
+        uint32_t k0 = clave_[0];
+        uint32_t k1 = clave_[1];
+        for (int ronda = 0; ronda < 10; ++ronda) {
+            if (ronda > 0) {
+                k0 += PHILOX_W0;
+                k1 += PHILOX_W1;
+            }
+            for (int j = 0; j < LOTE_CONTADORES; ++j) {
+                uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0[j];
+                uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2[j];
+                uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[j] ^ k0;
+                uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[j] ^ k1;
+                c1[j] = static_cast<uint32_t>(p1);
+                c3[j] = static_cast<uint32_t>(p0);
+                c0[j] = n0;
+                c2[j] = n2;
+            }
+        }
+        
+        for (int j = 0; j < LOTE_CONTADORES; ++j) {
+            destino[i + 2 * j] = minimo + escala * aUniforme(c0[j], c1[j]);
+            destino[i + 2 * j + 1] = minimo + escala * aUniforme(c2[j], c3[j]);
+        }
+        i += 2 * LOTE_CONTADORES;
+    }
+    
+    for (; i < n; ++i) {
+        destino[i] = minimo + escala * uniforme(inicio + i);
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * @file aleatorio.h
+ * @brief Generador aleatorio basado en contador (Philox4x32-10)
+ * @author Emil M
+ * @date 2025
+ * 
+ * A diferencia de std::mt19937, que es secuencial, un generador basado en
+ * contador calcula el valor del elemento i directamente a partir de (semilla, i).
+ * Esto permite saltar a cualquier posición, repartir la generación entre
+ * hilos, bloques y carriles SIMD sin solapamiento de flujos, y obtener el
+ * mismo conjunto de datos global independientemente de cómo se divida entre
+ * procesos.
+ */
+
+#ifndef MPI_AVANZADO_ALEATORIO_H
+#define MPI_AVANZADO_ALEATORIO_H
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief Semilla por defecto de los programas del proyecto
+ */
+const uint64_t SEMILLA_POR_DEFECTO = 42;
+
+/**
+ * @brief Generador Philox4x32-10 (Salmon et al., SC'11)
+ *
+ * Cada contador produce cuatro palabras de 32 bits, es decir, dos valores
+ * double. El elemento i usa la mitad (i % 2) del contador i / 2.
+ */
+class GeneradorPhilox {
+public:
+    using Contador = std::array<uint32_t, 4>;
+    using Clave = std::array<uint32_t, 2>;
+    
+    /**
+     * @brief Crea el generador
+     * @param semilla Semilla (clave de 64 bits)
+     * @param flujo Identificador de flujo independiente (p. ej. iteración)
+     */
+    explicit GeneradorPhilox(uint64_t semilla = SEMILLA_POR_DEFECTO, uint64_t flujo = 0);
+    
+    /**
+     * @brief Aplica las 10 rondas de Philox a un contador
+     * @param contador Contador de 128 bits
+     * @param clave Clave de 64 bits
+     * @return Cuatro palabras pseudoaleatorias
+     */
+    static Contador philox(Contador contador, Clave clave);
+    
+    /**
+     * @brief Valor uniforme en [0, 1) del elemento indicado
+     * @param indice Índice global del elemento
+     */
+    double uniforme(uint64_t indice) const;
+    
+    /**
+     * @brief Genera n valores uniformes en [minimo, maximo) a partir de un índice
+     * @param inicio Índice global del primer elemento
+     * @param n Número de valores a generar
+     * @param destino Buffer de salida con al menos n elementos
+     * @param minimo Límite inferior del intervalo
+     * @param maximo Límite superior del intervalo
+     */
+    void generar(uint64_t inicio, int64_t n, double* destino,
+                 double minimo = 0.0, double maximo = 100.0) const;
+
+private:
+    Clave clave_;
+    uint32_t flujoBajo_;
+    uint32_t flujoAlto_;
+};
+
+#endif // MPI_AVANZADO_ALEATORIO_H
@@ -0,0 +1,682 @@
+/**
+ * @file algoritmos.cpp
+ * @brief Implementación de los algoritmos colectivos propios
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "algoritmos.h"
+#include "colectivas.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace {
+
+const int ETIQUETA_BCAST = 7101;
+const int ETIQUETA_REDUCE = 7102;
+const int ETIQUETA_ALLREDUCE = 7103;
+
+/**
+ * @brief Tamaño en bytes de un elemento del tipo dado (incluyendo su extensión)
+ */
+MPI_Aint extensionTipo(MPI_Datatype datatype) {
+    MPI_Aint lowerBound = 0;
+    MPI_Aint extent = 0;
+    MPI_Type_get_extent(datatype, &lowerBound, &extent);
+    return extent;
+}
+
+/**
+ * @brief Posición del elemento indice dentro de un buffer
+ */
+char* desplazar(void* buffer, int64_t indice, MPI_Aint extent) {
+    return static_cast<char*>(buffer) + indice * extent;
+}
+
+/**
+ * @brief Elementos por segmento de la cadena (al menos uno)
+ */
+int elementosSegmento(MPI_Aint extent) {
+    return static_cast<int>(std::max<int64_t>(1, TAMANO_SEGMENTO_CADENA / std::max<MPI_Aint>(1, extent)));
+}
+
+/**
+ * @brief Rank real a partir del rank relativo a la raíz
+ */
+int rankReal(int relativo, int root, int numProcs) {
+    return (relativo + root) % numProcs;
+}
+
+/**
+ * @brief Mayor potencia de 2 que no supera n
+ */
+int potenciaDosInferior(int n) {
+    int potencia = 1;
+    while (potencia * 2 <= n) {
+        potencia *= 2;
+    }
+    return potencia;
+}
+
+/**
+ * @brief Plegado de P procesos a la potencia de 2 inferior
+ *
+ * Con P = p' + r, los 2r primeros ranks relativos se agrupan por parejas: el
+ * impar entrega su vector al par, que lo acumula y sigue en el algoritmo. El
+ * rank relativo 0 siempre sobrevive, así que la raíz queda dentro.
+ */
+struct Plegado {
+    int potencia = 1; ///< p', procesos que siguen tras el plegado
+    int resto = 0;    ///< r = P - p'
+    int nuevo = -1;   ///< Rank dentro de los p' procesos (-1 si se retira)
+    
+    Plegado(int relativo, int numProcs) : potencia(potenciaDosInferior(numProcs)), resto(numProcs - potencia) {
+        if (relativo < 2 * resto) {
+            nuevo = (relativo % 2 == 0) ? relativo / 2 : -1;
+        } else {
+            nuevo = relativo - resto;
+        }
+    }
+    
+    /**
+     * @brief Rank relativo de un rank plegado
+     */
+    int relativoDe(int plegado) const {
+        return plegado < resto ? plegado * 2 : plegado + resto;
+    }
+};
+
+/**
+ * @brief Acumulador de una reducción: recvbuf si está disponible, si no un temporal
+ *
+ * Empieza con una copia de los datos locales (o con recvbuf tal cual si se
+ * usa MPI_IN_PLACE).
+ */
+char* prepararAcumulador(const void* sendbuf, void* recvbuf, bool usarRecepcion, int64_t count,
+                         MPI_Aint extent, std::vector<char>& temporal) {
+    char* acumulador = nullptr;
+    if (usarRecepcion) {
+        acumulador = static_cast<char*>(recvbuf);
+    } else {
+        temporal.resize(static_cast<size_t>(count * extent));
+        acumulador = temporal.data();
+    }
+    if (sendbuf != MPI_IN_PLACE && count > 0) {
+        std::memcpy(acumulador, sendbuf, static_cast<size_t>(count * extent));
+    }
+    return acumulador;
+}
+
+/**
+ * @brief Tramo [inicio, fin) de elementos de un vector
+ */
+struct Tramo {
+    int64_t inicio = 0;
+    int64_t fin = 0;
+    
+    int elementos() const {
+        return static_cast<int>(fin - inicio);
+    }
+};
+
+// ============================================================================
+// Broadcast
+// ============================================================================
+
+int bcastBinomial(void* buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+    int rank = 0;
+    int numProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numProcs);
+    const int relativo = (rank - root + numProcs) % numProcs;
+    
+    // Recibir del padre: el bit más bajo a 1 del rank relativo
+    int mascara = 1;
+    while (mascara < numProcs) {
+        if (relativo & mascara) {
+            int error = MPI_Recv(buffer, count, datatype, rankReal(relativo - mascara, root, numProcs),
+                                 ETIQUETA_BCAST, comm, MPI_STATUS_IGNORE);
+            if (error != MPI_SUCCESS) {
+                return error;
+            }
+            break;
+        }
+        mascara <<= 1;
+    }
+    
+    // Reenviar a los hijos, del subárbol mayor al menor
+    for (mascara >>= 1; mascara > 0; mascara >>= 1) {
+        if (relativo + mascara < numProcs) {
+            int error = MPI_Send(buffer, count, datatype, rankReal(relativo + mascara, root, numProcs),
+                                 ETIQUETA_BCAST, comm);
+            if (error != MPI_SUCCESS) {
+                return error;
+            }
+        }
+    }
+    return MPI_SUCCESS;
+}
+
+int bcastCadena(void* buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+    int rank = 0;
+    int numProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numProcs);
+    const int relativo = (rank - root + numProcs) % numProcs;
+    const MPI_Aint extent = extensionTipo(datatype);
+    const int segmento = elementosSegmento(extent);
+    
+    // Cada segmento se reenvía en cuanto llega, mientras se recibe el siguiente
+    std::vector<MPI_Request> envios;
+    for (int inicio = 0; inicio < count; inicio += segmento) {
+        int elementos = std::min(segmento, count - inicio);
+        char* posicion = desplazar(buffer, inicio, extent);
+        if (relativo > 0) {
+            int error = MPI_Recv(posicion, elementos, datatype, rankReal(relativo - 1, root, numProcs),
+                                 ETIQUETA_BCAST, comm, MPI_STATUS_IGNORE);
+            if (error != MPI_SUCCESS) {
+                return error;
+            }
+        }
+        if (relativo + 1 < numProcs) {
+            MPI_Request peticion;
+            int error = MPI_Isend(posicion, elementos, datatype, rankReal(relativo + 1, root, numProcs),
+                                  ETIQUETA_BCAST, comm, &peticion);
+            if (error != MPI_SUCCESS) {
+                return error;
+            }
+            envios.push_back(peticion);
+        }
+    }
+    return MPI_Waitall(static_cast<int>(envios.size()), envios.data(), MPI_STATUSES_IGNORE);
+}
+
+int bcastScatterAllgather(void* buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+    int rank = 0;
+    int numProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numProcs);
+    if (count < numProcs) {
+        // Con menos elementos que procesos no hay bloques que repartir
+        return bcastBinomial(buffer, count, datatype, root, comm);
+    }
+    const int relativo = (rank - root + numProcs) % numProcs;
+    const MPI_Aint extent = extensionTipo(datatype);
+    const int bloque = (count + numProcs - 1) / numProcs;
+    
+    // Scatter binomial: cada proceso recibe los bloques de su subárbol
+    int recibidos = (relativo == 0) ? count : 0;
+    int mascara = 1;
+    while (mascara < numProcs) {
+        if (relativo & mascara) {
+            int64_t esperados = static_cast<int64_t>(count) - static_cast<int64_t>(relativo) * bloque;
+            if (esperados > 0) {
+                MPI_Status estado;
+                int error = MPI_Recv(desplazar(buffer, static_cast<int64_t>(relativo) * bloque, extent),
+                                     static_cast<int>(esperados), datatype,
+                                     rankReal(relativo - mascara, root, numProcs), ETIQUETA_BCAST, comm, &estado);
+                if (error != MPI_SUCCESS) {
+                    return error;
+                }
+                MPI_Get_count(&estado, datatype, &recibidos);
+            }
+            break;
+        }
+        mascara <<= 1;
+    }
+    for (mascara >>= 1; mascara > 0; mascara >>= 1) {
+        if (relativo + mascara < numProcs) {
+            int64_t enviar = static_cast<int64_t>(recibidos) - static_cast<int64_t>(bloque) * mascara;
+            if (enviar > 0) {
+                int error = MPI_Send(desplazar(buffer, static_cast<int64_t>(relativo + mascara) * bloque, extent),
+                                     static_cast<int>(enviar), datatype, rankReal(relativo + mascara, root, numProcs),
+                                     ETIQUETA_BCAST, comm);
+                if (error != MPI_SUCCESS) {
+                    return error;
+                }
+                recibidos -= static_cast<int>(enviar);
+            }
+        }
+    }
+    
+    // Allgather en anillo: en el paso i se pasa al vecino el bloque recibido en el paso i-1
+    auto tramoBloque = [&](int indice) {
+        Tramo tramo;
+        tramo.inicio = std::min<int64_t>(count, static_cast<int64_t>(indice) * bloque);
+        tramo.fin = std::min<int64_t>(count, tramo.inicio + bloque);
+        return tramo;
+    };
+    const int derecho = rankReal(relativo + 1, root, numProcs);
+    const int izquierdo = rankReal(relativo + numProcs - 1, root, numProcs);
+    for (int paso = 0; paso < numProcs - 1; ++paso) {
+        Tramo envio = tramoBloque((relativo - paso + numProcs) % numProcs);
+        Tramo recepcion = tramoBloque((relativo - paso - 1 + 2 * numProcs) % numProcs);
+        int error = MPI_Sendrecv(desplazar(buffer, envio.inicio, extent), envio.elementos(), datatype, derecho,
+                                 ETIQUETA_BCAST, desplazar(buffer, recepcion.inicio, extent), recepcion.elementos(),
+                                 datatype, izquierdo, ETIQUETA_BCAST, comm, MPI_STATUS_IGNORE);
+        if (error != MPI_SUCCESS) {
+            return error;
+        }
+    }
+    return MPI_SUCCESS;
+}
+
+// ============================================================================
+// Reduce
+// ============================================================================
+
+int reduceBinomial(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
+                   int root, MPI_Comm comm) {
+    int rank = 0;
+    int numProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numProcs);
+    const int relativo = (rank - root + numProcs) % numProcs;
+    const MPI_Aint extent = extensionTipo(datatype);
+    
+    std::vector<char> temporal;
+    char* acumulador = prepararAcumulador(sendbuf, recvbuf, rank == root, count, extent, temporal);
+    std::vector<char> entrante(static_cast<size_t>(count * extent));
+    
+    // Árbol binomial invertido: se acumula lo de cada hijo y se entrega al padre
+    for (int mascara = 1; mascara < numProcs; mascara <<= 1) {
+        if (relativo & mascara) {
+            return MPI_Send(acumulador, count, datatype, rankReal(relativo - mascara, root, numProcs),
+                            ETIQUETA_REDUCE, comm);
+        }
+        if (relativo + mascara < numProcs) {
+            int error = MPI_Recv(entrante.data(), count, datatype, rankReal(relativo + mascara, root, numProcs),
+                                 ETIQUETA_REDUCE, comm, MPI_STATUS_IGNORE);
+            if (error != MPI_SUCCESS) {
+                return error;
+            }
+            MPI_Reduce_local(entrante.data(), acumulador, count, datatype, op);
+        }
+    }
+    return MPI_SUCCESS;
+}
+
+int reduceCadena(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
+                 int root, MPI_Comm comm) {
+    int rank = 0;
+    int numProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numProcs);
+    const int relativo = (rank - root + numProcs) % numProcs;
+    const MPI_Aint extent = extensionTipo(datatype);
+    const int segmento = elementosSegmento(extent);
+    
+    std::vector<char> temporal;
+    char* acumulador = prepararAcumulador(sendbuf, recvbuf, rank == root, count, extent, temporal);
+    std::vector<char> entrante(static_cast<size_t>(std::min(segmento, count) * extent));
+    
+    // Los segmentos fluyen del último rank relativo hacia la raíz
+    std::vector<MPI_Request> envios;
+    for (int inicio = 0; inicio < count; inicio += segmento) {
+        int elementos = std::min(segmento, count - inicio);
+        char* posicion = desplazar(acumulador, inicio, extent);
+        if (relativo + 1 < numProcs) {
+            int error = MPI_Recv(entrante.data(), elementos, datatype, rankReal(relativo + 1, root, numProcs),
+                                 ETIQUETA_REDUCE, comm, MPI_STATUS_IGNORE);
+            if (error != MPI_SUCCESS) {
+                return error;
+            }
+            MPI_Reduce_local(entrante.data(), posicion, elementos, datatype, op);
+        }
+        if (relativo > 0) {
+            MPI_Request peticion;
+            int error = MPI_Isend(posicion, elementos, datatype, rankReal(relativo - 1, root, numProcs),
+                                  ETIQUETA_REDUCE, comm, &peticion);
+            if (error != MPI_SUCCESS) {
+                return error;
+            }
+            envios.push_back(peticion);
+        }
+    }
+    return MPI_Waitall(static_cast<int>(envios.size()), envios.data(), MPI_STATUSES_IGNORE);
+}
+
+/**
+ * @brief Reduce-scatter por mitades recursivas entre los p' procesos del plegado
+ * @param acumulador Vector completo; al terminar, el tramo devuelto contiene la reducción
+ * @param historial Tramos que el proceso tenía antes de cada paso (para deshacerlos)
+ * @return Tramo del que el proceso es responsable
+ */
+int reducirPorMitades(char* acumulador, int count, MPI_Datatype datatype, MPI_Op op, MPI_Aint extent,
+                      const Plegado& plegado, int root, int numProcs, int etiqueta, MPI_Comm comm,
+                      std::vector<Tramo>& historial, Tramo& propio) {
+    std::vector<char> entrante(static_cast<size_t>(((count + 1) / 2) * extent));
+    propio.inicio = 0;
+    propio.fin = count;
+    for (int mascara = plegado.potencia / 2; mascara > 0; mascara >>= 1) {
+        const int companero = rankReal(plegado.relativoDe(plegado.nuevo ^ mascara), root, numProcs);
+        const int64_t mitad = propio.inicio + (propio.fin - propio.inicio) / 2;
+        Tramo conservar = propio;
+        Tramo enviar = propio;
+        if ((plegado.nuevo & mascara) == 0) {
+            conservar.fin = mitad;
+            enviar.inicio = mitad;
+        } else {
+            conservar.inicio = mitad;
+            enviar.fin = mitad;
+        }
+        historial.push_back(propio);
+        int error = MPI_Sendrecv(desplazar(acumulador, enviar.inicio, extent), enviar.elementos(), datatype,
+                                 companero, etiqueta, entrante.data(), conservar.elementos(), datatype, companero,
+                                 etiqueta, comm, MPI_STATUS_IGNORE);
+        if (error != MPI_SUCCESS) {
+            return error;
+        }
+        MPI_Reduce_local(entrante.data(), desplazar(acumulador, conservar.inicio, extent), conservar.elementos(),
+                         datatype, op);
+        propio = conservar;
+    }
+    return MPI_SUCCESS;
+}
+
+int reduceRabenseifner(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
+                       int root, MPI_Comm comm) {
+    int rank = 0;
+    int numProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numProcs);
+    const int relativo = (rank - root + numProcs) % numProcs;
+    const MPI_Aint extent = extensionTipo(datatype);
+    const Plegado plegado(relativo, numProcs);
+    
+    std::vector<char> temporal;
+    char* acumulador = prepararAcumulador(sendbuf, recvbuf, rank == root, count, extent, temporal);
+    
+    // Plegado a potencia de 2
+    if (relativo < 2 * plegado.resto) {
+        if (plegado.nuevo < 0) {
+            return MPI_Send(acumulador, count, datatype, rankReal(relativo - 1, root, numProcs),
+                            ETIQUETA_REDUCE, comm);
+        }
+        std::vector<char> entrante(static_cast<size_t>(count * extent));
+        int error = MPI_Recv(entrante.data(), count, datatype, rankReal(relativo + 1, root, numProcs),
+                             ETIQUETA_REDUCE, comm, MPI_STATUS_IGNORE);
+        if (error != MPI_SUCCESS) {
+            return error;
+        }
+        MPI_Reduce_local(entrante.data(), acumulador, count, datatype, op);
+    }
+    
+    std::vector<Tramo> historial;
+    Tramo propio;
+    int error = reducirPorMitades(acumulador, count, datatype, op, extent, plegado, root, numProcs,
+                                  ETIQUETA_REDUCE, comm, historial, propio);
+    if (error != MPI_SUCCESS) {
+        return error;
+    }
+    
+    // Gather binomial de los tramos hacia el rank plegado 0 (la raíz)
+    for (int mascara = 1; mascara < plegado.potencia; mascara <<= 1) {
+        const int companero = rankReal(plegado.relativoDe(plegado.nuevo ^ mascara), root, numProcs);
+        const Tramo anterior = historial.back();
+        historial.pop_back();
+        if (plegado.nuevo & mascara) {
+            return MPI_Send(desplazar(acumulador, propio.inicio, extent), propio.elementos(), datatype, companero,
+                            ETIQUETA_REDUCE, comm);
+        }
+        Tramo ajeno = anterior;
+        if (propio.inicio == anterior.inicio) {
+            ajeno.inicio = propio.fin;
+        } else {
+            ajeno.fin = propio.inicio;
+        }
+        error = MPI_Recv(desplazar(acumulador, ajeno.inicio, extent), ajeno.elementos(), datatype, companero,
+                         ETIQUETA_REDUCE, comm, MPI_STATUS_IGNORE);
+        if (error != MPI_SUCCESS) {
+            return error;
+        }
+        propio = anterior;
+    }
+    return MPI_SUCCESS;
+}
+
+// ============================================================================
+// Allreduce
+// ============================================================================
+
+/**
+ * @brief Devuelve el resultado a los procesos retirados en el plegado
+ */
+int desplegar(char* acumulador, int count, MPI_Datatype datatype, const Plegado& plegado, int relativo,
+              MPI_Comm comm) {
+    if (relativo >= 2 * plegado.resto) {
+        return MPI_SUCCESS;
+    }
+    if (plegado.nuevo < 0) {
+        return MPI_Recv(acumulador, count, datatype, relativo - 1, ETIQUETA_ALLREDUCE, comm, MPI_STATUS_IGNORE);
+    }
+    return MPI_Send(acumulador, count, datatype, relativo + 1, ETIQUETA_ALLREDUCE, comm);
+}
+
+/**
+ * @brief Pliega a potencia de 2 (los ranks se usan tal cual, sin raíz)
+ */
+int plegar(char* acumulador, int count, MPI_Datatype datatype, MPI_Op op, MPI_Aint extent,
+           const Plegado& plegado, int relativo, MPI_Comm comm) {
+    if (relativo >= 2 * plegado.resto) {
+        return MPI_SUCCESS;
+    }
+    if (plegado.nuevo < 0) {
+        return MPI_Send(acumulador, count, datatype, relativo - 1, ETIQUETA_ALLREDUCE, comm);
+    }
+    std::vector<char> entrante(static_cast<size_t>(count * extent));
+    int error = MPI_Recv(entrante.data(), count, datatype, relativo + 1, ETIQUETA_ALLREDUCE, comm,
+                         MPI_STATUS_IGNORE);
+    if (error != MPI_SUCCESS) {
+        return error;
+    }
+    return MPI_Reduce_local(entrante.data(), acumulador, count, datatype, op);
+}
+
+int allreduceDobladoRecursivo(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
+                              MPI_Comm comm) {
+    int rank = 0;
+    int numProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numProcs);
+    const MPI_Aint extent = extensionTipo(datatype);
+    const Plegado plegado(rank, numProcs);
+    
+    std::vector<char> temporal;
+    char* acumulador = prepararAcumulador(sendbuf, recvbuf, true, count, extent, temporal);
+    int error = plegar(acumulador, count, datatype, op, extent, plegado, rank, comm);
+    if (error != MPI_SUCCESS) {
+        return error;
+    }
+    
+    // Cada pareja intercambia el vector completo y ambas calculan la misma
+    // combinación de los mismos dos operandos, así que el resultado coincide bit a bit
+    if (plegado.nuevo >= 0) {
+        std::vector<char> entrante(static_cast<size_t>(count * extent));
+        for (int mascara = 1; mascara < plegado.potencia; mascara <<= 1) {
+            const int companero = plegado.relativoDe(plegado.nuevo ^ mascara);
+            error = MPI_Sendrecv(acumulador, count, datatype, companero, ETIQUETA_ALLREDUCE, entrante.data(),
+                                 count, datatype, companero, ETIQUETA_ALLREDUCE, comm, MPI_STATUS_IGNORE);
+            if (error != MPI_SUCCESS) {
+                return error;
+            }
+            MPI_Reduce_local(entrante.data(), acumulador, count, datatype, op);
+        }
+    }
+    return desplegar(acumulador, count, datatype, plegado, rank, comm);
+}
+
+int allreduceRabenseifner(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
+                          MPI_Comm comm) {
+    int rank = 0;
+    int numProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numProcs);
+    const MPI_Aint extent = extensionTipo(datatype);
+    const Plegado plegado(rank, numProcs);
+    
+    std::vector<char> temporal;
+    char* acumulador = prepararAcumulador(sendbuf, recvbuf, true, count, extent, temporal);
+    int error = plegar(acumulador, count, datatype, op, extent, plegado, rank, comm);
+    if (error != MPI_SUCCESS) {
+        return error;
+    }
+    
+    if (plegado.nuevo >= 0) {
+        std::vector<Tramo> historial;
+        Tramo propio;
+        error = reducirPorMitades(acumulador, count, datatype, op, extent, plegado, 0, numProcs,
+                                  ETIQUETA_ALLREDUCE, comm, historial, propio);
+        if (error != MPI_SUCCESS) {
+            return error;
+        }
+        
+        // Allgather por duplicación recursiva deshaciendo los pasos en orden inverso
+        for (int mascara = 1; mascara < plegado.potencia; mascara <<= 1) {
+            const int companero = plegado.relativoDe(plegado.nuevo ^ mascara);
+            const Tramo anterior = historial.back();
+            historial.pop_back();
+            Tramo ajeno = anterior;
+            if (propio.inicio == anterior.inicio) {
+                ajeno.inicio = propio.fin;
+            } else {
+                ajeno.fin = propio.inicio;
+            }
+            error = MPI_Sendrecv(desplazar(acumulador, propio.inicio, extent), propio.elementos(), datatype,
+                                 companero, ETIQUETA_ALLREDUCE, desplazar(acumulador, ajeno.inicio, extent),
+                                 ajeno.elementos(), datatype, companero, ETIQUETA_ALLREDUCE, comm,
+                                 MPI_STATUS_IGNORE);
+            if (error != MPI_SUCCESS) {
+                return error;
+            }
+            propio = anterior;
+        }
+    }
+    return desplegar(acumulador, count, datatype, plegado, rank, comm);
+}
+
+} // namespace
+
+std::vector<AlgoritmoColectiva> algoritmosDe(OperacionColectiva operacion) {
+    switch (operacion) {
+        case OperacionColectiva::Bcast:
+            return {AlgoritmoColectiva::Biblioteca, AlgoritmoColectiva::Binomial, AlgoritmoColectiva::Cadena,
+                    AlgoritmoColectiva::ScatterAllgather};
+        case OperacionColectiva::Reduce:
+            return {AlgoritmoColectiva::Biblioteca, AlgoritmoColectiva::Binomial, AlgoritmoColectiva::Cadena,
+                    AlgoritmoColectiva::Rabenseifner};
+        case OperacionColectiva::Allreduce:
+            return {AlgoritmoColectiva::Biblioteca, AlgoritmoColectiva::DobladoRecursivo,
+                    AlgoritmoColectiva::Rabenseifner};
+    }
+    return {AlgoritmoColectiva::Biblioteca};
+}
+
+int bcastAlgoritmo(AlgoritmoColectiva algoritmo, void* buffer, int64_t count, MPI_Datatype datatype,
+                   int root, MPI_Comm comm) {
+    if (algoritmo == AlgoritmoColectiva::Biblioteca || count > INT_MAX) {
+        return bcastGrande(buffer, count, datatype, root, comm);
+    }
+    const int elementos = static_cast<int>(count);
+    switch (algoritmo) {
+        case AlgoritmoColectiva::Binomial:
+            return bcastBinomial(buffer, elementos, datatype, root, comm);
+        case AlgoritmoColectiva::Cadena:
+            return bcastCadena(buffer, elementos, datatype, root, comm);
+        case AlgoritmoColectiva::ScatterAllgather:
+            return bcastScatterAllgather(buffer, elementos, datatype, root, comm);
+        default:
+            return MPI_ERR_ARG;
+    }
+}
+
+int reduceAlgoritmo(AlgoritmoColectiva algoritmo, const void* sendbuf, void* recvbuf, int64_t count,
+                    MPI_Datatype datatype, MPI_Op op, int root, MPI_Comm comm) {
+    if (algoritmo == AlgoritmoColectiva::Biblioteca || count > INT_MAX) {
+        return reduceGrande(sendbuf, recvbuf, count, datatype, op, root, comm);
+    }
+    const int elementos = static_cast<int>(count);
+    switch (algoritmo) {
+        case AlgoritmoColectiva::Binomial:
+            return reduceBinomial(sendbuf, recvbuf, elementos, datatype, op, root, comm);
+        case AlgoritmoColectiva::Cadena:
+            return reduceCadena(sendbuf, recvbuf, elementos, datatype, op, root, comm);
+        case AlgoritmoColectiva::Rabenseifner:
+            return reduceRabenseifner(sendbuf, recvbuf, elementos, datatype, op, root, comm);
+        default:
+            return MPI_ERR_ARG;
+    }
+}
+
+int allreduceAlgoritmo(AlgoritmoColectiva algoritmo, const void* sendbuf, void* recvbuf, int64_t count,
+                       MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+    if (algoritmo == AlgoritmoColectiva::Biblioteca || count > INT_MAX) {
+        return allreduceGrande(sendbuf, recvbuf, count, datatype, op, comm);
+    }
+    const int elementos = static_cast<int>(count);
+    switch (algoritmo) {
+        case AlgoritmoColectiva::DobladoRecursivo:
+            return allreduceDobladoRecursivo(sendbuf, recvbuf, elementos, datatype, op, comm);
+        case AlgoritmoColectiva::Rabenseifner:
+            return allreduceRabenseifner(sendbuf, recvbuf, elementos, datatype, op, comm);
+        default:
+            return MPI_ERR_ARG;
+    }
+}
+
+const char* nombreAlgoritmo(AlgoritmoColectiva algoritmo) {
+    switch (algoritmo) {
+        case AlgoritmoColectiva::Biblioteca:
+            return "biblioteca";
+        case AlgoritmoColectiva::Binomial:
+            return "binomial";
+        case AlgoritmoColectiva::Cadena:
+            return "cadena";
+        case AlgoritmoColectiva::ScatterAllgather:
+            return "scatter-allgather";
+        case AlgoritmoColectiva::DobladoRecursivo:
+            return "doblado-recursivo";
+        case AlgoritmoColectiva::Rabenseifner:
+            return "rabenseifner";
+    }
+    return "desconocido";
+}
+
+const char* nombreOperacion(OperacionColectiva operacion) {
+    switch (operacion) {
+        case OperacionColectiva::Bcast:
+            return "bcast";
+        case OperacionColectiva::Reduce:
+            return "reduce";
+        case OperacionColectiva::Allreduce:
+            return "allreduce";
+    }
+    return "desconocida";
+}
+
+bool algoritmoPorNombre(const char* nombre, AlgoritmoColectiva& algoritmo) {
+    const AlgoritmoColectiva todos[] = {
+        AlgoritmoColectiva::Biblioteca, AlgoritmoColectiva::Binomial, AlgoritmoColectiva::Cadena,
+        AlgoritmoColectiva::ScatterAllgather, AlgoritmoColectiva::DobladoRecursivo,
+        AlgoritmoColectiva::Rabenseifner
+    };
+    for (AlgoritmoColectiva candidato : todos) {
+        if (std::strcmp(nombre, nombreAlgoritmo(candidato)) == 0) {
+            algoritmo = candidato;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool operacionPorNombre(const char* nombre, OperacionColectiva& operacion) {
+    for (OperacionColectiva candidata : OPERACIONES_COLECTIVAS) {
+        if (std::strcmp(nombre, nombreOperacion(candidata)) == 0) {
+            operacion = candidata;
+            return true;
+        }
+    }
+    return false;
+}
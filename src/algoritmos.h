@@ -0,0 +1,138 @@
+/**
+ * @file algoritmos.h
+ * @brief Algoritmos colectivos propios sobre punto a punto (árbol binomial, cadena segmentada...)
+ * @author Emil M
+ * @date 2025
+ *
+ * La biblioteca MPI elige internamente el algoritmo de cada colectiva y su
+ * elección no siempre es la mejor para una red y un tamaño concretos. Estas
+ * implementaciones con MPI_Send/MPI_Recv permiten medirlas una junto a otra:
+ * - Árbol binomial: log2(P) pasos con el mensaje completo (mensajes cortos).
+ * - Cadena segmentada: el mensaje avanza por segmentos de proceso en proceso,
+ *   de modo que todos los enlaces trabajan a la vez (mensajes largos).
+ * - Scatter + allgather (van de Geijn): broadcast que reparte un bloque por
+ *   proceso con un árbol binomial y lo completa con un allgather en anillo.
+ * - Duplicación recursiva: allreduce en log2(P) intercambios del vector entero.
+ * - Rabenseifner: reduce-scatter por mitades recursivas seguido de un gather
+ *   binomial (reduce) o de un allgather por duplicación recursiva (allreduce).
+ *
+ * Las operaciones de reducción deben ser conmutativas y los tipos de dato
+ * contiguos. Los mensajes usan etiquetas propias, así que no se mezclan con
+ * otros mensajes punto a punto del mismo comunicador si estos usan etiquetas
+ * distintas.
+ */
+
+#ifndef MPI_AVANZADO_ALGORITMOS_H
+#define MPI_AVANZADO_ALGORITMOS_H
+
+#include <mpi.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Colectiva con algoritmos alternativos
+ */
+enum class OperacionColectiva : int32_t {
+    Bcast,
+    Reduce,
+    Allreduce
+};
+
+/**
+ * @brief Todas las colectivas con algoritmos alternativos
+ */
+const OperacionColectiva OPERACIONES_COLECTIVAS[] = {
+    OperacionColectiva::Bcast,
+    OperacionColectiva::Reduce,
+    OperacionColectiva::Allreduce
+};
+
+/**
+ * @brief Algoritmo de una colectiva
+ */
+enum class AlgoritmoColectiva : int32_t {
+    Biblioteca,       ///< La implementación de la biblioteca MPI
+    Binomial,         ///< Árbol binomial (bcast, reduce)
+    Cadena,           ///< Cadena segmentada (bcast, reduce)
+    ScatterAllgather, ///< Scatter binomial + allgather en anillo (bcast)
+    DobladoRecursivo, ///< Duplicación recursiva (allreduce)
+    Rabenseifner      ///< Reduce-scatter por mitades + gather/allgather (reduce, allreduce)
+};
+
+/**
+ * @brief Bytes de cada segmento de la cadena segmentada
+ */
+const int64_t TAMANO_SEGMENTO_CADENA = int64_t(64) << 10;
+
+/**
+ * @brief Algoritmos disponibles para una colectiva (el primero es el de la biblioteca)
+ */
+std::vector<AlgoritmoColectiva> algoritmosDe(OperacionColectiva operacion);
+
+/**
+ * @brief MPI_Bcast con el algoritmo dado
+ * @param algoritmo Algoritmo (Biblioteca, Binomial, Cadena o ScatterAllgather)
+ * @param buffer Buffer a distribuir
+ * @param count Número de elementos
+ * @param datatype Tipo de dato contiguo de cada elemento
+ * @param root Proceso raíz
+ * @param comm Comunicador
+ * @return Código de error MPI (MPI_ERR_ARG si el algoritmo no aplica)
+ *
+ * Por encima de INT_MAX elementos se usa siempre la biblioteca.
+ */
+int bcastAlgoritmo(AlgoritmoColectiva algoritmo, void* buffer, int64_t count, MPI_Datatype datatype,
+                   int root, MPI_Comm comm);
+
+/**
+ * @brief MPI_Reduce con el algoritmo dado
+ * @param algoritmo Algoritmo (Biblioteca, Binomial, Cadena o Rabenseifner)
+ * @param sendbuf Datos locales (o MPI_IN_PLACE en la raíz)
+ * @param recvbuf Resultado (solo significativo en la raíz)
+ * @param count Número de elementos
+ * @param datatype Tipo de dato contiguo de cada elemento
+ * @param op Operación conmutativa
+ * @param root Proceso raíz
+ * @param comm Comunicador
+ * @return Código de error MPI (MPI_ERR_ARG si el algoritmo no aplica)
+ */
+int reduceAlgoritmo(AlgoritmoColectiva algoritmo, const void* sendbuf, void* recvbuf, int64_t count,
+                    MPI_Datatype datatype, MPI_Op op, int root, MPI_Comm comm);
+
+/**
+ * @brief MPI_Allreduce con el algoritmo dado
+ * @param algoritmo Algoritmo (Biblioteca, DobladoRecursivo o Rabenseifner)
+ * @param sendbuf Datos locales (o MPI_IN_PLACE)
+ * @param recvbuf Resultado en todos los procesos
+ * @param count Número de elementos
+ * @param datatype Tipo de dato contiguo de cada elemento
+ * @param op Operación conmutativa
+ * @param comm Comunicador
+ * @return Código de error MPI (MPI_ERR_ARG si el algoritmo no aplica)
+ */
+int allreduceAlgoritmo(AlgoritmoColectiva algoritmo, const void* sendbuf, void* recvbuf, int64_t count,
+                       MPI_Datatype datatype, MPI_Op op, MPI_Comm comm);
+
+/**
+ * @brief Nombre de un algoritmo ("biblioteca", "binomial", "cadena"...)
+ */
+const char* nombreAlgoritmo(AlgoritmoColectiva algoritmo);
+
+/**
+ * @brief Nombre de una colectiva ("bcast", "reduce" o "allreduce")
+ */
+const char* nombreOperacion(OperacionColectiva operacion);
+
+/**
+ * @brief Busca un algoritmo por nombre
+ * @return true si el nombre existe
+ */
+bool algoritmoPorNombre(const char* nombre, AlgoritmoColectiva& algoritmo);
+
+/**
+ * @brief Busca una colectiva por nombre
+ * @return true si el nombre existe
+ */
+bool operacionPorNombre(const char* nombre, OperacionColectiva& operacion);
+
+#endif // MPI_AVANZADO_ALGORITMOS_H
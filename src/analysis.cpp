@@ -1,333 +1,532 @@
-/**
- * @file analysis.cpp
- * @brief Programa de análisis avanzado para MPI - Memoria, robustez y escalabilidad
- * @author Estudiante
- * @date 2024
- * 
- * Este programa realiza análisis detallados:
- * - Medición de uso de memoria
- * - Tests de robustez (fallos, timeouts)
- * - Análisis de escalabilidad fuerte y débil
- * - Comparación de rendimiento
- */
-
-#include <mpi.h>
-#include <iostream>
-#include <vector>
-#include <random>
-#include <chrono>
-#include <iomanip>
-#include <fstream>
-#include <string>
-#include <sys/resource.h>
-#include <unistd.h>
-
-/**
- * @brief Obtiene el uso de memoria del proceso actual
- * @return Uso de memoria en KB
- */
-long getMemoryUsage() {
-    struct rusage rusage;
-    if (getrusage(RUSAGE_SELF, &rusage) == 0) {
-        return rusage.ru_maxrss;
-    }
-    return -1;
-}
-
-/**
- * @brief Obtiene información del sistema
- * @param rank Rank del proceso
- * @param numProcs Número total de procesos
- */
-void printSystemInfo(int rank, int numProcs) {
-    if (rank == 0) {
-        std::cout << "=== INFORMACIÓN DEL SISTEMA ===" << std::endl;
-        std::cout << "Número de procesos: " << numProcs << std::endl;
-        std::cout << "Número de núcleos: " << sysconf(_SC_NPROCESSORS_ONLN) << std::endl;
-        std::cout << "Tamaño de página: " << sysconf(_SC_PAGESIZE) << " bytes" << std::endl;
-        std::cout << std::endl;
-    }
-}
-
-/**
- * @brief Análisis de escalabilidad fuerte (mismo problema, más procesos)
- * @param N Tamaño total del problema
- * @param maxProcs Máximo número de procesos a probar
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- */
-void strongScalingAnalysis(int N, int maxProcs, int rank, int numProcs) {
-    if (rank == 0) {
-        std::cout << "=== ANÁLISIS DE ESCALABILIDAD FUERTE ===" << std::endl;
-        std::cout << "Tamaño total del problema: " << N << " elementos" << std::endl;
-        std::cout << std::endl;
-    }
-    
-    // Calcular elementos por proceso
-    int elementsPerProc = N / numProcs;
-    if (N % numProcs != 0) {
-        elementsPerProc++;
-    }
-    
-    // Generar datos
-    std::vector<double> data(elementsPerProc);
-    std::mt19937 gen(rank + 42);
-    std::uniform_real_distribution<double> dist(0.0, 100.0);
-    
-    for (int i = 0; i < elementsPerProc; ++i) {
-        data[i] = dist(gen);
-    }
-    
-    // Medir tiempo de computación
-    double startTime = MPI_Wtime();
-    
-    double localSum = 0.0;
-    for (double val : data) {
-        localSum += val;
-    }
-    
-    double globalSum = 0.0;
-    MPI_Reduce(&localSum, &globalSum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-    
-    double endTime = MPI_Wtime();
-    double elapsed = (endTime - startTime) * 1e6; // microsegundos
-    
-    // Medir memoria
-    long memoryUsage = getMemoryUsage();
-    
-    if (rank == 0) {
-        double avg = globalSum / N;
-        std::cout << "Procesos: " << numProcs << " | ";
-        std::cout << "Tiempo: " << std::fixed << std::setprecision(2) << elapsed << " μs | ";
-        std::cout << "Memoria: " << memoryUsage << " KB | ";
-        std::cout << "Promedio: " << std::fixed << std::setprecision(4) << avg << std::endl;
-    }
-}
-
-/**
- * @brief Análisis de escalabilidad débil (mismo trabajo por proceso)
- * @param NPerProc Elementos por proceso
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- */
-void weakScalingAnalysis(int NPerProc, int rank, int numProcs) {
-    if (rank == 0) {
-        std::cout << "=== ANÁLISIS DE ESCALABILIDAD DÉBIL ===" << std::endl;
-        std::cout << "Elementos por proceso: " << NPerProc << std::endl;
-        std::cout << std::endl;
-    }
-    
-    // Generar datos
-    std::vector<double> data(NPerProc);
-    std::mt19937 gen(rank + 42);
-    std::uniform_real_distribution<double> dist(0.0, 100.0);
-    
-    for (int i = 0; i < NPerProc; ++i) {
-        data[i] = dist(gen);
-    }
-    
-    // Medir tiempo
-    double startTime = MPI_Wtime();
-    
-    double localSum = 0.0;
-    for (double val : data) {
-        localSum += val;
-    }
-    
-    double globalSum = 0.0;
-    MPI_Reduce(&localSum, &globalSum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-    
-    double endTime = MPI_Wtime();
-    double elapsed = (endTime - startTime) * 1e6; // microsegundos
-    
-    // Medir memoria
-    long memoryUsage = getMemoryUsage();
-    
-    if (rank == 0) {
-        int totalElements = NPerProc * numProcs;
-        double avg = globalSum / totalElements;
-        std::cout << "Procesos: " << numProcs << " | ";
-        std::cout << "Total elementos: " << totalElements << " | ";
-        std::cout << "Tiempo: " << std::fixed << std::setprecision(2) << elapsed << " μs | ";
-        std::cout << "Memoria: " << memoryUsage << " KB | ";
-        std::cout << "Promedio: " << std::fixed << std::setprecision(4) << avg << std::endl;
-    }
-}
-
-/**
- * @brief Test de robustez - manejo de errores
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- */
-void robustnessTest(int rank, int numProcs) {
-    if (rank == 0) {
-        std::cout << "=== TEST DE ROBUSTEZ ===" << std::endl;
-    }
-    
-    // Test 1: Datos muy grandes
-    if (rank == 0) {
-        std::cout << "Test 1: Datos grandes (1M elementos)..." << std::endl;
-    }
-    
-    try {
-        std::vector<double> largeData(1000000);
-        std::mt19937 gen(rank + 42);
-        std::uniform_real_distribution<double> dist(0.0, 100.0);
-        
-        for (int i = 0; i < 1000000; ++i) {
-            largeData[i] = dist(gen);
-        }
-        
-        double localSum = 0.0;
-        for (double val : largeData) {
-            localSum += val;
-        }
-        
-        double globalSum = 0.0;
-        MPI_Reduce(&localSum, &globalSum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-        
-        if (rank == 0) {
-            std::cout << "  ✅ Test 1 completado exitosamente" << std::endl;
-        }
-    } catch (const std::exception& e) {
-        if (rank == 0) {
-            std::cout << "  ❌ Test 1 falló: " << e.what() << std::endl;
-        }
-    }
-    
-    // Test 2: Múltiples operaciones colectivas
-    if (rank == 0) {
-        std::cout << "Test 2: Múltiples operaciones colectivas..." << std::endl;
-    }
-    
-    std::vector<double> data(1000);
-    std::mt19937 gen(rank + 42);
-    std::uniform_real_distribution<double> dist(0.0, 100.0);
-    
-    for (int i = 0; i < 1000; ++i) {
-        data[i] = dist(gen);
-    }
-    
-    for (int iter = 0; iter < 10; ++iter) {
-        double localSum = 0.0;
-        for (double val : data) {
-            localSum += val;
-        }
-        
-        double globalSum = 0.0;
-        MPI_Reduce(&localSum, &globalSum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-        
-        MPI_Bcast(&globalSum, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-    }
-    
-    if (rank == 0) {
-        std::cout << "  ✅ Test 2 completado exitosamente" << std::endl;
-    }
-    
-    // Test 3: Verificación de sincronización
-    if (rank == 0) {
-        std::cout << "Test 3: Verificación de sincronización..." << std::endl;
-    }
-    
-    int localValue = rank + 1;
-    int globalSum = 0;
-    
-    MPI_Reduce(&localValue, &globalSum, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-    
-    if (rank == 0) {
-        int expectedSum = (numProcs * (numProcs + 1)) / 2;
-        if (globalSum == expectedSum) {
-            std::cout << "  ✅ Test 3 completado exitosamente" << std::endl;
-        } else {
-            std::cout << "  ❌ Test 3 falló: suma esperada " << expectedSum 
-                      << ", obtenida " << globalSum << std::endl;
-        }
-    }
-}
-
-/**
- * @brief Análisis de comunicación vs cómputo
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- */
-void communicationVsComputationAnalysis(int rank, int numProcs) {
-    if (rank == 0) {
-        std::cout << "=== ANÁLISIS COMUNICACIÓN VS CÓMPUTO ===" << std::endl;
-    }
-    
-    std::vector<int> problemSizes = {100, 1000, 10000, 100000};
-    
-    for (int N : problemSizes) {
-        std::vector<double> data(N);
-        std::mt19937 gen(rank + 42);
-        std::uniform_real_distribution<double> dist(0.0, 100.0);
-        
-        for (int i = 0; i < N; ++i) {
-            data[i] = dist(gen);
-        }
-        
-        // Medir tiempo de cómputo
-        double startComp = MPI_Wtime();
-        double localSum = 0.0;
-        for (double val : data) {
-            localSum += val;
-        }
-        double endComp = MPI_Wtime();
-        double compTime = (endComp - startComp) * 1e6;
-        
-        // Medir tiempo de comunicación
-        double startComm = MPI_Wtime();
-        double globalSum = 0.0;
-        MPI_Reduce(&localSum, &globalSum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-        double endComm = MPI_Wtime();
-        double commTime = (endComm - startComm) * 1e6;
-        
-        if (rank == 0) {
-            double totalTime = compTime + commTime;
-            double compRatio = (compTime / totalTime) * 100;
-            double commRatio = (commTime / totalTime) * 100;
-            
-            std::cout << "N=" << N << " | ";
-            std::cout << "Cómputo: " << std::fixed << std::setprecision(2) << compTime << " μs (" 
-                      << std::fixed << std::setprecision(1) << compRatio << "%) | ";
-            std::cout << "Comunicación: " << std::fixed << std::setprecision(2) << commTime << " μs (" 
-                      << std::fixed << std::setprecision(1) << commRatio << "%)" << std::endl;
-        }
-    }
-}
-
-int main(int argc, char** argv) {
-    MPI_Init(&argc, &argv);
-    
-    int rank, numProcs;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
-    
-    if (rank == 0) {
-        std::cout << "=== ANÁLISIS AVANZADO MPI - COMUNICACIONES COLECTIVAS ===" << std::endl;
-        std::cout << std::endl;
-    }
-    
-    // Información del sistema
-    printSystemInfo(rank, numProcs);
-    
-    // Análisis de escalabilidad fuerte
-    strongScalingAnalysis(10000, 16, rank, numProcs);
-    
-    // Análisis de escalabilidad débil
-    weakScalingAnalysis(1000, rank, numProcs);
-    
-    // Test de robustez
-    robustnessTest(rank, numProcs);
-    
-    // Análisis comunicación vs cómputo
-    communicationVsComputationAnalysis(rank, numProcs);
-    
-    if (rank == 0) {
-        std::cout << std::endl;
-        std::cout << "=== ANÁLISIS COMPLETADO ===" << std::endl;
-    }
-    
-    MPI_Finalize();
-    return 0;
+/**
+ * @file analysis.cpp
+ * @brief Programa de análisis avanzado para MPI - Memoria, robustez y escalabilidad
+ * @author Estudiante
+ * @date 2024
+ * 
+ * Este programa realiza análisis detallados:
+ * - Medición de uso de memoria
+ * - Tests de robustez (fallos, timeouts)
+ * - Análisis de escalabilidad fuerte y débil
+ * - Comparación de rendimiento
+ */
+
+#include <mpi.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdint>
+#include <unistd.h>
+
+#include "aleatorio.h"
+#include "colectivas.h"
+#include "configuracion.h"
+#include "desfase.h"
+#include "escalado.h"
+#include "persistente.h"
+#include "reparto.h"
+#include "resiliencia.h"
+#include "suma.h"
+#include "usomemoria.h"
+
+/**
+ * @brief Obtiene información del sistema
+ * @param rank Rank del proceso
+ * @param numProcs Número total de procesos
+ */
+void printSystemInfo(int rank, int numProcs) {
+    if (rank == 0) {
+        std::cout << "=== INFORMACIÓN DEL SISTEMA ===" << std::endl;
+        std::cout << "Número de procesos: " << numProcs << std::endl;
+        std::cout << "Número de núcleos: " << sysconf(_SC_NPROCESSORS_ONLN) << std::endl;
+        std::cout << "Tamaño de página: " << sysconf(_SC_PAGESIZE) << " bytes" << std::endl;
+        std::cout << std::endl;
+    }
+}
+
+/**
+ * @brief Punto del estudio de escalabilidad
+ */
+struct ScalingPoint {
+    MetricasEscalado metrics;     ///< Procesos y tiempo del punto
+    double average = 0.0;         ///< Promedio calculado
+    DesgloseColectiva breakdown;  ///< Espera y transferencia de MPI_Reduce
+};
+
+/**
+ * @brief Mide el núcleo del estudio (suma local + MPI_Reduce) en un subcomunicador
+ * @param data Valores locales del proceso
+ * @param comm Subcomunicador del punto (su rank 0 es el de clock)
+ * @param repetitions Repeticiones de la medida
+ * @param clock Reloj alineado con el rank 0
+ * @param globalSum Suma global recibida en el rank 0 de comm
+ * @param breakdown Desglose medio de MPI_Reduce (solo en el rank 0)
+ * @return Mejor tiempo (μs) entre repeticiones del proceso más lento (solo en el rank 0)
+ *
+ * Cada repetición empieza tras una barrera y su tiempo es el máximo entre
+ * procesos; se toma el mínimo de las repeticiones para filtrar el ruido. La
+ * llegada a MPI_Reduce se anota tras la suma local, así que el desfase es el
+ * desequilibrio de la suma y no la barrera.
+ */
+double measureKernel(const std::vector<double>& data, MPI_Comm comm, int repetitions,
+                     const RelojSincronizado& clock, double& globalSum, DesgloseColectiva& breakdown) {
+    double best = 0.0;
+    std::vector<DesgloseColectiva> breakdowns;
+    for (int rep = 0; rep < repetitions; ++rep) {
+        MPI_Barrier(comm);
+        double startTime = MPI_Wtime();
+        
+        double localSum = sumarValores(data.data(), static_cast<int64_t>(data.size()));
+        double arrival = clock.ahora();
+        MPI_Reduce(&localSum, &globalSum, 1, MPI_DOUBLE, MPI_SUM, 0, comm);
+        double departure = clock.ahora();
+        
+        double elapsed = (MPI_Wtime() - startTime) * 1e6; // microsegundos
+        double slowest = 0.0;
+        MPI_Reduce(&elapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+        best = (rep == 0) ? slowest : std::min(best, slowest);
+        breakdowns.push_back(desglosarColectiva(arrival, departure, 0, comm));
+    }
+    breakdown = promedioDesgloses(breakdowns);
+    return best;
+}
+
+/**
+ * @brief Imprime la tabla de escalabilidad con aceleración, eficiencia y Karp-Flatt
+ * @param points Tiempo, promedio y desglose de cada tamaño de subcomunicador
+ * @param weak true para escalado débil (aceleración escalada)
+ *
+ * Las últimas columnas separan MPI_Reduce en la espera media al proceso más
+ * lento (desequilibrio de carga) y la transferencia desde su llegada (red).
+ */
+void printScalingTable(const std::vector<ScalingPoint>& points, bool weak) {
+    std::cout << std::setw(9) << "Procesos" << std::setw(14) << "Tiempo (μs)"
+              << std::setw(13) << "Aceleración" << std::setw(12) << "Eficiencia"
+              << std::setw(12) << "Karp-Flatt" << std::setw(11) << "Promedio"
+              << std::setw(14) << "Desfase (μs)" << std::setw(14) << "Espera (μs)"
+              << std::setw(14) << "Transf. (μs)" << std::setw(10) << "Tardío" << std::endl;
+    double timeOne = points.front().metrics.tiempo;
+    for (const auto& point : points) {
+        MetricasEscalado metrics = metricasEscalado(timeOne, point.metrics.tiempo, point.metrics.procesos, weak);
+        std::cout << std::setw(9) << metrics.procesos
+                  << std::setw(13) << std::fixed << std::setprecision(2) << metrics.tiempo
+                  << std::setw(13) << std::setprecision(2) << metrics.aceleracion
+                  << std::setw(12) << std::setprecision(3) << metrics.eficiencia;
+        if (metrics.procesos > 1) {
+            std::cout << std::setw(12) << std::setprecision(4) << metrics.karpFlatt;
+        } else {
+            std::cout << std::setw(12) << "-";
+        }
+        std::cout << std::setw(11) << std::setprecision(4) << point.average
+                  << std::setw(13) << std::setprecision(2) << point.breakdown.desfase
+                  << std::setw(13) << point.breakdown.esperaMedia
+                  << std::setw(13) << point.breakdown.transferencia
+                  << std::setw(9) << point.breakdown.rankTardio << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Análisis de escalabilidad fuerte (mismo problema, más procesos)
+ * @param N Tamaño total del problema
+ * @param maxProcs Máximo número de procesos a probar
+ * @param repetitions Repeticiones de cada medida
+ * @param clock Reloj alineado con el rank 0
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ *
+ * Un solo lanzamiento mide subcomunicadores de 1, 2, 4, ... procesos
+ * (MPI_Comm_split) con los mismos N elementos repartidos de forma exacta.
+ */
+void strongScalingAnalysis(int64_t N, int maxProcs, int repetitions, const RelojSincronizado& clock, int rank,
+                           int numProcs) {
+    if (rank == 0) {
+        std::cout << "=== ANÁLISIS DE ESCALABILIDAD FUERTE ===" << std::endl;
+        std::cout << "Tamaño total del problema: " << N << " elementos, "
+                  << repetitions << " repeticiones por punto" << std::endl;
+    }
+    
+    std::vector<ScalingPoint> points;
+    for (int procs : tamanosEscalado(numProcs, maxProcs)) {
+        MPI_Comm sub = subcomunicadorEscalado(MPI_COMM_WORLD, procs);
+        if (sub == MPI_COMM_NULL) {
+            continue;
+        }
+        
+        // Reparto exacto de los N elementos: los primeros N % procs procesos
+        // tienen uno más, sin relleno, de modo que la suma cubre exactamente N
+        RepartoCarga reparto = repartoUniforme(N, procs);
+        std::vector<double> data(reparto.conteos[rank]);
+        GeneradorPhilox gen(SEMILLA_POR_DEFECTO);
+        gen.generar(static_cast<uint64_t>(reparto.desplazamientos[rank]), reparto.conteos[rank], data.data());
+        
+        double globalSum = 0.0;
+        ScalingPoint point;
+        point.metrics.procesos = procs;
+        point.metrics.tiempo = measureKernel(data, sub, repetitions, clock, globalSum, point.breakdown);
+        if (rank == 0) {
+            point.average = globalSum / static_cast<double>(N);
+            points.push_back(point);
+        }
+        MPI_Comm_free(&sub);
+    }
+    
+    // Memoria residente de todos los procesos, no solo la del raíz
+    ReduccionMemoria memory = reducirMemoria(medirMemoria(), 0, MPI_COMM_WORLD);
+    if (rank == 0) {
+        printScalingTable(points, false);
+        std::cout << "RSS actual: mín " << std::setprecision(0) << memory.minimo.rss << " KB, máx "
+                  << memory.maximo.rss << " KB (rank " << memory.rankMaximoRss << "), suma "
+                  << memory.suma.rss << " KB; pico máx " << memory.maximo.pico << " KB" << std::endl << std::endl;
+    }
+}
+
+/**
+ * @brief Perfil de memoria por fases (generación, colectiva, liberación)
+ * @param NPerProc Elementos por proceso
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ *
+ * Imprime, para cada fase, el RSS mínimo, máximo y total entre procesos, su
+ * incremento y el rank que más crece, el PSS total, el pico y la memoria que
+ * la biblioteca MPI declara por MPI_T.
+ */
+void memoryAnalysis(int64_t NPerProc, int rank, int numProcs) {
+    if (rank == 0) {
+        std::cout << "=== PERFIL DE MEMORIA POR FASES ===" << std::endl;
+        std::vector<std::string> variables = variablesMemoriaMpi();
+        std::cout << "Variables MPI_T de memoria: " << (variables.empty() ? "ninguna" : "");
+        for (size_t i = 0; i < variables.size(); ++i) {
+            std::cout << (i > 0 ? ", " : "") << variables[i];
+        }
+        std::cout << std::endl;
+    }
+    
+    PerfilMemoria profile;
+    {
+        std::vector<double> data(NPerProc);
+        GeneradorPhilox gen(SEMILLA_POR_DEFECTO);
+        gen.generar(static_cast<uint64_t>(rank) * NPerProc, NPerProc, data.data());
+        profile.marcar("generación");
+        
+        // Reducción de un vector completo: la raíz necesita otro buffer
+        // igual y la biblioteca MPI sus propios buffers intermedios
+        std::vector<double> reduced(rank == 0 ? NPerProc : 0);
+        reduceGrande(data.data(), reduced.data(), NPerProc, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+        profile.marcar("colectiva");
+    }
+    profile.marcar("liberación");
+    
+    profile.imprimir(0, MPI_COMM_WORLD, std::cout);
+    if (rank == 0) {
+        std::cout << "Vector de " << NPerProc << " doubles por proceso ("
+                  << NPerProc * static_cast<int64_t>(sizeof(double)) / 1024 << " KB) en " << numProcs
+                  << " procesos" << std::endl << std::endl;
+    }
+}
+
+/**
+ * @brief Análisis de escalabilidad débil (mismo trabajo por proceso)
+ * @param NPerProc Elementos por proceso
+ * @param maxProcs Máximo número de procesos a probar
+ * @param repetitions Repeticiones de cada medida
+ * @param clock Reloj alineado con el rank 0
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ */
+void weakScalingAnalysis(int64_t NPerProc, int maxProcs, int repetitions, const RelojSincronizado& clock, int rank,
+                         int numProcs) {
+    if (rank == 0) {
+        std::cout << "=== ANÁLISIS DE ESCALABILIDAD DÉBIL ===" << std::endl;
+        std::cout << "Elementos por proceso: " << NPerProc << ", "
+                  << repetitions << " repeticiones por punto" << std::endl;
+    }
+    
+    // Los datos de cada proceso no dependen del tamaño del subcomunicador
+    std::vector<double> data(NPerProc);
+    GeneradorPhilox gen(SEMILLA_POR_DEFECTO);
+    gen.generar(static_cast<uint64_t>(rank) * NPerProc, NPerProc, data.data());
+    
+    std::vector<ScalingPoint> points;
+    for (int procs : tamanosEscalado(numProcs, maxProcs)) {
+        MPI_Comm sub = subcomunicadorEscalado(MPI_COMM_WORLD, procs);
+        if (sub == MPI_COMM_NULL) {
+            continue;
+        }
+        
+        double globalSum = 0.0;
+        ScalingPoint point;
+        point.metrics.procesos = procs;
+        point.metrics.tiempo = measureKernel(data, sub, repetitions, clock, globalSum, point.breakdown);
+        if (rank == 0) {
+            int64_t totalElements = NPerProc * static_cast<int64_t>(procs);
+            point.average = globalSum / static_cast<double>(totalElements);
+            points.push_back(point);
+        }
+        MPI_Comm_free(&sub);
+    }
+    
+    if (rank == 0) {
+        printScalingTable(points, true);
+    }
+}
+
+/**
+ * @brief Test de robustez - manejo de errores
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ */
+void robustnessTest(int rank, int numProcs) {
+    if (rank == 0) {
+        std::cout << "=== TEST DE ROBUSTEZ ===" << std::endl;
+    }
+    
+    // Test 1: Datos muy grandes
+    if (rank == 0) {
+        std::cout << "Test 1: Datos grandes (1M elementos)..." << std::endl;
+    }
+    
+    try {
+        std::vector<double> largeData(1000000);
+        GeneradorPhilox gen(SEMILLA_POR_DEFECTO);
+        gen.generar(static_cast<uint64_t>(rank) * 1000000, 1000000, largeData.data());
+        
+        double localSum = sumarValores(largeData.data(), static_cast<int64_t>(largeData.size()));
+        
+        double globalSum = 0.0;
+        MPI_Reduce(&localSum, &globalSum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+        
+        if (rank == 0) {
+            std::cout << "  ✅ Test 1 completado exitosamente" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        if (rank == 0) {
+            std::cout << "  ❌ Test 1 falló: " << e.what() << std::endl;
+        }
+    }
+    
+    // Test 2: Múltiples operaciones colectivas
+    if (rank == 0) {
+        std::cout << "Test 2: Múltiples operaciones colectivas..." << std::endl;
+    }
+    
+    std::vector<double> data(1000);
+    GeneradorPhilox gen(SEMILLA_POR_DEFECTO);
+    gen.generar(static_cast<uint64_t>(rank) * 1000, 1000, data.data());
+    
+    // Los argumentos no cambian entre iteraciones: las colectivas se preparan
+    // una sola vez y cada iteración solo las reinicia
+    double sumaLocal = 0.0;
+    double sumaGlobal = 0.0;
+    ColectivaPersistente reduccion = ColectivaPersistente::reduce(&sumaLocal, &sumaGlobal, 1, MPI_DOUBLE, MPI_SUM,
+                                                                  0, MPI_COMM_WORLD);
+    ColectivaPersistente difusion = ColectivaPersistente::bcast(&sumaGlobal, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    
+    for (int iter = 0; iter < 10; ++iter) {
+        sumaLocal = sumarValores(data.data(), static_cast<int64_t>(data.size()));
+        
+        reduccion.ejecutar();
+        
+        difusion.ejecutar();
+    }
+    
+    if (rank == 0) {
+        std::cout << "  ✅ Test 2 completado exitosamente" << std::endl;
+    }
+    
+    // Test 3: Verificación de sincronización
+    if (rank == 0) {
+        std::cout << "Test 3: Verificación de sincronización..." << std::endl;
+    }
+    
+    int localValue = rank + 1;
+    int globalSum = 0;
+    
+    MPI_Reduce(&localValue, &globalSum, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    
+    if (rank == 0) {
+        int expectedSum = (numProcs * (numProcs + 1)) / 2;
+        if (globalSum == expectedSum) {
+            std::cout << "  ✅ Test 3 completado exitosamente" << std::endl;
+        } else {
+            std::cout << "  ❌ Test 3 falló: suma esperada " << expectedSum 
+                      << ", obtenida " << globalSum << std::endl;
+        }
+    }
+    
+    // Test 4: Proceso bloqueado durante la reducción. El último rank llega
+    // después del plazo; los demás lo dan por perdido, terminan el promedio
+    // con sus datos y siguen con un comunicador reducido
+    if (numProcs < 2) {
+        return;
+    }
+    if (rank == 0) {
+        std::cout << "Test 4: Reducción resiliente con un proceso bloqueado ("
+                  << (ulfmDisponible() ? "ULFM" : "plazos con MPI_Test") << ")..." << std::endl;
+    }
+    
+    const double deadline = 0.2;
+    const int64_t valuesPerProc = 1000;
+    {
+        ReduccionResiliente resilient(MPI_COMM_WORLD, deadline);
+        if (rank == numProcs - 1) {
+            usleep(static_cast<useconds_t>(3.0 * deadline * 1e6));
+        }
+        double localSum = sumarValores(data.data(), valuesPerProc);
+        double start = MPI_Wtime();
+        ResultadoResiliente outcome = resilient.reducir(localSum, valuesPerProc);
+        double elapsed = MPI_Wtime() - start;
+        
+        // Una segunda reducción solo entre los supervivientes
+        ResultadoResiliente second = resilient.reducir(localSum, valuesPerProc);
+        
+        if (rank == 0) {
+            int64_t lostValues = valuesPerProc * numProcs - outcome.cuenta;
+            bool ok = outcome.estado == EstadoResiliente::Reducida && outcome.procesosPerdidos.size() == 1 &&
+                      outcome.procesosPerdidos[0] == numProcs - 1 &&
+                      second.estado == EstadoResiliente::Completa && second.procesosIncluidos == numProcs - 1;
+            std::cout << "  Perdidos: " << outcome.procesosPerdidos.size() << " procesos, " << lostValues
+                      << " valores; promedio de " << outcome.cuenta << " valores: " << std::fixed
+                      << std::setprecision(4) << outcome.media() << " (" << std::setprecision(2)
+                      << elapsed * 1e3 << " ms)" << std::endl;
+            if (ok) {
+                std::cout << "  ✅ Test 4 completado exitosamente" << std::endl;
+            } else {
+                std::cout << "  ❌ Test 4 falló: el proceso bloqueado no se excluyó" << std::endl;
+            }
+        }
+    }
+    // El proceso "perdido" sigue vivo: se resincroniza con el resto
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/**
+ * @brief Análisis de comunicación vs cómputo
+ * @param clock Reloj alineado con el rank 0
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ *
+ * No hay barrera antes de cada tamaño, así que los procesos llegan a
+ * MPI_Reduce en momentos distintos; la comunicación del rank 0 se desglosa
+ * en la espera media al más lento y la transferencia desde su llegada.
+ */
+void communicationVsComputationAnalysis(const RelojSincronizado& clock, int rank, int numProcs) {
+    if (rank == 0) {
+        std::cout << "=== ANÁLISIS COMUNICACIÓN VS CÓMPUTO (" << numProcs << " procesos) ===" << std::endl;
+    }
+    
+    std::vector<int64_t> problemSizes = {100, 1000, 10000, 100000};
+    
+    for (int64_t N : problemSizes) {
+        std::vector<double> data(N);
+        GeneradorPhilox gen(SEMILLA_POR_DEFECTO);
+        gen.generar(static_cast<uint64_t>(rank) * N, N, data.data());
+        
+        // Medir tiempo de cómputo
+        double startComp = MPI_Wtime();
+        double localSum = sumarValores(data.data(), static_cast<int64_t>(data.size()));
+        double endComp = MPI_Wtime();
+        double compTime = (endComp - startComp) * 1e6;
+        
+        // Medir tiempo de comunicación
+        double startComm = MPI_Wtime();
+        double arrival = clock.ahora();
+        double globalSum = 0.0;
+        MPI_Reduce(&localSum, &globalSum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+        double departure = clock.ahora();
+        double endComm = MPI_Wtime();
+        double commTime = (endComm - startComm) * 1e6;
+        DesgloseColectiva breakdown = desglosarColectiva(arrival, departure, 0, MPI_COMM_WORLD);
+        
+        if (rank == 0) {
+            double totalTime = compTime + commTime;
+            double compRatio = (compTime / totalTime) * 100;
+            double commRatio = (commTime / totalTime) * 100;
+            
+            std::cout << "N=" << N << " | ";
+            std::cout << "Cómputo: " << std::fixed << std::setprecision(2) << compTime << " μs (" 
+                      << std::fixed << std::setprecision(1) << compRatio << "%) | ";
+            std::cout << "Comunicación: " << std::fixed << std::setprecision(2) << commTime << " μs (" 
+                      << std::fixed << std::setprecision(1) << commRatio << "%)" << std::endl;
+            std::cout << "    espera media " << std::setprecision(2) << breakdown.esperaMedia
+                      << " μs + transferencia " << breakdown.transferencia << " μs (desfase "
+                      << breakdown.desfase << " μs, último en llegar: rank " << breakdown.rankTardio << ")"
+                      << std::endl;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    
+    int rank, numProcs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+    
+    // Parámetros del estudio: --n-total para el escalado fuerte, --n por
+    // proceso para el débil, --iteraciones repeticiones por punto y
+    // --max-procs tope de procesos
+    Configuracion config = configuracionPorDefecto();
+    config.nTotal = int64_t(1) << 22;
+    config.N = int64_t(1) << 20;
+    config.iteraciones = 10;
+    if (rank == 0) {
+        interpretarArgumentos(argc, argv, config, std::cerr);
+        if (config.estado == EstadoConfiguracion::Valida && !validarTotalValores(config, numProcs, std::cerr)) {
+            config.estado = EstadoConfiguracion::Error;
+        }
+        if (config.estado == EstadoConfiguracion::Ayuda) {
+            imprimirAyuda(std::cout, argv[0]);
+        }
+    }
+    difundirConfiguracion(config, 0, MPI_COMM_WORLD);
+    if (config.estado != EstadoConfiguracion::Valida) {
+        MPI_Finalize();
+        return config.estado == EstadoConfiguracion::Ayuda ? 0 : 1;
+    }
+    
+    if (rank == 0) {
+        std::cout << "=== ANÁLISIS AVANZADO MPI - COMUNICACIONES COLECTIVAS ===" << std::endl;
+        std::cout << std::endl;
+    }
+    
+    // Información del sistema
+    printSystemInfo(rank, numProcs);
+    
+    // Reloj común para las marcas de llegada y salida de las colectivas
+    RelojSincronizado clock(MPI_COMM_WORLD);
+    double clockError = clock.error();
+    double maxClockError = 0.0;
+    MPI_Reduce(&clockError, &maxClockError, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    if (rank == 0) {
+        std::cout << "Reloj sincronizado con el rank 0 (error máximo " << std::fixed << std::setprecision(2)
+                  << maxClockError * 1e6 << " μs)" << std::endl << std::endl;
+    }
+    
+    // Análisis de escalabilidad fuerte
+    strongScalingAnalysis(config.nTotal, config.maxProcs, config.iteraciones, clock, rank, numProcs);
+    
+    // Análisis de escalabilidad débil
+    weakScalingAnalysis(config.N, config.maxProcs, config.iteraciones, clock, rank, numProcs);
+    
+    // Perfil de memoria por fases
+    memoryAnalysis(config.N, rank, numProcs);
+    
+    // Test de robustez
+    robustnessTest(rank, numProcs);
+    
+    // Análisis comunicación vs cómputo
+    communicationVsComputationAnalysis(clock, rank, numProcs);
+    
+    if (rank == 0) {
+        std::cout << std::endl;
+        std::cout << "=== ANÁLISIS COMPLETADO ===" << std::endl;
+    }
+    
+    MPI_Finalize();
+    return 0;
 } 
\ No newline at end of file
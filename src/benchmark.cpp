@@ -1,253 +1,1587 @@
-/**
- * @file benchmark.cpp
- * @brief Programa de benchmark para medir el rendimiento de las comunicaciones colectivas
- * @author Emil M
- * @date 2025
- * 
- * Este programa realiza mediciones de rendimiento para:
- * - MPI_Bcast con diferentes tamaños de datos
- * - MPI_Reduce con diferentes tamaños de datos
- * - Escalabilidad con diferentes números de procesos
- */
-
-#include <mpi.h>
-#include <iostream>
-#include <vector>
-#include <random>
-#include <chrono>
-#include <iomanip>
-#include <fstream>
-#include <string>
-
-/**
- * @brief Ejecuta un benchmark de MPI_Bcast
- * @param dataSize Tamaño de los datos a transmitir
- * @param numIterations Número de iteraciones para el benchmark
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- * @return Tiempo promedio en microsegundos
- */
-double benchmarkBroadcast(int dataSize, int numIterations, int rank, int numProcs) {
-    std::vector<double> data(dataSize);
-    
-    // Inicializar datos en el proceso raíz
-    if (rank == 0) {
-        std::mt19937 gen(42);
-        std::uniform_real_distribution<double> dist(0.0, 100.0);
-        for (int i = 0; i < dataSize; ++i) {
-            data[i] = dist(gen);
-        }
-    }
-    
-    // Sincronizar antes del benchmark
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    for (int iter = 0; iter < numIterations; ++iter) {
-        MPI_Bcast(data.data(), dataSize, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-    }
-    
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-    
-    return static_cast<double>(duration.count()) / numIterations;
-}
-
-/**
- * @brief Ejecuta un benchmark de MPI_Reduce
- * @param dataSize Tamaño de los datos a reducir
- * @param numIterations Número de iteraciones para el benchmark
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- * @return Tiempo promedio en microsegundos
- */
-double benchmarkReduce(int dataSize, int numIterations, int rank, int numProcs) {
-    std::vector<double> localData(dataSize);
-    std::vector<double> globalData(dataSize);
-    
-    // Inicializar datos locales
-    std::mt19937 gen(rank + 42);
-    std::uniform_real_distribution<double> dist(0.0, 100.0);
-    for (int i = 0; i < dataSize; ++i) {
-        localData[i] = dist(gen);
-    }
-    
-    // Sincronizar antes del benchmark
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    for (int iter = 0; iter < numIterations; ++iter) {
-        MPI_Reduce(localData.data(), globalData.data(), dataSize, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-    }
-    
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-    
-    return static_cast<double>(duration.count()) / numIterations;
-}
-
-/**
- * @brief Ejecuta un benchmark completo del programa principal
- * @param N Número de valores por proceso
- * @param numIterations Número de iteraciones para el benchmark
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- * @return Tiempo promedio en microsegundos
- */
-double benchmarkCompleto(int N, int numIterations, int rank, int numProcs) {
-    std::vector<double> valores(N);
-    double sumaParcial = 0.0;
-    double sumaTotal = 0.0;
-    double promedioFinal = 0.0;
-    
-    // Sincronizar antes del benchmark
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    for (int iter = 0; iter < numIterations; ++iter) {
-        // Generar valores aleatorios
-        std::mt19937 generador(rank + 42 + iter);
-        std::uniform_real_distribution<double> distribucion(0.0, 100.0);
-        
-        for (int i = 0; i < N; ++i) {
-            valores[i] = distribucion(generador);
-        }
-        
-        // Calcular suma parcial
-        sumaParcial = 0.0;
-        for (double valor : valores) {
-            sumaParcial += valor;
-        }
-        
-        // MPI_Reduce
-        MPI_Reduce(&sumaParcial, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-        
-        // Calcular promedio en proceso raíz
-        if (rank == 0) {
-            promedioFinal = sumaTotal / (N * numProcs);
-        }
-        
-        // MPI_Bcast del promedio
-        MPI_Bcast(&promedioFinal, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-    }
-    
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-    
-    return static_cast<double>(duration.count()) / numIterations;
-}
-
-/**
- * @brief Guarda los resultados del benchmark en un archivo CSV
- * @param filename Nombre del archivo
- * @param results Vector de resultados
- */
-void guardarResultados(const std::string& filename, const std::vector<std::string>& results) {
-    if (MPI::COMM_WORLD.Get_rank() == 0) {
-        std::ofstream file(filename);
-        if (file.is_open()) {
-            for (const auto& result : results) {
-                file << result << std::endl;
-            }
-            file.close();
-            std::cout << "Resultados guardados en: " << filename << std::endl;
-        }
-    }
-}
-
-int main(int argc, char** argv) {
-    MPI_Init(&argc, &argv);
-    
-    int rank, numProcs;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
-    
-    if (rank == 0) {
-        std::cout << "=== BENCHMARK DE COMUNICACIONES COLECTIVAS MPI ===" << std::endl;
-        std::cout << "Número de procesos: " << numProcs << std::endl;
-        std::cout << std::endl;
-    }
-    
-    std::vector<std::string> resultados;
-    resultados.push_back("Operacion,TamañoDatos,NumProcesos,TiempoPromedio(microsegundos)");
-    
-    // Configuración del benchmark
-    std::vector<int> dataSizes = {1, 10, 100, 1000, 10000};
-    std::vector<int> NValues = {100, 1000, 10000};
-    int numIterations = 100;
-    
-    // Benchmark de MPI_Bcast
-    if (rank == 0) {
-        std::cout << "Ejecutando benchmark de MPI_Bcast..." << std::endl;
-    }
-    
-    for (int dataSize : dataSizes) {
-        double tiempoPromedio = benchmarkBroadcast(dataSize, numIterations, rank, numProcs);
-        
-        if (rank == 0) {
-            std::string resultado = "MPI_Bcast," + std::to_string(dataSize) + "," + 
-                                   std::to_string(numProcs) + "," + 
-                                   std::to_string(tiempoPromedio);
-            resultados.push_back(resultado);
-            
-            std::cout << "  MPI_Bcast con " << dataSize << " elementos: " 
-                      << std::fixed << std::setprecision(2) << tiempoPromedio 
-                      << " microsegundos" << std::endl;
-        }
-    }
-    
-    // Benchmark de MPI_Reduce
-    if (rank == 0) {
-        std::cout << std::endl << "Ejecutando benchmark de MPI_Reduce..." << std::endl;
-    }
-    
-    for (int dataSize : dataSizes) {
-        double tiempoPromedio = benchmarkReduce(dataSize, numIterations, rank, numProcs);
-        
-        if (rank == 0) {
-            std::string resultado = "MPI_Reduce," + std::to_string(dataSize) + "," + 
-                                   std::to_string(numProcs) + "," + 
-                                   std::to_string(tiempoPromedio);
-            resultados.push_back(resultado);
-            
-            std::cout << "  MPI_Reduce con " << dataSize << " elementos: " 
-                      << std::fixed << std::setprecision(2) << tiempoPromedio 
-                      << " microsegundos" << std::endl;
-        }
-    }
-    
-    // Benchmark del programa completo
-    if (rank == 0) {
-        std::cout << std::endl << "Ejecutando benchmark del programa completo..." << std::endl;
-    }
-    
-    for (int N : NValues) {
-        double tiempoPromedio = benchmarkCompleto(N, numIterations, rank, numProcs);
-        
-        if (rank == 0) {
-            std::string resultado = "ProgramaCompleto," + std::to_string(N) + "," + 
-                                   std::to_string(numProcs) + "," + 
-                                   std::to_string(tiempoPromedio);
-            resultados.push_back(resultado);
-            
-            std::cout << "  Programa completo con N=" << N << ": " 
-                      << std::fixed << std::setprecision(2) << tiempoPromedio 
-                      << " microsegundos" << std::endl;
-        }
-    }
-    
-    // Guardar resultados
-    std::string filename = "benchmark_results_" + std::to_string(numProcs) + "procs.csv";
-    guardarResultados(filename, resultados);
-    
-    if (rank == 0) {
-        std::cout << std::endl << "=== BENCHMARK COMPLETADO ===" << std::endl;
-        std::cout << "Los resultados han sido guardados en: " << filename << std::endl;
-    }
-    
-    MPI_Finalize();
-    return 0;
+/**
+ * @file benchmark.cpp
+ * @brief Programa de benchmark para medir el rendimiento de las comunicaciones colectivas
+ * @author Emil M
+ * @date 2025
+ * 
+ * Este programa realiza mediciones de rendimiento para:
+ * - MPI_Bcast con diferentes tamaños de datos
+ * - MPI_Reduce con diferentes tamaños de datos
+ * - Escalabilidad con diferentes números de procesos
+ */
+
+#include <mpi.h>
+#include <iostream>
+#include <vector>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <cmath>
+
+#include "ajuste.h"
+#include "aleatorio.h"
+#include "algoritmos.h"
+#include "colectivas.h"
+#include "configuracion.h"
+#include "escalado.h"
+#include "estadisticas.h"
+#include "gpu.h"
+#include "hilos.h"
+#include "jerarquia.h"
+#include "malla.h"
+#include "memoria.h"
+#include "persistente.h"
+#include "precision.h"
+#include "reductor.h"
+#include "resultados.h"
+#include "solapamiento.h"
+#include "suma.h"
+
+/**
+ * @brief Ranura del pool de buffers con los datos de envío (o el vector generado)
+ */
+const int RANURA_ENVIO = 0;
+
+/**
+ * @brief Ranura del pool de buffers con el resultado de las reducciones
+ */
+const int RANURA_RECEPCION = 1;
+
+/**
+ * @brief Ranuras con la carga en precisión reducida (envío y resultado)
+ */
+const int RANURA_REDUCIDA_ENVIO = 2;
+const int RANURA_REDUCIDA_RECEPCION = 3;
+
+/**
+ * @brief Ranura con el resultado en doble precisión que sirve de referencia
+ */
+const int RANURA_REFERENCIA = 4;
+
+/**
+ * @brief Ranuras de las colectivas de columna de la malla (envío y resultado)
+ */
+const int RANURA_COLUMNA_ENVIO = 5;
+const int RANURA_COLUMNA_RECEPCION = 6;
+
+/**
+ * @brief Doubles que ocupan `elementos` valores en la precisión dada (para pedir ranuras)
+ */
+int64_t doublesParaCarga(int64_t elementos, PrecisionCarga precision) {
+    int64_t bytes = elementos * bytesPorElemento(precision);
+    return (bytes + static_cast<int64_t>(sizeof(double)) - 1) / static_cast<int64_t>(sizeof(double));
+}
+
+/**
+ * @brief Ejecuta un benchmark de MPI_Bcast
+ * @param dataSize Tamaño de los datos a transmitir
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones para el benchmark
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @param buffers Buffers compartidos entre fases (se usa la ranura de envío)
+ * @return Estadísticas por iteración en microsegundos (válidas en el rank 0)
+ */
+EstadisticasTiempo benchmarkBroadcast(int64_t dataSize, int calentamiento, int numIterations, int rank, int numProcs,
+                                      PoolBuffers& buffers) {
+    double* data = buffers.obtener(RANURA_ENVIO, dataSize);
+    
+    // Inicializar datos en el proceso raíz
+    if (rank == 0) {
+        GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+        generador.generar(0, dataSize, data);
+    }
+    
+    return medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+        bcastAjustado(data, dataSize, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    });
+}
+
+/**
+ * @brief Ejecuta un benchmark de MPI_Reduce
+ * @param dataSize Tamaño de los datos a reducir
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones para el benchmark
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @param precision Precisión de la carga (las conversiones se incluyen en la medida)
+ * @param buffers Buffers compartidos entre fases (ranuras de envío, recepción y carga reducida)
+ * @return Estadísticas por iteración en microsegundos (válidas en el rank 0)
+ */
+EstadisticasTiempo benchmarkReduce(int64_t dataSize, int calentamiento, int numIterations, int rank, int numProcs,
+                                   PrecisionCarga precision, PoolBuffers& buffers) {
+    double* localData = buffers.obtener(RANURA_ENVIO, dataSize);
+    double* globalData = buffers.obtener(RANURA_RECEPCION, dataSize);
+    double* envioReducido = buffers.obtener(RANURA_REDUCIDA_ENVIO, doublesParaCarga(dataSize, precision));
+    double* recepcionReducida = buffers.obtener(RANURA_REDUCIDA_RECEPCION, doublesParaCarga(dataSize, precision));
+    
+    // Inicializar datos locales: cada proceso genera su tramo del vector global
+    GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+    generador.generar(static_cast<uint64_t>(rank) * dataSize, dataSize, localData);
+    
+    // Las conversiones forman parte de la medida: son el coste de la precisión reducida
+    return medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+        reducirSumaConPrecision(localData, globalData, dataSize, precision, envioReducido, recepcionReducida,
+                                0, MPI_COMM_WORLD);
+    });
+}
+
+/**
+ * @brief Tiempos de un Reductor<T, Op>: núcleo local y MPI_Reduce del vector
+ */
+struct ResultadoReductor {
+    EstadisticasTiempo local;     ///< Reducción local de dataSize elementos
+    EstadisticasTiempo reduccion; ///< MPI_Reduce elemento a elemento de dataSize elementos
+};
+
+/**
+ * @brief Ejecuta el benchmark de un Reductor especializado en T y Op
+ * @param dataSize Elementos de tipo T por proceso
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones para el benchmark
+ * @param rank Rank del proceso actual
+ * @param buffers Buffers compartidos entre fases (ranuras de envío y recepción, de al menos dataSize doubles)
+ * @return Estadísticas por iteración en microsegundos (válidas en el rank 0)
+ */
+template <typename T, typename Op>
+ResultadoReductor benchmarkReductor(int64_t dataSize, int calentamiento, int numIterations, int rank,
+                                    PoolBuffers& buffers) {
+    using R = Reductor<T, Op>;
+    T* envio = reinterpret_cast<T*>(buffers.obtener(RANURA_ENVIO, dataSize));
+    T* recepcion = reinterpret_cast<T*>(buffers.obtener(RANURA_RECEPCION, dataSize));
+    
+    // Valores pequeños: el producto se desborda igual que en cualquier
+    // ejecución real, pero nunca produce subnormales que falseen el tiempo
+    for (int64_t i = 0; i < dataSize; ++i) {
+        envio[i] = static_cast<T>(1 + (rank + i) % 3);
+    }
+    
+    ResultadoReductor resultado;
+    volatile typename R::Acumulado sumidero = R::neutro();
+    resultado.local = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+        sumidero = R::local(envio, dataSize);
+    });
+    resultado.reduccion = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+        R::reducir(envio, recepcion, dataSize, 0, MPI_COMM_WORLD);
+    });
+    return resultado;
+}
+
+#if defined(MPI_AVANZADO_GPU)
+/**
+ * @brief Tiempos de MPI_Bcast y MPI_Reduce con buffers del dispositivo
+ */
+struct MedidaGpu {
+    EstadisticasTiempo bcast;  ///< Broadcast de dataSize doubles desde el rank 0
+    EstadisticasTiempo reduce; ///< Reducción de dataSize doubles en el rank 0
+};
+
+/**
+ * @brief Ejecuta MPI_Bcast y MPI_Reduce sobre memoria del dispositivo con un transporte
+ * @param dataSize Doubles por proceso
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones para el benchmark
+ * @param rank Rank del proceso actual
+ * @param gpu GPU del proceso
+ * @param transporte Copia al host, puntero del dispositivo a MPI o NCCL
+ * @param envio Buffer del dispositivo de al menos dataSize doubles
+ * @param recepcion Buffer del dispositivo de al menos dataSize doubles
+ * @return Estadísticas por iteración en microsegundos (válidas en el rank 0)
+ *
+ * Los datos son los de benchmarkBroadcast y benchmarkReduce, generados
+ * directamente en el dispositivo.
+ */
+MedidaGpu benchmarkGpu(int64_t dataSize, int calentamiento, int numIterations, int rank, ContextoGpu& gpu,
+                       TransporteGpu transporte, double* envio, double* recepcion) {
+    MedidaGpu medida;
+    gpu.generar(SEMILLA_POR_DEFECTO, 0, dataSize, recepcion);
+    medida.bcast = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+        gpu.bcast(recepcion, dataSize, 0, transporte);
+    });
+    
+    gpu.generar(SEMILLA_POR_DEFECTO, static_cast<uint64_t>(rank) * dataSize, dataSize, envio);
+    gpu.sincronizar();
+    medida.reduce = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+        gpu.reduce(envio, recepcion, dataSize, 0, transporte);
+    });
+    return medida;
+}
+#endif
+
+/**
+ * @brief Error de una reducción en precisión reducida respecto de la de doble precisión
+ */
+struct ErrorPrecision {
+    double absoluto = 0.0; ///< Máximo de |reducido - doble|
+    double relativo = 0.0; ///< Error absoluto dividido por el máximo de |doble|
+};
+
+/**
+ * @brief Mide el error de la reducción en la precisión dada frente a MPI_DOUBLE
+ * @param dataSize Número de doubles
+ * @param precision Precisión de la carga
+ * @param rank Rank del proceso actual
+ * @param buffers Buffers compartidos entre fases
+ * @return Error máximo (válido en el rank 0)
+ *
+ * Usa los mismos datos que benchmarkReduce.
+ */
+ErrorPrecision errorPrecision(int64_t dataSize, PrecisionCarga precision, int rank, PoolBuffers& buffers) {
+    double* localData = buffers.obtener(RANURA_ENVIO, dataSize);
+    double* globalData = buffers.obtener(RANURA_RECEPCION, dataSize);
+    double* referencia = buffers.obtener(RANURA_REFERENCIA, dataSize);
+    double* envioReducido = buffers.obtener(RANURA_REDUCIDA_ENVIO, doublesParaCarga(dataSize, precision));
+    double* recepcionReducida = buffers.obtener(RANURA_REDUCIDA_RECEPCION, doublesParaCarga(dataSize, precision));
+    GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+    generador.generar(static_cast<uint64_t>(rank) * dataSize, dataSize, localData);
+    
+    reduceGrande(localData, referencia, dataSize, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    reducirSumaConPrecision(localData, globalData, dataSize, precision, envioReducido, recepcionReducida,
+                            0, MPI_COMM_WORLD);
+    
+    ErrorPrecision error;
+    if (rank == 0) {
+        double escala = 0.0;
+        for (int64_t i = 0; i < dataSize; ++i) {
+            error.absoluto = std::max(error.absoluto, std::abs(globalData[i] - referencia[i]));
+            escala = std::max(escala, std::abs(referencia[i]));
+        }
+        error.relativo = escala > 0.0 ? error.absoluto / escala : 0.0;
+    }
+    return error;
+}
+
+/**
+ * @brief Operaciones que se comparan entre la versión plana y la jerárquica
+ */
+const char* const OPERACIONES_JERARQUICAS[] = {"MPI_Bcast", "MPI_Reduce", "MPI_Allreduce"};
+
+/**
+ * @brief Tiempos de una colectiva plana y de su versión jerárquica
+ */
+struct ComparacionJerarquica {
+    EstadisticasTiempo plano;      ///< Colectiva sobre MPI_COMM_WORLD
+    EstadisticasTiempo jerarquico; ///< Colectiva en dos niveles (nodo y líderes)
+};
+
+/**
+ * @brief Compara una colectiva plana con su versión jerárquica
+ * @param operacion "MPI_Bcast", "MPI_Reduce" o "MPI_Allreduce"
+ * @param dataSize Número de doubles
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones para el benchmark
+ * @param rank Rank del proceso actual
+ * @param jerarquico Comunicadores de nodo y de líderes
+ * @param buffers Buffers compartidos entre fases (ranuras de envío y recepción)
+ * @return Estadísticas de ambas versiones (válidas en el rank 0)
+ */
+ComparacionJerarquica benchmarkJerarquico(const std::string& operacion, int64_t dataSize, int calentamiento,
+                                          int numIterations, int rank, ComunicadorJerarquico& jerarquico,
+                                          PoolBuffers& buffers) {
+    double* envio = buffers.obtener(RANURA_ENVIO, dataSize);
+    double* recepcion = buffers.obtener(RANURA_RECEPCION, dataSize);
+    GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+    generador.generar(static_cast<uint64_t>(rank) * dataSize, dataSize, envio);
+    
+    ComparacionJerarquica comparacion;
+    if (operacion == "MPI_Bcast") {
+        comparacion.plano = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+            bcastGrande(envio, dataSize, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+        });
+        comparacion.jerarquico = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+            jerarquico.bcast(envio, dataSize, MPI_DOUBLE);
+        });
+    } else if (operacion == "MPI_Reduce") {
+        comparacion.plano = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+            reduceGrande(envio, recepcion, dataSize, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+        });
+        comparacion.jerarquico = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+            jerarquico.reduce(envio, recepcion, dataSize, MPI_DOUBLE, MPI_SUM);
+        });
+    } else {
+        comparacion.plano = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+            allreduceGrande(envio, recepcion, dataSize, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        });
+        comparacion.jerarquico = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+            jerarquico.allreduce(envio, recepcion, dataSize, MPI_DOUBLE, MPI_SUM);
+        });
+    }
+    return comparacion;
+}
+
+/**
+ * @brief Benchmark de broadcast hacia una única copia por nodo en memoria compartida
+ * @param dataSize Número de doubles
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones para el benchmark
+ * @param rank Rank del proceso actual
+ * @param compartido Ventana compartida del nodo con capacidad suficiente
+ * @return Estadísticas de tiempo en microsegundos (válidas en el rank 0)
+ */
+EstadisticasTiempo benchmarkBroadcastCompartido(int64_t dataSize, int calentamiento, int numIterations, int rank,
+                                                BufferNodoCompartido& compartido) {
+    double* data = static_cast<double*>(compartido.datos());
+    
+    // Inicializar datos en el proceso raíz (su copia es la de su nodo)
+    if (rank == 0) {
+        GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+        generador.generar(0, dataSize, data);
+    }
+    
+    return medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+        compartido.difundir(dataSize, MPI_DOUBLE);
+    });
+}
+
+/**
+ * @brief Tiempos de una colectiva bloqueante y de su versión persistente
+ */
+struct ComparacionPersistente {
+    EstadisticasTiempo bloqueante;       ///< Llamada bloqueante en cada iteración
+    EstadisticasTiempo conPreparacion;   ///< Preparar, iniciar, esperar y liberar en cada iteración
+    EstadisticasTiempo persistente;      ///< Solo iniciar y esperar una colectiva preparada antes
+    
+    /**
+     * @brief Coste de preparación por llamada que ahorra la persistencia (μs, medianas)
+     */
+    double costePreparacion() const { return conPreparacion.mediana - persistente.mediana; }
+};
+
+/**
+ * @brief Separa el coste de preparación de una colectiva del de su ejecución
+ * @param operacion "MPI_Bcast" o "MPI_Allreduce"
+ * @param dataSize Número de doubles
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones para el benchmark
+ * @param rank Rank del proceso actual
+ * @param buffers Buffers compartidos entre fases (ranuras de envío y recepción)
+ * @return Estadísticas de las tres variantes (válidas en el rank 0)
+ */
+ComparacionPersistente benchmarkPersistente(const std::string& operacion, int64_t dataSize, int calentamiento,
+                                            int numIterations, int rank, PoolBuffers& buffers) {
+    double* envio = buffers.obtener(RANURA_ENVIO, dataSize);
+    double* recepcion = buffers.obtener(RANURA_RECEPCION, dataSize);
+    GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+    generador.generar(static_cast<uint64_t>(rank) * dataSize, dataSize, envio);
+    bool esBcast = operacion == "MPI_Bcast";
+    auto preparar = [&]() {
+        return esBcast ? ColectivaPersistente::bcast(envio, dataSize, MPI_DOUBLE, 0, MPI_COMM_WORLD)
+                       : ColectivaPersistente::allreduce(envio, recepcion, dataSize, MPI_DOUBLE, MPI_SUM,
+                                                         MPI_COMM_WORLD);
+    };
+    
+    ComparacionPersistente comparacion;
+    comparacion.bloqueante = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+        if (esBcast) {
+            bcastGrande(envio, dataSize, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+        } else {
+            allreduceGrande(envio, recepcion, dataSize, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        }
+    });
+    comparacion.conPreparacion = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+        ColectivaPersistente colectiva = preparar();
+        colectiva.ejecutar();
+    });
+    ColectivaPersistente colectiva = preparar();
+    comparacion.persistente = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+        colectiva.ejecutar();
+    });
+    return comparacion;
+}
+
+/**
+ * @brief Genera un tramo de valores y calcula su suma repartiendo el trabajo entre hilos
+ * @param generador Generador basado en contador
+ * @param inicioGlobal Índice global del primer valor del tramo
+ * @param cantidad Número de valores del tramo
+ * @param destino Buffer donde se escriben los valores
+ * @param pool Pool de hilos
+ * @param modoSuma Modo del núcleo de suma local
+ * @return Suma del tramo (las sumas de los hilos se combinan en orden fijo)
+ */
+double generarYSumarTramo(const GeneradorPhilox& generador, int64_t inicioGlobal, int64_t cantidad,
+                          double* destino, PoolHilos& pool, ModoSuma modoSuma) {
+    std::vector<double> sumasHilos(pool.numHilos());
+    
+    pool.ejecutar([&](int hilo) {
+        std::pair<int64_t, int64_t> rango = rangoHilo(cantidad, hilo, pool.numHilos());
+        generador.generar(static_cast<uint64_t>(inicioGlobal + rango.first),
+                          rango.second - rango.first, destino + rango.first);
+        sumasHilos[hilo] = sumarValores(destino + rango.first, rango.second - rango.first, modoSuma);
+    });
+    
+    double suma = 0.0;
+    for (double parcial : sumasHilos) {
+        suma += parcial;
+    }
+    return suma;
+}
+
+/**
+ * @brief Ejecuta un benchmark de una estrategia de reducción en todos los procesos
+ * @param dataSize Tamaño del vector a reducir
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones para el benchmark
+ * @param estrategia Estrategia colectiva a medir
+ * @param rank Rank del proceso actual
+ * @param buffers Buffers compartidos entre fases (ranuras de envío y recepción)
+ * @return Estadísticas por iteración en microsegundos (válidas en el rank 0)
+ */
+EstadisticasTiempo benchmarkEstrategia(int64_t dataSize, int calentamiento, int numIterations,
+                                       EstrategiaColectiva estrategia, int rank, PoolBuffers& buffers) {
+    double* localData = buffers.obtener(RANURA_ENVIO, dataSize);
+    double* globalData = buffers.obtener(RANURA_RECEPCION, dataSize);
+    
+    GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+    generador.generar(static_cast<uint64_t>(rank) * dataSize, dataSize, localData);
+    
+    return medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int) {
+        reducirEnTodos(localData, globalData, dataSize, MPI_DOUBLE, MPI_SUM,
+                       MPI_COMM_WORLD, estrategia);
+    });
+}
+
+/**
+ * @brief Ejecuta un benchmark completo del programa principal
+ * @param N Número de valores por proceso
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones para el benchmark
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @param pool Pool de hilos que reparte la generación y la suma parcial
+ * @param modoSuma Modo del núcleo de suma local
+ * @param estrategia Estrategia colectiva para obtener el promedio en todos los procesos
+ * @param persistente Si es true, las colectivas se preparan una vez y se reinician en cada iteración
+ * @param buffers Buffers compartidos entre fases (se usa la ranura de envío)
+ * @return Estadísticas por iteración en microsegundos (válidas en el rank 0)
+ */
+EstadisticasTiempo benchmarkCompleto(int64_t N, int calentamiento, int numIterations, int rank, int numProcs,
+                                     PoolHilos& pool, ModoSuma modoSuma, EstrategiaColectiva estrategia,
+                                     bool persistente, PoolBuffers& buffers) {
+    double* valores = buffers.obtener(RANURA_ENVIO, N);
+    double sumaParcial = 0.0;
+    double sumaTotal = 0.0;
+    double promedioFinal = 0.0;
+    int64_t totalValores = N * static_cast<int64_t>(numProcs);
+    int64_t inicioProceso = static_cast<int64_t>(rank) * N;
+    
+    // Las colectivas repiten los mismos argumentos en cada iteración: en modo
+    // persistente se preparan aquí una sola vez (reduce-scatter + allgather
+    // no tiene forma persistente)
+    persistente &= estrategia != EstrategiaColectiva::ReduceScatterAllgather;
+    std::unique_ptr<ColectivaPersistente> reduccion;
+    std::unique_ptr<ColectivaPersistente> difusion;
+    if (persistente && estrategia == EstrategiaColectiva::Allreduce) {
+        reduccion.reset(new ColectivaPersistente(
+            ColectivaPersistente::allreduce(&sumaParcial, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD)));
+    } else if (persistente) {
+        reduccion.reset(new ColectivaPersistente(
+            ColectivaPersistente::reduce(&sumaParcial, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD)));
+        difusion.reset(new ColectivaPersistente(
+            ColectivaPersistente::bcast(&promedioFinal, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD)));
+    }
+    
+    return medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int iter) {
+        // Generar valores aleatorios y calcular la suma parcial;
+        // cada iteración usa un flujo independiente del generador
+        GeneradorPhilox generador(SEMILLA_POR_DEFECTO, static_cast<uint64_t>(iter));
+        sumaParcial = generarYSumarTramo(generador, inicioProceso, N, valores, pool, modoSuma);
+        
+        if (persistente) {
+            reduccion->ejecutar();
+            if (difusion) {
+                if (rank == 0) {
+                    promedioFinal = sumaTotal / static_cast<double>(totalValores);
+                }
+                difusion->ejecutar();
+            } else {
+                promedioFinal = sumaTotal / static_cast<double>(totalValores);
+            }
+        } else if (estrategia == EstrategiaColectiva::ReduceBcast) {
+            // MPI_Reduce (con el algoritmo de la tabla activa, si hay)
+            reduceAjustado(&sumaParcial, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+            
+            // Calcular promedio en proceso raíz
+            if (rank == 0) {
+                promedioFinal = sumaTotal / static_cast<double>(totalValores);
+            }
+            
+            // MPI_Bcast del promedio
+            bcastAjustado(&promedioFinal, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+        } else {
+            // Una sola colectiva deja la suma en todos los procesos
+            reducirEnTodos(&sumaParcial, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, estrategia);
+            promedioFinal = sumaTotal / static_cast<double>(totalValores);
+        }
+    });
+}
+
+/**
+ * @brief Resultado del benchmark de solapamiento
+ *
+ * Los tiempos totales son estadísticas por iteración (máximo entre procesos);
+ * la comunicación y la espera son medias por iteración del rank 0.
+ */
+struct ResultadoSolapamiento {
+    EstadisticasTiempo tiempoBloqueante;  ///< Programa completo con MPI_Reduce bloqueante (μs)
+    double comunicacionBloqueante = 0.0;  ///< Tiempo dentro de MPI_Reduce bloqueante (μs)
+    EstadisticasTiempo tiempoSolapado;    ///< Programa completo con MPI_Ireduce por segmento (μs)
+    double esperaSolapada = 0.0;          ///< Tiempo esperando las reducciones pendientes (μs)
+    
+    /**
+     * @brief Porcentaje de la latencia de comunicación oculta tras el cómputo
+     */
+    double latenciaOcultada() const {
+        if (comunicacionBloqueante <= 0.0) {
+            return 0.0;
+        }
+        double ocultada = 1.0 - esperaSolapada / comunicacionBloqueante;
+        return (ocultada > 0.0 ? ocultada : 0.0) * 100.0;
+    }
+    
+    /**
+     * @brief Diferencia de tiempo total entre ambos modos (negativa si el solapado es más lento)
+     */
+    double ahorroNeto() const { return tiempoBloqueante.media - tiempoSolapado.media; }
+};
+
+/**
+ * @brief Compara el programa completo bloqueante con el modo solapado por segmentos
+ * @param N Número de valores por proceso
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones para el benchmark
+ * @param segmentos Número de segmentos del modo solapado
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @param pool Pool de hilos que reparte la generación y la suma parcial
+ * @param modoSuma Modo del núcleo de suma local
+ * @param buffers Buffers compartidos entre fases (se usa la ranura de envío)
+ * @return Tiempos de ambos modos y latencia de comunicación restante
+ */
+ResultadoSolapamiento benchmarkSolapamiento(int64_t N, int calentamiento, int numIterations, int segmentos,
+                                            int rank, int numProcs, PoolHilos& pool, ModoSuma modoSuma,
+                                            PoolBuffers& buffers) {
+    ResultadoSolapamiento resultado;
+    double* valores = buffers.obtener(RANURA_ENVIO, N);
+    double sumaTotal = 0.0;
+    double promedioFinal = 0.0;
+    double totalValores = static_cast<double>(N * static_cast<int64_t>(numProcs));
+    int64_t inicioProceso = static_cast<int64_t>(rank) * N;
+    
+    // Línea base bloqueante: calcular todo y después reducir
+    resultado.tiempoBloqueante = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int iter) {
+        GeneradorPhilox generador(SEMILLA_POR_DEFECTO, static_cast<uint64_t>(iter));
+        double sumaParcial = generarYSumarTramo(generador, inicioProceso, N, valores, pool, modoSuma);
+        
+        double inicioComunicacion = MPI_Wtime();
+        MPI_Reduce(&sumaParcial, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+        if (iter >= calentamiento) {
+            resultado.comunicacionBloqueante += MPI_Wtime() - inicioComunicacion;
+        }
+        
+        if (rank == 0) {
+            promedioFinal = sumaTotal / totalValores;
+        }
+        MPI_Bcast(&promedioFinal, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    });
+    
+    // Modo solapado: publicar cada segmento con MPI_Ireduce y seguir calculando
+    resultado.tiempoSolapado = medirColectiva(calentamiento, numIterations, MPI_COMM_WORLD, [&](int iter) {
+        GeneradorPhilox generador(SEMILLA_POR_DEFECTO, static_cast<uint64_t>(iter));
+        ReduccionSolapada reduccion(segmentos, ModoSuma::Rapida, 0, MPI_COMM_WORLD);
+        
+        for (int segmento = 0; segmento < segmentos; ++segmento) {
+            std::pair<int64_t, int64_t> rango = rangoHilo(N, segmento, segmentos);
+            double suma = generarYSumarTramo(generador, inicioProceso + rango.first,
+                                             rango.second - rango.first,
+                                             valores + rango.first, pool, modoSuma);
+            reduccion.publicar(segmento, SumaCompensada{suma, 0.0});
+        }
+        
+        sumaTotal = reduccion.esperar().total();
+        if (iter >= calentamiento) {
+            resultado.esperaSolapada += reduccion.tiempoEspera();
+        }
+        
+        if (rank == 0) {
+            promedioFinal = sumaTotal / totalValores;
+        }
+        MPI_Bcast(&promedioFinal, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    });
+    
+    // Convertir a microsegundos por iteración
+    double escala = 1e6 / numIterations;
+    resultado.comunicacionBloqueante *= escala;
+    resultado.esperaSolapada *= escala;
+    return resultado;
+}
+
+/**
+ * @brief Tamaños del barrido: potencias de dos entre dos tamaños en bytes
+ * @param minimoBytes Tamaño mínimo (se redondea hacia arriba a una potencia de dos y a un double)
+ * @param maximoBytes Tamaño máximo
+ * @return Número de doubles de cada punto del barrido
+ */
+std::vector<int64_t> tamanosBarrido(int64_t minimoBytes, int64_t maximoBytes) {
+    std::vector<int64_t> tamanos;
+    int64_t bytes = static_cast<int64_t>(sizeof(double));
+    while (bytes < minimoBytes) {
+        bytes *= 2;
+    }
+    for (; bytes <= maximoBytes; bytes *= 2) {
+        tamanos.push_back(bytes / static_cast<int64_t>(sizeof(double)));
+        if (bytes > maximoBytes / 2) {
+            break; // El siguiente doble superaría el máximo (o desbordaría)
+        }
+    }
+    return tamanos;
+}
+
+/**
+ * @brief Iteraciones para un punto del barrido
+ * @param iteraciones Iteraciones configuradas (para mensajes de hasta 1 MiB)
+ * @param bytes Tamaño del mensaje
+ * @return Iteraciones escaladas para que cada punto mueva como mucho
+ *         `iteraciones` MiB, con un mínimo de 5
+ *
+ * Por encima de 1 MiB cada iteración dura lo bastante para que pocas
+ * muestras den una mediana estable, y así el barrido hasta cientos de MB
+ * termina en un tiempo razonable.
+ */
+int iteracionesParaTamano(int iteraciones, int64_t bytes) {
+    const int64_t UN_MIB = 1 << 20;
+    if (bytes <= UN_MIB) {
+        return iteraciones;
+    }
+    int64_t escaladas = static_cast<int64_t>(iteraciones) * UN_MIB / bytes;
+    return static_cast<int>(std::max<int64_t>(std::min<int64_t>(iteraciones, 5), escaladas));
+}
+
+/**
+ * @brief Ancho de banda en GB/s (10^9 bytes por segundo)
+ * @param bytes Bytes del mensaje
+ * @param microsegundos Tiempo de la operación
+ */
+double anchoBanda(int64_t bytes, double microsegundos) {
+    return microsegundos > 0.0 ? static_cast<double>(bytes) / (microsegundos * 1e3) : 0.0;
+}
+
+/**
+ * @brief Factor del ancho de banda de bus respecto al algorítmico
+ * @param operacion Nombre de la operación ("MPI_Bcast", "MPI_Reduce" o una reducción en todos los
+ *                  procesos), con un prefijo de variante opcional
+ * @param numProcs Número total de procesos
+ *
+ * El ancho de banda de bus normaliza por el volumen que un algoritmo óptimo
+ * mueve por cada enlace, lo que permite compararlo con el pico del hardware:
+ * 1 para broadcast y reduce, 2(P-1)/P para allreduce.
+ */
+double factorBus(const std::string& operacion, int numProcs) {
+    // Las variantes ("Plano:MPI_Bcast", "Jerarquico:MPI_Reduce"...) usan el factor de su colectiva
+    if (operacion.find("MPI_Bcast") != std::string::npos || operacion.find("MPI_Reduce") != std::string::npos) {
+        return 1.0;
+    }
+    return 2.0 * (numProcs - 1) / numProcs;
+}
+
+/**
+ * @brief Construye un registro de resultados
+ * @param operacion Nombre de la operación medida
+ * @param tamano Tamaño de los datos (elementos)
+ * @param numProcs Número total de procesos
+ * @param numHilos Número de hilos por proceso
+ * @param estadisticas Estadísticas por iteración
+ * @param bytes Bytes movidos por la colectiva (0 si el ancho de banda no aplica)
+ * @return Registro con los anchos de banda algorítmico y de bus (calculados con la mediana)
+ */
+RegistroResultado registroResultado(const std::string& operacion, int64_t tamano, int numProcs, int numHilos,
+                                    const EstadisticasTiempo& estadisticas, int64_t bytes = 0) {
+    RegistroResultado registro;
+    registro.operacion = operacion;
+    registro.tamano = tamano;
+    registro.procesos = numProcs;
+    registro.hilos = numHilos;
+    registro.estadisticas = estadisticas;
+    registro.bytes = bytes;
+    registro.anchoBanda = anchoBanda(bytes, estadisticas.mediana);
+    registro.anchoBandaBus = registro.anchoBanda * factorBus(operacion, numProcs);
+    return registro;
+}
+
+/**
+ * @brief Formatea un tamaño en bytes con unidades binarias (B, KiB, MiB, GiB)
+ */
+std::string formatearBytes(int64_t bytes) {
+    const char* unidades[] = {"B", "KiB", "MiB", "GiB"};
+    int unidad = 0;
+    while (unidad < 3 && bytes >= 1024 && bytes % 1024 == 0) {
+        bytes /= 1024;
+        ++unidad;
+    }
+    return std::to_string(bytes) + " " + unidades[unidad];
+}
+
+/**
+ * @brief Imprime un resumen de las estadísticas en una línea
+ * @param estadisticas Estadísticas por iteración
+ */
+void imprimirEstadisticas(const EstadisticasTiempo& estadisticas) {
+    std::cout << std::fixed << std::setprecision(2)
+              << "media " << estadisticas.media << " μs | mín " << estadisticas.minimo
+              << " | mediana " << estadisticas.mediana << " | p95 " << estadisticas.p95
+              << " | p99 " << estadisticas.p99 << " | desv " << estadisticas.desviacion << std::endl;
+}
+
+/**
+ * @brief Guarda los resultados del benchmark en CSV y en JSON lines con metadatos
+ * @param filename Nombre del archivo CSV
+ * @param jsonFilename Nombre del archivo JSON lines
+ * @param metadatos Contexto de la ejecución
+ * @param results Registros de resultados
+ */
+void guardarResultados(const std::string& filename, const std::string& jsonFilename,
+                       const MetadatosEjecucion& metadatos, const std::vector<RegistroResultado>& results) {
+    if (MPI::COMM_WORLD.Get_rank() == 0) {
+        std::ofstream file(filename);
+        if (file.is_open()) {
+            file << cabeceraCsvResultados() << std::endl;
+            for (const auto& result : results) {
+                file << filaCsv(result) << std::endl;
+            }
+            file.close();
+            std::cout << "Resultados guardados en: " << filename << std::endl;
+        }
+        std::ofstream jsonFile(jsonFilename);
+        if (jsonFile.is_open()) {
+            escribirJsonLineas(jsonFile, metadatos, results);
+            jsonFile.close();
+            std::cout << "Resultados con metadatos guardados en: " << jsonFilename << std::endl;
+        }
+    }
+}
+
+/**
+ * @brief Nombre MPI de una colectiva con algoritmos alternativos (para las filas CSV)
+ */
+const char* nombreColectivaMpi(OperacionColectiva operacion) {
+    switch (operacion) {
+        case OperacionColectiva::Bcast:
+            return "MPI_Bcast";
+        case OperacionColectiva::Reduce:
+            return "MPI_Reduce";
+        case OperacionColectiva::Allreduce:
+            return "MPI_Allreduce";
+    }
+    return "desconocida";
+}
+
+/**
+ * @brief Mide un algoritmo de una colectiva sobre un subcomunicador
+ * @param operacion Colectiva
+ * @param algoritmo Algoritmo a medir
+ * @param dataSize Número de doubles
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones medidas
+ * @param comm Subcomunicador del punto del barrido
+ * @param buffers Buffers compartidos entre fases (ranuras de envío y recepción)
+ * @return Estadísticas por iteración en microsegundos (válidas en el rank 0 de comm)
+ */
+EstadisticasTiempo benchmarkAlgoritmo(OperacionColectiva operacion, AlgoritmoColectiva algoritmo, int64_t dataSize,
+                                      int calentamiento, int numIterations, MPI_Comm comm, PoolBuffers& buffers) {
+    double* envio = buffers.obtener(RANURA_ENVIO, dataSize);
+    double* recepcion = buffers.obtener(RANURA_RECEPCION, dataSize);
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+    GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+    generador.generar(static_cast<uint64_t>(rank) * dataSize, dataSize, envio);
+    
+    return medirColectiva(calentamiento, numIterations, comm, [&](int) {
+        switch (operacion) {
+            case OperacionColectiva::Bcast:
+                bcastAlgoritmo(algoritmo, envio, dataSize, MPI_DOUBLE, 0, comm);
+                break;
+            case OperacionColectiva::Reduce:
+                reduceAlgoritmo(algoritmo, envio, recepcion, dataSize, MPI_DOUBLE, MPI_SUM, 0, comm);
+                break;
+            case OperacionColectiva::Allreduce:
+                allreduceAlgoritmo(algoritmo, envio, recepcion, dataSize, MPI_DOUBLE, MPI_SUM, comm);
+                break;
+        }
+    });
+}
+
+/**
+ * @brief Barrido de ajuste: mide cada algoritmo por tamaño de mensaje y número de procesos
+ * @param tamanos Tamaños del barrido (se mide uno de cada dos: pasos de 4x)
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Iteraciones configuradas (se escalan con iteracionesParaTamano)
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @param maxProcs Tope de procesos del barrido (0 = todos)
+ * @param numHilos Número de hilos por proceso (para las filas CSV)
+ * @param buffers Buffers compartidos entre fases
+ * @param resultados Registros de resultados (solo en el rank 0)
+ * @return Tabla con el algoritmo más rápido por tramo (válida en el rank 0)
+ *
+ * Los comunicadores de 2, 4, ..., P procesos son los de escalado.h: con un
+ * único lanzamiento se obtiene la tabla para todos los tamaños de trabajo
+ * menores.
+ */
+TablaDecision benchmarkAjuste(const std::vector<int64_t>& tamanos, int calentamiento, int numIterations, int rank,
+                              int numProcs, int maxProcs, int numHilos, PoolBuffers& buffers,
+                              std::vector<RegistroResultado>& resultados) {
+    std::vector<int> procesos;
+    std::vector<MPI_Comm> subcomunicadores;
+    for (int p : tamanosEscalado(numProcs, maxProcs)) {
+        if (p >= 2) {
+            procesos.push_back(p);
+            subcomunicadores.push_back(subcomunicadorEscalado(MPI_COMM_WORLD, p));
+        }
+    }
+    std::vector<int64_t> medidos;
+    for (size_t i = 0; i < tamanos.size(); i += 2) {
+        medidos.push_back(tamanos[i]);
+    }
+    
+    TablaDecision tabla;
+    for (OperacionColectiva operacion : OPERACIONES_COLECTIVAS) {
+        std::vector<AlgoritmoColectiva> algoritmos = algoritmosDe(operacion);
+        if (rank == 0) {
+            std::cout << "Ajustando " << nombreColectivaMpi(operacion) << " (mediana en μs)..." << std::endl;
+            std::cout << "  " << std::setw(5) << "P" << " | " << std::setw(10) << "Bytes";
+            for (AlgoritmoColectiva algoritmo : algoritmos) {
+                std::cout << " | " << std::setw(17) << nombreAlgoritmo(algoritmo);
+            }
+            std::cout << " | Más rápido" << std::endl;
+        }
+        
+        for (size_t indice = 0; indice < procesos.size(); ++indice) {
+            MPI_Comm sub = subcomunicadores[indice];
+            if (sub == MPI_COMM_NULL) {
+                continue;
+            }
+            std::vector<int64_t> bytesMedidos;
+            std::vector<AlgoritmoColectiva> mejores;
+            for (int64_t dataSize : medidos) {
+                int64_t bytes = dataSize * static_cast<int64_t>(sizeof(double));
+                int iteraciones = iteracionesParaTamano(numIterations, bytes);
+                int calentamientoPunto = std::min(calentamiento, iteraciones);
+                
+                std::vector<EstadisticasTiempo> tiempos;
+                for (AlgoritmoColectiva algoritmo : algoritmos) {
+                    tiempos.push_back(benchmarkAlgoritmo(operacion, algoritmo, dataSize, calentamientoPunto,
+                                                         iteraciones, sub, buffers));
+                }
+                if (rank != 0) {
+                    continue;
+                }
+                
+                size_t mejor = 0;
+                std::cout << "  " << std::setw(5) << procesos[indice] << " | " << std::setw(10)
+                          << formatearBytes(bytes);
+                for (size_t i = 0; i < tiempos.size(); ++i) {
+                    resultados.push_back(registroResultado(std::string("Algoritmo-") + nombreAlgoritmo(algoritmos[i]) +
+                                                           ":" + nombreColectivaMpi(operacion), dataSize,
+                                                           procesos[indice], numHilos, tiempos[i], bytes));
+                    std::cout << " | " << std::setw(17) << std::fixed << std::setprecision(2) << tiempos[i].mediana;
+                    if (tiempos[i].mediana < tiempos[mejor].mediana) {
+                        mejor = i;
+                    }
+                }
+                std::cout << " | " << nombreAlgoritmo(algoritmos[mejor]) << std::endl;
+                bytesMedidos.push_back(bytes);
+                mejores.push_back(algoritmos[mejor]);
+            }
+            if (rank == 0) {
+                tabla.agregarBarrido(operacion, procesos[indice], bytesMedidos, mejores);
+            }
+        }
+        if (rank == 0) {
+            std::cout << std::endl;
+        }
+    }
+    
+    for (MPI_Comm& sub : subcomunicadores) {
+        if (sub != MPI_COMM_NULL) {
+            MPI_Comm_free(&sub);
+        }
+    }
+    return tabla;
+}
+
+/**
+ * @brief Tiempos de una colectiva en las filas y columnas de la malla, aisladas y a la vez
+ */
+struct ComparacionContencion {
+    EstadisticasTiempo filas;       ///< Solo las colectivas de fila (todas las filas a la vez)
+    EstadisticasTiempo columnas;    ///< Solo las colectivas de columna
+    EstadisticasTiempo concurrente; ///< Las de fila y las de columna en vuelo a la vez
+    
+    /**
+     * @brief Tiempo que añade la competencia respecto a la más lenta de las
+     *        aisladas (0 = ninguna interferencia, 1 = se serializan por completo
+     *        si ambas duran lo mismo)
+     */
+    double interferencia() const {
+        double aislada = std::max(filas.mediana, columnas.mediana);
+        return aislada > 0.0 ? concurrente.mediana / aislada - 1.0 : 0.0;
+    }
+};
+
+/**
+ * @brief Mide una colectiva no bloqueante en los comunicadores de fila y de columna
+ * @param operacion Colectiva
+ * @param dataSize Número de doubles de cada colectiva
+ * @param calentamiento Iteraciones de calentamiento (no medidas)
+ * @param numIterations Número de iteraciones medidas
+ * @param rank Rank del proceso actual
+ * @param malla Malla con los comunicadores de fila y de columna
+ * @param buffers Buffers compartidos entre fases (ranuras de envío, recepción y de columna)
+ * @return Estadísticas aisladas y concurrentes (válidas en el rank 0)
+ *
+ * La raíz rota en cada iteración, de modo que la carga de ser raíz (recibir
+ * o enviar el mensaje completo) se reparte entre todos los procesos. Las
+ * colectivas no bloqueantes usan conteos int: con más de INT_MAX doubles no
+ * se mide nada y las estadísticas quedan vacías.
+ */
+ComparacionContencion benchmarkContencion(OperacionColectiva operacion, int64_t dataSize, int calentamiento,
+                                          int numIterations, int rank, MallaCartesiana& malla,
+                                          PoolBuffers& buffers) {
+    ComparacionContencion comparacion;
+    if (dataSize > INT_MAX) {
+        return comparacion;
+    }
+    double* envioFila = buffers.obtener(RANURA_ENVIO, dataSize);
+    double* recepcionFila = buffers.obtener(RANURA_RECEPCION, dataSize);
+    double* envioColumna = buffers.obtener(RANURA_COLUMNA_ENVIO, dataSize);
+    double* recepcionColumna = buffers.obtener(RANURA_COLUMNA_RECEPCION, dataSize);
+    GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+    generador.generar(static_cast<uint64_t>(rank) * dataSize, dataSize, envioFila);
+    generador.generar(static_cast<uint64_t>(rank) * dataSize, dataSize, envioColumna);
+    const int count = static_cast<int>(dataSize);
+    
+    auto enFila = [&](int iteracion, MPI_Request* peticion) {
+        iniciarColectiva(operacion, envioFila, recepcionFila, count, MPI_DOUBLE, MPI_SUM,
+                         raizRotatoria(iteracion, malla.fila()), malla.fila(), peticion);
+    };
+    auto enColumna = [&](int iteracion, MPI_Request* peticion) {
+        iniciarColectiva(operacion, envioColumna, recepcionColumna, count, MPI_DOUBLE, MPI_SUM,
+                         raizRotatoria(iteracion, malla.columna()), malla.columna(), peticion);
+    };
+    
+    comparacion.filas = medirColectiva(calentamiento, numIterations, malla.cartesiano(), [&](int iteracion) {
+        MPI_Request peticion;
+        enFila(iteracion, &peticion);
+        MPI_Wait(&peticion, MPI_STATUS_IGNORE);
+    });
+    comparacion.columnas = medirColectiva(calentamiento, numIterations, malla.cartesiano(), [&](int iteracion) {
+        MPI_Request peticion;
+        enColumna(iteracion, &peticion);
+        MPI_Wait(&peticion, MPI_STATUS_IGNORE);
+    });
+    comparacion.concurrente = medirColectiva(calentamiento, numIterations, malla.cartesiano(), [&](int iteracion) {
+        MPI_Request peticiones[2];
+        enFila(iteracion, &peticiones[0]);
+        enColumna(iteracion, &peticiones[1]);
+        MPI_Waitall(2, peticiones, MPI_STATUSES_IGNORE);
+    });
+    return comparacion;
+}
+
+int main(int argc, char** argv) {
+    bool soporteHilos = inicializarMPIFunneled(&argc, &argv);
+    
+    int rank, numProcs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+    
+    // La configuración se lee en la raíz y se distribuye con un único MPI_Bcast
+    Configuracion config = configuracionPorDefecto();
+    config.iteraciones = 100;
+    config.calentamiento = 10;
+    if (rank == 0) {
+        if (interpretarArgumentos(argc, argv, config, std::cerr) == EstadoConfiguracion::Ayuda) {
+            imprimirAyuda(std::cout, argv[0]);
+        }
+        if (config.estado == EstadoConfiguracion::Valida && !validarTotalValores(config, numProcs, std::cerr)) {
+            config.estado = EstadoConfiguracion::Error;
+        }
+    }
+    difundirConfiguracion(config, 0, MPI_COMM_WORLD);
+    if (config.estado != EstadoConfiguracion::Valida) {
+        MPI_Finalize();
+        return config.estado == EstadoConfiguracion::Ayuda ? 0 : 1;
+    }
+    
+    int numHilos = (config.numHilos > 1 && soporteHilos) ? config.numHilos : 1;
+    ModoSuma modoSuma = config.modoSuma;
+    EstrategiaColectiva estrategia = config.estrategia;
+    PoolHilos pool(numHilos);
+    
+    if (rank == 0) {
+        std::cout << "=== BENCHMARK DE COMUNICACIONES COLECTIVAS MPI ===" << std::endl;
+        std::cout << "Número de procesos: " << numProcs << std::endl;
+        std::cout << "Hilos por proceso: " << numHilos << std::endl;
+        std::cout << "Suma: " << nombreModoSuma(modoSuma) << " (ruta SIMD " << nombreRutaSimd() << ")" << std::endl;
+        std::cout << "Estrategia colectiva: " << nombreEstrategia(estrategia) << std::endl;
+        std::cout << "Iteraciones: " << config.iteraciones << " medidas + " << config.calentamiento
+                  << " de calentamiento (máximo entre procesos por iteración)" << std::endl;
+        std::cout << std::endl;
+    }
+    
+    std::vector<RegistroResultado> resultados;
+    
+    // Configuración del benchmark
+    std::vector<int64_t> dataSizes = {1, 10, 100, 1000, 10000};  // Comparación de estrategias
+    std::vector<int64_t> NValues = {100, 1000, 10000};
+    if (config.N > 0) {
+        NValues = {config.N};
+    }
+    int numIterations = config.iteraciones;
+    int calentamiento = config.calentamiento;
+    int segmentosSolapados = config.segmentos > 0 ? config.segmentos : 8;
+    std::vector<int64_t> tamanos = tamanosBarrido(config.tamanoMinimo, config.tamanoMaximo);
+    
+    // Los buffers se reservan una sola vez con el tamaño máximo de todas las
+    // fases y se tocan antes de medir: ninguna iteración paga fallos de página
+    // ni el registro de memoria de la red
+    int64_t maxElementos = 0;
+    for (const std::vector<int64_t>* lista : {&tamanos, &dataSizes, &NValues}) {
+        for (int64_t elementos : *lista) {
+            maxElementos = std::max(maxElementos, elementos);
+        }
+    }
+    PoolBuffers buffers(config.asignador, &pool);
+    buffers.reservar(RANURA_ENVIO, maxElementos);
+    buffers.reservar(RANURA_RECEPCION, maxElementos);
+    if (config.precision != PrecisionCarga::Doble) {
+        buffers.reservar(RANURA_REDUCIDA_ENVIO, doublesParaCarga(maxElementos, config.precision));
+        buffers.reservar(RANURA_REDUCIDA_RECEPCION, doublesParaCarga(maxElementos, config.precision));
+    }
+    if (rank == 0) {
+        std::cout << "Buffers: " << formatearBytes(buffers.bytesReservados()) << " por proceso ("
+                  << nombreAsignador(config.asignador) << ")" << std::endl << std::endl;
+    }
+    
+    // Tabla de decisión: --ajustar la mide y la escribe (por defecto en
+    // tabla_colectivas.txt); con solo --tabla se carga. En ambos casos el resto
+    // del benchmark despacha con ella y sus filas llevan el prefijo "Ajustado:"
+    std::string rutaTabla = config.tablaDecision[0] != '\0' ? config.tablaDecision : "tabla_colectivas.txt";
+    if (config.ajustar) {
+        TablaDecision medida = benchmarkAjuste(tamanos, calentamiento, numIterations, rank, numProcs,
+                                               config.maxProcs, numHilos, buffers, resultados);
+        if (rank == 0) {
+            std::ofstream archivo(rutaTabla);
+            medida.escribir(archivo);
+        }
+    }
+    if (config.ajustar || config.tablaDecision[0] != '\0') {
+        std::string error;
+        if (!cargarTablaDecision(rutaTabla, 0, MPI_COMM_WORLD, error)) {
+            if (rank == 0) {
+                std::cerr << "Error: tabla de decisión '" << rutaTabla << "': " << error << std::endl;
+            }
+            buffers.liberar();
+            MPI_Finalize();
+            return 1;
+        }
+        if (rank == 0) {
+            std::cout << "Tabla de decisión: " << rutaTabla << " (" << tablaDecisionActiva().entradas().size()
+                      << " entradas)" << std::endl << std::endl;
+        }
+    }
+    const std::string prefijoAjustado = tablaDecisionActiva().vacia() ? "" : "Ajustado:";
+    
+    // Barrido de tamaños en potencias de dos para MPI_Bcast y MPI_Reduce, con
+    // ancho de banda algorítmico y de bus calculados sobre la mediana
+    for (const char* operacion : {"MPI_Bcast", "MPI_Reduce"}) {
+        bool esBcast = std::string(operacion) == "MPI_Bcast";
+        if (rank == 0) {
+            std::cout << "Barrido de " << operacion << " (" << formatearBytes(config.tamanoMinimo) << " a "
+                      << formatearBytes(config.tamanoMaximo);
+            if (!esBcast && config.precision != PrecisionCarga::Doble) {
+                std::cout << ", carga " << nombrePrecision(config.precision);
+            }
+            std::cout << ")..." << std::endl;
+            std::cout << "  " << std::setw(10) << "Bytes" << " | " << std::setw(12) << "Mediana (μs)"
+                      << " | " << std::setw(12) << "p99 (μs)" << " | " << std::setw(10) << "GB/s"
+                      << " | " << std::setw(10) << "Bus GB/s" << std::endl;
+        }
+        
+        for (int64_t dataSize : tamanos) {
+            int64_t bytes = dataSize * static_cast<int64_t>(sizeof(double));
+            int iteraciones = iteracionesParaTamano(numIterations, bytes);
+            int calentamientoPunto = std::min(calentamiento, iteraciones);
+            EstadisticasTiempo tiempos = esBcast
+                ? benchmarkBroadcast(dataSize, calentamientoPunto, iteraciones, rank, numProcs, buffers)
+                : benchmarkReduce(dataSize, calentamientoPunto, iteraciones, rank, numProcs, config.precision,
+                                  buffers);
+            
+            if (rank == 0) {
+                std::string nombre = operacion;
+                if (!esBcast && config.precision != PrecisionCarga::Doble) {
+                    nombre = std::string(nombrePrecision(config.precision)) + ":" + nombre;
+                }
+                nombre = prefijoAjustado + nombre;
+                resultados.push_back(registroResultado(nombre, dataSize, numProcs, numHilos, tiempos, bytes));
+                
+                double algoritmico = anchoBanda(bytes, tiempos.mediana);
+                std::cout << "  " << std::setw(10) << formatearBytes(bytes) << " | " << std::fixed
+                          << std::setprecision(2) << std::setw(12) << tiempos.mediana << " | "
+                          << std::setw(12) << tiempos.p99 << " | " << std::setprecision(3)
+                          << std::setw(10) << algoritmico << " | " << std::setw(10)
+                          << algoritmico * factorBus(operacion, numProcs) << std::endl;
+            }
+        }
+        
+        if (rank == 0) {
+            std::cout << std::endl;
+        }
+    }
+    
+    // Precisión reducida en MPI_Reduce: tiempo ahorrado (incluidas las
+    // conversiones) y error frente a la reducción en doble precisión
+    if (rank == 0) {
+        std::cout << "Comparando la precisión de la carga de MPI_Reduce (mediana, conversión "
+                  << nombreRutaConversion() << ")..." << std::endl;
+        std::cout << "  " << std::setw(10) << "Bytes" << " | " << std::setw(9) << "Precisión" << " | "
+                  << std::setw(12) << "Mediana (μs)" << " | " << std::setw(7) << "Ahorro" << " | "
+                  << std::setw(13) << "Error máx." << " | " << "Error relativo" << std::endl;
+    }
+    
+    for (size_t i = 0; i < tamanos.size(); i += 4) {
+        int64_t dataSize = tamanos[i];
+        int64_t bytes = dataSize * static_cast<int64_t>(sizeof(double));
+        int iteraciones = iteracionesParaTamano(numIterations, bytes);
+        int calentamientoPunto = std::min(calentamiento, iteraciones);
+        
+        double medianaDoble = 0.0;
+        for (PrecisionCarga precision : PRECISIONES_CARGA) {
+            EstadisticasTiempo tiempos = benchmarkReduce(dataSize, calentamientoPunto, iteraciones, rank, numProcs,
+                                                         precision, buffers);
+            ErrorPrecision error = errorPrecision(dataSize, precision, rank, buffers);
+            if (rank == 0) {
+                if (precision == PrecisionCarga::Doble) {
+                    medianaDoble = tiempos.mediana;
+                }
+                resultados.push_back(registroResultado(std::string("Precision-") + nombrePrecision(precision) +
+                                                       ":MPI_Reduce", dataSize, numProcs, numHilos, tiempos, bytes));
+                
+                double ahorro = medianaDoble > 0.0 ? (1.0 - tiempos.mediana / medianaDoble) * 100.0 : 0.0;
+                std::cout << "  " << std::setw(10) << formatearBytes(bytes) << " | " << std::setw(9)
+                          << nombrePrecision(precision) << " | " << std::fixed << std::setprecision(2)
+                          << std::setw(12) << tiempos.mediana << " | " << std::setw(6) << ahorro << "%" << " | "
+                          << std::scientific << std::setprecision(3) << std::setw(13) << error.absoluto << " | "
+                          << error.relativo << std::defaultfloat << std::endl;
+            }
+        }
+    }
+    
+    if (rank == 0) {
+        std::cout << std::endl;
+    }
+    
+    // Tipos de elemento y operaciones: cada combinación es un Reductor<T, Op>
+    // distinto, así que el bucle interno no despacha nada en tiempo de ejecución
+    if (rank == 0) {
+        std::cout << "Comparando tipos de datos y operaciones (mediana, Reductor<T, Op>, núcleo local "
+                  << nombreRutaReductor() << ")..." << std::endl;
+        std::cout << "  " << std::setw(10) << "Elementos" << " | " << std::setw(6) << "Tipo" << " | "
+                  << std::setw(9) << "Operación" << " | " << std::setw(10) << "Local (μs)" << " | "
+                  << std::setw(12) << "Local (GB/s)" << " | " << "MPI_Reduce (μs)" << std::endl;
+    }
+    
+    for (size_t i = 0; i < tamanos.size(); i += 8) {
+        int64_t dataSize = tamanos[i];
+        for (TipoDato tipo : TIPOS_DATO) {
+            for (OperacionReduccion operacion : OPERACIONES_REDUCCION) {
+                int64_t bytes = dataSize * bytesTipoDato(tipo);
+                int iteraciones = iteracionesParaTamano(numIterations, bytes);
+                int calentamientoPunto = std::min(calentamiento, iteraciones);
+                
+                // Único despacho: elegir la instanciación; la medida es de código especializado
+                ResultadoReductor medida;
+                conTipoDato(tipo, [&](auto muestra) {
+                    conOperacion(operacion, [&](auto op) {
+                        medida = benchmarkReductor<decltype(muestra), decltype(op)>(
+                            dataSize, calentamientoPunto, iteraciones, rank, buffers);
+                    });
+                });
+                if (rank == 0) {
+                    std::string nombre = std::string("Reductor-") + nombreTipoDato(tipo) + "-" +
+                                         nombreOperacion(operacion);
+                    resultados.push_back(registroResultado(nombre + ":Local", dataSize, numProcs, numHilos,
+                                                           medida.local, bytes));
+                    resultados.push_back(registroResultado(nombre + ":MPI_Reduce", dataSize, numProcs, numHilos,
+                                                           medida.reduccion, bytes));
+                    std::cout << "  " << std::setw(10) << dataSize << " | " << std::setw(6) << nombreTipoDato(tipo)
+                              << " | " << std::setw(9) << nombreOperacion(operacion) << " | " << std::fixed
+                              << std::setprecision(2) << std::setw(10) << medida.local.mediana << " | "
+                              << std::setw(12) << anchoBanda(bytes, medida.local.mediana) << " | "
+                              << medida.reduccion.mediana << std::endl;
+                }
+            }
+        }
+    }
+    
+    if (rank == 0) {
+        std::cout << std::endl;
+    }
+    
+#if defined(MPI_AVANZADO_GPU)
+    // Buffers del host frente a buffers del dispositivo: copia al host, puntero
+    // del dispositivo a MPI (GPUDirect RDMA si la red lo admite) y NCCL, en uno
+    // de cada cuatro puntos del barrido
+    {
+        ContextoGpu gpu(MPI_COMM_WORLD, TransporteGpu::Auto);
+        int64_t maximoGpu = 0;
+        for (size_t i = 0; i < tamanos.size(); i += 4) {
+            maximoGpu = std::max(maximoGpu, tamanos[i]);
+        }
+        double* envioGpu = gpu.valido() ? gpu.reservar(maximoGpu) : nullptr;
+        double* recepcionGpu = gpu.valido() ? gpu.reservar(maximoGpu) : nullptr;
+        int reservados = (envioGpu != nullptr && recepcionGpu != nullptr) ? 1 : 0;
+        MPI_Allreduce(MPI_IN_PLACE, &reservados, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+        
+        if (!reservados) {
+            if (rank == 0) {
+                std::cout << "Sin GPU utilizable en todos los procesos: se omite la comparación host/dispositivo."
+                          << std::endl << std::endl;
+            }
+        } else {
+            std::vector<TransporteGpu> transportes = gpu.transportesDisponibles();
+            if (rank == 0) {
+                std::cout << "Comparando buffers del host y del dispositivo (mediana, " << gpu.nombreDispositivo()
+                          << ", MPI " << (mpiAdmiteGpu() ? "" : "no ") << "consciente de la GPU)..." << std::endl;
+                std::cout << "  " << std::setw(10) << "Bytes" << " | " << std::setw(10) << "Operación" << " | "
+                          << std::setw(10) << "Host (μs)";
+                for (TransporteGpu transporte : transportes) {
+                    std::cout << " | " << std::setw(12) << (std::string(nombreTransporteGpu(transporte)) + " (μs)");
+                }
+                std::cout << std::endl;
+            }
+            
+            for (size_t i = 0; i < tamanos.size(); i += 4) {
+                int64_t dataSize = tamanos[i];
+                int64_t bytes = dataSize * static_cast<int64_t>(sizeof(double));
+                int iteraciones = iteracionesParaTamano(numIterations, bytes);
+                int calentamientoPunto = std::min(calentamiento, iteraciones);
+                
+                EstadisticasTiempo hostBcast = benchmarkBroadcast(dataSize, calentamientoPunto, iteraciones, rank,
+                                                                  numProcs, buffers);
+                EstadisticasTiempo hostReduce = benchmarkReduce(dataSize, calentamientoPunto, iteraciones, rank,
+                                                                numProcs, PrecisionCarga::Doble, buffers);
+                std::vector<MedidaGpu> medidas;
+                for (TransporteGpu transporte : transportes) {
+                    medidas.push_back(benchmarkGpu(dataSize, calentamientoPunto, iteraciones, rank, gpu, transporte,
+                                                   envioGpu, recepcionGpu));
+                }
+                
+                if (rank == 0) {
+                    for (size_t j = 0; j < transportes.size(); ++j) {
+                        std::string nombre = std::string("Gpu-") + nombreTransporteGpu(transportes[j]);
+                        resultados.push_back(registroResultado(nombre + ":MPI_Bcast", dataSize, numProcs, numHilos,
+                                                               medidas[j].bcast, bytes));
+                        resultados.push_back(registroResultado(nombre + ":MPI_Reduce", dataSize, numProcs, numHilos,
+                                                               medidas[j].reduce, bytes));
+                    }
+                    std::cout << "  " << std::setw(10) << formatearBytes(bytes) << " | " << std::setw(10)
+                              << "MPI_Bcast" << " | " << std::fixed << std::setprecision(2) << std::setw(10)
+                              << hostBcast.mediana;
+                    for (const MedidaGpu& medida : medidas) {
+                        std::cout << " | " << std::setw(12) << medida.bcast.mediana;
+                    }
+                    std::cout << std::endl << "  " << std::setw(10) << "" << " | " << std::setw(10) << "MPI_Reduce"
+                              << " | " << std::setw(10) << hostReduce.mediana;
+                    for (const MedidaGpu& medida : medidas) {
+                        std::cout << " | " << std::setw(12) << medida.reduce.mediana;
+                    }
+                    std::cout << std::defaultfloat << std::endl;
+                }
+            }
+            
+            if (rank == 0) {
+                std::cout << std::endl;
+            }
+        }
+        gpu.liberar(envioGpu);
+        gpu.liberar(recepcionGpu);
+    }
+#endif
+    
+    // Comparación de las colectivas planas con las jerárquicas (dentro del
+    // nodo y después entre un líder por nodo), en uno de cada cuatro puntos
+    // del barrido
+    {
+        ComunicadorJerarquico jerarquico(MPI_COMM_WORLD, config.ranksPorNodo);
+        if (rank == 0) {
+            std::cout << "Comparando colectivas planas y jerárquicas (mediana, " << jerarquico.numNodos()
+                      << " nodos)..." << std::endl;
+            std::cout << "  " << std::setw(10) << "Bytes" << " | " << std::setw(13) << "Operación"
+                      << " | " << std::setw(12) << "Plana (μs)" << " | " << std::setw(15) << "Jerárquica (μs)"
+                      << " | Aceleración" << std::endl;
+        }
+        
+        for (size_t i = 0; i < tamanos.size(); i += 4) {
+            int64_t dataSize = tamanos[i];
+            int64_t bytes = dataSize * static_cast<int64_t>(sizeof(double));
+            int iteraciones = iteracionesParaTamano(numIterations, bytes);
+            int calentamientoPunto = std::min(calentamiento, iteraciones);
+            
+            for (const char* operacion : OPERACIONES_JERARQUICAS) {
+                ComparacionJerarquica comparacion = benchmarkJerarquico(operacion, dataSize, calentamientoPunto,
+                                                                        iteraciones, rank, jerarquico, buffers);
+                if (rank == 0) {
+                    resultados.push_back(registroResultado(std::string("Plano:") + operacion, dataSize, numProcs,
+                                                           numHilos, comparacion.plano, bytes));
+                    resultados.push_back(registroResultado(std::string("Jerarquico:") + operacion, dataSize, numProcs,
+                                                           numHilos, comparacion.jerarquico, bytes));
+                    
+                    std::cout << "  " << std::setw(10) << formatearBytes(bytes) << " | " << std::setw(13) << operacion
+                              << " | " << std::fixed << std::setprecision(2) << std::setw(12)
+                              << comparacion.plano.mediana << " | " << std::setw(15) << comparacion.jerarquico.mediana
+                              << " | " << comparacion.plano.mediana / comparacion.jerarquico.mediana << "x" << std::endl;
+                }
+            }
+        }
+        
+        // Broadcast sin copias dentro del nodo: solo el líder recibe, en una
+        // ventana de memoria compartida que el resto del nodo lee en su sitio
+        int64_t maximoCompartido = 0;
+        for (size_t i = 0; i < tamanos.size(); i += 4) {
+            maximoCompartido = std::max(maximoCompartido, tamanos[i]);
+        }
+        BufferNodoCompartido compartido(jerarquico, maximoCompartido * static_cast<int64_t>(sizeof(double)));
+        int ranksNodo = 1;
+        MPI_Comm_size(jerarquico.nodo(), &ranksNodo);
+        if (rank == 0) {
+            std::cout << std::endl << "Comparando MPI_Bcast con copia por proceso y ventana compartida del nodo "
+                      << "(mediana, " << ranksNodo << " procesos en el nodo 0)..." << std::endl;
+            std::cout << "  " << std::setw(10) << "Bytes" << " | " << std::setw(12) << "Copia (μs)" << " | "
+                      << std::setw(13) << "Ventana (μs)" << " | " << std::setw(11) << "Aceleración" << " | "
+                      << "Memoria del nodo" << std::endl;
+        }
+        
+        for (size_t i = 0; i < tamanos.size(); i += 4) {
+            int64_t dataSize = tamanos[i];
+            int64_t bytes = dataSize * static_cast<int64_t>(sizeof(double));
+            int iteraciones = iteracionesParaTamano(numIterations, bytes);
+            int calentamientoPunto = std::min(calentamiento, iteraciones);
+            
+            EstadisticasTiempo copia = benchmarkBroadcast(dataSize, calentamientoPunto, iteraciones, rank,
+                                                          numProcs, buffers);
+            EstadisticasTiempo ventana = benchmarkBroadcastCompartido(dataSize, calentamientoPunto, iteraciones,
+                                                                      rank, compartido);
+            if (rank == 0) {
+                resultados.push_back(registroResultado("Compartido:MPI_Bcast", dataSize, numProcs, numHilos,
+                                                       ventana, bytes));
+                
+                std::cout << "  " << std::setw(10) << formatearBytes(bytes) << " | " << std::fixed
+                          << std::setprecision(2) << std::setw(12) << copia.mediana << " | " << std::setw(13)
+                          << ventana.mediana << " | " << std::setw(10) << copia.mediana / ventana.mediana << "x"
+                          << " | " << formatearBytes(bytes * ranksNodo) << " -> " << formatearBytes(bytes)
+                          << std::endl;
+            }
+        }
+        
+        if (rank == 0) {
+            std::cout << std::endl;
+        }
+    }
+    
+    // Colectivas concurrentes en las filas y columnas de una malla 2D con
+    // raíz rotatoria: cuánto se estorban frente a ejecutarlas por separado
+    {
+        MallaCartesiana malla(MPI_COMM_WORLD);
+        int64_t maximoContencion = 0;
+        for (size_t i = 0; i < tamanos.size(); i += 4) {
+            if (tamanos[i] <= INT_MAX) {
+                maximoContencion = std::max(maximoContencion, tamanos[i]);
+            }
+        }
+        buffers.reservar(RANURA_COLUMNA_ENVIO, maximoContencion);
+        buffers.reservar(RANURA_COLUMNA_RECEPCION, maximoContencion);
+        const int colectivasSimultaneas = malla.numFilas() + malla.numColumnas();
+        if (rank == 0) {
+            std::cout << "Comparando colectivas de fila y columna aisladas y concurrentes (mediana, malla "
+                      << malla.numFilas() << "x" << malla.numColumnas() << ", raíz rotatoria)..." << std::endl;
+            std::cout << "  " << std::setw(10) << "Bytes" << " | " << std::setw(13) << "Operación" << " | "
+                      << std::setw(11) << "Filas (μs)" << " | " << std::setw(14) << "Columnas (μs)" << " | "
+                      << std::setw(17) << "Concurrente (μs)" << " | " << std::setw(13) << "Interferencia"
+                      << " | GB/s agregados (aislado -> concurrente)" << std::endl;
+        }
+        
+        for (size_t i = 0; i < tamanos.size(); i += 4) {
+            int64_t dataSize = tamanos[i];
+            int64_t bytes = dataSize * static_cast<int64_t>(sizeof(double));
+            int iteraciones = iteracionesParaTamano(numIterations, bytes);
+            int calentamientoPunto = std::min(calentamiento, iteraciones);
+            
+            // MPI_Ibcast, MPI_Ireduce... solo admiten conteos int
+            if (dataSize > INT_MAX) {
+                if (rank == 0) {
+                    std::cout << "  " << std::setw(10) << formatearBytes(bytes) << " | se omite: más de INT_MAX "
+                              << "elementos para las colectivas no bloqueantes" << std::endl;
+                }
+                continue;
+            }
+            
+            for (OperacionColectiva operacion : OPERACIONES_COLECTIVAS) {
+                ComparacionContencion comparacion = benchmarkContencion(operacion, dataSize, calentamientoPunto,
+                                                                        iteraciones, rank, malla, buffers);
+                if (rank == 0) {
+                    std::string nombre = nombreColectivaMpi(operacion);
+                    resultados.push_back(registroResultado("Filas:" + nombre, dataSize, numProcs, numHilos,
+                                                           comparacion.filas, bytes));
+                    resultados.push_back(registroResultado("Columnas:" + nombre, dataSize, numProcs, numHilos,
+                                                           comparacion.columnas, bytes));
+                    resultados.push_back(registroResultado("Concurrente:" + nombre, dataSize, numProcs, numHilos,
+                                                           comparacion.concurrente, bytes));
+                    
+                    // Bytes de todas las colectivas de fila y columna: en serie frente a la vez
+                    int64_t bytesTotales = bytes * colectivasSimultaneas;
+                    double aislado = anchoBanda(bytesTotales, comparacion.filas.mediana +
+                                                              comparacion.columnas.mediana);
+                    double concurrente = anchoBanda(bytesTotales, comparacion.concurrente.mediana);
+                    std::cout << "  " << std::setw(10) << formatearBytes(bytes) << " | " << std::setw(13) << nombre
+                              << " | " << std::fixed << std::setprecision(2) << std::setw(11)
+                              << comparacion.filas.mediana << " | " << std::setw(14) << comparacion.columnas.mediana
+                              << " | " << std::setw(17) << comparacion.concurrente.mediana << " | "
+                              << std::setw(12) << comparacion.interferencia() * 100.0 << "%" << " | "
+                              << std::setprecision(3) << aislado << " -> " << concurrente << std::endl;
+                }
+            }
+        }
+        
+        if (rank == 0) {
+            std::cout << std::endl;
+        }
+    }
+    
+    // Comparación de estrategias colectivas para vectores
+    if (rank == 0) {
+        std::cout << "Comparando estrategias colectivas (mediana, resultado en todos los procesos)..." << std::endl;
+        std::cout << "  " << std::setw(10) << "Elementos";
+        for (EstrategiaColectiva candidata : ESTRATEGIAS_COLECTIVAS) {
+            std::cout << " | " << std::setw(24) << nombreEstrategia(candidata);
+        }
+        std::cout << " | Más rápida" << std::endl;
+    }
+    
+    for (int64_t dataSize : dataSizes) {
+        std::vector<EstadisticasTiempo> tiempos;
+        for (EstrategiaColectiva candidata : ESTRATEGIAS_COLECTIVAS) {
+            tiempos.push_back(benchmarkEstrategia(dataSize, calentamiento, numIterations, candidata, rank, buffers));
+        }
+        
+        if (rank == 0) {
+            size_t mejor = 0;
+            std::cout << "  " << std::setw(10) << dataSize;
+            for (size_t i = 0; i < tiempos.size(); ++i) {
+                resultados.push_back(registroResultado(std::string("Estrategia:") + nombreEstrategia(ESTRATEGIAS_COLECTIVAS[i]),
+                                                       dataSize, numProcs, numHilos, tiempos[i],
+                                                       dataSize * static_cast<int64_t>(sizeof(double))));
+                std::cout << " | " << std::setw(21) << std::fixed << std::setprecision(2) << tiempos[i].mediana << " μs";
+                if (tiempos[i].mediana < tiempos[mejor].mediana) {
+                    mejor = i;
+                }
+            }
+            std::cout << " | " << nombreEstrategia(ESTRATEGIAS_COLECTIVAS[mejor]) << std::endl;
+        }
+    }
+    
+    // Coste de preparación que ahorran las colectivas persistentes
+    if (rank == 0) {
+        std::cout << std::endl << "Comparando colectivas bloqueantes y persistentes (mediana, "
+                  << (colectivasPersistentesDisponibles() ? "MPI_*_init" : "sin soporte: no bloqueantes")
+                  << ")..." << std::endl;
+        std::cout << "  " << std::setw(10) << "Elementos" << " | " << std::setw(13) << "Operación" << " | "
+                  << std::setw(15) << "Bloqueante (μs)" << " | " << std::setw(17) << "Init+Start (μs)" << " | "
+                  << std::setw(16) << "Persistente (μs)" << " | Preparación (μs)" << std::endl;
+    }
+    
+    for (int64_t dataSize : dataSizes) {
+        for (const char* operacion : {"MPI_Bcast", "MPI_Allreduce"}) {
+            ComparacionPersistente comparacion = benchmarkPersistente(operacion, dataSize, calentamiento,
+                                                                      numIterations, rank, buffers);
+            if (rank == 0) {
+                int64_t bytes = dataSize * static_cast<int64_t>(sizeof(double));
+                resultados.push_back(registroResultado(std::string("Bloqueante:") + operacion, dataSize, numProcs,
+                                                       numHilos, comparacion.bloqueante, bytes));
+                resultados.push_back(registroResultado(std::string("PersistenteConPreparacion:") + operacion, dataSize,
+                                                       numProcs, numHilos, comparacion.conPreparacion, bytes));
+                resultados.push_back(registroResultado(std::string("Persistente:") + operacion, dataSize, numProcs,
+                                                       numHilos, comparacion.persistente, bytes));
+                
+                std::cout << "  " << std::setw(10) << dataSize << " | " << std::setw(13) << operacion << " | "
+                          << std::fixed << std::setprecision(2) << std::setw(15) << comparacion.bloqueante.mediana
+                          << " | " << std::setw(17) << comparacion.conPreparacion.mediana << " | " << std::setw(16)
+                          << comparacion.persistente.mediana << " | " << comparacion.costePreparacion() << std::endl;
+            }
+        }
+    }
+    
+    // Benchmark del programa completo
+    if (rank == 0) {
+        std::cout << std::endl << "Ejecutando benchmark del programa completo"
+                  << (config.persistente ? " (colectivas persistentes)" : "") << "..." << std::endl;
+    }
+    
+    for (int64_t N : NValues) {
+        EstadisticasTiempo tiempos = benchmarkCompleto(N, calentamiento, numIterations, rank, numProcs,
+                                                       pool, modoSuma, estrategia, config.persistente != 0,
+                                                       buffers);
+        
+        if (rank == 0) {
+            resultados.push_back(registroResultado("ProgramaCompleto", N, numProcs, numHilos, tiempos));
+            
+            std::cout << "  Programa completo con N=" << N << ": ";
+            imprimirEstadisticas(tiempos);
+        }
+    }
+    
+    // Benchmark de solapamiento cómputo/comunicación
+    if (rank == 0) {
+        std::cout << std::endl << "Ejecutando benchmark de solapamiento (" << segmentosSolapados
+                  << " segmentos con MPI_Ireduce)..." << std::endl;
+    }
+    
+    for (int64_t N : NValues) {
+        ResultadoSolapamiento solapamiento = benchmarkSolapamiento(N, calentamiento, numIterations, segmentosSolapados,
+                                                                   rank, numProcs, pool, modoSuma, buffers);
+        
+        if (rank == 0) {
+            resultados.push_back(registroResultado("ProgramaBloqueante", N, numProcs, numHilos, solapamiento.tiempoBloqueante));
+            resultados.push_back(registroResultado("ProgramaSolapado", N, numProcs, numHilos, solapamiento.tiempoSolapado));
+            
+            std::cout << "  N=" << N << ": bloqueante " << std::fixed << std::setprecision(2)
+                      << solapamiento.tiempoBloqueante.media << " μs (comunicación "
+                      << solapamiento.comunicacionBloqueante << " μs) | solapado "
+                      << solapamiento.tiempoSolapado.media << " μs (espera "
+                      << solapamiento.esperaSolapada << " μs) | latencia ocultada: "
+                      << std::setprecision(1) << solapamiento.latenciaOcultada() << "% | ahorro neto: "
+                      << std::setprecision(2) << solapamiento.ahorroNeto() << " μs" << std::endl;
+        }
+    }
+    
+    // Guardar resultados
+    std::string filename = "benchmark_results_" + std::to_string(numProcs) + "procs.csv";
+    std::string jsonFilename = "benchmark_results_" + std::to_string(numProcs) + "procs.jsonl";
+    MetadatosEjecucion metadatos = recogerMetadatos("mpi_benchmark", numProcs, numHilos, numIterations,
+                                                    calentamiento);
+    guardarResultados(filename, jsonFilename, metadatos, resultados);
+    
+    if (rank == 0) {
+        std::cout << std::endl << "=== BENCHMARK COMPLETADO ===" << std::endl;
+        std::cout << "Los resultados han sido guardados en: " << filename << std::endl;
+    }
+    
+    // Los buffers de MPI_Alloc_mem deben liberarse antes de MPI_Finalize
+    buffers.liberar();
+    MPI_Finalize();
+    return 0;
 } 
\ No newline at end of file
@@ -0,0 +1,173 @@
+/**
+ * @file colectivas.cpp
+ * @brief Implementación de las operaciones colectivas compartidas
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "colectivas.h"
+#include "ajuste.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Tamaño en bytes de un elemento del tipo dado (incluyendo su extensión)
+ */
+MPI_Aint extensionTipo(MPI_Datatype datatype) {
+    MPI_Aint lowerBound = 0;
+    MPI_Aint extent = 0;
+    MPI_Type_get_extent(datatype, &lowerBound, &extent);
+    return extent;
+}
+
+} // namespace
+
+int bcastGrande(void* buffer, int64_t count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+#if MPI_VERSION >= 4
+    return MPI_Bcast_c(buffer, static_cast<MPI_Count>(count), datatype, root, comm);
+#else
+    // Fragmentar en bloques de como máximo INT_MAX elementos
+    const MPI_Aint extent = extensionTipo(datatype);
+    char* bytes = static_cast<char*>(buffer);
+    
+    for (int64_t offset = 0; offset < count; offset += INT_MAX) {
+        int fragmento = static_cast<int>(std::min<int64_t>(INT_MAX, count - offset));
+        int error = MPI_Bcast(bytes + offset * extent, fragmento, datatype, root, comm);
+        if (error != MPI_SUCCESS) {
+            return error;
+        }
+    }
+    return MPI_SUCCESS;
+#endif
+}
+
+int reduceGrande(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                 MPI_Op op, int root, MPI_Comm comm) {
+#if MPI_VERSION >= 4
+    return MPI_Reduce_c(sendbuf, recvbuf, static_cast<MPI_Count>(count), datatype, op, root, comm);
+#else
+    // Fragmentar en bloques de como máximo INT_MAX elementos; las operaciones
+    // predefinidas son elemento a elemento, por lo que el resultado es idéntico
+    const MPI_Aint extent = extensionTipo(datatype);
+    const char* envio = static_cast<const char*>(sendbuf);
+    char* recepcion = static_cast<char*>(recvbuf);
+    bool enSitio = (sendbuf == MPI_IN_PLACE);
+    
+    for (int64_t offset = 0; offset < count; offset += INT_MAX) {
+        int fragmento = static_cast<int>(std::min<int64_t>(INT_MAX, count - offset));
+        const void* origen = enSitio ? MPI_IN_PLACE : envio + offset * extent;
+        void* destino = (recepcion != nullptr) ? recepcion + offset * extent : nullptr;
+        int error = MPI_Reduce(origen, destino, fragmento, datatype, op, root, comm);
+        if (error != MPI_SUCCESS) {
+            return error;
+        }
+    }
+    return MPI_SUCCESS;
+#endif
+}
+
+int allreduceGrande(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                    MPI_Op op, MPI_Comm comm) {
+#if MPI_VERSION >= 4
+    return MPI_Allreduce_c(sendbuf, recvbuf, static_cast<MPI_Count>(count), datatype, op, comm);
+#else
+    const MPI_Aint extent = extensionTipo(datatype);
+    const char* envio = static_cast<const char*>(sendbuf);
+    char* recepcion = static_cast<char*>(recvbuf);
+    bool enSitio = (sendbuf == MPI_IN_PLACE);
+    
+    for (int64_t offset = 0; offset < count; offset += INT_MAX) {
+        int fragmento = static_cast<int>(std::min<int64_t>(INT_MAX, count - offset));
+        const void* origen = enSitio ? MPI_IN_PLACE : envio + offset * extent;
+        int error = MPI_Allreduce(origen, recepcion + offset * extent, fragmento, datatype, op, comm);
+        if (error != MPI_SUCCESS) {
+            return error;
+        }
+    }
+    return MPI_SUCCESS;
+#endif
+}
+
+EstrategiaColectiva estrategiaEfectiva(EstrategiaColectiva estrategia, int64_t count) {
+    // Reduce-scatter y allgatherv usan conteos y desplazamientos int: el
+    // último desplazamiento solo cabe si el vector completo cabe
+    if (estrategia == EstrategiaColectiva::ReduceScatterAllgather && count > INT_MAX) {
+        return EstrategiaColectiva::Allreduce;
+    }
+    return estrategia;
+}
+
+int reducirEnTodos(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                   MPI_Op op, MPI_Comm comm, EstrategiaColectiva estrategia) {
+    int numProcs = 1;
+    MPI_Comm_size(comm, &numProcs);
+    
+    switch (estrategiaEfectiva(estrategia, count)) {
+        case EstrategiaColectiva::ReduceBcast: {
+            int error = reduceAjustado(sendbuf, recvbuf, count, datatype, op, 0, comm);
+            if (error != MPI_SUCCESS) {
+                return error;
+            }
+            return bcastAjustado(recvbuf, count, datatype, 0, comm);
+        }
+        case EstrategiaColectiva::Allreduce:
+            return allreduceAjustado(sendbuf, recvbuf, count, datatype, op, comm);
+        case EstrategiaColectiva::ReduceScatterAllgather: {
+            int rank = 0;
+            MPI_Comm_rank(comm, &rank);
+            
+            // Un bloque contiguo por proceso; los restos van a los primeros procesos
+            std::vector<int> conteos(numProcs);
+            std::vector<int> desplazamientos(numProcs);
+            int64_t base = count / numProcs;
+            int64_t resto = count % numProcs;
+            int64_t offset = 0;
+            for (int p = 0; p < numProcs; ++p) {
+                conteos[p] = static_cast<int>(base + (p < resto ? 1 : 0));
+                desplazamientos[p] = static_cast<int>(offset);
+                offset += conteos[p];
+            }
+            
+            const MPI_Aint extent = extensionTipo(datatype);
+            char* bloquePropio = static_cast<char*>(recvbuf) + desplazamientos[rank] * extent;
+            int error = MPI_Reduce_scatter(sendbuf, bloquePropio, conteos.data(), datatype, op, comm);
+            if (error != MPI_SUCCESS) {
+                return error;
+            }
+            return MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, recvbuf, conteos.data(),
+                                  desplazamientos.data(), datatype, comm);
+        }
+    }
+    return MPI_ERR_ARG;
+}
+
+EstrategiaColectiva leerEstrategia() {
+    const char* valor = std::getenv(VARIABLE_ESTRATEGIA);
+    if (valor != nullptr) {
+        if (std::strcmp(valor, "allreduce") == 0) {
+            return EstrategiaColectiva::Allreduce;
+        }
+        if (std::strcmp(valor, "reduce-scatter-allgather") == 0) {
+            return EstrategiaColectiva::ReduceScatterAllgather;
+        }
+    }
+    return EstrategiaColectiva::ReduceBcast;
+}
+
+const char* nombreEstrategia(EstrategiaColectiva estrategia) {
+    switch (estrategia) {
+        case EstrategiaColectiva::ReduceBcast:
+            return "reduce-bcast";
+        case EstrategiaColectiva::Allreduce:
+            return "allreduce";
+        case EstrategiaColectiva::ReduceScatterAllgather:
+            return "reduce-scatter-allgather";
+    }
+    return "desconocida";
+}
@@ -0,0 +1,126 @@
+/**
+ * @file colectivas.h
+ * @brief Operaciones colectivas compartidas por los programas del proyecto
+ * @author Emil M
+ * @date 2025
+ * 
+ * Envoltorios de las operaciones colectivas que aceptan conteos de 64 bits.
+ * Con MPI-4 se usan las variantes de conteo grande (`MPI_Bcast_c`,
+ * `MPI_Reduce_c`, `MPI_Allreduce_c`); en bibliotecas anteriores la operación
+ * se divide en fragmentos de como máximo INT_MAX elementos.
+ * 
+ * También define las estrategias seleccionables para obtener en todos los
+ * procesos el resultado de una reducción.
+ */
+
+#ifndef MPI_AVANZADO_COLECTIVAS_H
+#define MPI_AVANZADO_COLECTIVAS_H
+
+#include <mpi.h>
+#include <cstdint>
+
+/**
+ * @brief MPI_Bcast con un número de elementos de 64 bits
+ * @param buffer Buffer a distribuir (entrada en la raíz, salida en el resto)
+ * @param count Número de elementos
+ * @param datatype Tipo de dato de cada elemento
+ * @param root Rank del proceso raíz
+ * @param comm Comunicador
+ * @return Código de error MPI
+ */
+int bcastGrande(void* buffer, int64_t count, MPI_Datatype datatype, int root, MPI_Comm comm);
+
+/**
+ * @brief MPI_Reduce con un número de elementos de 64 bits
+ * @param sendbuf Buffer con los datos locales
+ * @param recvbuf Buffer de resultado (solo significativo en la raíz)
+ * @param count Número de elementos
+ * @param datatype Tipo de dato de cada elemento
+ * @param op Operación de reducción
+ * @param root Rank del proceso raíz
+ * @param comm Comunicador
+ * @return Código de error MPI
+ */
+int reduceGrande(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                 MPI_Op op, int root, MPI_Comm comm);
+
+/**
+ * @brief MPI_Allreduce con un número de elementos de 64 bits
+ * @param sendbuf Buffer con los datos locales (o MPI_IN_PLACE)
+ * @param recvbuf Buffer de resultado en todos los procesos
+ * @param count Número de elementos
+ * @param datatype Tipo de dato de cada elemento
+ * @param op Operación de reducción
+ * @param comm Comunicador
+ * @return Código de error MPI
+ */
+int allreduceGrande(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                    MPI_Op op, MPI_Comm comm);
+
+/**
+ * @brief Variable de entorno con la estrategia colectiva
+ *
+ * Valores aceptados: `reduce-bcast` (por defecto), `allreduce` y
+ * `reduce-scatter-allgather`.
+ */
+const char* const VARIABLE_ESTRATEGIA = "MPI_AVANZADO_COLECTIVA";
+
+/**
+ * @brief Estrategia para que todos los procesos obtengan una reducción
+ */
+enum class EstrategiaColectiva {
+    ReduceBcast,            ///< MPI_Reduce a la raíz seguido de MPI_Bcast (dos latencias)
+    Allreduce,              ///< Un único MPI_Allreduce
+    ReduceScatterAllgather  ///< MPI_Reduce_scatter + MPI_Allgatherv (vectores grandes)
+};
+
+/**
+ * @brief Todas las estrategias, en el orden en que se comparan en los benchmarks
+ */
+const EstrategiaColectiva ESTRATEGIAS_COLECTIVAS[] = {
+    EstrategiaColectiva::ReduceBcast,
+    EstrategiaColectiva::Allreduce,
+    EstrategiaColectiva::ReduceScatterAllgather
+};
+
+/**
+ * @brief Reduce un vector y deja el resultado en todos los procesos
+ * @param sendbuf Buffer con los datos locales
+ * @param recvbuf Buffer de resultado en todos los procesos (distinto de sendbuf)
+ * @param count Número de elementos
+ * @param datatype Tipo de dato de cada elemento
+ * @param op Operación de reducción (conmutativa para reduce-scatter)
+ * @param comm Comunicador
+ * @param estrategia Estrategia colectiva a usar
+ * @return Código de error MPI
+ *
+ * Reduce-scatter + allgather reparte el vector en un bloque por proceso, por
+ * lo que cada proceso solo reduce count / P elementos; es la variante que
+ * escala mejor con el tamaño del mensaje. Con una tabla de decisión cargada
+ * (ajuste.h), el reduce, el bcast y el allreduce usan el algoritmo que la
+ * tabla indica para el tamaño y el número de procesos. Los vectores de más
+ * de INT_MAX elementos usan allreduce en lugar de reduce-scatter + allgather
+ * (ver estrategiaEfectiva).
+ */
+int reducirEnTodos(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                   MPI_Op op, MPI_Comm comm, EstrategiaColectiva estrategia);
+
+/**
+ * @brief Estrategia que usa reducirEnTodos para un vector de count elementos
+ * @return La indicada, salvo reduce-scatter + allgather con más de INT_MAX
+ *         elementos, que pasa a allreduce (sus desplazamientos son int)
+ */
+EstrategiaColectiva estrategiaEfectiva(EstrategiaColectiva estrategia, int64_t count);
+
+/**
+ * @brief Lee la estrategia colectiva de la variable de entorno
+ * @return Estrategia (reduce-bcast si no está definida o no es válida)
+ */
+EstrategiaColectiva leerEstrategia();
+
+/**
+ * @brief Nombre legible de la estrategia colectiva
+ */
+const char* nombreEstrategia(EstrategiaColectiva estrategia);
+
+#endif // MPI_AVANZADO_COLECTIVAS_H
@@ -0,0 +1,143 @@
+/**
+ * @file comparar.cpp
+ * @brief Compara dos ejecuciones de mpi_benchmark y señala las regresiones
+ * @author Emil M
+ * @date 2025
+ *
+ * Uso: mpi_comparar BASE.jsonl NUEVO.jsonl [--umbral PORCENTAJE] [--alfa A] [--todas]
+ *
+ * Lee los archivos JSON lines de guardarResultados, empareja las filas por
+ * operación, tamaño, procesos e hilos y marca como regresión las que son más
+ * lentas en más de --umbral por ciento (5 por defecto) con una prueba t de
+ * Welch significativa al nivel --alfa (0.01 por defecto). Termina con código
+ * 1 si hay alguna regresión y 2 si los archivos no se pueden leer, para usarlo
+ * como puerta en un pipeline (por ejemplo, al actualizar la biblioteca MPI).
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "resultados.h"
+
+/**
+ * @brief Lee un archivo de resultados
+ * @return true si se pudo leer; si no, informa en std::cerr
+ */
+bool cargarResultados(const std::string& ruta, MetadatosEjecucion& metadatos,
+                      std::vector<RegistroResultado>& registros) {
+    std::ifstream archivo(ruta);
+    if (!archivo.is_open()) {
+        std::cerr << "Error: no se puede abrir " << ruta << std::endl;
+        return false;
+    }
+    std::string error;
+    if (!leerJsonLineas(archivo, metadatos, registros, error)) {
+        std::cerr << "Error en " << ruta << ": " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Imprime un campo de metadatos de ambas ejecuciones, marcando si difiere
+ */
+void imprimirMetadato(const char* nombre, const std::string& base, const std::string& nuevo) {
+    std::cout << "  " << std::left << std::setw(16) << nombre << std::right << base;
+    if (nuevo != base) {
+        std::cout << "  ->  " << nuevo << "  (distinto)";
+    }
+    std::cout << std::endl;
+}
+
+void imprimirUso(const char* programa) {
+    std::cout << "Uso: " << programa << " BASE.jsonl NUEVO.jsonl [opciones]" << std::endl
+              << std::endl
+              << "  --umbral P   Cambio mínimo del tiempo medio, en porcentaje (por defecto 5)" << std::endl
+              << "  --alfa A     Nivel de significación de la prueba t de Welch (por defecto 0.01)" << std::endl
+              << "  --todas      Lista también las filas sin cambio" << std::endl
+              << std::endl
+              << "Código de salida: 0 sin regresiones, 1 con regresiones, 2 si hay un error." << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> rutas;
+    double umbral = 5.0;
+    double alfa = 0.01;
+    bool todas = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string argumento = argv[i];
+        if (argumento == "--help" || argumento == "-h") {
+            imprimirUso(argv[0]);
+            return 0;
+        }
+        if (argumento == "--todas") {
+            todas = true;
+        } else if ((argumento == "--umbral" || argumento == "--alfa") && i + 1 < argc) {
+            char* fin = nullptr;
+            double valor = std::strtod(argv[++i], &fin);
+            if (*fin != '\0' || valor < 0.0 || (argumento == "--alfa" && (valor <= 0.0 || valor >= 1.0))) {
+                std::cerr << "Error: valor no válido para " << argumento << ": '" << argv[i] << "'." << std::endl;
+                return 2;
+            }
+            (argumento == "--umbral" ? umbral : alfa) = valor;
+        } else if (argumento.rfind("--", 0) == 0) {
+            std::cerr << "Error: opción desconocida o sin valor: " << argumento << std::endl;
+            return 2;
+        } else {
+            rutas.push_back(argumento);
+        }
+    }
+    if (rutas.size() != 2) {
+        imprimirUso(argv[0]);
+        return 2;
+    }
+    
+    MetadatosEjecucion metaBase;
+    MetadatosEjecucion metaNuevo;
+    std::vector<RegistroResultado> base;
+    std::vector<RegistroResultado> nuevo;
+    if (!cargarResultados(rutas[0], metaBase, base) || !cargarResultados(rutas[1], metaNuevo, nuevo)) {
+        return 2;
+    }
+    
+    std::cout << "=== COMPARACIÓN DE RESULTADOS ===" << std::endl;
+    imprimirMetadato("Fecha", metaBase.fecha, metaNuevo.fecha);
+    imprimirMetadato("Host", metaBase.host, metaNuevo.host);
+    imprimirMetadato("Biblioteca MPI", metaBase.bibliotecaMpi, metaNuevo.bibliotecaMpi);
+    imprimirMetadato("Commit", metaBase.git, metaNuevo.git);
+    imprimirMetadato("Compilador", metaBase.compilador, metaNuevo.compilador);
+    imprimirMetadato("Opciones", metaBase.opciones, metaNuevo.opciones);
+    imprimirMetadato("Ruta SIMD", metaBase.rutaSimd, metaNuevo.rutaSimd);
+    std::cout << std::endl;
+    
+    std::vector<ComparacionResultado> comparaciones = compararResultados(base, nuevo, umbral / 100.0, alfa);
+    int regresiones = 0;
+    int mejoras = 0;
+    std::cout << std::left << std::setw(44) << "Operación" << std::right << std::setw(10) << "Tamaño"
+              << std::setw(6) << "P" << std::setw(14) << "Base (μs)" << std::setw(15) << "Nuevo (μs)"
+              << std::setw(10) << "Cambio" << std::setw(11) << "Valor p" << "  Veredicto" << std::endl;
+    for (const ComparacionResultado& comparacion : comparaciones) {
+        regresiones += comparacion.veredicto == Veredicto::Regresion;
+        mejoras += comparacion.veredicto == Veredicto::Mejora;
+        if (!todas && comparacion.veredicto == Veredicto::SinCambio) {
+            continue;
+        }
+        std::cout << std::left << std::setw(44) << comparacion.base.operacion << std::right
+                  << std::setw(10) << comparacion.base.tamano << std::setw(6) << comparacion.base.procesos
+                  << std::fixed << std::setprecision(2) << std::setw(13) << comparacion.base.estadisticas.media
+                  << std::setw(14) << comparacion.nuevo.estadisticas.media
+                  << std::setw(9) << std::showpos << comparacion.cambio * 100.0 << "%" << std::noshowpos
+                  << std::setw(11) << std::setprecision(4) << comparacion.valorP
+                  << "  " << nombreVeredicto(comparacion.veredicto) << std::endl;
+    }
+    
+    std::cout << std::endl << comparaciones.size() << " filas comparadas (" << base.size() << " en la base, "
+              << nuevo.size() << " en la nueva): " << regresiones << " regresiones, " << mejoras
+              << " mejoras (umbral " << std::setprecision(1) << umbral << " %, alfa " << std::setprecision(3)
+              << alfa << ")" << std::endl;
+    return regresiones > 0 ? 1 : 0;
+}
@@ -0,0 +1,492 @@
+/**
+ * @file configuracion.cpp
+ * @brief Implementación de la lectura y distribución de la configuración
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "configuracion.h"
+
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "hilos.h"
+#include "solapamiento.h"
+
+namespace {
+
+/// Mayor tamaño de barrido admitido: el barrido dobla el tamaño hasta superarlo
+constexpr int64_t TAMANO_BARRIDO_MAXIMO = int64_t(1) << 62;
+
+/**
+ * @brief Convierte un texto completo en entero de 64 bits
+ * @return true si todo el texto es un número válido que cabe en 64 bits
+ */
+bool leerEntero(const std::string& texto, int64_t& valor) {
+    if (texto.empty()) {
+        return false;
+    }
+    char* fin = nullptr;
+    errno = 0;
+    long long leido = std::strtoll(texto.c_str(), &fin, 10);
+    if (*fin != '\0' || errno == ERANGE) {
+        return false;
+    }
+    valor = static_cast<int64_t>(leido);
+    return true;
+}
+
+/**
+ * @brief Lee un entero de 64 bits no menor que `minimo`
+ */
+bool leerEnteroDesde(const std::string& clave, const std::string& texto, int64_t minimo,
+                     int64_t& valor, std::ostream& errores) {
+    if (!leerEntero(texto, valor) || valor < minimo) {
+        errores << "Error: el valor de --" << clave << " debe ser un entero >= " << minimo
+                << " (se recibió '" << texto << "')." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Lee un entero de 32 bits no menor que `minimo`
+ */
+bool leerEntero32Desde(const std::string& clave, const std::string& texto, int64_t minimo,
+                       int32_t& valor, std::ostream& errores) {
+    int64_t leido = 0;
+    if (!leerEnteroDesde(clave, texto, minimo, leido, errores)) {
+        return false;
+    }
+    if (leido > INT32_MAX) {
+        errores << "Error: el valor de --" << clave << " es demasiado grande." << std::endl;
+        return false;
+    }
+    valor = static_cast<int32_t>(leido);
+    return true;
+}
+
+/**
+ * @brief Lee un tamaño en bytes con sufijo binario opcional (K, M o G)
+ */
+bool leerTamano(const std::string& clave, const std::string& texto, int64_t& bytes, std::ostream& errores) {
+    std::string numero = texto;
+    int desplazamiento = 0;
+    if (!numero.empty()) {
+        char sufijo = static_cast<char>(std::toupper(static_cast<unsigned char>(numero.back())));
+        if (sufijo == 'K' || sufijo == 'M' || sufijo == 'G') {
+            desplazamiento = sufijo == 'K' ? 10 : (sufijo == 'M' ? 20 : 30);
+            numero.pop_back();
+        }
+    }
+    int64_t valor = 0;
+    if (!leerEntero(numero, valor) || valor < 1 || valor > (INT64_MAX >> 30)) {
+        errores << "Error: --" << clave << " debe ser un tamaño positivo en bytes, con sufijo K, M o G opcional"
+                << " (se recibió '" << texto << "')." << std::endl;
+        return false;
+    }
+    bytes = valor << desplazamiento;
+    return true;
+}
+
+/**
+ * @brief Elimina los espacios al principio y al final
+ */
+std::string recortar(const std::string& texto) {
+    const char* espacios = " \t\r\n";
+    size_t inicio = texto.find_first_not_of(espacios);
+    if (inicio == std::string::npos) {
+        return "";
+    }
+    size_t fin = texto.find_last_not_of(espacios);
+    return texto.substr(inicio, fin - inicio + 1);
+}
+
+/**
+ * @brief Indica si la opción es un interruptor sin valor
+ */
+bool esInterruptor(const std::string& clave) {
+    return clave == "silencioso" || clave == "jerarquico" || clave == "persistente" ||
+           clave == "resumen" || clave == "balanceo" || clave == "ajustar" || clave == "reanudar" ||
+           clave == "gpu" || clave == "ayuda";
+}
+
+} // namespace
+
+Configuracion configuracionPorDefecto() {
+    Configuracion config;
+    config.numHilos = leerNumHilos();
+    config.modoSuma = leerModoSuma();
+    config.segmentos = leerNumSegmentos();
+    config.estrategia = leerEstrategia();
+    
+    const char* silencioso = std::getenv(VARIABLE_SILENCIOSO);
+    config.silencioso = (silencioso != nullptr && std::string(silencioso) != "0") ? 1 : 0;
+    return config;
+}
+
+bool aplicarOpcion(const std::string& clave, const std::string& valor, Configuracion& config,
+                   std::ostream& errores) {
+    if (clave == "n") {
+        return leerEnteroDesde(clave, valor, 1, config.N, errores);
+    }
+    if (clave == "n-total") {
+        return leerEnteroDesde(clave, valor, 1, config.nTotal, errores);
+    }
+    if (clave == "iteraciones") {
+        return leerEntero32Desde(clave, valor, 1, config.iteraciones, errores);
+    }
+    if (clave == "calentamiento") {
+        return leerEntero32Desde(clave, valor, 0, config.calentamiento, errores);
+    }
+    if (clave == "tamano-min") {
+        return leerTamano(clave, valor, config.tamanoMinimo, errores);
+    }
+    if (clave == "tamano-max") {
+        return leerTamano(clave, valor, config.tamanoMaximo, errores);
+    }
+    if (clave == "semilla") {
+        int64_t semilla = 0;
+        if (!leerEnteroDesde(clave, valor, 0, semilla, errores)) {
+            return false;
+        }
+        config.semilla = static_cast<uint64_t>(semilla);
+        return true;
+    }
+    if (clave == "hilos") {
+        if (!leerEntero32Desde(clave, valor, 0, config.numHilos, errores)) {
+            return false;
+        }
+        // Igual que MPI_AVANZADO_HILOS: 0 usa todos los núcleos
+        if (config.numHilos == 0) {
+            config.numHilos = static_cast<int32_t>(std::thread::hardware_concurrency());
+        }
+        if (config.numHilos <= 0) {
+            config.numHilos = 1;
+        }
+        return true;
+    }
+    if (clave == "segmentos") {
+        return leerEntero32Desde(clave, valor, 0, config.segmentos, errores);
+    }
+    if (clave == "suma") {
+        for (ModoSuma modo : {ModoSuma::Rapida, ModoSuma::Compensada}) {
+            if (valor == nombreModoSuma(modo)) {
+                config.modoSuma = modo;
+                return true;
+            }
+        }
+        errores << "Error: --suma debe ser 'rapida' o 'compensada' (se recibió '" << valor << "')." << std::endl;
+        return false;
+    }
+    if (clave == "colectiva") {
+        for (EstrategiaColectiva estrategia : ESTRATEGIAS_COLECTIVAS) {
+            if (valor == nombreEstrategia(estrategia)) {
+                config.estrategia = estrategia;
+                return true;
+            }
+        }
+        errores << "Error: estrategia colectiva desconocida '" << valor << "'." << std::endl;
+        return false;
+    }
+    if (clave == "formato") {
+        for (FormatoSalida formato : {FormatoSalida::Texto, FormatoSalida::Csv, FormatoSalida::Json}) {
+            if (valor == nombreFormato(formato)) {
+                config.formato = formato;
+                return true;
+            }
+        }
+        errores << "Error: --formato debe ser 'texto', 'csv' o 'json' (se recibió '" << valor << "')." << std::endl;
+        return false;
+    }
+    if (clave == "memoria") {
+        for (AsignadorMemoria asignador : {AsignadorMemoria::Alineado, AsignadorMemoria::MpiAllocMem}) {
+            if (valor == nombreAsignador(asignador)) {
+                config.asignador = asignador;
+                return true;
+            }
+        }
+        errores << "Error: --memoria debe ser 'alineado' o 'mpi' (se recibió '" << valor << "')." << std::endl;
+        return false;
+    }
+    if (clave == "precision") {
+        for (PrecisionCarga precision : PRECISIONES_CARGA) {
+            if (valor == nombrePrecision(precision)) {
+                config.precision = precision;
+                return true;
+            }
+        }
+        errores << "Error: --precision debe ser 'doble', 'simple' o 'bf16' (se recibió '" << valor << "')."
+                << std::endl;
+        return false;
+    }
+    if (clave == "jerarquico") {
+        config.jerarquico = (valor != "0") ? 1 : 0;
+        return true;
+    }
+    if (clave == "persistente") {
+        config.persistente = (valor != "0") ? 1 : 0;
+        return true;
+    }
+    if (clave == "resumen") {
+        config.resumen = (valor != "0") ? 1 : 0;
+        return true;
+    }
+    if (clave == "balanceo") {
+        config.balanceo = (valor != "0") ? 1 : 0;
+        return true;
+    }
+    if (clave == "ajustar") {
+        config.ajustar = (valor != "0") ? 1 : 0;
+        return true;
+    }
+    if (clave == "tabla") {
+        if (valor.empty() || valor.size() >= sizeof(config.tablaDecision)) {
+            errores << "Error: --tabla necesita una ruta de entre 1 y " << sizeof(config.tablaDecision) - 1
+                    << " caracteres." << std::endl;
+            return false;
+        }
+        std::memset(config.tablaDecision, 0, sizeof(config.tablaDecision));
+        std::memcpy(config.tablaDecision, valor.data(), valor.size());
+        return true;
+    }
+    if (clave == "punto-control") {
+        if (valor.empty() || valor.size() >= sizeof(config.puntoControl)) {
+            errores << "Error: --punto-control necesita una ruta de entre 1 y " << sizeof(config.puntoControl) - 1
+                    << " caracteres." << std::endl;
+            return false;
+        }
+        std::memset(config.puntoControl, 0, sizeof(config.puntoControl));
+        std::memcpy(config.puntoControl, valor.data(), valor.size());
+        return true;
+    }
+    if (clave == "entrada" || clave == "hints-io") {
+        char* destino = (clave == "entrada") ? config.entrada : config.hintsIo;
+        const size_t capacidad = (clave == "entrada") ? sizeof(config.entrada) : sizeof(config.hintsIo);
+        if (valor.empty() || valor.size() >= capacidad) {
+            errores << "Error: --" << clave << " necesita un valor de entre 1 y " << capacidad - 1
+                    << " caracteres." << std::endl;
+            return false;
+        }
+        std::memset(destino, 0, capacidad);
+        std::memcpy(destino, valor.data(), valor.size());
+        return true;
+    }
+    if (clave == "lectura") {
+        for (ModoLectura modo : {ModoLectura::MpiIo, ModoLectura::Mmap}) {
+            if (valor == nombreModoLectura(modo)) {
+                config.lectura = modo;
+                return true;
+            }
+        }
+        errores << "Error: --lectura debe ser 'mpiio' o 'mmap' (se recibió '" << valor << "')." << std::endl;
+        return false;
+    }
+    if (clave == "tipo-entrada") {
+        for (TipoDato tipo : TIPOS_DATO) {
+            if (valor == nombreTipoDato(tipo)) {
+                config.tipoEntrada = tipo;
+                return true;
+            }
+        }
+        errores << "Error: --tipo-entrada debe ser 'int32', 'int64', 'float' o 'double' (se recibió '" << valor
+                << "')." << std::endl;
+        return false;
+    }
+    if (clave == "punto-control-cada") {
+        return leerEnteroDesde(clave, valor, 1, config.puntoControlCada, errores);
+    }
+    if (clave == "reanudar") {
+        config.reanudar = (valor != "0") ? 1 : 0;
+        return true;
+    }
+    if (clave == "gpu") {
+        config.gpu = (valor != "0") ? 1 : 0;
+        return true;
+    }
+    if (clave == "transporte-gpu") {
+        for (TransporteGpu transporte : {TransporteGpu::Auto, TransporteGpu::Copia, TransporteGpu::MpiGpu,
+                                         TransporteGpu::Nccl}) {
+            if (valor == nombreTransporteGpu(transporte)) {
+                config.transporteGpu = transporte;
+                return true;
+            }
+        }
+        errores << "Error: --transporte-gpu debe ser 'auto', 'copia', 'mpi' o 'nccl' (se recibió '" << valor
+                << "')." << std::endl;
+        return false;
+    }
+    if (clave == "plazo") {
+        return leerEntero32Desde(clave, valor, 0, config.plazoMs, errores);
+    }
+    if (clave == "max-procs") {
+        return leerEntero32Desde(clave, valor, 0, config.maxProcs, errores);
+    }
+    if (clave == "ranks-por-nodo") {
+        return leerEntero32Desde(clave, valor, 0, config.ranksPorNodo, errores);
+    }
+    if (clave == "silencioso") {
+        config.silencioso = (valor != "0") ? 1 : 0;
+        return true;
+    }
+    if (clave == "config") {
+        return leerArchivoConfiguracion(valor, config, errores);
+    }
+    
+    errores << "Error: opción desconocida '" << clave << "'." << std::endl;
+    return false;
+}
+
+bool leerArchivoConfiguracion(const std::string& ruta, Configuracion& config, std::ostream& errores) {
+    std::ifstream archivo(ruta);
+    if (!archivo.is_open()) {
+        errores << "Error: no se pudo abrir el archivo de configuración '" << ruta << "'." << std::endl;
+        return false;
+    }
+    
+    std::string linea;
+    int numeroLinea = 0;
+    while (std::getline(archivo, linea)) {
+        ++numeroLinea;
+        linea = recortar(linea);
+        if (linea.empty() || linea[0] == '#') {
+            continue;
+        }
+        
+        size_t igual = linea.find('=');
+        std::string clave = recortar(linea.substr(0, igual));
+        std::string valor = igual == std::string::npos ? "1" : recortar(linea.substr(igual + 1));
+        
+        // Un archivo no puede incluir otro, para evitar ciclos
+        if (clave == "config" || (igual == std::string::npos && !esInterruptor(clave))) {
+            errores << ruta << ":" << numeroLinea << ": línea no válida '" << linea << "'." << std::endl;
+            return false;
+        }
+        if (!aplicarOpcion(clave, valor, config, errores)) {
+            errores << "  (en " << ruta << ":" << numeroLinea << ")" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+EstadoConfiguracion interpretarArgumentos(int argc, char** argv, Configuracion& config,
+                                          std::ostream& errores) {
+    config.estado = EstadoConfiguracion::Valida;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string argumento = argv[i];
+        if (argumento == "-h" || argumento == "--ayuda" || argumento == "--help") {
+            config.estado = EstadoConfiguracion::Ayuda;
+            return config.estado;
+        }
+        if (argumento.compare(0, 2, "--") != 0) {
+            errores << "Error: argumento no reconocido '" << argumento << "'." << std::endl;
+            config.estado = EstadoConfiguracion::Error;
+            return config.estado;
+        }
+        
+        std::string clave = argumento.substr(2);
+        std::string valor;
+        size_t igual = clave.find('=');
+        if (igual != std::string::npos) {
+            valor = clave.substr(igual + 1);
+            clave = clave.substr(0, igual);
+        } else if (esInterruptor(clave)) {
+            valor = "1";
+        } else if (i + 1 < argc) {
+            valor = argv[++i];
+        } else {
+            errores << "Error: falta el valor de --" << clave << "." << std::endl;
+            config.estado = EstadoConfiguracion::Error;
+            return config.estado;
+        }
+        
+        if (!aplicarOpcion(clave, valor, config, errores)) {
+            config.estado = EstadoConfiguracion::Error;
+            return config.estado;
+        }
+    }
+    
+    if (config.tamanoMaximo > TAMANO_BARRIDO_MAXIMO) {
+        errores << "Error: --tamano-max no puede superar " << TAMANO_BARRIDO_MAXIMO << " bytes." << std::endl;
+        config.estado = EstadoConfiguracion::Error;
+    } else if (config.tamanoMinimo > config.tamanoMaximo) {
+        errores << "Error: --tamano-min (" << config.tamanoMinimo << ") no puede superar a --tamano-max ("
+                << config.tamanoMaximo << ")." << std::endl;
+        config.estado = EstadoConfiguracion::Error;
+    }
+    return config.estado;
+}
+
+bool validarTotalValores(const Configuracion& config, int numProcs, std::ostream& errores) {
+    if (numProcs > 0 && config.N > INT64_MAX / numProcs) {
+        errores << "Error: --n " << config.N << " con " << numProcs << " procesos supera el total máximo de "
+                << INT64_MAX << " valores." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void difundirConfiguracion(Configuracion& config, int root, MPI_Comm comm) {
+    MPI_Bcast(&config, static_cast<int>(sizeof(Configuracion)), MPI_BYTE, root, comm);
+}
+
+void imprimirAyuda(std::ostream& salida, const char* programa) {
+    salida << "Uso: mpirun -np P " << programa << " [opciones]" << std::endl
+           << std::endl
+           << "Opciones (también válidas como 'clave = valor' en el archivo de --config):" << std::endl
+           << "  --n N                 Valores por proceso" << std::endl
+           << "  --n-total T           Valores totales, repartidos de forma exacta (sustituye a --n)" << std::endl
+           << "  --iteraciones K       Repeticiones de la medición" << std::endl
+           << "  --calentamiento W     Repeticiones previas que no se miden" << std::endl
+           << "  --tamano-min B        Primer tamaño del barrido de mensajes (sufijos K/M/G)" << std::endl
+           << "  --tamano-max B        Último tamaño del barrido de mensajes (por defecto 256M)" << std::endl
+           << "  --memoria NOMBRE      alineado | mpi (MPI_Alloc_mem) para los buffers de benchmark" << std::endl
+           << "  --precision NOMBRE    doble | simple | bf16: carga del barrido de MPI_Reduce" << std::endl
+           << "  --semilla S           Semilla del generador (por defecto " << SEMILLA_POR_DEFECTO << ")" << std::endl
+           << "  --colectiva NOMBRE    reduce-bcast | allreduce | reduce-scatter-allgather" << std::endl
+           << "  --formato NOMBRE      texto | csv | json" << std::endl
+           << "  --hilos H             Hilos por proceso (0 = todos los núcleos)" << std::endl
+           << "  --suma NOMBRE         rapida | compensada" << std::endl
+           << "  --segmentos S         Segmentos del modo solapado (0 = bloqueante)" << std::endl
+           << "  --silencioso          Omite el diagnóstico por proceso" << std::endl
+           << "  --jerarquico          Reduce y difunde en dos niveles (nodo y líderes)" << std::endl
+           << "  --ranks-por-nodo R    Emula nodos de R ranks consecutivos (0 = nodos reales)" << std::endl
+           << "  --max-procs P         Tope de procesos del estudio de escalabilidad de mpi_analysis" << std::endl
+           << "  --persistente         Prepara las colectivas una vez (MPI_Bcast_init...) y las reinicia" << std::endl
+           << "  --resumen             Reduce en una colectiva cuenta, media, varianza, mínimo y máximo" << std::endl
+           << "  --balanceo            Reparte los valores según el rendimiento medido en cada iteración" << std::endl
+           << "  --tabla RUTA          Tabla de decisión de algoritmos colectivos (ver --ajustar)" << std::endl
+           << "  --ajustar             mpi_benchmark: mide cada algoritmo y escribe la tabla (--tabla)" << std::endl
+           << "  --plazo MS            Reducción resiliente: excluye a los procesos que no llegan en MS ms" << std::endl
+           << "  --entrada RUTA        Promedia un archivo binario de doubles en lugar de generar valores" << std::endl
+           << "  --lectura NOMBRE      mpiio (MPI_File_iread_at_all) | mmap (almacenamiento local)" << std::endl
+           << "  --hints-io LISTA      Hints de MPI-IO 'clave=valor,...' (cb_nodes, striping_factor...)" << std::endl
+           << "  --tipo-entrada TIPO   Tipo de los valores de --entrada: int32 | int64 | float | double" << std::endl
+           << "  --punto-control RUTA  Guarda la suma parcial y la posición del generador en RUTA (MPI-IO)" << std::endl
+           << "  --punto-control-cada V Valores por proceso entre puntos de control (por defecto 2^24)" << std::endl
+           << "  --reanudar            Continúa desde el último punto de control común de --punto-control" << std::endl
+           << "  --gpu                 Genera, suma y reduce en la GPU (compilación MPI_AVANZADO_GPU)" << std::endl
+           << "  --transporte-gpu NOMBRE auto | copia (al host) | mpi (MPI consciente de la GPU) | nccl" << std::endl
+           << "  --config RUTA         Lee opciones de un archivo" << std::endl
+           << "  --ayuda               Muestra esta ayuda" << std::endl;
+}
+
+const char* nombreFormato(FormatoSalida formato) {
+    switch (formato) {
+        case FormatoSalida::Texto:
+            return "texto";
+        case FormatoSalida::Csv:
+            return "csv";
+        case FormatoSalida::Json:
+            return "json";
+    }
+    return "desconocido";
+}
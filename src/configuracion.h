@@ -0,0 +1,180 @@
+/**
+ * @file configuracion.h
+ * @brief Configuración no interactiva de los programas (argumentos y archivo)
+ * @author Emil M
+ * @date 2025
+ *
+ * Los parámetros se leen en el proceso raíz, en este orden de prioridad
+ * creciente: variables de entorno, archivo de configuración (`--config`) y
+ * argumentos de línea de comandos. El resultado se distribuye después con un
+ * único MPI_Bcast de la estructura empaquetada, de modo que el resto de los
+ * procesos no lee argumentos ni archivos.
+ */
+
+#ifndef MPI_AVANZADO_CONFIGURACION_H
+#define MPI_AVANZADO_CONFIGURACION_H
+
+#include <mpi.h>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <type_traits>
+
+#include "aleatorio.h"
+#include "colectivas.h"
+#include "entrada.h"
+#include "gpu.h"
+#include "memoria.h"
+#include "precision.h"
+#include "reductor.h"
+#include "suma.h"
+
+/**
+ * @brief Variable de entorno que activa el modo silencioso (producción)
+ *
+ * En modo silencioso no se recogen ni imprimen diagnósticos por proceso: el
+ * camino crítico contiene solo las colectivas del cálculo.
+ */
+const char* const VARIABLE_SILENCIOSO = "MPI_AVANZADO_SILENCIOSO";
+
+/**
+ * @brief Formato de salida de los resultados
+ */
+enum class FormatoSalida : int32_t {
+    Texto, ///< Salida legible (por defecto)
+    Csv,   ///< Una cabecera y una fila CSV
+    Json   ///< Un objeto JSON en una línea
+};
+
+/**
+ * @brief Resultado de interpretar la configuración
+ */
+enum class EstadoConfiguracion : int32_t {
+    Valida, ///< Configuración lista para usarse
+    Ayuda,  ///< Se pidió la ayuda: terminar sin error
+    Error   ///< Argumento o archivo inválido: terminar con error
+};
+
+/**
+ * @brief Parámetros de ejecución
+ *
+ * Solo contiene campos de tamaño fijo para poder distribuirse como un bloque
+ * de bytes con un único MPI_Bcast.
+ */
+struct Configuracion {
+    int64_t N = 0;                        ///< Valores por proceso (0 = no indicado)
+    int64_t nTotal = 0;                   ///< Valores totales repartidos de forma exacta (0 = N por proceso)
+    uint64_t semilla = SEMILLA_POR_DEFECTO; ///< Semilla del generador
+    int64_t tamanoMinimo = 8;             ///< Bytes del primer punto del barrido de mensajes
+    int64_t tamanoMaximo = int64_t(256) << 20; ///< Bytes del último punto del barrido de mensajes
+    int32_t iteraciones = 1;              ///< Repeticiones de la medición
+    int32_t calentamiento = 0;            ///< Repeticiones previas que no se miden
+    int32_t numHilos = 1;                 ///< Hilos por proceso
+    int32_t segmentos = 0;                ///< Segmentos del modo solapado (0 = bloqueante)
+    int32_t silencioso = 0;               ///< Distinto de 0 para omitir el diagnóstico por proceso
+    int32_t jerarquico = 0;               ///< Distinto de 0 para usar las colectivas jerárquicas
+    int32_t ranksPorNodo = 0;             ///< Tamaño de los nodos emulados (0 = nodos reales)
+    int32_t maxProcs = 0;                 ///< Tope de procesos del estudio de escalabilidad (0 = todos)
+    int32_t persistente = 0;              ///< Distinto de 0 para preparar las colectivas una sola vez
+    int32_t resumen = 0;                  ///< Distinto de 0 para reducir cuenta, media, M2, mínimo y máximo
+    int32_t balanceo = 0;                 ///< Distinto de 0 para reequilibrar el reparto entre iteraciones
+    int32_t ajustar = 0;                  ///< Distinto de 0 para el barrido de ajuste de algoritmos colectivos
+    int32_t plazoMs = 0;                  ///< Plazo de la reducción resiliente en ms (0 = reducción normal)
+    int32_t reanudar = 0;                 ///< Distinto de 0 para continuar desde el último punto de control
+    int32_t gpu = 0;                      ///< Distinto de 0 para generar y sumar en la GPU (compilación con GPU)
+    TransporteGpu transporteGpu = TransporteGpu::Auto; ///< Forma de mover los buffers de la GPU en las colectivas
+    int64_t puntoControlCada = int64_t(1) << 24; ///< Valores por proceso entre puntos de control
+    char puntoControl[256] = {};          ///< Archivo de puntos de control ("" = sin puntos de control)
+    char entrada[256] = {};               ///< Archivo binario de doubles a promediar ("" = valores generados)
+    char hintsIo[256] = {};               ///< Hints adicionales de MPI-IO ("clave=valor,clave=valor")
+    ModoLectura lectura = ModoLectura::MpiIo; ///< Forma de leer el archivo de entrada
+    TipoDato tipoEntrada = TipoDato::Double; ///< Tipo de los valores del archivo de entrada
+    char tablaDecision[256] = {};         ///< Archivo de la tabla de decisión de algoritmos ("" = biblioteca)
+    ModoSuma modoSuma = ModoSuma::Rapida; ///< Modo de suma
+    EstrategiaColectiva estrategia = EstrategiaColectiva::ReduceBcast; ///< Estrategia colectiva
+    FormatoSalida formato = FormatoSalida::Texto; ///< Formato de salida
+    AsignadorMemoria asignador = AsignadorMemoria::Alineado; ///< Origen de los buffers de benchmark
+    PrecisionCarga precision = PrecisionCarga::Doble; ///< Precisión de la carga del barrido de MPI_Reduce
+    EstadoConfiguracion estado = EstadoConfiguracion::Valida; ///< Resultado de la lectura
+};
+
+static_assert(std::is_trivially_copyable<Configuracion>::value,
+              "Configuracion se distribuye como bytes y debe ser trivialmente copiable");
+
+/**
+ * @brief Configuración inicial a partir de las variables de entorno
+ * @return Configuración con los valores de MPI_AVANZADO_HILOS,
+ *         MPI_AVANZADO_SUMA, MPI_AVANZADO_SEGMENTOS, MPI_AVANZADO_COLECTIVA y
+ *         MPI_AVANZADO_SILENCIOSO
+ */
+Configuracion configuracionPorDefecto();
+
+/**
+ * @brief Aplica una opción `clave = valor` a la configuración
+ * @param clave Nombre de la opción (sin el prefijo `--`)
+ * @param valor Valor de la opción
+ * @param config Configuración a modificar
+ * @param errores Flujo donde se describe el error
+ * @return true si la opción es válida
+ */
+bool aplicarOpcion(const std::string& clave, const std::string& valor, Configuracion& config,
+                   std::ostream& errores);
+
+/**
+ * @brief Lee un archivo de configuración con líneas `clave = valor`
+ * @param ruta Ruta del archivo
+ * @param config Configuración a modificar
+ * @param errores Flujo donde se describe el error
+ * @return true si el archivo existe y todas sus opciones son válidas
+ *
+ * Las líneas vacías y las que empiezan por `#` se ignoran. Las claves son los
+ * nombres largos de los argumentos (`n`, `iteraciones`, `semilla`...).
+ */
+bool leerArchivoConfiguracion(const std::string& ruta, Configuracion& config, std::ostream& errores);
+
+/**
+ * @brief Interpreta los argumentos de línea de comandos
+ * @param argc Número de argumentos
+ * @param argv Argumentos
+ * @param config Configuración a modificar
+ * @param errores Flujo donde se describe el error
+ * @return Estado resultante (también se guarda en config.estado)
+ *
+ * Acepta `--clave valor` y `--clave=valor`. `--config ruta` aplica el archivo
+ * en su posición, de modo que los argumentos posteriores lo sobrescriben.
+ */
+EstadoConfiguracion interpretarArgumentos(int argc, char** argv, Configuracion& config,
+                                          std::ostream& errores);
+
+/**
+ * @brief Comprueba que N valores por proceso en numProcs procesos caben en un total de 64 bits
+ * @param config Configuración leída
+ * @param numProcs Número de procesos
+ * @param errores Flujo donde se describe el error
+ * @return false si N * numProcs desborda int64_t
+ */
+bool validarTotalValores(const Configuracion& config, int numProcs, std::ostream& errores);
+
+/**
+ * @brief Distribuye la configuración desde la raíz con un único MPI_Bcast
+ * @param config Configuración (entrada en la raíz, salida en el resto)
+ * @param root Rank del proceso raíz
+ * @param comm Comunicador
+ *
+ * Se envía como bytes: todos los procesos ejecutan el mismo binario.
+ */
+void difundirConfiguracion(Configuracion& config, int root, MPI_Comm comm);
+
+/**
+ * @brief Imprime la ayuda de los argumentos
+ * @param salida Flujo de salida
+ * @param programa Nombre del programa
+ */
+void imprimirAyuda(std::ostream& salida, const char* programa);
+
+/**
+ * @brief Nombre de un formato de salida
+ */
+const char* nombreFormato(FormatoSalida formato);
+
+#endif // MPI_AVANZADO_CONFIGURACION_H
@@ -0,0 +1,124 @@
+/**
+ * @file desfase.cpp
+ * @brief Implementación del reloj sincronizado y del desglose de colectivas
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "desfase.h"
+
+#include <algorithm>
+#include <map>
+
+namespace {
+
+const int ETIQUETA_SONDA = 7201;
+
+} // namespace
+
+RelojSincronizado::RelojSincronizado(MPI_Comm comm, int rondas) {
+    int rank = 0;
+    int numProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numProcs);
+    
+    if (rank == 0) {
+        // Un proceso cada vez para que las sondas no se estorben
+        for (int origen = 1; origen < numProcs; ++origen) {
+            for (int ronda = 0; ronda < rondas; ++ronda) {
+                MPI_Recv(nullptr, 0, MPI_BYTE, origen, ETIQUETA_SONDA, comm, MPI_STATUS_IGNORE);
+                double hora = MPI_Wtime();
+                MPI_Send(&hora, 1, MPI_DOUBLE, origen, ETIQUETA_SONDA, comm);
+            }
+        }
+        return;
+    }
+    
+    double mejorIdaVuelta = -1.0;
+    for (int ronda = 0; ronda < rondas; ++ronda) {
+        double envio = MPI_Wtime();
+        MPI_Send(nullptr, 0, MPI_BYTE, 0, ETIQUETA_SONDA, comm);
+        double horaRaiz = 0.0;
+        MPI_Recv(&horaRaiz, 1, MPI_DOUBLE, 0, ETIQUETA_SONDA, comm, MPI_STATUS_IGNORE);
+        double recepcion = MPI_Wtime();
+        
+        // La raíz leyó su reloj, en el mejor caso, a mitad del trayecto
+        double idaVuelta = recepcion - envio;
+        if (mejorIdaVuelta < 0.0 || idaVuelta < mejorIdaVuelta) {
+            mejorIdaVuelta = idaVuelta;
+            desfase_ = horaRaiz - (envio + recepcion) / 2.0;
+        }
+    }
+    error_ = std::max(mejorIdaVuelta, 0.0) / 2.0;
+}
+
+DesgloseColectiva desglosarColectiva(double llegada, double salida, int root, MPI_Comm comm) {
+    int rank = 0;
+    int numProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numProcs);
+    
+    double propias[2] = {llegada, salida};
+    std::vector<double> marcas(rank == root ? 2 * numProcs : 0);
+    MPI_Gather(propias, 2, MPI_DOUBLE, marcas.data(), 2, MPI_DOUBLE, root, comm);
+    
+    DesgloseColectiva desglose;
+    if (rank != root) {
+        return desglose;
+    }
+    
+    double primeraLlegada = marcas[0];
+    double ultimaLlegada = marcas[0];
+    double ultimaSalida = marcas[1];
+    for (int p = 1; p < numProcs; ++p) {
+        primeraLlegada = std::min(primeraLlegada, marcas[2 * p]);
+        if (marcas[2 * p] > ultimaLlegada) {
+            ultimaLlegada = marcas[2 * p];
+            desglose.rankTardio = p;
+        }
+        ultimaSalida = std::max(ultimaSalida, marcas[2 * p + 1]);
+    }
+    
+    double sumaEspera = 0.0;
+    double sumaDentro = 0.0;
+    for (int p = 0; p < numProcs; ++p) {
+        sumaEspera += ultimaLlegada - marcas[2 * p];
+        sumaDentro += marcas[2 * p + 1] - marcas[2 * p];
+    }
+    desglose.desfase = (ultimaLlegada - primeraLlegada) * 1e6;
+    desglose.esperaMedia = sumaEspera / numProcs * 1e6;
+    // El error del reloj puede dejar la salida un poco antes de la última llegada
+    desglose.transferencia = std::max(ultimaSalida - ultimaLlegada, 0.0) * 1e6;
+    desglose.dentroMedio = sumaDentro / numProcs * 1e6;
+    return desglose;
+}
+
+DesgloseColectiva promedioDesgloses(const std::vector<DesgloseColectiva>& desgloses) {
+    DesgloseColectiva media;
+    if (desgloses.empty()) {
+        return media;
+    }
+    
+    std::map<int, int> vecesTardio;
+    for (const DesgloseColectiva& desglose : desgloses) {
+        media.desfase += desglose.desfase;
+        media.esperaMedia += desglose.esperaMedia;
+        media.transferencia += desglose.transferencia;
+        media.dentroMedio += desglose.dentroMedio;
+        ++vecesTardio[desglose.rankTardio];
+    }
+    double n = static_cast<double>(desgloses.size());
+    media.desfase /= n;
+    media.esperaMedia /= n;
+    media.transferencia /= n;
+    media.dentroMedio /= n;
+    
+    int masVeces = 0;
+    for (const auto& tardio : vecesTardio) {
+        if (tardio.second > masVeces) {
+            masVeces = tardio.second;
+            media.rankTardio = tardio.first;
+        }
+    }
+    return media;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file desfase.h
+ * @brief Desfase de llegada a una colectiva: espera al más lento frente a transferencia
+ * @author Emil M
+ * @date 2025
+ *
+ * Si un proceso llega tarde a MPI_Reduce, los demás pasan ese tiempo dentro
+ * de la colectiva esperándolo, y un cronómetro alrededor de la llamada lo
+ * cuenta como comunicación. Para separarlo, cada proceso anota su llegada y su
+ * salida con un reloj alineado con el del rank 0 (RelojSincronizado) y la raíz
+ * reúne las marcas: la espera de cada proceso es lo que tarda en llegar el
+ * último, y la transferencia, lo que dura la colectiva desde esa llegada hasta
+ * que sale el último proceso. Una espera grande se corrige con el reparto de
+ * carga; una transferencia grande, en la red o en el algoritmo.
+ */
+
+#ifndef MPI_AVANZADO_DESFASE_H
+#define MPI_AVANZADO_DESFASE_H
+
+#include <mpi.h>
+#include <vector>
+
+/**
+ * @brief Reloj alineado con el del rank 0
+ *
+ * MPI_Wtime es local a cada proceso, y salvo que MPI_WTIME_IS_GLOBAL lo diga
+ * los relojes de dos nodos no comparten origen. El desfase se estima con el
+ * algoritmo de Cristian: el rank 0 responde con su hora a varias sondas de
+ * cada proceso y se toma la de menor ida y vuelta, cuyo error está acotado
+ * por la mitad de ese tiempo.
+ */
+class RelojSincronizado {
+public:
+    /**
+     * @brief Mide el desfase de cada proceso (operación colectiva sobre comm)
+     * @param comm Comunicador; su rank 0 es la referencia
+     * @param rondas Sondas por proceso
+     */
+    explicit RelojSincronizado(MPI_Comm comm, int rondas = 16);
+    
+    /**
+     * @brief Hora del rank 0 de comm, en segundos
+     */
+    double ahora() const { return MPI_Wtime() + desfase_; }
+    
+    /**
+     * @brief Desfase sumado a MPI_Wtime (0 en el rank 0)
+     */
+    double desfase() const { return desfase_; }
+    
+    /**
+     * @brief Cota del error del desfase: media ida y vuelta de la mejor sonda
+     */
+    double error() const { return error_; }
+
+private:
+    double desfase_ = 0.0;
+    double error_ = 0.0;
+};
+
+/**
+ * @brief Desglose del tiempo de una colectiva entre procesos (tiempos en μs)
+ */
+struct DesgloseColectiva {
+    double desfase = 0.0;       ///< Última llegada menos la primera
+    int rankTardio = 0;         ///< Proceso que llegó el último
+    double esperaMedia = 0.0;   ///< Media de lo que cada proceso espera al último
+    double transferencia = 0.0; ///< Última salida menos la última llegada
+    double dentroMedio = 0.0;   ///< Media del tiempo dentro de la colectiva (espera + su parte de transferencia)
+};
+
+/**
+ * @brief Reúne las marcas de una colectiva y la desglosa
+ * @param llegada Hora sincronizada justo antes de la colectiva (s)
+ * @param salida Hora sincronizada justo después (s)
+ * @param root Proceso que recibe el desglose
+ * @param comm Comunicador de la colectiva (operación colectiva sobre él)
+ * @return Desglose (solo válido en root)
+ */
+DesgloseColectiva desglosarColectiva(double llegada, double salida, int root, MPI_Comm comm);
+
+/**
+ * @brief Media de varios desgloses de la misma colectiva
+ * @return Medias de los tiempos; rankTardio es el que más veces llegó el último
+ */
+DesgloseColectiva promedioDesgloses(const std::vector<DesgloseColectiva>& desgloses);
+
+#endif // MPI_AVANZADO_DESFASE_H
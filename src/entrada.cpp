@@ -0,0 +1,272 @@
+/**
+ * @file entrada.cpp
+ * @brief Implementación de la lectura paralela del archivo de entrada
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "entrada.h"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "memoria.h"
+
+namespace {
+
+/**
+ * @brief Valores que se entregan de una vez a procesar
+ *
+ * Entre trozo y trozo se consulta la lectura pendiente para que la
+ * biblioteca la haga avanzar mientras se suma.
+ */
+const int64_t VALORES_TROZO = int64_t(1) << 16;
+
+/**
+ * @brief Añade o sustituye los pares "clave=valor,clave=valor" de un texto
+ */
+void mezclarHints(const std::string& texto, std::vector<std::pair<std::string, std::string>>& hints) {
+    size_t inicio = 0;
+    while (inicio < texto.size()) {
+        size_t fin = texto.find(',', inicio);
+        if (fin == std::string::npos) {
+            fin = texto.size();
+        }
+        std::string par = texto.substr(inicio, fin - inicio);
+        size_t igual = par.find('=');
+        if (igual != std::string::npos && igual > 0) {
+            std::string clave = par.substr(0, igual);
+            std::string valor = par.substr(igual + 1);
+            auto existente = std::find_if(hints.begin(), hints.end(),
+                                          [&](const std::pair<std::string, std::string>& hint) {
+                                              return hint.first == clave;
+                                          });
+            if (existente != hints.end()) {
+                existente->second = valor;
+            } else {
+                hints.emplace_back(clave, valor);
+            }
+        }
+        inicio = fin + 1;
+    }
+}
+
+/**
+ * @brief Entrega un bloque a procesar en trozos, consultando la petición pendiente entre ellos
+ */
+void procesarEnTrozos(const char* datos, int64_t cantidad, int64_t bytesValor,
+                      const std::function<void(const void*, int64_t)>& procesar, MPI_Request* pendiente) {
+    for (int64_t desde = 0; desde < cantidad; desde += VALORES_TROZO) {
+        procesar(datos + desde * bytesValor, std::min(VALORES_TROZO, cantidad - desde));
+        if (pendiente != nullptr && *pendiente != MPI_REQUEST_NULL) {
+            int hecho = 0;
+            MPI_Test(pendiente, &hecho, MPI_STATUS_IGNORE);
+        }
+    }
+}
+
+/**
+ * @brief Lectura con MPI_File_iread_at_all y doble buffer
+ */
+EstadisticasLectura leerMpiIo(const std::string& ruta, MPI_Datatype tipo, int64_t bytesValor, int64_t inicio,
+                              int64_t conteo, const std::string& hints, MPI_Comm comm,
+                              const std::function<void(const void*, int64_t)>& procesar, int64_t valoresBloque) {
+    EstadisticasLectura estadisticas;
+    double comienzo = MPI_Wtime();
+    
+    MPI_Info info;
+    MPI_Info_create(&info);
+    for (const std::pair<std::string, std::string>& hint : hintsLectura(hints, comm)) {
+        MPI_Info_set(info, hint.first.c_str(), hint.second.c_str());
+    }
+    MPI_File archivo = MPI_FILE_NULL;
+    int abierto = MPI_File_open(comm, ruta.c_str(), MPI_MODE_RDONLY, info, &archivo) == MPI_SUCCESS ? 1 : 0;
+    MPI_Info_free(&info);
+    
+    // El tramo se comprueba contra el tamaño antes de leer: OMPIO no rellena
+    // siempre la cuenta del estado de una lectura colectiva no bloqueante, así
+    // que una lectura corta no se puede detectar con MPI_Get_count
+    MPI_Offset tamano = 0;
+    int valido = abierto && MPI_File_get_size(archivo, &tamano) == MPI_SUCCESS &&
+                 tamano >= static_cast<MPI_Offset>(inicio + conteo) * static_cast<MPI_Offset>(bytesValor);
+    int todosValidos = 0;
+    MPI_Allreduce(&valido, &todosValidos, 1, MPI_INT, MPI_LAND, comm);
+    if (!todosValidos) {
+        if (abierto) {
+            MPI_File_close(&archivo);
+        }
+        estadisticas.correcta = false;
+        return estadisticas;
+    }
+    
+    // Las lecturas son colectivas: todos hacen tantas rondas como el proceso
+    // con más valores, leyendo 0 cuando terminan su tramo
+    int64_t conteoMaximo = 0;
+    MPI_Allreduce(&conteo, &conteoMaximo, 1, MPI_INT64_T, MPI_MAX, comm);
+    int64_t rondas = (conteoMaximo + valoresBloque - 1) / valoresBloque;
+    
+    const int64_t bytesBuffer = std::max<int64_t>(1, std::min(valoresBloque, conteoMaximo)) * bytesValor;
+    BufferMemoria buffers[2] = {BufferMemoria(bytesBuffer, AsignadorMemoria::Alineado),
+                                BufferMemoria(bytesBuffer, AsignadorMemoria::Alineado)};
+    int64_t cantidades[2] = {0, 0};
+    MPI_Request peticiones[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+    auto lanzar = [&](int64_t ronda) {
+        int b = static_cast<int>(ronda % 2);
+        int64_t desde = ronda * valoresBloque;
+        cantidades[b] = std::max<int64_t>(0, std::min(valoresBloque, conteo - desde));
+        MPI_Offset desplazamiento = static_cast<MPI_Offset>(inicio + std::min(desde, conteo)) *
+                                    static_cast<MPI_Offset>(bytesValor);
+        if (MPI_File_iread_at_all(archivo, desplazamiento, buffers[b].datos(), static_cast<int>(cantidades[b]),
+                                  tipo, &peticiones[b]) != MPI_SUCCESS) {
+            estadisticas.correcta = false;
+            peticiones[b] = MPI_REQUEST_NULL;
+        }
+    };
+    
+    if (rondas > 0) {
+        lanzar(0);
+    }
+    for (int64_t ronda = 0; ronda < rondas; ++ronda) {
+        int b = static_cast<int>(ronda % 2);
+        double inicioEspera = MPI_Wtime();
+        if (MPI_Wait(&peticiones[b], MPI_STATUS_IGNORE) != MPI_SUCCESS) {
+            estadisticas.correcta = false;
+        }
+        estadisticas.tiempoEspera += MPI_Wtime() - inicioEspera;
+        
+        // El bloque siguiente se lee mientras se suma este
+        if (ronda + 1 < rondas) {
+            lanzar(ronda + 1);
+        }
+        procesarEnTrozos(static_cast<const char*>(buffers[b].datos()), cantidades[b], bytesValor, procesar,
+                         &peticiones[1 - b]);
+        estadisticas.bytes += cantidades[b] * bytesValor;
+        estadisticas.bloques += cantidades[b] > 0 ? 1 : 0;
+    }
+    
+    MPI_File_close(&archivo);
+    estadisticas.tiempoTotal = MPI_Wtime() - comienzo;
+    return estadisticas;
+}
+
+/**
+ * @brief Lectura con mmap del tramo y lectura anticipada del bloque siguiente
+ */
+EstadisticasLectura leerMmap(const std::string& ruta, int64_t bytesValor, int64_t inicio, int64_t conteo,
+                             const std::function<void(const void*, int64_t)>& procesar, int64_t valoresBloque) {
+    EstadisticasLectura estadisticas;
+    double comienzo = MPI_Wtime();
+    if (conteo <= 0) {
+        return estadisticas;
+    }
+    
+    int descriptor = open(ruta.c_str(), O_RDONLY);
+    struct stat informacion;
+    const off_t inicioBytes = static_cast<off_t>(inicio) * static_cast<off_t>(bytesValor);
+    const off_t finBytes = inicioBytes + static_cast<off_t>(conteo) * static_cast<off_t>(bytesValor);
+    if (descriptor < 0 || fstat(descriptor, &informacion) != 0 || informacion.st_size < finBytes) {
+        if (descriptor >= 0) {
+            close(descriptor);
+        }
+        estadisticas.correcta = false;
+        return estadisticas;
+    }
+    
+    // mmap exige un desplazamiento múltiplo de la página
+    const off_t pagina = static_cast<off_t>(sysconf(_SC_PAGESIZE));
+    const off_t alineado = inicioBytes - inicioBytes % pagina;
+    const size_t longitud = static_cast<size_t>(finBytes - alineado);
+    void* proyeccion = mmap(nullptr, longitud, PROT_READ, MAP_PRIVATE, descriptor, alineado);
+    close(descriptor);
+    if (proyeccion == MAP_FAILED) {
+        estadisticas.correcta = false;
+        return estadisticas;
+    }
+    madvise(proyeccion, longitud, MADV_SEQUENTIAL);
+    
+    char* base = static_cast<char*>(proyeccion);
+    const char* datos = base + (inicioBytes - alineado);
+    for (int64_t desde = 0; desde < conteo; desde += valoresBloque) {
+        int64_t cantidad = std::min(valoresBloque, conteo - desde);
+        int64_t siguiente = desde + cantidad;
+        if (siguiente < conteo) {
+            // Se pide el bloque siguiente mientras se suma este
+            const char* inicioSiguiente = datos + siguiente * bytesValor;
+            char* paginaSiguiente = base + ((inicioSiguiente - base) / pagina) * pagina;
+            int64_t bytesSiguiente = std::min(valoresBloque, conteo - siguiente) * bytesValor;
+            madvise(paginaSiguiente, static_cast<size_t>(inicioSiguiente - paginaSiguiente + bytesSiguiente),
+                    MADV_WILLNEED);
+        }
+        procesarEnTrozos(datos + desde * bytesValor, cantidad, bytesValor, procesar, nullptr);
+        estadisticas.bytes += cantidad * bytesValor;
+        ++estadisticas.bloques;
+    }
+    munmap(proyeccion, longitud);
+    
+    estadisticas.tiempoTotal = MPI_Wtime() - comienzo;
+    estadisticas.tiempoEspera = estadisticas.tiempoTotal;
+    return estadisticas;
+}
+
+} // namespace
+
+int64_t valoresEnArchivo(const std::string& ruta, int64_t bytesValor) {
+    struct stat informacion;
+    if (stat(ruta.c_str(), &informacion) != 0 || !S_ISREG(informacion.st_mode)) {
+        return -1;
+    }
+    // Un resto indica que el archivo no es de este tipo: se leería basura
+    if (informacion.st_size % bytesValor != 0) {
+        return -1;
+    }
+    return static_cast<int64_t>(informacion.st_size) / bytesValor;
+}
+
+std::vector<std::pair<std::string, std::string>> hintsLectura(const std::string& hints, MPI_Comm comm) {
+    // Un agregador por nodo: la lectura en dos fases junta las peticiones de
+    // los procesos del nodo en un solo acceso grande al sistema de archivos
+    MPI_Comm nodo;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &nodo);
+    int rankNodo = 0;
+    MPI_Comm_rank(nodo, &rankNodo);
+    MPI_Comm_free(&nodo);
+    int lider = (rankNodo == 0) ? 1 : 0;
+    int numNodos = 0;
+    MPI_Allreduce(&lider, &numNodos, 1, MPI_INT, MPI_SUM, comm);
+    
+    std::vector<std::pair<std::string, std::string>> efectivos;
+    mezclarHints(HINTS_LECTURA_POR_DEFECTO, efectivos);
+    efectivos.emplace_back("cb_nodes", std::to_string(numNodos));
+    mezclarHints(hints, efectivos);
+    return efectivos;
+}
+
+EstadisticasLectura leerValoresPorBloques(const std::string& ruta, ModoLectura modo, MPI_Datatype tipo,
+                                          int64_t inicio, int64_t conteo, const std::string& hints, MPI_Comm comm,
+                                          const std::function<void(const void*, int64_t)>& procesar,
+                                          int64_t valoresBloque) {
+    valoresBloque = std::max<int64_t>(1, valoresBloque);
+    int bytesValor = 0;
+    MPI_Type_size(tipo, &bytesValor);
+    if (modo == ModoLectura::Mmap) {
+        return leerMmap(ruta, bytesValor, inicio, conteo, procesar, valoresBloque);
+    }
+    return leerMpiIo(ruta, tipo, bytesValor, inicio, conteo, hints, comm, procesar, valoresBloque);
+}
+
+EstadisticasLectura leerPorBloques(const std::string& ruta, ModoLectura modo, int64_t inicio, int64_t conteo,
+                                   const std::string& hints, MPI_Comm comm,
+                                   const std::function<void(const double*, int64_t)>& procesar,
+                                   int64_t valoresBloque) {
+    return leerValoresPorBloques(ruta, modo, MPI_DOUBLE, inicio, conteo, hints, comm,
+                                 [&](const void* valores, int64_t cantidad) {
+                                     procesar(static_cast<const double*>(valores), cantidad);
+                                 }, valoresBloque);
+}
+
+const char* nombreModoLectura(ModoLectura modo) {
+    return modo == ModoLectura::Mmap ? "mmap" : "mpiio";
+}
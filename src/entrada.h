@@ -0,0 +1,112 @@
+/**
+ * @file entrada.h
+ * @brief Lectura paralela de un archivo binario de doubles (MPI-IO o mmap)
+ * @author Emil M
+ * @date 2025
+ *
+ * Con un archivo de entrada cada proceso lee su tramo contiguo de valores en
+ * lugar de generarlo. Con MPI-IO los procesos leen a la vez con
+ * MPI_File_iread_at_all (lectura colectiva no bloqueante) en bloques de
+ * tamaño fijo y doble buffer: mientras se suma un bloque ya se está leyendo
+ * el siguiente. Los hints activan la lectura colectiva en dos fases, con un
+ * agregador por nodo (cb_nodes) por defecto, y se pueden ampliar con los del
+ * sistema de archivos (striping_factor, striping_unit...). Con mmap, pensado
+ * para almacenamiento local al nodo, el tramo se proyecta en memoria y se
+ * pide al núcleo que lea por adelantado el bloque siguiente.
+ *
+ * El archivo son valores nativos sin cabecera (doubles por defecto, o
+ * cualquier tipo MPI de tamaño fijo con leerValoresPorBloques); su tamaño
+ * fija el número de valores.
+ */
+
+#ifndef MPI_AVANZADO_ENTRADA_H
+#define MPI_AVANZADO_ENTRADA_H
+
+#include <mpi.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Forma de leer el archivo de entrada
+ */
+enum class ModoLectura : int32_t {
+    MpiIo, ///< MPI_File_iread_at_all colectiva con doble buffer
+    Mmap   ///< mmap del tramo con lectura anticipada (almacenamiento local)
+};
+
+/**
+ * @brief Valores por bloque de lectura (16 MiB de doubles)
+ */
+const int64_t VALORES_BLOQUE_LECTURA = int64_t(1) << 21;
+
+/**
+ * @brief Hints por defecto de la lectura con MPI-IO
+ */
+const char* const HINTS_LECTURA_POR_DEFECTO = "romio_cb_read=enable,cb_buffer_size=16777216";
+
+/**
+ * @brief Tiempos y volumen de una lectura
+ */
+struct EstadisticasLectura {
+    int64_t bytes = 0;         ///< Bytes leídos por este proceso
+    int bloques = 0;           ///< Bloques procesados
+    double tiempoEspera = 0.0; ///< Segundos bloqueado esperando datos (con mmap, todo el tiempo de lectura)
+    double tiempoTotal = 0.0;  ///< Segundos de lectura y proceso
+    bool correcta = true;      ///< false si falló la apertura o alguna lectura
+};
+
+/**
+ * @brief Número de valores del archivo
+ * @param ruta Ruta del archivo
+ * @param bytesValor Bytes de cada valor
+ * @return -1 si no se puede consultar o su tamaño no es múltiplo de bytesValor
+ */
+int64_t valoresEnArchivo(const std::string& ruta, int64_t bytesValor = sizeof(double));
+
+/**
+ * @brief Hints de MPI-IO efectivos: los por defecto, cb_nodes y los indicados
+ * @param hints Lista "clave=valor,clave=valor" que sobrescribe a las anteriores
+ * @param comm Comunicador de la lectura (operación colectiva: cuenta los nodos)
+ * @return Pares clave-valor en el orden en que se aplican
+ */
+std::vector<std::pair<std::string, std::string>> hintsLectura(const std::string& hints, MPI_Comm comm);
+
+/**
+ * @brief Lee el tramo [inicio, inicio + conteo) del archivo por bloques
+ * @param ruta Ruta del archivo, la misma en todos los procesos
+ * @param modo Forma de lectura
+ * @param inicio Índice del primer valor de este proceso
+ * @param conteo Valores de este proceso (puede ser 0)
+ * @param hints Hints adicionales de MPI-IO (ver hintsLectura)
+ * @param comm Comunicador (con MPI-IO, operación colectiva sobre él)
+ * @param procesar Función que recibe los valores en orden, en trozos de como mucho valoresBloque
+ * @param valoresBloque Valores por bloque
+ * @return Estadísticas de la lectura
+ */
+EstadisticasLectura leerPorBloques(const std::string& ruta, ModoLectura modo, int64_t inicio, int64_t conteo,
+                                   const std::string& hints, MPI_Comm comm,
+                                   const std::function<void(const double*, int64_t)>& procesar,
+                                   int64_t valoresBloque = VALORES_BLOQUE_LECTURA);
+
+/**
+ * @brief Lee por bloques el tramo [inicio, inicio + conteo) de un archivo de valores del tipo dado
+ * @param tipo Tipo MPI de cada valor (MPI_INT32_T, MPI_FLOAT...)
+ * @param procesar Recibe un puntero a los valores (del tipo indicado) y su número
+ *
+ * Los demás parámetros son los de leerPorBloques; valoresBloque sigue
+ * contando valores, no bytes.
+ */
+EstadisticasLectura leerValoresPorBloques(const std::string& ruta, ModoLectura modo, MPI_Datatype tipo,
+                                          int64_t inicio, int64_t conteo, const std::string& hints, MPI_Comm comm,
+                                          const std::function<void(const void*, int64_t)>& procesar,
+                                          int64_t valoresBloque = VALORES_BLOQUE_LECTURA);
+
+/**
+ * @brief Nombre de un modo de lectura ("mpiio" o "mmap")
+ */
+const char* nombreModoLectura(ModoLectura modo);
+
+#endif // MPI_AVANZADO_ENTRADA_H
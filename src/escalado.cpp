@@ -0,0 +1,48 @@
+/**
+ * @file escalado.cpp
+ * @brief Implementación del estudio de escalabilidad con subcomunicadores
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "escalado.h"
+
+#include <algorithm>
+
+std::vector<int> tamanosEscalado(int numProcs, int maxProcs) {
+    int tope = maxProcs > 0 ? std::min(numProcs, maxProcs) : numProcs;
+    std::vector<int> tamanos;
+    for (int p = 1; p <= tope; p *= 2) {
+        tamanos.push_back(p);
+    }
+    if (tamanos.back() != tope) {
+        tamanos.push_back(tope);
+    }
+    return tamanos;
+}
+
+MPI_Comm subcomunicadorEscalado(MPI_Comm comm, int p) {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm sub = MPI_COMM_NULL;
+    MPI_Comm_split(comm, rank < p ? 0 : MPI_UNDEFINED, rank, &sub);
+    return sub;
+}
+
+MetricasEscalado metricasEscalado(double tiempoUno, double tiempo, int p, bool debil) {
+    MetricasEscalado metricas;
+    metricas.procesos = p;
+    metricas.tiempo = tiempo;
+    if (tiempo <= 0.0) {
+        return metricas;
+    }
+    
+    // En escalado débil el trabajo total es p veces el de un proceso
+    metricas.aceleracion = (debil ? static_cast<double>(p) : 1.0) * tiempoUno / tiempo;
+    metricas.eficiencia = metricas.aceleracion / static_cast<double>(p);
+    if (p > 1) {
+        double inversaP = 1.0 / static_cast<double>(p);
+        metricas.karpFlatt = (1.0 / metricas.aceleracion - inversaP) / (1.0 - inversaP);
+    }
+    return metricas;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file escalado.h
+ * @brief Estudio de escalabilidad en un solo lanzamiento con subcomunicadores
+ * @author Emil M
+ * @date 2025
+ *
+ * En lugar de repetir mpirun con distinto -np, el estudio divide
+ * MPI_COMM_WORLD con MPI_Comm_split en subcomunicadores de 1, 2, 4, ..., P
+ * procesos (los ranks más bajos) y mide el mismo núcleo en cada uno. Con los
+ * tiempos se calculan la aceleración, la eficiencia paralela y la métrica de
+ * Karp-Flatt (fracción secuencial determinada experimentalmente).
+ */
+
+#ifndef MPI_AVANZADO_ESCALADO_H
+#define MPI_AVANZADO_ESCALADO_H
+
+#include <mpi.h>
+#include <vector>
+
+/**
+ * @brief Tamaños de subcomunicador del estudio
+ * @param numProcs Procesos disponibles
+ * @param maxProcs Tope de procesos (0 = sin tope)
+ * @return 1, 2, 4, ... hasta el tope, más el tope si no es potencia de 2
+ */
+std::vector<int> tamanosEscalado(int numProcs, int maxProcs);
+
+/**
+ * @brief Subcomunicador con los primeros p ranks de comm
+ * @param comm Comunicador original (operación colectiva sobre él)
+ * @param p Número de procesos del subcomunicador
+ * @return Subcomunicador (MPI_COMM_NULL en los ranks que no participan);
+ *         el llamante lo libera con MPI_Comm_free
+ */
+MPI_Comm subcomunicadorEscalado(MPI_Comm comm, int p);
+
+/**
+ * @brief Métricas de escalabilidad de un punto del estudio
+ */
+struct MetricasEscalado {
+    int procesos = 1;        ///< Procesos del punto
+    double tiempo = 0.0;     ///< Tiempo medido con esos procesos (μs)
+    double aceleracion = 1.0; ///< Aceleración respecto a 1 proceso
+    double eficiencia = 1.0; ///< Aceleración / procesos
+    double karpFlatt = 0.0;  ///< Fracción secuencial experimental (0 con 1 proceso)
+};
+
+/**
+ * @brief Calcula las métricas de un punto
+ * @param tiempoUno Tiempo con 1 proceso
+ * @param tiempo Tiempo con p procesos
+ * @param p Número de procesos
+ * @param debil true si el trabajo crece con p (aceleración escalada p * T1 / Tp)
+ * @return Métricas; Karp-Flatt es (1/S - 1/p) / (1 - 1/p)
+ */
+MetricasEscalado metricasEscalado(double tiempoUno, double tiempo, int p, bool debil);
+
+#endif // MPI_AVANZADO_ESCALADO_H
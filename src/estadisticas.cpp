@@ -0,0 +1,78 @@
+/**
+ * @file estadisticas.cpp
+ * @brief Implementación de las estadísticas de tiempo
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "estadisticas.h"
+
+#include <algorithm>
+#include <cmath>
+
+const char* cabeceraEstadisticas() {
+    return "TiempoPromedio(microsegundos),Minimo(microsegundos),Mediana(microsegundos),"
+           "P95(microsegundos),P99(microsegundos),Maximo(microsegundos),Desviacion(microsegundos),Muestras";
+}
+
+std::string columnasEstadisticas(const EstadisticasTiempo& estadisticas) {
+    return std::to_string(estadisticas.media) + "," +
+           std::to_string(estadisticas.minimo) + "," +
+           std::to_string(estadisticas.mediana) + "," +
+           std::to_string(estadisticas.p95) + "," +
+           std::to_string(estadisticas.p99) + "," +
+           std::to_string(estadisticas.maximo) + "," +
+           std::to_string(estadisticas.desviacion) + "," +
+           std::to_string(estadisticas.muestras);
+}
+
+double percentil(const std::vector<double>& ordenadas, double p) {
+    double posicion = p / 100.0 * static_cast<double>(ordenadas.size() - 1);
+    size_t inferior = static_cast<size_t>(posicion);
+    if (inferior + 1 >= ordenadas.size()) {
+        return ordenadas.back();
+    }
+    double fraccion = posicion - static_cast<double>(inferior);
+    return ordenadas[inferior] + fraccion * (ordenadas[inferior + 1] - ordenadas[inferior]);
+}
+
+EstadisticasTiempo calcularEstadisticas(std::vector<double> muestras) {
+    EstadisticasTiempo estadisticas;
+    if (muestras.empty()) {
+        return estadisticas;
+    }
+
+    std::sort(muestras.begin(), muestras.end());
+    size_t n = muestras.size();
+
+    double suma = 0.0;
+    for (double muestra : muestras) {
+        suma += muestra;
+    }
+    double media = suma / static_cast<double>(n);
+
+    double cuadrados = 0.0;
+    for (double muestra : muestras) {
+        cuadrados += (muestra - media) * (muestra - media);
+    }
+
+    estadisticas.muestras = static_cast<int>(n);
+    estadisticas.media = media;
+    estadisticas.minimo = muestras.front();
+    estadisticas.mediana = percentil(muestras, 50.0);
+    estadisticas.p95 = percentil(muestras, 95.0);
+    estadisticas.p99 = percentil(muestras, 99.0);
+    estadisticas.maximo = muestras.back();
+    estadisticas.desviacion = n > 1 ? std::sqrt(cuadrados / static_cast<double>(n - 1)) : 0.0;
+    return estadisticas;
+}
+
+std::vector<double> maximoPorIteracion(const std::vector<double>& locales, int root, MPI_Comm comm) {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+
+    std::vector<double> maximos(rank == root ? locales.size() : 0);
+    MPI_Reduce(locales.data(), maximos.data(), static_cast<int>(locales.size()), MPI_DOUBLE, MPI_MAX,
+               root, comm);
+    return maximos;
+}
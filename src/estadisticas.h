@@ -0,0 +1,103 @@
+/**
+ * @file estadisticas.h
+ * @brief Medición por iteración de operaciones colectivas y sus estadísticas
+ * @author Emil M
+ * @date 2025
+ *
+ * Cada iteración se cronometra por separado con MPI_Wtime en todos los
+ * procesos. La latencia de una colectiva es la del proceso más lento, así que
+ * la muestra de cada iteración es el máximo entre procesos; sobre esas
+ * muestras se calculan mínimo, media, mediana, percentiles 95/99 y desviación
+ * típica, para que la cola de latencia no quede oculta tras la media.
+ */
+
+#ifndef MPI_AVANZADO_ESTADISTICAS_H
+#define MPI_AVANZADO_ESTADISTICAS_H
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Estadísticas de una serie de muestras de tiempo (microsegundos)
+ */
+struct EstadisticasTiempo {
+    int muestras = 0;        ///< Número de iteraciones medidas
+    double media = 0.0;      ///< Media
+    double minimo = 0.0;     ///< Mínimo
+    double mediana = 0.0;    ///< Mediana (percentil 50)
+    double p95 = 0.0;        ///< Percentil 95
+    double p99 = 0.0;        ///< Percentil 99
+    double maximo = 0.0;     ///< Máximo
+    double desviacion = 0.0; ///< Desviación típica muestral
+};
+
+/**
+ * @brief Cabecera CSV de las columnas estadísticas (sin coma inicial)
+ *
+ * La primera columna es `TiempoPromedio(microsegundos)` para mantener la
+ * compatibilidad con los análisis existentes.
+ */
+const char* cabeceraEstadisticas();
+
+/**
+ * @brief Columnas CSV de unas estadísticas, en el orden de cabeceraEstadisticas()
+ */
+std::string columnasEstadisticas(const EstadisticasTiempo& estadisticas);
+
+/**
+ * @brief Percentil de una serie ordenada, con interpolación lineal
+ * @param ordenadas Muestras ordenadas de menor a mayor (no vacía)
+ * @param p Percentil en [0, 100]
+ * @return Valor del percentil
+ */
+double percentil(const std::vector<double>& ordenadas, double p);
+
+/**
+ * @brief Calcula las estadísticas de una serie de muestras
+ * @param muestras Muestras en microsegundos (se copian para ordenarlas)
+ * @return Estadísticas (todas a cero si no hay muestras)
+ */
+EstadisticasTiempo calcularEstadisticas(std::vector<double> muestras);
+
+/**
+ * @brief Reduce las muestras locales al máximo entre procesos, iteración a iteración
+ * @param locales Muestras del proceso actual (mismo número en todos los procesos)
+ * @param root Rank del proceso que recibe el resultado
+ * @param comm Comunicador
+ * @return Máximo entre procesos de cada iteración (vacío fuera de la raíz)
+ */
+std::vector<double> maximoPorIteracion(const std::vector<double>& locales, int root, MPI_Comm comm);
+
+/**
+ * @brief Mide una operación colectiva iteración a iteración
+ * @param calentamiento Iteraciones iniciales que se ejecutan pero no se miden
+ * @param iteraciones Iteraciones medidas
+ * @param comm Comunicador en el que participan todos los procesos
+ * @param operacion Función `void(int iteracion)`; recibe el índice global de la
+ *                  ejecución, de modo que los índices menores que
+ *                  `calentamiento` corresponden al calentamiento
+ * @return Estadísticas del máximo entre procesos por iteración (válidas solo
+ *         en el rank 0 de comm)
+ *
+ * Antes de cada iteración medida se sincroniza con MPI_Barrier para que todos
+ * los procesos arranquen a la vez y las iteraciones no se encadenen entre sí.
+ */
+template <typename Operacion>
+EstadisticasTiempo medirColectiva(int calentamiento, int iteraciones, MPI_Comm comm, Operacion&& operacion) {
+    for (int iteracion = 0; iteracion < calentamiento; ++iteracion) {
+        operacion(iteracion);
+    }
+
+    std::vector<double> locales(iteraciones);
+    for (int i = 0; i < iteraciones; ++i) {
+        MPI_Barrier(comm);
+        double inicio = MPI_Wtime();
+        operacion(calentamiento + i);
+        locales[i] = (MPI_Wtime() - inicio) * 1e6; // microsegundos
+    }
+
+    return calcularEstadisticas(maximoPorIteracion(locales, 0, comm));
+}
+
+#endif // MPI_AVANZADO_ESTADISTICAS_H
@@ -0,0 +1,44 @@
+/**
+ * @file gpu.cpp
+ * @brief Parte del modo GPU que no necesita CUDA: soporte de MPI y nombres de los transportes
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "gpu.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(OPEN_MPI) && OPEN_MPI
+#include <mpi-ext.h>
+#endif
+
+bool mpiAdmiteGpu() {
+    const char* valor = std::getenv(VARIABLE_MPI_GPU);
+    if (valor != nullptr && valor[0] != '\0') {
+        return std::strcmp(valor, "0") != 0;
+    }
+#if defined(MPIX_CUDA_AWARE_SUPPORT) && MPIX_CUDA_AWARE_SUPPORT
+    // Compilada con soporte: se pregunta si está activo en esta ejecución
+    return MPIX_Query_cuda_support() != 0;
+#elif defined(MPIX_ROCM_AWARE_SUPPORT) && MPIX_ROCM_AWARE_SUPPORT
+    return MPIX_Query_rocm_support() != 0;
+#else
+    return false;
+#endif
+}
+
+const char* nombreTransporteGpu(TransporteGpu transporte) {
+    switch (transporte) {
+        case TransporteGpu::Auto:
+            return "auto";
+        case TransporteGpu::Copia:
+            return "copia";
+        case TransporteGpu::MpiGpu:
+            return "mpi";
+        case TransporteGpu::Nccl:
+            return "nccl";
+    }
+    return "desconocido";
+}
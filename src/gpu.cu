@@ -0,0 +1,421 @@
+/**
+ * @file gpu.cu
+ * @brief Implementación de ContextoGpu con CUDA (o HIP) y NCCL (o RCCL) opcional
+ * @author Emil M
+ * @date 2025
+ *
+ * Solo se compila con la opción de CMake MPI_AVANZADO_GPU. Con HIP el mismo
+ * código se compila con hipcc gracias a los alias del principio.
+ */
+
+#include "gpu.h"
+#include "colectivas.h"
+
+#include <algorithm>
+
+#if defined(__HIP_PLATFORM_AMD__)
+#include <hip/hip_runtime.h>
+#define cudaError_t hipError_t
+#define cudaSuccess hipSuccess
+#define cudaStream_t hipStream_t
+#define cudaDeviceProp hipDeviceProp_t
+#define cudaGetDeviceCount hipGetDeviceCount
+#define cudaGetDeviceProperties hipGetDeviceProperties
+#define cudaSetDevice hipSetDevice
+#define cudaStreamCreate hipStreamCreate
+#define cudaStreamDestroy hipStreamDestroy
+#define cudaStreamSynchronize hipStreamSynchronize
+#define cudaMalloc hipMalloc
+#define cudaFree hipFree
+#define cudaMallocHost hipHostMalloc
+#define cudaFreeHost hipHostFree
+#define cudaMemcpyAsync hipMemcpyAsync
+#define cudaMemcpyDeviceToHost hipMemcpyDeviceToHost
+#define cudaMemcpyHostToDevice hipMemcpyHostToDevice
+#if defined(MPI_AVANZADO_NCCL)
+#include <rccl/rccl.h>
+#endif
+#else
+#include <cuda_runtime.h>
+#if defined(MPI_AVANZADO_NCCL)
+#include <nccl.h>
+#endif
+#endif
+
+namespace {
+
+/**
+ * @brief Bloques y hilos de la suma: fijos para que el orden de las sumas no dependa de la GPU
+ */
+const int BLOQUES_SUMA = 1024;
+const int HILOS_SUMA = 256;
+
+/**
+ * @brief Las mismas constantes de Philox4x32-10 que aleatorio.cpp
+ */
+__device__ const uint32_t PHILOX_M0 = 0xD2511F53u;
+__device__ const uint32_t PHILOX_M1 = 0xCD9E8D57u;
+__device__ const uint32_t PHILOX_W0 = 0x9E3779B9u;
+__device__ const uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+/**
+ * @brief Valor en [minimo, maximo) del elemento indice, idéntico a GeneradorPhilox(semilla).uniforme
+ */
+struct FuentePhilox {
+    uint32_t k0, k1;
+    uint64_t inicio;
+    double minimo, escala;
+    
+    __device__ double operator()(int64_t i) const {
+        uint64_t indice = inicio + static_cast<uint64_t>(i);
+        uint64_t contador = indice >> 1;
+        uint32_t c0 = static_cast<uint32_t>(contador);
+        uint32_t c1 = static_cast<uint32_t>(contador >> 32);
+        uint32_t c2 = 0;
+        uint32_t c3 = 0;
+        uint32_t a = k0;
+        uint32_t b = k1;
+        for (int ronda = 0; ronda < 10; ++ronda) {
+            if (ronda > 0) {
+                a += PHILOX_W0;
+                b += PHILOX_W1;
+            }
+            uint32_t hi0 = __umulhi(PHILOX_M0, c0);
+            uint32_t lo0 = PHILOX_M0 * c0;
+            uint32_t hi1 = __umulhi(PHILOX_M1, c2);
+            uint32_t lo1 = PHILOX_M1 * c2;
+            c0 = hi1 ^ c1 ^ a;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ b;
+            c3 = lo0;
+        }
+        uint64_t bits = (indice & 1) ? ((static_cast<uint64_t>(c2) << 32) | c3)
+                                     : ((static_cast<uint64_t>(c0) << 32) | c1);
+        return minimo + escala * (static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0));
+    }
+};
+
+/**
+ * @brief Valor leído de memoria del dispositivo
+ */
+struct FuenteMemoria {
+    const double* datos;
+    
+    __device__ double operator()(int64_t i) const { return datos[i]; }
+};
+
+FuentePhilox fuentePhilox(uint64_t semilla, uint64_t inicio, double minimo, double maximo) {
+    return {static_cast<uint32_t>(semilla), static_cast<uint32_t>(semilla >> 32), inicio, minimo, maximo - minimo};
+}
+
+__global__ void kernelGenerar(FuentePhilox fuente, int64_t n, double* destino) {
+    int64_t paso = static_cast<int64_t>(gridDim.x) * blockDim.x;
+    for (int64_t i = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x; i < n; i += paso) {
+        destino[i] = fuente(i);
+    }
+}
+
+/**
+ * @brief Suma en bloque de HILOS_SUMA hilos; el resultado queda en el hilo 0
+ */
+__device__ double sumarBloque(double valor) {
+    __shared__ double compartida[HILOS_SUMA];
+    compartida[threadIdx.x] = valor;
+    __syncthreads();
+    for (unsigned mitad = HILOS_SUMA / 2; mitad > 0; mitad /= 2) {
+        if (threadIdx.x < mitad) {
+            compartida[threadIdx.x] += compartida[threadIdx.x + mitad];
+        }
+        __syncthreads();
+    }
+    return compartida[0];
+}
+
+/**
+ * @brief Primer paso: cada bloque suma su tramo contiguo de valores en parciales[blockIdx.x]
+ */
+template <typename Fuente>
+__global__ void kernelSumarTramos(Fuente fuente, int64_t n, double* parciales) {
+    int64_t tramo = (n + gridDim.x - 1) / gridDim.x;
+    int64_t desde = static_cast<int64_t>(blockIdx.x) * tramo;
+    int64_t hasta = desde + tramo < n ? desde + tramo : n;
+    double suma = 0.0;
+    for (int64_t i = desde + threadIdx.x; i < hasta; i += blockDim.x) {
+        suma += fuente(i);
+    }
+    double total = sumarBloque(suma);
+    if (threadIdx.x == 0) {
+        parciales[blockIdx.x] = total;
+    }
+}
+
+/**
+ * @brief Segundo paso: un bloque suma los parciales en un orden fijo
+ */
+__global__ void kernelSumarParciales(const double* parciales, int bloques, double* suma) {
+    double parcial = 0.0;
+    for (int i = threadIdx.x; i < bloques; i += blockDim.x) {
+        parcial += parciales[i];
+    }
+    double total = sumarBloque(parcial);
+    if (threadIdx.x == 0) {
+        *suma = total;
+    }
+}
+
+int bloquesPara(int64_t n) {
+    return static_cast<int>(std::min<int64_t>(BLOQUES_SUMA, std::max<int64_t>(1, (n + HILOS_SUMA - 1) / HILOS_SUMA)));
+}
+
+cudaStream_t comoStream(void* stream) {
+    return static_cast<cudaStream_t>(stream);
+}
+
+#if defined(MPI_AVANZADO_NCCL)
+ncclComm_t comoNccl(void* nccl) {
+    return static_cast<ncclComm_t>(nccl);
+}
+#endif
+
+} // namespace
+
+ContextoGpu::ContextoGpu(MPI_Comm comm, TransporteGpu transporte) : comm_(comm) {
+    MPI_Comm_rank(comm_, &rank_);
+    
+    // GPU por rank dentro del nodo
+    MPI_Comm nodo;
+    MPI_Comm_split_type(comm_, MPI_COMM_TYPE_SHARED, rank_, MPI_INFO_NULL, &nodo);
+    int rankNodo = 0;
+    MPI_Comm_rank(nodo, &rankNodo);
+    MPI_Comm_free(&nodo);
+    
+    int numDispositivos = 0;
+    if (cudaGetDeviceCount(&numDispositivos) == cudaSuccess && numDispositivos > 0) {
+        int dispositivo = rankNodo % numDispositivos;
+        cudaDeviceProp propiedades;
+        cudaStream_t stream;
+        if (cudaSetDevice(dispositivo) == cudaSuccess &&
+            cudaGetDeviceProperties(&propiedades, dispositivo) == cudaSuccess &&
+            cudaStreamCreate(&stream) == cudaSuccess) {
+            stream_ = stream;
+            if (cudaMalloc(reinterpret_cast<void**>(&parciales_), BLOQUES_SUMA * sizeof(double)) == cudaSuccess) {
+                dispositivo_ = dispositivo;
+                nombre_ = propiedades.name;
+            }
+        }
+    }
+    
+    // El modo GPU es de todos los procesos o de ninguno, y el transporte el mismo en todos
+    int disponibles[2] = {dispositivo_ >= 0 ? 1 : 0, mpiAdmiteGpu() ? 1 : 0};
+    MPI_Allreduce(MPI_IN_PLACE, disponibles, 2, MPI_INT, MPI_LAND, comm_);
+    if (!disponibles[0]) {
+        dispositivo_ = -1;
+        return;
+    }
+    mpiGpu_ = disponibles[1] != 0;
+    
+    bool nccl = false;
+#if defined(MPI_AVANZADO_NCCL)
+    nccl = true;
+#endif
+    if (transporte == TransporteGpu::Auto) {
+        transporte = nccl ? TransporteGpu::Nccl : (mpiGpu_ ? TransporteGpu::MpiGpu : TransporteGpu::Copia);
+    }
+    if ((transporte == TransporteGpu::Nccl && !nccl) || (transporte == TransporteGpu::MpiGpu && !mpiGpu_)) {
+        transporte = TransporteGpu::Copia;
+    }
+
+#if defined(MPI_AVANZADO_NCCL)
+    // NCCL se inicializa siempre que esté, para poder compararlo en los benchmarks
+    int numProcs = 1;
+    MPI_Comm_size(comm_, &numProcs);
+    ncclUniqueId id;
+    if (rank_ == 0) {
+        ncclGetUniqueId(&id);
+    }
+    MPI_Bcast(&id, sizeof(id), MPI_BYTE, 0, comm_);
+    ncclComm_t comunicador;
+    int correcto = ncclCommInitRank(&comunicador, numProcs, id, rank_) == ncclSuccess ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &correcto, 1, MPI_INT, MPI_LAND, comm_);
+    if (correcto) {
+        nccl_ = comunicador;
+    } else if (transporte == TransporteGpu::Nccl) {
+        transporte = mpiGpu_ ? TransporteGpu::MpiGpu : TransporteGpu::Copia;
+    }
+#endif
+    transporte_ = transporte;
+}
+
+ContextoGpu::~ContextoGpu() {
+#if defined(MPI_AVANZADO_NCCL)
+    if (nccl_ != nullptr) {
+        ncclCommDestroy(comoNccl(nccl_));
+    }
+#endif
+    for (int i = 0; i < 2; ++i) {
+        if (copias_[i] != nullptr) {
+            cudaFreeHost(copias_[i]);
+        }
+    }
+    if (parciales_ != nullptr) {
+        cudaFree(parciales_);
+    }
+    if (stream_ != nullptr) {
+        cudaStreamDestroy(comoStream(stream_));
+    }
+}
+
+std::vector<TransporteGpu> ContextoGpu::transportesDisponibles() const {
+    std::vector<TransporteGpu> transportes = {TransporteGpu::Copia};
+    if (mpiGpu_) {
+        transportes.push_back(TransporteGpu::MpiGpu);
+    }
+    if (nccl_ != nullptr) {
+        transportes.push_back(TransporteGpu::Nccl);
+    }
+    return transportes;
+}
+
+double* ContextoGpu::reservar(int64_t n) {
+    double* datos = nullptr;
+    if (cudaMalloc(reinterpret_cast<void**>(&datos), std::max<int64_t>(n, 1) * sizeof(double)) != cudaSuccess) {
+        return nullptr;
+    }
+    return datos;
+}
+
+void ContextoGpu::liberar(double* datos) {
+    if (datos != nullptr) {
+        cudaFree(datos);
+    }
+}
+
+void ContextoGpu::copiarAHost(double* host, const double* dispositivo, int64_t n) {
+    cudaMemcpyAsync(host, dispositivo, n * sizeof(double), cudaMemcpyDeviceToHost, comoStream(stream_));
+    sincronizar();
+}
+
+void ContextoGpu::copiarADispositivo(double* dispositivo, const double* host, int64_t n) {
+    cudaMemcpyAsync(dispositivo, host, n * sizeof(double), cudaMemcpyHostToDevice, comoStream(stream_));
+    sincronizar();
+}
+
+void ContextoGpu::generar(uint64_t semilla, uint64_t inicio, int64_t n, double* destino,
+                          double minimo, double maximo) {
+    if (n <= 0) {
+        return;
+    }
+    kernelGenerar<<<bloquesPara(n), HILOS_SUMA, 0, comoStream(stream_)>>>(
+        fuentePhilox(semilla, inicio, minimo, maximo), n, destino);
+}
+
+void ContextoGpu::generarYSumar(uint64_t semilla, uint64_t inicio, int64_t n, double* suma,
+                                double minimo, double maximo) {
+    int bloques = bloquesPara(n);
+    kernelSumarTramos<<<bloques, HILOS_SUMA, 0, comoStream(stream_)>>>(
+        fuentePhilox(semilla, inicio, minimo, maximo), std::max<int64_t>(n, 0), parciales_);
+    kernelSumarParciales<<<1, HILOS_SUMA, 0, comoStream(stream_)>>>(parciales_, bloques, suma);
+}
+
+void ContextoGpu::sumar(const double* datos, int64_t n, double* suma) {
+    int bloques = bloquesPara(n);
+    kernelSumarTramos<<<bloques, HILOS_SUMA, 0, comoStream(stream_)>>>(
+        FuenteMemoria{datos}, std::max<int64_t>(n, 0), parciales_);
+    kernelSumarParciales<<<1, HILOS_SUMA, 0, comoStream(stream_)>>>(parciales_, bloques, suma);
+}
+
+int ContextoGpu::reduce(const double* envio, double* recepcion, int64_t count, int root,
+                        TransporteGpu transporte) {
+    if (transporte == TransporteGpu::Auto) {
+        transporte = transporte_;
+    }
+    switch (transporte) {
+#if defined(MPI_AVANZADO_NCCL)
+        case TransporteGpu::Nccl: {
+            ncclResult_t resultado = ncclReduce(envio, recepcion, static_cast<size_t>(count), ncclDouble, ncclSum,
+                                                root, comoNccl(nccl_), comoStream(stream_));
+            sincronizar();
+            return resultado == ncclSuccess ? MPI_SUCCESS : MPI_ERR_OTHER;
+        }
+#endif
+        case TransporteGpu::MpiGpu:
+            // MPI lee y escribe la memoria del dispositivo (GPUDirect si la red lo admite)
+            sincronizar();
+            return reduceGrande(envio, recepcion, count, MPI_DOUBLE, MPI_SUM, root, comm_);
+        default: {
+            double* envioHost = buffer(0, count);
+            double* recepcionHost = buffer(1, count);
+            if (!buffersListosEnTodos(envioHost != nullptr && recepcionHost != nullptr)) {
+                return MPI_ERR_NO_MEM;
+            }
+            copiarAHost(envioHost, envio, count);
+            int codigo = reduceGrande(envioHost, recepcionHost, count, MPI_DOUBLE, MPI_SUM, root, comm_);
+            if (codigo == MPI_SUCCESS && rank_ == root) {
+                copiarADispositivo(recepcion, recepcionHost, count);
+            }
+            return codigo;
+        }
+    }
+}
+
+int ContextoGpu::bcast(double* datos, int64_t count, int root, TransporteGpu transporte) {
+    if (transporte == TransporteGpu::Auto) {
+        transporte = transporte_;
+    }
+    switch (transporte) {
+#if defined(MPI_AVANZADO_NCCL)
+        case TransporteGpu::Nccl: {
+            ncclResult_t resultado = ncclBroadcast(datos, datos, static_cast<size_t>(count), ncclDouble, root,
+                                                   comoNccl(nccl_), comoStream(stream_));
+            sincronizar();
+            return resultado == ncclSuccess ? MPI_SUCCESS : MPI_ERR_OTHER;
+        }
+#endif
+        case TransporteGpu::MpiGpu:
+            sincronizar();
+            return bcastGrande(datos, count, MPI_DOUBLE, root, comm_);
+        default: {
+            double* host = buffer(0, count);
+            if (!buffersListosEnTodos(host != nullptr)) {
+                return MPI_ERR_NO_MEM;
+            }
+            if (rank_ == root) {
+                copiarAHost(host, datos, count);
+            }
+            int codigo = bcastGrande(host, count, MPI_DOUBLE, root, comm_);
+            if (codigo == MPI_SUCCESS && rank_ != root) {
+                copiarADispositivo(datos, host, count);
+            }
+            return codigo;
+        }
+    }
+}
+
+void ContextoGpu::sincronizar() {
+    cudaStreamSynchronize(comoStream(stream_));
+}
+
+double* ContextoGpu::buffer(int indice, int64_t n) {
+    if (capacidadCopias_[indice] < n) {
+        if (copias_[indice] != nullptr) {
+            cudaFreeHost(copias_[indice]);
+            copias_[indice] = nullptr;
+        }
+        // Memoria fijada: las copias van por DMA sin un buffer intermedio del controlador
+        if (cudaMallocHost(reinterpret_cast<void**>(&copias_[indice]), n * sizeof(double)) != cudaSuccess) {
+            copias_[indice] = nullptr;
+            capacidadCopias_[indice] = 0;
+            return nullptr;
+        }
+        capacidadCopias_[indice] = n;
+    }
+    return copias_[indice];
+}
+
+bool ContextoGpu::buffersListosEnTodos(bool listos) {
+    // Si un proceso abandonara solo, el resto esperaría para siempre en la colectiva
+    int local = listos ? 1 : 0;
+    int global = 0;
+    MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_LAND, comm_);
+    return global != 0;
+}
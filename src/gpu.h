@@ -0,0 +1,195 @@
+/**
+ * @file gpu.h
+ * @brief Modo GPU: generación y suma en el dispositivo y colectivas sobre memoria del dispositivo
+ * @author Emil M
+ * @date 2025
+ *
+ * Con la opción de CMake MPI_AVANZADO_GPU (CUDA, o HIP con
+ * MPI_AVANZADO_GPU_HIP) se compila ContextoGpu en gpu.cu: cada proceso usa la
+ * GPU que le corresponde en su nodo, genera los valores con el mismo Philox
+ * de aleatorio.h y los suma en el dispositivo sin pasar por la memoria del
+ * host. Las colectivas reciben punteros del dispositivo y los mueven de una
+ * de tres formas:
+ * - Copiando a un buffer del host y usando MPI sobre él (siempre disponible).
+ * - Pasando el puntero directamente a MPI si la biblioteca es consciente de
+ *   la GPU (CUDA-aware, con GPUDirect RDMA si la red lo admite).
+ * - Con NCCL (o RCCL) si se encontró al compilar.
+ *
+ * La selección del transporte y sus nombres (este archivo y gpu.cpp) se
+ * compilan siempre, para que la configuración sea la misma en todos los
+ * ejecutables; ContextoGpu solo existe si está definido MPI_AVANZADO_GPU.
+ */
+
+#ifndef MPI_AVANZADO_GPU_H
+#define MPI_AVANZADO_GPU_H
+
+#include <mpi.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Forma de mover buffers del dispositivo en una colectiva
+ */
+enum class TransporteGpu : int32_t {
+    Auto,    ///< El mejor disponible: NCCL, después MPI consciente de la GPU, después copia al host
+    Copia,   ///< cudaMemcpy a un buffer del host y MPI sobre el host
+    MpiGpu,  ///< Puntero del dispositivo directamente a MPI (CUDA-aware)
+    Nccl     ///< ncclReduce / ncclBroadcast
+};
+
+/**
+ * @brief Variable de entorno que declara que MPI admite punteros del dispositivo
+ *
+ * Solo hace falta con bibliotecas que no lo informan (Open MPI lo informa con
+ * MPIX_Query_cuda_support); "1" lo afirma y "0" lo niega.
+ */
+const char* const VARIABLE_MPI_GPU = "MPI_AVANZADO_MPI_GPU";
+
+/**
+ * @brief Indica si la biblioteca MPI acepta punteros del dispositivo
+ */
+bool mpiAdmiteGpu();
+
+/**
+ * @brief Nombre de un transporte ("auto", "copia", "mpi" o "nccl")
+ */
+const char* nombreTransporteGpu(TransporteGpu transporte);
+
+/**
+ * @brief Declarada siempre para que las firmas sean las mismas con y sin GPU
+ */
+class ContextoGpu;
+
+#if defined(MPI_AVANZADO_GPU)
+
+/**
+ * @brief GPU de un proceso y colectivas sobre su memoria
+ *
+ * Todos los punteros "del dispositivo" son memoria reservada con reservar().
+ * Las operaciones se encolan en un stream propio; las que devuelven datos al
+ * host o llaman a MPI sincronizan antes.
+ */
+class ContextoGpu {
+public:
+    /**
+     * @brief Elige la GPU local (rank en el nodo módulo número de GPU) y prepara el transporte (colectiva)
+     * @param comm Comunicador de las colectivas
+     * @param transporte Transporte pedido; si no está disponible se usa la copia al host
+     */
+    ContextoGpu(MPI_Comm comm, TransporteGpu transporte);
+    ~ContextoGpu();
+    
+    ContextoGpu(const ContextoGpu&) = delete;
+    ContextoGpu& operator=(const ContextoGpu&) = delete;
+    
+    /**
+     * @brief Indica si hay una GPU utilizable en este proceso
+     */
+    bool valido() const { return dispositivo_ >= 0; }
+    
+    /**
+     * @brief Transporte efectivo de las colectivas
+     */
+    TransporteGpu transporte() const { return transporte_; }
+    
+    /**
+     * @brief Transportes disponibles en este proceso, de menor a mayor preferencia
+     */
+    std::vector<TransporteGpu> transportesDisponibles() const;
+    
+    /**
+     * @brief Nombre de la GPU elegida
+     */
+    const std::string& nombreDispositivo() const { return nombre_; }
+    
+    /**
+     * @brief Reserva n doubles en el dispositivo
+     * @return nullptr si no hay memoria
+     */
+    double* reservar(int64_t n);
+    
+    /**
+     * @brief Libera memoria obtenida con reservar()
+     */
+    void liberar(double* datos);
+    
+    /**
+     * @brief Copia n doubles del dispositivo al host (sincroniza)
+     */
+    void copiarAHost(double* host, const double* dispositivo, int64_t n);
+    
+    /**
+     * @brief Copia n doubles del host al dispositivo (sincroniza)
+     */
+    void copiarADispositivo(double* dispositivo, const double* host, int64_t n);
+    
+    /**
+     * @brief Genera en el dispositivo los n valores de GeneradorPhilox(semilla) desde el índice inicio
+     */
+    void generar(uint64_t semilla, uint64_t inicio, int64_t n, double* destino,
+                 double minimo = 0.0, double maximo = 100.0);
+    
+    /**
+     * @brief Genera y suma los valores sin guardarlos; la suma queda en suma (del dispositivo)
+     *
+     * La suma es determinista: cada bloque suma un tramo fijo y los parciales
+     * se combinan en orden en un segundo paso.
+     */
+    void generarYSumar(uint64_t semilla, uint64_t inicio, int64_t n, double* suma,
+                       double minimo = 0.0, double maximo = 100.0);
+    
+    /**
+     * @brief Suma n valores del dispositivo; la suma queda en suma (del dispositivo)
+     */
+    void sumar(const double* datos, int64_t n, double* suma);
+    
+    /**
+     * @brief MPI_Reduce con MPI_SUM de buffers del dispositivo
+     * @param envio Buffer del dispositivo con count doubles
+     * @param recepcion Buffer del dispositivo para el resultado (solo significativo en la raíz)
+     * @param transporte Transporte de esta llamada (Auto = el del contexto)
+     * @return Código de error MPI (o MPI_ERR_OTHER si falla NCCL)
+     */
+    int reduce(const double* envio, double* recepcion, int64_t count, int root,
+               TransporteGpu transporte = TransporteGpu::Auto);
+    
+    /**
+     * @brief MPI_Bcast de un buffer del dispositivo
+     * @return Código de error MPI (o MPI_ERR_OTHER si falla NCCL)
+     */
+    int bcast(double* buffer, int64_t count, int root, TransporteGpu transporte = TransporteGpu::Auto);
+    
+    /**
+     * @brief Espera a que termine el trabajo encolado en el dispositivo
+     */
+    void sincronizar();
+
+private:
+    /**
+     * @brief Buffer del host para el transporte por copia (crece según haga falta)
+     */
+    double* buffer(int indice, int64_t n);
+    
+    /**
+     * @brief Acuerda entre todos los procesos si los buffers del host están listos
+     * @return false en todos los procesos si alguno no pudo reservarlos
+     */
+    bool buffersListosEnTodos(bool listos);
+    
+    MPI_Comm comm_;
+    int rank_ = 0;
+    int dispositivo_ = -1;
+    std::string nombre_;
+    TransporteGpu transporte_ = TransporteGpu::Copia;
+    bool mpiGpu_ = false;
+    void* stream_ = nullptr;      ///< cudaStream_t / hipStream_t
+    void* nccl_ = nullptr;        ///< ncclComm_t (nullptr = sin NCCL)
+    double* parciales_ = nullptr; ///< Sumas por bloque del dispositivo
+    double* copias_[2] = {nullptr, nullptr}; ///< Buffers fijados del host para el transporte por copia
+    int64_t capacidadCopias_[2] = {0, 0};
+};
+
+#endif // MPI_AVANZADO_GPU
+
+#endif // MPI_AVANZADO_GPU_H
@@ -0,0 +1,122 @@
+/**
+ * @file hilos.cpp
+ * @brief Implementación del pool de hilos del modo híbrido
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "hilos.h"
+
+#include <mpi.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+PoolHilos::PoolHilos(int numHilos) : numHilos_(numHilos < 1 ? 1 : numHilos) {
+    for (int hilo = 1; hilo < numHilos_; ++hilo) {
+        trabajadores_.emplace_back(&PoolHilos::bucleTrabajador, this, hilo);
+    }
+}
+
+PoolHilos::~PoolHilos() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        terminar_ = true;
+    }
+    hayTarea_.notify_all();
+    for (auto& trabajador : trabajadores_) {
+        trabajador.join();
+    }
+}
+
+void PoolHilos::ejecutar(const std::function<void(int)>& tarea) {
+    if (numHilos_ == 1) {
+        tarea(0);
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tarea_ = &tarea;
+        pendientes_ = numHilos_ - 1;
+        ++generacion_;
+    }
+    hayTarea_.notify_all();
+    
+    // El hilo llamante actúa como hilo 0
+    tarea(0);
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    tareaTerminada_.wait(lock, [this] { return pendientes_ == 0; });
+    tarea_ = nullptr;
+}
+
+void PoolHilos::bucleTrabajador(int hilo) {
+    uint64_t vista = 0;
+    while (true) {
+        const std::function<void(int)>* tarea = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            hayTarea_.wait(lock, [this, vista] { return terminar_ || generacion_ != vista; });
+            if (terminar_) {
+                return;
+            }
+            vista = generacion_;
+            tarea = tarea_;
+        }
+        
+        (*tarea)(hilo);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --pendientes_;
+        }
+        tareaTerminada_.notify_one();
+    }
+}
+
+int leerNumHilos() {
+    const char* valor = std::getenv(VARIABLE_HILOS);
+    if (valor == nullptr) {
+        return 1;
+    }
+    
+    int numHilos = std::atoi(valor);
+    if (numHilos == 0) {
+        numHilos = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    return numHilos > 0 ? numHilos : 1;
+}
+
+bool inicializarMPIFunneled(int* argc, char*** argv) {
+    // Solo el hilo principal llama a MPI; los demás hilos solo calculan
+    int provisto = MPI_THREAD_SINGLE;
+    MPI_Init_thread(argc, argv, MPI_THREAD_FUNNELED, &provisto);
+    return provisto >= MPI_THREAD_FUNNELED;
+}
+
+void inicializarMPIHibrido(int* argc, char*** argv, int& numHilos) {
+    if (numHilos <= 1) {
+        MPI_Init(argc, argv);
+        numHilos = 1;
+        return;
+    }
+    
+    if (!inicializarMPIFunneled(argc, argv)) {
+        int rank = 0;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        if (rank == 0) {
+            std::cerr << "Advertencia: la biblioteca MPI no soporta MPI_THREAD_FUNNELED; "
+                      << "se usará un solo hilo por proceso." << std::endl;
+        }
+        numHilos = 1;
+    }
+}
+
+std::pair<int64_t, int64_t> rangoHilo(int64_t N, int hilo, int numHilos) {
+    int64_t base = N / numHilos;
+    int64_t resto = N % numHilos;
+    int64_t inicio = hilo * base + std::min<int64_t>(hilo, resto);
+    int64_t fin = inicio + base + (hilo < resto ? 1 : 0);
+    return {inicio, fin};
+}
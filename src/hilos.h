@@ -0,0 +1,108 @@
+/**
+ * @file hilos.h
+ * @brief Pool de hilos para el modo híbrido MPI + hilos
+ * @author Emil M
+ * @date 2025
+ * 
+ * En el modo híbrido se lanza un proceso MPI por socket o dominio NUMA y cada
+ * proceso reparte la generación de datos y las sumas parciales entre varios
+ * hilos. Solo el hilo principal realiza llamadas MPI (MPI_THREAD_FUNNELED).
+ */
+
+#ifndef MPI_AVANZADO_HILOS_H
+#define MPI_AVANZADO_HILOS_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Variable de entorno con el número de hilos por proceso
+ *
+ * Un valor de 0 usa todos los núcleos disponibles para el proceso.
+ */
+const char* const VARIABLE_HILOS = "MPI_AVANZADO_HILOS";
+
+/**
+ * @brief Pool de hilos persistente que ejecuta una tarea en todos sus hilos
+ *
+ * El hilo que llama a ejecutar() participa como hilo 0, de modo que un pool
+ * de un solo hilo no crea ningún hilo adicional.
+ */
+class PoolHilos {
+public:
+    /**
+     * @brief Crea el pool
+     * @param numHilos Número total de hilos (incluyendo el hilo llamante)
+     */
+    explicit PoolHilos(int numHilos);
+    ~PoolHilos();
+    
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+    
+    /**
+     * @brief Número total de hilos del pool
+     */
+    int numHilos() const { return numHilos_; }
+    
+    /**
+     * @brief Ejecuta tarea(hilo) en cada hilo del pool y espera a que terminen
+     * @param tarea Función que recibe el índice del hilo en [0, numHilos)
+     */
+    void ejecutar(const std::function<void(int)>& tarea);
+
+private:
+    void bucleTrabajador(int hilo);
+    
+    int numHilos_;
+    std::vector<std::thread> trabajadores_;
+    std::mutex mutex_;
+    std::condition_variable hayTarea_;
+    std::condition_variable tareaTerminada_;
+    const std::function<void(int)>* tarea_ = nullptr;
+    uint64_t generacion_ = 0;
+    int pendientes_ = 0;
+    bool terminar_ = false;
+};
+
+/**
+ * @brief Lee el número de hilos por proceso de la variable de entorno
+ * @return Número de hilos (1 si la variable no está definida o no es válida)
+ */
+int leerNumHilos();
+
+/**
+ * @brief Inicializa MPI solicitando siempre MPI_THREAD_FUNNELED
+ * @param argc Puntero al número de argumentos
+ * @param argv Puntero a los argumentos
+ * @return true si la biblioteca MPI ofrece MPI_THREAD_FUNNELED
+ *
+ * Se usa cuando el número de hilos solo se conoce después de inicializar MPI
+ * (por ejemplo, cuando lo indica un argumento leído en la raíz).
+ */
+bool inicializarMPIFunneled(int* argc, char*** argv);
+
+/**
+ * @brief Inicializa MPI solicitando soporte de hilos si se usan varios hilos
+ * @param argc Puntero al número de argumentos
+ * @param argv Puntero a los argumentos
+ * @param numHilos Número de hilos deseado; se reduce a 1 si la biblioteca MPI
+ *                 no ofrece MPI_THREAD_FUNNELED
+ */
+void inicializarMPIHibrido(int* argc, char*** argv, int& numHilos);
+
+/**
+ * @brief Calcula el rango [inicio, fin) que corresponde a un hilo
+ * @param N Número total de elementos
+ * @param hilo Índice del hilo
+ * @param numHilos Número total de hilos
+ * @return Par (inicio, fin); los restos se reparten entre los primeros hilos
+ */
+std::pair<int64_t, int64_t> rangoHilo(int64_t N, int hilo, int numHilos);
+
+#endif // MPI_AVANZADO_HILOS_H
@@ -0,0 +1,151 @@
+/**
+ * @file jerarquia.cpp
+ * @brief Implementación de las colectivas jerárquicas
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "jerarquia.h"
+
+#include "colectivas.h"
+
+ComunicadorJerarquico::ComunicadorJerarquico(MPI_Comm comm, int ranksPorNodo) {
+    MPI_Comm_rank(comm, &rankOriginal_);
+    
+    // Ordenar por el rank original hace que el rank 0 sea el líder 0
+    if (ranksPorNodo > 0) {
+        MPI_Comm_split(comm, rankOriginal_ / ranksPorNodo, rankOriginal_, &nodo_);
+    } else {
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rankOriginal_, MPI_INFO_NULL, &nodo_);
+    }
+    
+    int rankNodo = 0;
+    MPI_Comm_rank(nodo_, &rankNodo);
+    MPI_Comm_split(comm, rankNodo == 0 ? 0 : MPI_UNDEFINED, rankOriginal_, &lideres_);
+    
+    // Solo los líderes conocen el número de nodos; se difunde dentro del nodo
+    if (lideres_ != MPI_COMM_NULL) {
+        MPI_Comm_size(lideres_, &numNodos_);
+    }
+    MPI_Bcast(&numNodos_, 1, MPI_INT, 0, nodo_);
+}
+
+ComunicadorJerarquico::~ComunicadorJerarquico() {
+    if (lideres_ != MPI_COMM_NULL) {
+        MPI_Comm_free(&lideres_);
+    }
+    if (nodo_ != MPI_COMM_NULL) {
+        MPI_Comm_free(&nodo_);
+    }
+}
+
+int ComunicadorJerarquico::reduce(const void* sendbuf, void* recvbuf, int64_t count,
+                                  MPI_Datatype datatype, MPI_Op op) {
+    // Nivel 1: reducir dentro del nodo hacia el líder
+    void* resultadoNodo = nullptr;
+    if (esLider()) {
+        if (rankOriginal_ == 0) {
+            resultadoNodo = recvbuf;
+        } else {
+            MPI_Aint lowerBound = 0;
+            MPI_Aint extent = 0;
+            MPI_Type_get_extent(datatype, &lowerBound, &extent);
+            temporal_.resize(static_cast<size_t>(count * extent));
+            resultadoNodo = temporal_.data();
+        }
+    }
+    // MPI_IN_PLACE solo es válido en la raíz del nodo si el resultado va a recvbuf
+    const void* origen = (sendbuf == MPI_IN_PLACE && resultadoNodo != recvbuf) ? recvbuf : sendbuf;
+    int error = reduceGrande(origen, resultadoNodo, count, datatype, op, 0, nodo_);
+    if (error != MPI_SUCCESS || !esLider()) {
+        return error;
+    }
+    
+    // Nivel 2: reducir entre los líderes hacia la raíz
+    if (numNodos_ == 1) {
+        return MPI_SUCCESS;
+    }
+    if (rankOriginal_ == 0) {
+        return reduceGrande(MPI_IN_PLACE, recvbuf, count, datatype, op, 0, lideres_);
+    }
+    return reduceGrande(resultadoNodo, nullptr, count, datatype, op, 0, lideres_);
+}
+
+int ComunicadorJerarquico::bcast(void* buffer, int64_t count, MPI_Datatype datatype) {
+    // Nivel 1: entre líderes; nivel 2: cada líder dentro de su nodo
+    if (esLider() && numNodos_ > 1) {
+        int error = bcastGrande(buffer, count, datatype, 0, lideres_);
+        if (error != MPI_SUCCESS) {
+            return error;
+        }
+    }
+    return bcastGrande(buffer, count, datatype, 0, nodo_);
+}
+
+int ComunicadorJerarquico::allreduce(const void* sendbuf, void* recvbuf, int64_t count,
+                                     MPI_Datatype datatype, MPI_Op op) {
+    // Reducir dentro del nodo directamente en recvbuf del líder
+    const void* origen = sendbuf;
+    if (sendbuf == MPI_IN_PLACE && !esLider()) {
+        origen = recvbuf;
+    }
+    int error = reduceGrande(origen, esLider() ? recvbuf : nullptr, count, datatype, op, 0, nodo_);
+    if (error != MPI_SUCCESS) {
+        return error;
+    }
+    
+    if (esLider() && numNodos_ > 1) {
+        error = allreduceGrande(MPI_IN_PLACE, recvbuf, count, datatype, op, lideres_);
+        if (error != MPI_SUCCESS) {
+            return error;
+        }
+    }
+    return bcastGrande(recvbuf, count, datatype, 0, nodo_);
+}
+
+BufferNodoCompartido::BufferNodoCompartido(const ComunicadorJerarquico& jerarquico, int64_t bytes)
+    : jerarquico_(jerarquico), bytes_(bytes) {
+    MPI_Aint tamanoLocal = jerarquico_.esLider() ? static_cast<MPI_Aint>(bytes_) : 0;
+    void* local = nullptr;
+    MPI_Win_allocate_shared(tamanoLocal, 1, MPI_INFO_NULL, jerarquico_.nodo(), &local, &ventana_);
+    
+    // La memoria del nodo es la del líder (rank 0 del comunicador de nodo)
+    MPI_Aint tamanoLider = 0;
+    int unidad = 0;
+    MPI_Win_shared_query(ventana_, 0, &tamanoLider, &unidad, &datos_);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, ventana_);
+}
+
+BufferNodoCompartido::~BufferNodoCompartido() {
+    if (ventana_ != MPI_WIN_NULL) {
+        MPI_Win_unlock_all(ventana_);
+        MPI_Win_free(&ventana_);
+    }
+}
+
+int BufferNodoCompartido::esperarLectores() {
+    MPI_Win_sync(ventana_);
+    return MPI_Barrier(jerarquico_.nodo());
+}
+
+int BufferNodoCompartido::difundir(int64_t count, MPI_Datatype datatype) {
+    // Nadie del nodo sigue leyendo la difusión anterior
+    int error = esperarLectores();
+    if (error != MPI_SUCCESS) {
+        return error;
+    }
+    
+    // Solo los líderes reciben, directamente en la memoria compartida
+    if (jerarquico_.esLider() && jerarquico_.numNodos() > 1) {
+        error = bcastGrande(datos_, count, datatype, 0, jerarquico_.lideres());
+        if (error != MPI_SUCCESS) {
+            return error;
+        }
+    }
+    
+    // Publicar las escrituras del líder y hacerlas visibles al resto del nodo
+    MPI_Win_sync(ventana_);
+    error = MPI_Barrier(jerarquico_.nodo());
+    MPI_Win_sync(ventana_);
+    return error;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file jerarquia.h
+ * @brief Colectivas jerárquicas en dos niveles (dentro del nodo y entre nodos)
+ * @author Emil M
+ * @date 2025
+ *
+ * El comunicador se divide por nodo con MPI_Comm_split_type
+ * (MPI_COMM_TYPE_SHARED). Las reducciones se hacen primero dentro del nodo,
+ * donde la biblioteca MPI usa memoria compartida, y después solo entre un
+ * líder por nodo; los broadcasts siguen el camino inverso. Así el tráfico
+ * entre nodos pasa de P mensajes a uno por nodo.
+ *
+ * BufferNodoCompartido va un paso más allá para los broadcasts: el buffer es
+ * una ventana MPI_Win_allocate_shared de la que solo el líder tiene memoria,
+ * de modo que cada nodo recibe una única copia y el resto de sus procesos la
+ * leen en su sitio.
+ */
+
+#ifndef MPI_AVANZADO_JERARQUIA_H
+#define MPI_AVANZADO_JERARQUIA_H
+
+#include <mpi.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Comunicadores de nodo y de líderes derivados de un comunicador
+ *
+ * El líder de cada nodo es su proceso de menor rank, por lo que el rank 0
+ * del comunicador original es siempre el líder 0 y actúa como raíz.
+ */
+class ComunicadorJerarquico {
+public:
+    /**
+     * @brief Crea los comunicadores (operación colectiva sobre comm)
+     * @param comm Comunicador original
+     * @param ranksPorNodo Si es mayor que 0, agrupa los ranks consecutivos en
+     *                     nodos de ese tamaño en lugar de usar la memoria
+     *                     compartida real (para emular varios nodos en uno)
+     */
+    explicit ComunicadorJerarquico(MPI_Comm comm, int ranksPorNodo = 0);
+    ~ComunicadorJerarquico();
+    
+    ComunicadorJerarquico(const ComunicadorJerarquico&) = delete;
+    ComunicadorJerarquico& operator=(const ComunicadorJerarquico&) = delete;
+    
+    /**
+     * @brief Comunicador con los procesos del mismo nodo
+     */
+    MPI_Comm nodo() const { return nodo_; }
+    
+    /**
+     * @brief Comunicador de los líderes (MPI_COMM_NULL fuera de los líderes)
+     */
+    MPI_Comm lideres() const { return lideres_; }
+    
+    /**
+     * @brief Indica si el proceso es el líder de su nodo
+     */
+    bool esLider() const { return lideres_ != MPI_COMM_NULL; }
+    
+    /**
+     * @brief Número de nodos
+     */
+    int numNodos() const { return numNodos_; }
+    
+    /**
+     * @brief Reducción jerárquica hacia el rank 0 del comunicador original
+     * @param sendbuf Buffer con los datos locales (o MPI_IN_PLACE en la raíz)
+     * @param recvbuf Buffer de resultado (solo significativo en la raíz)
+     * @param count Número de elementos
+     * @param datatype Tipo de dato de cada elemento
+     * @param op Operación de reducción (debe ser conmutativa)
+     * @return Código de error MPI
+     */
+    int reduce(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype, MPI_Op op);
+    
+    /**
+     * @brief Broadcast jerárquico desde el rank 0 del comunicador original
+     * @param buffer Buffer a distribuir
+     * @param count Número de elementos
+     * @param datatype Tipo de dato de cada elemento
+     * @return Código de error MPI
+     */
+    int bcast(void* buffer, int64_t count, MPI_Datatype datatype);
+    
+    /**
+     * @brief Reducción jerárquica con el resultado en todos los procesos
+     * @param sendbuf Buffer con los datos locales (o MPI_IN_PLACE)
+     * @param recvbuf Buffer de resultado en todos los procesos
+     * @param count Número de elementos
+     * @param datatype Tipo de dato de cada elemento
+     * @param op Operación de reducción (debe ser conmutativa)
+     * @return Código de error MPI
+     */
+    int allreduce(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype, MPI_Op op);
+
+private:
+    MPI_Comm nodo_ = MPI_COMM_NULL;
+    MPI_Comm lideres_ = MPI_COMM_NULL;
+    int rankOriginal_ = 0;
+    int numNodos_ = 1;
+    std::vector<char> temporal_; ///< Resultado del nodo en los líderes que no son la raíz
+};
+
+/**
+ * @brief Buffer en memoria compartida del nodo para broadcasts sin copias
+ *
+ * Solo el líder de cada nodo reserva memoria en la ventana; los demás
+ * procesos obtienen un puntero a ella con MPI_Win_shared_query. La ventana
+ * permanece en una época de acceso pasivo (MPI_Win_lock_all) durante toda su
+ * vida y la visibilidad se garantiza con MPI_Win_sync más una barrera del
+ * nodo. Con ranksPorNodo > 0 cada nodo emulado debe caber en un nodo real.
+ */
+class BufferNodoCompartido {
+public:
+    /**
+     * @brief Reserva la ventana (operación colectiva sobre el comunicador original)
+     * @param jerarquico Comunicadores de nodo y de líderes (debe sobrevivir al buffer)
+     * @param bytes Capacidad en bytes
+     */
+    BufferNodoCompartido(const ComunicadorJerarquico& jerarquico, int64_t bytes);
+    ~BufferNodoCompartido();
+    
+    BufferNodoCompartido(const BufferNodoCompartido&) = delete;
+    BufferNodoCompartido& operator=(const BufferNodoCompartido&) = delete;
+    
+    /**
+     * @brief Inicio de la copia del nodo (el mismo buffer en todos sus procesos)
+     *
+     * El rank 0 del comunicador original escribe aquí los datos entre
+     * esperarLectores() y difundir(); el resto solo debe leerlos tras difundir().
+     */
+    void* datos() const { return datos_; }
+    
+    /**
+     * @brief Espera a que el nodo termine de leer la difusión anterior
+     * @return Código de error MPI
+     *
+     * Colectiva sobre el nodo; obligatoria antes de que el rank 0 vuelva a
+     * escribir en datos() si otros procesos pueden seguir leyéndolos.
+     */
+    int esperarLectores();
+    
+    /**
+     * @brief Capacidad en bytes
+     */
+    int64_t bytes() const { return bytes_; }
+    
+    /**
+     * @brief Difunde el contenido del rank 0 a la copia de cada nodo
+     * @param count Número de elementos
+     * @param datatype Tipo de dato de cada elemento
+     * @return Código de error MPI
+     *
+     * Los líderes esperan a que su nodo haya terminado de leer la difusión
+     * anterior antes de sobrescribirla, así que dos difusiones seguidas del
+     * mismo contenido no necesitan más sincronización.
+     */
+    int difundir(int64_t count, MPI_Datatype datatype);
+
+private:
+    const ComunicadorJerarquico& jerarquico_;
+    MPI_Win ventana_ = MPI_WIN_NULL;
+    void* datos_ = nullptr;
+    int64_t bytes_ = 0;
+};
+
+#endif // MPI_AVANZADO_JERARQUIA_H
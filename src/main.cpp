@@ -1,192 +1,1186 @@
-/**
- * @file main.cpp
- * @brief Programa MPI para calcular el promedio de valores aleatorios usando comunicaciones colectivas
- * @author Emil M
- * @date 2025
- * 
- * Este programa demuestra el uso de las siguientes operaciones colectivas de MPI:
- * - MPI_Bcast: Para distribuir el tamaño N a todos los procesos
- * - MPI_Reduce: Para sumar todas las contribuciones parciales
- * - MPI_Bcast: Para distribuir el promedio final a todos los procesos
- */
-
-#include <mpi.h>
-#include <iostream>
-#include <vector>
-#include <random>
-#include <chrono>
-#include <iomanip>
-
-/**
- * @brief Genera N valores aleatorios y calcula su suma
- * @param N Número de valores a generar
- * @param rank Rank del proceso actual
- * @return Vector con los valores generados
- */
-std::vector<double> generarValoresAleatorios(int N, int rank) {
-    std::vector<double> valores(N);
-    
-    // Usar una semilla diferente para cada proceso para evitar correlación
-    std::mt19937 generador(rank + 42);
-    std::uniform_real_distribution<double> distribucion(0.0, 100.0);
-    
-    for (int i = 0; i < N; ++i) {
-        valores[i] = distribucion(generador);
-    }
-    
-    return valores;
-}
-
-/**
- * @brief Calcula la suma de los valores en un vector
- * @param valores Vector de valores
- * @return Suma de todos los valores
- */
-double calcularSumaParcial(const std::vector<double>& valores) {
-    double suma = 0.0;
-    for (double valor : valores) {
-        suma += valor;
-    }
-    return suma;
-}
-
-/**
- * @brief Imprime información del proceso
- * @param rank Rank del proceso
- * @param valores Vector de valores generados
- * @param sumaParcial Suma parcial calculada
- */
-void imprimirInfoProceso(int rank, const std::vector<double>& valores, double sumaParcial) {
-    std::cout << "Proceso " << rank << ":" << std::endl;
-    std::cout << "  - Valores generados: ";
-    
-    // Mostrar solo los primeros 5 valores para no saturar la salida
-    int maxMostrar = std::min(5, static_cast<int>(valores.size()));
-    for (int i = 0; i < maxMostrar; ++i) {
-        std::cout << std::fixed << std::setprecision(2) << valores[i];
-        if (i < maxMostrar - 1) std::cout << ", ";
-    }
-    if (valores.size() > maxMostrar) {
-        std::cout << ", ... (y " << (valores.size() - maxMostrar) << " más)";
-    }
-    std::cout << std::endl;
-    std::cout << "  - Suma parcial: " << std::fixed << std::setprecision(2) << sumaParcial << std::endl;
-    std::cout << std::endl;
-}
-
-int main(int argc, char** argv) {
-    // Inicialización MPI
-    MPI_Init(&argc, &argv);
-    
-    int rank, numProcs;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
-    
-    // Variables para el cálculo
-    int N = 0;
-    double sumaParcial = 0.0;
-    double sumaTotal = 0.0;
-    double promedioFinal = 0.0;
-    
-    // Punto de sincronización 1: Todos los procesos esperan aquí
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    // Paso 1: El proceso raíz solicita N al usuario y lo distribuye con MPI_Bcast
-    if (rank == 0) {
-        std::cout << "=== PROGRAMA MPI: CÁLCULO DE PROMEDIO CON COMUNICACIONES COLECTIVAS ===" << std::endl;
-        std::cout << "Número total de procesos: " << numProcs << std::endl;
-        std::cout << "Ingrese el número de valores por proceso (N): ";
-        std::cin >> N;
-        
-        if (N <= 0) {
-            std::cerr << "Error: N debe ser un número positivo." << std::endl;
-            MPI_Abort(MPI_COMM_WORLD, 1);
-        }
-        
-        std::cout << "Proceso raíz (rank 0) distribuyendo N = " << N << " a todos los procesos..." << std::endl;
-    }
-    
-    // MPI_Bcast: Distribuye N desde el proceso raíz a todos los procesos
-    // Punto de sincronización 2: Todos los procesos deben llegar aquí antes de continuar
-    MPI_Bcast(&N, 1, MPI_INT, 0, MPI_COMM_WORLD);
-    
-    // Paso 2: Cada proceso genera N valores aleatorios y calcula su suma parcial
-    double inicioGeneracion = MPI_Wtime();
-    
-    std::vector<double> valores = generarValoresAleatorios(N, rank);
-    sumaParcial = calcularSumaParcial(valores);
-    
-    double finGeneracion = MPI_Wtime();
-    double duracionGeneracion = (finGeneracion - inicioGeneracion) * 1e6; // microsegundos
-    
-    // Imprimir información de cada proceso en orden
-    for (int i = 0; i < numProcs; ++i) {
-        if (rank == i) {
-            imprimirInfoProceso(rank, valores, sumaParcial);
-        }
-        MPI_Barrier(MPI_COMM_WORLD);
-    }
-    
-    // Punto de sincronización 3: Todos los procesos esperan aquí antes de la reducción
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    // Paso 3: MPI_Reduce para sumar todas las contribuciones parciales en el proceso raíz
-    double inicioReduccion = MPI_Wtime();
-    
-    // MPI_Reduce: Suma todas las contribuciones parciales en el proceso raíz
-    // Punto de sincronización 4: Todos los procesos deben participar en la reducción
-    MPI_Reduce(&sumaParcial, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-    
-    double finReduccion = MPI_Wtime();
-    double duracionReduccion = (finReduccion - inicioReduccion) * 1e6; // microsegundos
-    
-    // Paso 4: El proceso raíz calcula el promedio total
-    if (rank == 0) {
-        promedioFinal = sumaTotal / (N * numProcs);
-        std::cout << "=== RESULTADOS EN EL PROCESO RAÍZ ===" << std::endl;
-        std::cout << "Suma total de todos los procesos: " << std::fixed << std::setprecision(2) << sumaTotal << std::endl;
-        std::cout << "Número total de valores: " << (N * numProcs) << std::endl;
-        std::cout << "Promedio calculado: " << std::fixed << std::setprecision(4) << promedioFinal << std::endl;
-        std::cout << "Tiempo de reducción: " << std::fixed << std::setprecision(2) << duracionReduccion << " microsegundos" << std::endl;
-        std::cout << std::endl;
-    }
-    
-    // Paso 5: MPI_Bcast para distribuir el promedio a todos los procesos
-    double inicioBroadcast = MPI_Wtime();
-    
-    // MPI_Bcast: Distribuye el promedio desde el proceso raíz a todos los procesos
-    // Punto de sincronización 5: Todos los procesos deben participar en el broadcast
-    MPI_Bcast(&promedioFinal, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-    
-    double finBroadcast = MPI_Wtime();
-    double duracionBroadcast = (finBroadcast - inicioBroadcast) * 1e6; // microsegundos
-    
-    // Paso 6: Cada proceso imprime el promedio recibido en orden
-    for (int i = 0; i < numProcs; ++i) {
-        if (rank == i) {
-            std::cout << "Proceso " << rank << " recibió el promedio final: " 
-                      << std::fixed << std::setprecision(4) << promedioFinal << std::endl;
-            std::cout << "Tiempo de broadcast: " << std::fixed << std::setprecision(2) 
-                      << duracionBroadcast << " microsegundos" << std::endl;
-        }
-        MPI_Barrier(MPI_COMM_WORLD);
-    }
-    
-    // Punto de sincronización final: Todos los procesos esperan aquí antes de finalizar
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    if (rank == 0) {
-        std::cout << std::endl;
-        std::cout << "=== RESUMEN DE TIEMPOS ===" << std::endl;
-        std::cout << "Tiempo de generación de datos: " << std::fixed << std::setprecision(2) << duracionGeneracion << " microsegundos" << std::endl;
-        std::cout << "Tiempo de reducción: " << std::fixed << std::setprecision(2) << duracionReduccion << " microsegundos" << std::endl;
-        std::cout << "Tiempo de broadcast final: " << std::fixed << std::setprecision(2) << duracionBroadcast << " microsegundos" << std::endl;
-        std::cout << std::endl;
-        std::cout << "=== PROGRAMA COMPLETADO EXITOSAMENTE ===" << std::endl;
-    }
-    
-    // Finalización MPI
-    MPI_Finalize();
-    
-    return 0;
-} 
\ No newline at end of file
+/**
+ * @file main.cpp
+ * @brief Programa MPI para calcular el promedio de valores aleatorios usando comunicaciones colectivas
+ * @author Emil M
+ * @date 2025
+ * 
+ * Este programa demuestra el uso de las siguientes operaciones colectivas de MPI:
+ * - MPI_Bcast: Para distribuir el tamaño N a todos los procesos
+ * - MPI_Reduce: Para sumar todas las contribuciones parciales
+ * - MPI_Bcast: Para distribuir el promedio final a todos los procesos
+ */
+
+#include <mpi.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <cmath>
+#include <type_traits>
+
+#include "ajuste.h"
+#include "aleatorio.h"
+#include "colectivas.h"
+#include "configuracion.h"
+#include "entrada.h"
+#include "gpu.h"
+#include "hilos.h"
+#include "jerarquia.h"
+#include "persistente.h"
+#include "puntocontrol.h"
+#include "reductor.h"
+#include "reparto.h"
+#include "resiliencia.h"
+#include "resumen.h"
+#include "solapamiento.h"
+#include "suma.h"
+
+/**
+ * @brief Tamaño del bloque de generación en modo streaming (8192 doubles = 64 KB)
+ *
+ * Se elige para que el bloque quepa en la caché L2 y se reutilice en cada
+ * iteración, de modo que la memoria pico sea O(bloque) e independiente de N.
+ */
+const int TAMANO_BLOQUE = 8192;
+
+/**
+ * @brief Resultado de la generación y suma en modo streaming
+ */
+struct ResultadoStreaming {
+    SumaCompensada sumaParcial;          ///< Suma de todos los valores generados
+    ResumenValores resumen;              ///< Cuenta, media, M2, mínimo y máximo (si se pidió)
+    std::vector<double> primerosValores; ///< Primeros valores generados (solo para mostrar)
+    int64_t sumaEntera = 0;              ///< Suma exacta de los valores enteros (--tipo-entrada int32/int64)
+};
+
+/**
+ * @brief Genera un bloque de valores aleatorios reutilizando el buffer dado
+ * @param bloque Buffer de destino (se rellenan sus primeros `cantidad` elementos)
+ * @param indiceGlobal Índice global del primer valor del bloque
+ * @param cantidad Número de valores a generar
+ * @param generador Generador basado en contador
+ */
+void generarBloque(std::vector<double>& bloque, int64_t indiceGlobal, int64_t cantidad,
+                   const GeneradorPhilox& generador) {
+    generador.generar(static_cast<uint64_t>(indiceGlobal), cantidad, bloque.data(), 0.0, 100.0);
+}
+
+/**
+ * @brief Acumula la suma de los primeros `cantidad` valores de un bloque
+ * @param acumulado Suma parcial a la que se añade el bloque
+ * @param bloque Buffer con los valores
+ * @param cantidad Número de valores válidos en el bloque
+ * @param modo Modo de suma (rápida o compensada)
+ */
+void calcularSumaParcial(SumaCompensada& acumulado, const double* bloque, int64_t cantidad, ModoSuma modo) {
+    if (modo == ModoSuma::Compensada) {
+        acumularCompensado(acumulado, sumarCompensado(bloque, cantidad));
+    } else {
+        acumulado.suma += sumarRapido(bloque, cantidad);
+    }
+}
+
+/**
+ * @brief Genera N valores aleatorios por bloques y acumula su suma en una sola pasada
+ * @param inicioGlobal Índice global del primer valor a generar
+ * @param N Número de valores a generar
+ * @param generador Generador basado en contador
+ * @param maxMostrar Número de valores iniciales a conservar para mostrarlos
+ * @param modo Modo de suma
+ * @param resumir Si es true, también resume cada bloque mientras está en caché
+ * @return Suma parcial y primeros valores generados
+ *
+ * Produce exactamente la misma secuencia que generar el vector completo, pero
+ * sin materializarlo: cada bloque se genera, se acumula y se sobrescribe.
+ */
+ResultadoStreaming generarYSumarStreaming(int64_t inicioGlobal, int64_t N, const GeneradorPhilox& generador,
+                                          int maxMostrar, ModoSuma modo, bool resumir) {
+    ResultadoStreaming resultado;
+    std::vector<double> bloque(std::min<int64_t>(N, TAMANO_BLOQUE));
+    
+    for (int64_t inicio = 0; inicio < N; inicio += TAMANO_BLOQUE) {
+        int64_t cantidad = std::min<int64_t>(TAMANO_BLOQUE, N - inicio);
+        generarBloque(bloque, inicioGlobal + inicio, cantidad, generador);
+        
+        if (inicio == 0) {
+            int64_t cuantos = std::min<int64_t>(maxMostrar, cantidad);
+            resultado.primerosValores.assign(bloque.begin(), bloque.begin() + cuantos);
+        }
+        
+        calcularSumaParcial(resultado.sumaParcial, bloque.data(), cantidad, modo);
+        if (resumir) {
+            combinarResumen(resultado.resumen, resumirValores(bloque.data(), cantidad));
+        }
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Reparte la generación y la suma parcial entre los hilos del pool
+ * @param inicioGlobal Índice global del primer valor a generar
+ * @param N Número de valores a generar
+ * @param pool Pool de hilos del proceso
+ * @param maxMostrar Número de valores iniciales a conservar para mostrarlos
+ * @param modo Modo de suma
+ * @param semilla Semilla del generador
+ * @param resumir Si es true, también calcula el resumen estadístico del proceso
+ * @return Suma parcial del proceso y primeros valores generados
+ *
+ * Cada hilo genera en streaming su tramo contiguo de [inicioGlobal,
+ * inicioGlobal + N) saltando directamente a su índice. Como cada valor depende solo de su índice global, el conjunto de
+ * datos es el mismo sin importar cómo se reparta entre procesos e hilos. Las
+ * sumas de los hilos se combinan siempre en el mismo orden para que el
+ * resultado sea determinista.
+ */
+ResultadoStreaming generarYSumarHibrido(int64_t inicioGlobal, int64_t N, PoolHilos& pool,
+                                        int maxMostrar, ModoSuma modo, uint64_t semilla, bool resumir) {
+    std::vector<ResultadoStreaming> porHilo(pool.numHilos());
+    GeneradorPhilox generador(semilla);
+    
+    pool.ejecutar([&](int hilo) {
+        std::pair<int64_t, int64_t> rango = rangoHilo(N, hilo, pool.numHilos());
+        porHilo[hilo] = generarYSumarStreaming(inicioGlobal + rango.first, rango.second - rango.first,
+                                               generador, hilo == 0 ? maxMostrar : 0, modo, resumir);
+    });
+    
+    ResultadoStreaming resultado;
+    resultado.primerosValores = std::move(porHilo[0].primerosValores);
+    for (const ResultadoStreaming& parcial : porHilo) {
+        acumularCompensado(resultado.sumaParcial, parcial.sumaParcial);
+        combinarResumen(resultado.resumen, parcial.resumen);
+    }
+    return resultado;
+}
+
+/**
+ * @brief Número máximo de valores generados que se muestran por proceso
+ */
+const int MAX_MOSTRAR = 5;
+
+/**
+ * @brief Diagnóstico de un proceso, recogido en la raíz con un único MPI_Gather
+ *
+ * Solo contiene doubles para poder enviarse como un bloque de MPI_DOUBLE.
+ */
+struct DiagnosticoProceso {
+    double sumaParcial = 0.0;           ///< Suma parcial del proceso
+    double primerosValores[MAX_MOSTRAR] = {};  ///< Primeros valores generados
+    double numPrimeros = 0.0;           ///< Número de valores válidos en primerosValores
+    double promedioRecibido = 0.0;      ///< Promedio final recibido
+    double duracionGeneracion = 0.0;    ///< Tiempo de generación (μs)
+    double duracionBroadcast = 0.0;     ///< Tiempo del broadcast final (μs)
+};
+
+const int DOUBLES_DIAGNOSTICO = sizeof(DiagnosticoProceso) / sizeof(double);
+static_assert(sizeof(DiagnosticoProceso) == DOUBLES_DIAGNOSTICO * sizeof(double),
+              "DiagnosticoProceso debe contener solo doubles");
+
+/**
+ * @brief Recoge el diagnóstico de todos los procesos en la raíz
+ * @param local Diagnóstico del proceso actual
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return Diagnósticos ordenados por rank (vacío fuera de la raíz)
+ *
+ * Una sola colectiva sustituye a los bucles de impresión ordenada con
+ * MPI_Barrier, que costaban O(P) rondas de sincronización.
+ */
+std::vector<DiagnosticoProceso> recogerDiagnosticos(const DiagnosticoProceso& local, int rank, int numProcs) {
+    std::vector<DiagnosticoProceso> todos(rank == 0 ? numProcs : 0);
+    MPI_Gather(&local, DOUBLES_DIAGNOSTICO, MPI_DOUBLE,
+               todos.data(), DOUBLES_DIAGNOSTICO, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    return todos;
+}
+
+/**
+ * @brief Imprime información del proceso
+ * @param rank Rank del proceso
+ * @param N Número total de valores generados por el proceso
+ * @param diagnostico Diagnóstico recogido del proceso
+ */
+void imprimirInfoProceso(int rank, int64_t N, const DiagnosticoProceso& diagnostico) {
+    std::cout << "Proceso " << rank << ":" << std::endl;
+    std::cout << "  - Valores generados: ";
+    
+    // Mostrar solo los primeros valores para no saturar la salida
+    int maxMostrar = static_cast<int>(diagnostico.numPrimeros);
+    for (int i = 0; i < maxMostrar; ++i) {
+        std::cout << std::fixed << std::setprecision(2) << diagnostico.primerosValores[i];
+        if (i < maxMostrar - 1) std::cout << ", ";
+    }
+    if (N > maxMostrar) {
+        std::cout << ", ... (y " << (N - maxMostrar) << " más)";
+    }
+    std::cout << std::endl;
+    std::cout << "  - Suma parcial: " << std::fixed << std::setprecision(2) << diagnostico.sumaParcial << std::endl;
+    std::cout << "  - Tiempo de generación: " << std::fixed << std::setprecision(2)
+              << diagnostico.duracionGeneracion << " microsegundos" << std::endl;
+    std::cout << "  - Promedio final recibido: " << std::fixed << std::setprecision(4)
+              << diagnostico.promedioRecibido << std::endl;
+    std::cout << "  - Tiempo de broadcast: " << std::fixed << std::setprecision(2)
+              << diagnostico.duracionBroadcast << " microsegundos" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Resultado de una ejecución del cálculo (generación, reducción y broadcast)
+ */
+struct ResultadoEjecucion {
+    double sumaTotal = 0.0;          ///< Suma global (válida en la raíz o en todos)
+    double promedioFinal = 0.0;      ///< Promedio recibido por el proceso
+    double duracionGeneracion = 0.0; ///< Tiempo de generación (μs)
+    double duracionReduccion = 0.0;  ///< Tiempo de reducción (μs)
+    double duracionBroadcast = 0.0;  ///< Tiempo del broadcast final (μs)
+    ResumenValores resumen;          ///< Resumen global (solo con --resumen)
+    double duracionPuntoControl = 0.0; ///< Tiempo escribiendo puntos de control (μs)
+    int64_t valoresReanudados = 0;   ///< Valores recuperados del punto de control (solo con --reanudar)
+    int64_t valoresIncluidos = 0;    ///< Valores de la suma (solo con --plazo)
+    std::vector<int> procesosPerdidos; ///< Procesos excluidos en esta ejecución (solo con --plazo)
+    int64_t bytesLeidos = 0;         ///< Bytes leídos del archivo de entrada (solo con --entrada)
+    double duracionEsperaLectura = 0.0; ///< Tiempo bloqueado esperando la lectura (μs)
+    bool lecturaCorrecta = true;     ///< false si falló la lectura del archivo de entrada
+    DiagnosticoProceso diagnostico;  ///< Diagnóstico del proceso
+};
+
+/**
+ * @brief Reducción y difusión de la suma preparadas una vez para todas las ejecuciones (--persistente)
+ *
+ * Las peticiones persistentes fijan sus buffers: cada ejecución copia su suma
+ * parcial en envio, reinicia las colectivas y lee el resultado de recepcion
+ * y promedio. No se mueve una vez preparada.
+ */
+struct ColectivasPersistentes {
+    SumaCompensada envio;           ///< Suma parcial del proceso
+    SumaCompensada recepcion;       ///< Suma global (en la raíz o en todos)
+    double promedio = 0.0;          ///< Promedio difundido desde la raíz
+    std::unique_ptr<ColectivaPersistente> reduccion;
+    std::unique_ptr<ColectivaPersistente> difusion; ///< Solo con reduce-bcast
+};
+
+/**
+ * @brief Prepara la reducción de la suma y, con reduce-bcast, la difusión del promedio (colectiva)
+ * @param config Configuración distribuida desde la raíz (estrategia reduce-bcast o allreduce)
+ * @return Colectivas preparadas sobre MPI_COMM_WORLD
+ */
+std::unique_ptr<ColectivasPersistentes> prepararColectivasPersistentes(const Configuracion& config) {
+    std::unique_ptr<ColectivasPersistentes> colectivas(new ColectivasPersistentes);
+    void* envio = &colectivas->envio;
+    void* recepcion = &colectivas->recepcion;
+    MPI_Datatype tipo = tipoSumaCompensada();
+    MPI_Op op = opSumaCompensada();
+    if (config.modoSuma != ModoSuma::Compensada) {
+        envio = &colectivas->envio.suma;
+        recepcion = &colectivas->recepcion.suma;
+        tipo = MPI_DOUBLE;
+        op = MPI_SUM;
+    }
+    
+    if (config.estrategia == EstrategiaColectiva::Allreduce) {
+        colectivas->reduccion.reset(new ColectivaPersistente(
+            ColectivaPersistente::allreduce(envio, recepcion, 1, tipo, op, MPI_COMM_WORLD)));
+    } else {
+        colectivas->reduccion.reset(new ColectivaPersistente(
+            ColectivaPersistente::reduce(envio, recepcion, 1, tipo, op, 0, MPI_COMM_WORLD)));
+        colectivas->difusion.reset(new ColectivaPersistente(
+            ColectivaPersistente::bcast(&colectivas->promedio, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD)));
+    }
+    return colectivas;
+}
+
+/**
+ * @brief Genera y suma los valores del proceso por tramos con un punto de control tras cada uno
+ * @param config Configuración distribuida desde la raíz
+ * @param pool Pool de hilos del proceso
+ * @param rank Rank del proceso actual
+ * @param reparto Elementos globales de cada proceso
+ * @param tramos Tramos en que se divide la generación (iguales en todos los procesos)
+ * @param reanudar Si es true se continúa desde el último punto de control común
+ * @param puntoControl Archivo de puntos de control
+ * @param resultado Recibe el tiempo de los puntos de control y los valores recuperados
+ * @return Suma (y resumen) de todos los valores del proceso
+ *
+ * Guardar y cargar son colectivas: todos los procesos hacen el mismo número
+ * de tramos aunque tengan conteos distintos.
+ */
+ResultadoStreaming generarConPuntosControl(const Configuracion& config, PoolHilos& pool, int rank,
+                                           const RepartoCarga& reparto, int tramos, bool reanudar,
+                                           PuntoControl& puntoControl, ResultadoEjecucion& resultado) {
+    const int64_t N = reparto.conteos[rank];
+    const int64_t inicioProceso = reparto.desplazamientos[rank];
+    double tiempoPrevio = puntoControl.tiempo();
+    
+    EstadoPuntoControl estado;
+    estado.semilla = config.semilla;
+    estado.procesos = static_cast<int32_t>(reparto.conteos.size());
+    estado.tramos = tramos;
+    estado.inicioGlobal = inicioProceso;
+    estado.conteo = N;
+    estado.conResumen = config.resumen != 0 ? 1 : 0;
+    estado.modoSuma = static_cast<int32_t>(config.modoSuma);
+    if (reanudar) {
+        if (puntoControl.cargar(estado)) {
+            resultado.valoresReanudados = estado.procesados;
+        } else if (puntoControl.descartadoPorIdentidad() && rank == 0) {
+            std::cerr << "Aviso: se ignora el punto de control '" << config.puntoControl
+                      << "': es de otra ejecución (procesos, N, semilla, --resumen o --suma distintos)."
+                      << " Se empieza desde el principio." << std::endl;
+        }
+    }
+    
+    // El generador está basado en contador: continuar es generar a partir del
+    // índice inicioProceso + procesados con la suma guardada
+    ResultadoStreaming generados;
+    generados.sumaParcial = estado.suma;
+    generados.resumen = estado.resumen;
+    for (int tramo = estado.tramo; tramo < tramos; ++tramo) {
+        std::pair<int64_t, int64_t> rango = rangoHilo(N, tramo, tramos);
+        ResultadoStreaming parcial = generarYSumarHibrido(inicioProceso + rango.first, rango.second - rango.first,
+                                                          pool, tramo == 0 ? MAX_MOSTRAR : 0, config.modoSuma,
+                                                          config.semilla, config.resumen != 0);
+        acumularCompensado(generados.sumaParcial, parcial.sumaParcial);
+        combinarResumen(generados.resumen, parcial.resumen);
+        if (tramo == 0) {
+            generados.primerosValores = std::move(parcial.primerosValores);
+        }
+        
+        // Tras el último tramo viene la reducción: no hace falta guardarlo
+        if (tramo + 1 < tramos) {
+            estado.tramo = tramo + 1;
+            estado.procesados = rango.second;
+            estado.suma = generados.sumaParcial;
+            estado.resumen = generados.resumen;
+            puntoControl.guardar(estado);
+        }
+    }
+    
+    resultado.duracionPuntoControl = (puntoControl.tiempo() - tiempoPrevio) * 1e6; // microsegundos
+    return generados;
+}
+
+/**
+ * @brief Lee y suma el tramo del proceso del archivo de entrada
+ * @param config Configuración distribuida desde la raíz
+ * @param rank Rank del proceso actual
+ * @param reparto Elementos globales de cada proceso
+ * @param resultado Recibe los bytes leídos, la espera y si la lectura fue correcta
+ * @return Suma (y resumen) de los valores leídos
+ *
+ * La suma se hace en el hilo que lee, bloque a bloque mientras llega el
+ * siguiente; el pool de hilos no interviene.
+ */
+ResultadoStreaming leerYSumarEntrada(const Configuracion& config, int rank, const RepartoCarga& reparto,
+                                     ResultadoEjecucion& resultado) {
+    ResultadoStreaming leidos;
+    EstadisticasLectura estadisticas;
+    
+    // El tipo se elige una vez aquí; dentro, la suma es Reductor<T, OpSuma>
+    // especializado al compilar
+    conTipoDato(config.tipoEntrada, [&](auto muestra) {
+        using T = decltype(muestra);
+        using Suma = Reductor<T, OpSuma>;
+        estadisticas = leerValoresPorBloques(
+            config.entrada, config.lectura, Suma::tipoMpi(), reparto.desplazamientos[rank], reparto.conteos[rank],
+            config.hintsIo, MPI_COMM_WORLD, [&](const void* crudos, int64_t cantidad) {
+                const T* valores = static_cast<const T*>(crudos);
+                int64_t cuantos = std::min<int64_t>(
+                    MAX_MOSTRAR - static_cast<int64_t>(leidos.primerosValores.size()), cantidad);
+                leidos.primerosValores.insert(leidos.primerosValores.end(), valores, valores + cuantos);
+                if constexpr (std::is_integral<T>::value) {
+                    leidos.sumaEntera += Suma::local(valores, cantidad);
+                } else if constexpr (std::is_same<T, float>::value) {
+                    acumularCompensado(leidos.sumaParcial, SumaCompensada{Suma::local(valores, cantidad), 0.0});
+                } else {
+                    calcularSumaParcial(leidos.sumaParcial, valores, cantidad, config.modoSuma);
+                    if (config.resumen) {
+                        combinarResumen(leidos.resumen, resumirValores(valores, cantidad));
+                    }
+                }
+            });
+    });
+    if (config.tipoEntrada == TipoDato::Int32 || config.tipoEntrada == TipoDato::Int64) {
+        leidos.sumaParcial = SumaCompensada{static_cast<double>(leidos.sumaEntera), 0.0};
+    }
+    resultado.bytesLeidos = estadisticas.bytes;
+    resultado.duracionEsperaLectura = estadisticas.tiempoEspera * 1e6; // microsegundos
+    resultado.lecturaCorrecta = estadisticas.correcta;
+    return leidos;
+}
+
+#if defined(MPI_AVANZADO_GPU)
+/**
+ * @brief Genera y suma en la GPU los valores del proceso
+ * @param gpu GPU del proceso
+ * @param inicioGlobal Índice global del primer valor
+ * @param N Número de valores
+ * @param semilla Semilla del generador
+ * @param sumaDispositivo Recibe la suma parcial (memoria del dispositivo)
+ * @param primerosDispositivo Buffer del dispositivo de MAX_MOSTRAR valores
+ * @return Suma parcial del proceso (copiada al host) y primeros valores
+ *
+ * Los valores son los mismos que los de GeneradorPhilox en el host; solo
+ * viajan al host la suma y los primeros valores que se muestran.
+ */
+ResultadoStreaming generarYSumarGpu(ContextoGpu& gpu, int64_t inicioGlobal, int64_t N, uint64_t semilla,
+                                    double* sumaDispositivo, double* primerosDispositivo) {
+    ResultadoStreaming resultado;
+    int64_t cuantos = std::min<int64_t>(MAX_MOSTRAR, N);
+    gpu.generarYSumar(semilla, inicioGlobal, N, sumaDispositivo);
+    gpu.generar(semilla, inicioGlobal, cuantos, primerosDispositivo);
+    
+    double suma = 0.0;
+    resultado.primerosValores.resize(cuantos);
+    gpu.copiarAHost(resultado.primerosValores.data(), primerosDispositivo, cuantos);
+    gpu.copiarAHost(&suma, sumaDispositivo, 1);
+    resultado.sumaParcial = SumaCompensada{suma, 0.0};
+    return resultado;
+}
+#endif
+
+/**
+ * @brief Ejecuta una vez el cálculo distribuido del promedio
+ * @param config Configuración distribuida desde la raíz
+ * @param pool Pool de hilos del proceso
+ * @param rank Rank del proceso actual
+ * @param reparto Elementos globales de cada proceso
+ * @param jerarquico Comunicador jerárquico (nullptr = colectivas planas)
+ * @param resiliente Reducción con plazo (nullptr = colectivas bloqueantes)
+ * @param puntoControl Archivo de puntos de control (nullptr = sin puntos de control)
+ * @param reanudar Si es true la generación continúa desde el último punto de control
+ * @param gpu GPU del proceso (nullptr = generación, suma y colectivas en el host)
+ * @param persistentes Colectivas preparadas antes de la primera ejecución (nullptr = se llaman en cada una)
+ * @return Resultado y tiempos de la ejecución
+ */
+ResultadoEjecucion ejecutarCalculo(const Configuracion& config, PoolHilos& pool, int rank,
+                                   const RepartoCarga& reparto, ComunicadorJerarquico* jerarquico,
+                                   ReduccionResiliente* resiliente, PuntoControl* puntoControl, bool reanudar,
+                                   [[maybe_unused]] ContextoGpu* gpu, ColectivasPersistentes* persistentes) {
+    ResultadoEjecucion resultado;
+    const int64_t N = reparto.conteos[rank];
+    const int segmentos = config.segmentos;
+    const ModoSuma modoSuma = config.modoSuma;
+    const bool resultadoEnTodos = (config.estrategia != EstrategiaColectiva::ReduceBcast) || resiliente != nullptr;
+    const bool entero = config.entrada[0] != '\0' &&
+                        (config.tipoEntrada == TipoDato::Int32 || config.tipoEntrada == TipoDato::Int64);
+    SumaCompensada sumaParcial;
+    SumaCompensada sumaGlobal;
+    int64_t sumaEnteraGlobal = 0;
+    
+    // Paso 2: Cada proceso genera sus N valores aleatorios y calcula su suma
+    // parcial en streaming: bloque a bloque, sin guardar el vector completo en
+    // memoria, repartiendo el trabajo entre los hilos del proceso. El proceso
+    // genera los elementos globales que le asigna el reparto (por defecto
+    // [rank * N, (rank + 1) * N))
+    double inicioGeneracion = MPI_Wtime();
+    int64_t inicioProceso = reparto.desplazamientos[rank];
+    
+    ResultadoStreaming generados;
+    ReduccionSolapada reduccionSolapada(segmentos, modoSuma, 0, MPI_COMM_WORLD, resultadoEnTodos);
+    
+#if defined(MPI_AVANZADO_GPU)
+    // Con --gpu la suma parcial, la global y el promedio viven en el
+    // dispositivo: [0] parcial, [1] global o promedio, [2...] primeros valores
+    double* dispositivo = nullptr;
+    if (gpu != nullptr) {
+        dispositivo = gpu->reservar(2 + MAX_MOSTRAR);
+    }
+#endif
+    
+    if (segmentos > 0) {
+        // Modo solapado: publicar la reducción de cada segmento terminado
+        // mientras se calcula el siguiente
+        for (int segmento = 0; segmento < segmentos; ++segmento) {
+            std::pair<int64_t, int64_t> rango = rangoHilo(N, segmento, segmentos);
+            ResultadoStreaming parcial = generarYSumarHibrido(inicioProceso + rango.first,
+                                                              rango.second - rango.first, pool,
+                                                              segmento == 0 ? MAX_MOSTRAR : 0, modoSuma,
+                                                              config.semilla, false);
+            reduccionSolapada.publicar(segmento, parcial.sumaParcial);
+            
+            acumularCompensado(generados.sumaParcial, parcial.sumaParcial);
+            if (segmento == 0) {
+                generados.primerosValores = std::move(parcial.primerosValores);
+            }
+        }
+#if defined(MPI_AVANZADO_GPU)
+    } else if (gpu != nullptr) {
+        generados = generarYSumarGpu(*gpu, inicioProceso, N, config.semilla, dispositivo, dispositivo + 2);
+#endif
+    } else if (config.entrada[0] != '\0') {
+        // Los valores se leen del archivo en lugar de generarse
+        generados = leerYSumarEntrada(config, rank, reparto, resultado);
+    } else if (puntoControl != nullptr) {
+        // Tantos tramos como hagan falta para que ningún proceso sume más de
+        // puntoControlCada valores sin guardar
+        int64_t maximo = *std::max_element(reparto.conteos.begin(), reparto.conteos.end());
+        int tramos = static_cast<int>(std::max<int64_t>(1, (maximo + config.puntoControlCada - 1) /
+                                                            config.puntoControlCada));
+        generados = generarConPuntosControl(config, pool, rank, reparto, tramos, reanudar, *puntoControl, resultado);
+    } else {
+        generados = generarYSumarHibrido(inicioProceso, N, pool, MAX_MOSTRAR, modoSuma, config.semilla,
+                                         config.resumen != 0);
+    }
+    sumaParcial = generados.sumaParcial;
+    
+    // Los puntos de control se informan aparte del tiempo de generación
+    double finGeneracion = MPI_Wtime();
+    resultado.duracionGeneracion = (finGeneracion - inicioGeneracion) * 1e6 - resultado.duracionPuntoControl;
+    
+    // El diagnóstico por proceso se guarda ahora y se recoge al final, fuera
+    // del camino crítico
+    DiagnosticoProceso& diagnostico = resultado.diagnostico;
+    diagnostico.sumaParcial = sumaParcial.total();
+    diagnostico.numPrimeros = static_cast<double>(generados.primerosValores.size());
+    std::copy(generados.primerosValores.begin(), generados.primerosValores.end(), diagnostico.primerosValores);
+    diagnostico.duracionGeneracion = resultado.duracionGeneracion;
+    
+    // Paso 3: MPI_Reduce para sumar todas las contribuciones parciales en el proceso raíz
+    // (o MPI_Allreduce / reduce-scatter + allgather para obtenerla en todos los procesos)
+    double inicioReduccion = MPI_Wtime();
+    
+    // MPI_Reduce: Suma todas las contribuciones parciales en el proceso raíz
+    // Punto de sincronización 4: Todos los procesos deben participar en la reducción
+    // En modo compensado se reduce el par doble-doble para no perder la corrección.
+    // En modo solapado las reducciones ya están en curso y solo se espera a que terminen.
+    // Con --resumen se reduce el resumen completo en lugar de la suma
+    if (segmentos > 0) {
+        sumaGlobal = reduccionSolapada.esperar();
+#if defined(MPI_AVANZADO_GPU)
+    } else if (gpu != nullptr) {
+        // Punteros del dispositivo directamente a la colectiva (MPI consciente
+        // de la GPU o NCCL) o copia al host, según el transporte
+        gpu->reduce(dispositivo, dispositivo + 1, 1, 0);
+        if (rank == 0) {
+            gpu->copiarAHost(&sumaGlobal.suma, dispositivo + 1, 1);
+        }
+#endif
+    } else if (resiliente != nullptr) {
+        // Los procesos que no llegan dentro del plazo se excluyen y la suma
+        // queda en todos los supervivientes, sin broadcast posterior
+        ResultadoResiliente reducido = resiliente->reducir(sumaParcial.total(), N);
+        sumaGlobal = SumaCompensada{reducido.suma, 0.0};
+        resultado.valoresIncluidos = reducido.cuenta;
+        resultado.procesosPerdidos = reducido.procesosPerdidos;
+    } else {
+        void* envio = &sumaParcial;
+        void* recepcion = &sumaGlobal;
+        MPI_Datatype tipo = MPI_DOUBLE;
+        MPI_Op op = MPI_SUM;
+        
+        if (config.resumen) {
+            envio = &generados.resumen;
+            recepcion = &resultado.resumen;
+            tipo = tipoResumenValores();
+            op = opResumenValores();
+        } else if (entero) {
+            // Los enteros se reducen exactos en int64
+            envio = &generados.sumaEntera;
+            recepcion = &sumaEnteraGlobal;
+            tipo = Reductor<int64_t, OpSuma>::tipoMpi();
+            op = Reductor<int64_t, OpSuma>::opMpi();
+        } else if (modoSuma == ModoSuma::Compensada) {
+            tipo = tipoSumaCompensada();
+            op = opSumaCompensada();
+        } else {
+            sumaParcial = SumaCompensada{sumaParcial.total(), 0.0};
+            envio = &sumaParcial.suma;
+            recepcion = &sumaGlobal.suma;
+        }
+        
+        if (jerarquico != nullptr) {
+            // Dentro del nodo primero y después solo entre líderes
+            if (resultadoEnTodos) {
+                jerarquico->allreduce(envio, recepcion, 1, tipo, op);
+            } else {
+                jerarquico->reduce(envio, recepcion, 1, tipo, op);
+            }
+        } else if (persistentes != nullptr) {
+            // Misma reducción que en la ejecución anterior: solo se reinicia
+            persistentes->envio = sumaParcial;
+            persistentes->reduccion->ejecutar();
+            sumaGlobal = persistentes->recepcion;
+        } else if (resultadoEnTodos) {
+            reducirEnTodos(envio, recepcion, 1, tipo, op, MPI_COMM_WORLD, config.estrategia);
+        } else {
+            reduceAjustado(envio, recepcion, 1, tipo, op, 0, MPI_COMM_WORLD);
+        }
+    }
+    resultado.sumaTotal = config.resumen ? resultado.resumen.suma()
+                        : entero ? static_cast<double>(sumaEnteraGlobal) : sumaGlobal.total();
+    
+    double finReduccion = MPI_Wtime();
+    resultado.duracionReduccion = (finReduccion - inicioReduccion) * 1e6; // microsegundos
+    
+    // Paso 4: El proceso raíz calcula el promedio total
+    // El total es la suma exacta de los conteos del reparto (en 64 bits); el
+    // resumen ya trae la cuenta real y la media
+    int64_t totalValores = reparto.total();
+    if (resiliente != nullptr) {
+        resultado.promedioFinal = resultado.valoresIncluidos > 0
+            ? resultado.sumaTotal / static_cast<double>(resultado.valoresIncluidos) : 0.0;
+    } else if (config.resumen && (rank == 0 || resultadoEnTodos)) {
+        resultado.promedioFinal = resultado.resumen.media;
+    } else if (entero && (rank == 0 || resultadoEnTodos)) {
+        // Cociente y resto exactos: la suma puede superar 2^53
+        int64_t cociente = sumaEnteraGlobal / totalValores;
+        int64_t resto = sumaEnteraGlobal % totalValores;
+        resultado.promedioFinal = static_cast<double>(cociente) +
+                                  static_cast<double>(resto) / static_cast<double>(totalValores);
+    } else if (rank == 0 || resultadoEnTodos) {
+        resultado.promedioFinal = resultado.sumaTotal / static_cast<double>(totalValores);
+    }
+    
+    // Paso 5: MPI_Bcast para distribuir el promedio a todos los procesos
+    // (innecesario si la estrategia ya dejó la suma en todos los procesos)
+    double inicioBroadcast = MPI_Wtime();
+    
+    // MPI_Bcast: Distribuye el promedio desde el proceso raíz a todos los procesos
+    // Punto de sincronización 5: Todos los procesos deben participar en el broadcast
+    if (!resultadoEnTodos && jerarquico != nullptr) {
+        jerarquico->bcast(&resultado.promedioFinal, 1, MPI_DOUBLE);
+#if defined(MPI_AVANZADO_GPU)
+    } else if (gpu != nullptr) {
+        if (rank == 0) {
+            gpu->copiarADispositivo(dispositivo + 1, &resultado.promedioFinal, 1);
+        }
+        gpu->bcast(dispositivo + 1, 1, 0);
+        gpu->copiarAHost(&resultado.promedioFinal, dispositivo + 1, 1);
+#endif
+    } else if (!resultadoEnTodos && persistentes != nullptr) {
+        persistentes->promedio = resultado.promedioFinal;
+        persistentes->difusion->ejecutar();
+        resultado.promedioFinal = persistentes->promedio;
+    } else if (!resultadoEnTodos) {
+        bcastAjustado(&resultado.promedioFinal, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    }
+    
+    double finBroadcast = MPI_Wtime();
+    resultado.duracionBroadcast = (finBroadcast - inicioBroadcast) * 1e6; // microsegundos
+    
+    diagnostico.promedioRecibido = resultado.promedioFinal;
+    diagnostico.duracionBroadcast = resultado.duracionBroadcast;
+#if defined(MPI_AVANZADO_GPU)
+    if (gpu != nullptr) {
+        gpu->liberar(dispositivo);
+    }
+#endif
+    return resultado;
+}
+
+/**
+ * @brief Imprime el resultado en formato CSV o JSON (una sola fila / objeto)
+ * @param config Configuración de la ejecución
+ * @param numProcs Número total de procesos
+ * @param resultado Resultado de la última ejecución
+ * @param tiempos Tiempos medios de generación, reducción, broadcast, puntos de control y espera de E/S (μs)
+ */
+void imprimirResultadoEstructurado(const Configuracion& config, int numProcs, const ResultadoEjecucion& resultado,
+                                   const double tiempos[5]) {
+    const int64_t totalValores = config.nTotal > 0 ? config.nTotal : config.N * static_cast<int64_t>(numProcs);
+    if (config.formato == FormatoSalida::Csv) {
+        std::cout << "NumProcesos,NumHilos,N,NTotal,Iteraciones,Semilla,Suma,Estrategia,Segmentos,"
+                  << "Promedio,TiempoGeneracion(microsegundos),TiempoReduccion(microsegundos),"
+                  << "TiempoBroadcast(microsegundos)" << (config.resumen ? ",Minimo,Maximo,Varianza" : "")
+                  << (config.puntoControl[0] != '\0' ? ",TiempoPuntoControl(microsegundos)" : "")
+                  << (config.entrada[0] != '\0' ? ",BytesLeidos,TiempoEsperaLectura(microsegundos)" : "") << std::endl;
+        std::cout << numProcs << "," << config.numHilos << "," << config.N << "," << totalValores << ","
+                  << config.iteraciones << ","
+                  << config.semilla << "," << nombreModoSuma(config.modoSuma) << ","
+                  << nombreEstrategia(config.estrategia) << "," << config.segmentos << ","
+                  << std::setprecision(17) << resultado.promedioFinal << std::fixed << std::setprecision(2)
+                  << "," << tiempos[0] << "," << tiempos[1] << "," << tiempos[2];
+        if (config.resumen) {
+            std::cout << std::defaultfloat << std::setprecision(17) << "," << resultado.resumen.minimo
+                      << "," << resultado.resumen.maximo
+                      << "," << resultado.resumen.varianza();
+        }
+        if (config.puntoControl[0] != '\0') {
+            std::cout << std::fixed << std::setprecision(2) << "," << tiempos[3];
+        }
+        if (config.entrada[0] != '\0') {
+            std::cout << "," << totalValores * bytesTipoDato(config.tipoEntrada) << std::fixed
+                      << std::setprecision(2) << "," << tiempos[4];
+        }
+        std::cout << std::endl;
+    } else {
+        std::cout << "{\"num_procesos\":" << numProcs << ",\"num_hilos\":" << config.numHilos
+                  << ",\"n\":" << config.N << ",\"n_total\":" << totalValores
+                  << ",\"iteraciones\":" << config.iteraciones
+                  << ",\"semilla\":" << config.semilla
+                  << ",\"suma\":\"" << nombreModoSuma(config.modoSuma) << "\""
+                  << ",\"estrategia\":\"" << nombreEstrategia(config.estrategia) << "\""
+                  << ",\"segmentos\":" << config.segmentos
+                  << ",\"promedio\":" << std::setprecision(17) << resultado.promedioFinal
+                  << std::fixed << std::setprecision(2)
+                  << ",\"tiempo_generacion_us\":" << tiempos[0]
+                  << ",\"tiempo_reduccion_us\":" << tiempos[1]
+                  << ",\"tiempo_broadcast_us\":" << tiempos[2];
+        if (config.resumen) {
+            std::cout << std::defaultfloat << std::setprecision(17) << ",\"minimo\":" << resultado.resumen.minimo
+                      << ",\"maximo\":" << resultado.resumen.maximo
+                      << ",\"varianza\":" << resultado.resumen.varianza();
+        }
+        if (config.puntoControl[0] != '\0') {
+            std::cout << std::fixed << std::setprecision(2) << ",\"tiempo_punto_control_us\":" << tiempos[3];
+        }
+        if (config.entrada[0] != '\0') {
+            std::cout << ",\"bytes_leidos\":" << totalValores * bytesTipoDato(config.tipoEntrada)
+                      << std::fixed << std::setprecision(2) << ",\"tiempo_espera_lectura_us\":" << tiempos[4];
+        }
+        std::cout << "}" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    // Inicialización MPI: el número de hilos solo se conoce tras leer la
+    // configuración en la raíz, así que se solicita siempre MPI_THREAD_FUNNELED
+    bool soporteHilos = inicializarMPIFunneled(&argc, &argv);
+    
+    int rank, numProcs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+    
+    // Paso 1: El proceso raíz lee la configuración (variables de entorno,
+    // archivo y argumentos) y la distribuye con un único MPI_Bcast
+    Configuracion config = configuracionPorDefecto();
+    if (rank == 0) {
+        interpretarArgumentos(argc, argv, config, std::cerr);
+        if (config.estado == EstadoConfiguracion::Valida && !validarTotalValores(config, numProcs, std::cerr)) {
+            config.estado = EstadoConfiguracion::Error;
+        }
+        
+        // Con --entrada el número de valores lo fija el archivo; --n y
+        // --n-total solo pueden leer una parte de él
+        if (config.estado == EstadoConfiguracion::Valida && config.entrada[0] != '\0') {
+            int64_t valores = valoresEnArchivo(config.entrada, bytesTipoDato(config.tipoEntrada));
+            if (valores <= 0) {
+                std::cerr << "Error: no se puede leer el archivo de entrada '" << config.entrada
+                          << "', está vacío o su tamaño no es múltiplo de " << bytesTipoDato(config.tipoEntrada)
+                          << " bytes (revise --tipo-entrada)." << std::endl;
+                config.estado = EstadoConfiguracion::Error;
+            } else {
+                int64_t pedidos = config.nTotal > 0 ? config.nTotal : config.N * static_cast<int64_t>(numProcs);
+                config.nTotal = (pedidos > 0 && pedidos < valores) ? pedidos : valores;
+            }
+        }
+        
+        // Compatibilidad: sin --n ni --n-total, N se lee de la entrada estándar
+        if (config.estado == EstadoConfiguracion::Valida && config.N == 0 && config.nTotal == 0) {
+            if (config.formato == FormatoSalida::Texto) {
+                std::cout << "Ingrese el número de valores por proceso (N): ";
+            }
+            bool leido = static_cast<bool>(std::cin >> config.N);
+            if (config.formato == FormatoSalida::Texto) {
+                std::cout << std::endl;
+            }
+            if (!leido || config.N <= 0) {
+                std::cerr << "Error: N debe ser un número positivo (use --n N)." << std::endl;
+                config.estado = EstadoConfiguracion::Error;
+            } else if (!validarTotalValores(config, numProcs, std::cerr)) {
+                config.estado = EstadoConfiguracion::Error;
+            }
+        }
+        if (config.estado == EstadoConfiguracion::Ayuda) {
+            imprimirAyuda(std::cout, argv[0]);
+        }
+    }
+    
+    // MPI_Bcast: Distribuye la configuración desde el proceso raíz a todos los procesos
+    // Punto de sincronización 2: Todos los procesos deben llegar aquí antes de continuar
+    difundirConfiguracion(config, 0, MPI_COMM_WORLD);
+    
+    if (config.estado != EstadoConfiguracion::Valida) {
+        MPI_Finalize();
+        return config.estado == EstadoConfiguracion::Ayuda ? 0 : 1;
+    }
+    
+    if (config.numHilos > 1 && !soporteHilos) {
+        if (rank == 0) {
+            std::cerr << "Advertencia: la biblioteca MPI no soporta MPI_THREAD_FUNNELED; "
+                      << "se usará un solo hilo por proceso." << std::endl;
+        }
+        config.numHilos = 1;
+    }
+    if (config.resumen && config.segmentos > 0) {
+        if (rank == 0) {
+            std::cerr << "Advertencia: --resumen usa una sola reducción; se ignora --segmentos." << std::endl;
+        }
+        config.segmentos = 0;
+    }
+    if (config.plazoMs > 0 && (config.resumen || config.segmentos > 0 || config.jerarquico || config.balanceo)) {
+        if (rank == 0) {
+            std::cerr << "Advertencia: --plazo reduce solo la suma; se ignoran --resumen, --segmentos, "
+                      << "--jerarquico y --balanceo." << std::endl;
+        }
+        config.resumen = 0;
+        config.segmentos = 0;
+        config.jerarquico = 0;
+        config.balanceo = 0;
+    }
+    if (config.puntoControl[0] != '\0' && config.segmentos > 0) {
+        if (rank == 0) {
+            std::cerr << "Advertencia: --punto-control guarda la generación bloqueante; se ignora --segmentos."
+                      << std::endl;
+        }
+        config.segmentos = 0;
+    }
+    if (config.entrada[0] != '\0' && (config.segmentos > 0 || config.puntoControl[0] != '\0' || config.plazoMs > 0)) {
+        if (rank == 0) {
+            std::cerr << "Advertencia: --entrada lee los valores del archivo con colectivas de E/S; se ignoran "
+                      << "--segmentos, --punto-control y --plazo." << std::endl;
+        }
+        config.segmentos = 0;
+        config.plazoMs = 0;
+        config.puntoControl[0] = '\0';
+        config.reanudar = 0;
+    }
+    if (config.entrada[0] != '\0' && config.tipoEntrada != TipoDato::Double && config.resumen) {
+        if (rank == 0) {
+            std::cerr << "Advertencia: --resumen solo admite valores double; se ignora con --tipo-entrada "
+                      << nombreTipoDato(config.tipoEntrada) << "." << std::endl;
+        }
+        config.resumen = 0;
+    }
+#if !defined(MPI_AVANZADO_GPU)
+    if (config.gpu) {
+        if (rank == 0) {
+            std::cerr << "Advertencia: compilado sin soporte de GPU (opción de CMake MPI_AVANZADO_GPU); "
+                      << "se ignora --gpu." << std::endl;
+        }
+        config.gpu = 0;
+    }
+#endif
+    if (config.gpu && config.entrada[0] != '\0') {
+        if (rank == 0) {
+            std::cerr << "Advertencia: --gpu genera los valores en el dispositivo; se ignora con --entrada."
+                      << std::endl;
+        }
+        config.gpu = 0;
+    }
+    if (config.gpu && (config.segmentos > 0 || config.puntoControl[0] != '\0' || config.plazoMs > 0 ||
+                       config.resumen || config.jerarquico || config.estrategia != EstrategiaColectiva::ReduceBcast)) {
+        if (rank == 0) {
+            std::cerr << "Advertencia: --gpu genera, reduce y difunde en la GPU con reduce-bcast; se ignoran "
+                      << "--segmentos, --punto-control, --plazo, --resumen, --jerarquico y --colectiva." << std::endl;
+        }
+        config.segmentos = 0;
+        config.puntoControl[0] = '\0';
+        config.reanudar = 0;
+        config.plazoMs = 0;
+        config.resumen = 0;
+        config.jerarquico = 0;
+        config.estrategia = EstrategiaColectiva::ReduceBcast;
+    }
+    const bool entradaEntera = config.entrada[0] != '\0' &&
+                               (config.tipoEntrada == TipoDato::Int32 || config.tipoEntrada == TipoDato::Int64);
+    if (config.persistente && (config.resumen || entradaEntera || config.segmentos > 0 || config.plazoMs > 0 ||
+                               config.jerarquico || config.gpu || config.tablaDecision[0] != '\0' ||
+                               config.estrategia == EstrategiaColectiva::ReduceScatterAllgather)) {
+        if (rank == 0) {
+            std::cerr << "Advertencia: --persistente prepara la reducción plana de la suma con reduce-bcast o "
+                      << "allreduce; se ignora con --resumen, entradas enteras, --segmentos, --plazo, --jerarquico, "
+                      << "--gpu, --tabla y --colectiva reduce-scatter-allgather." << std::endl;
+        }
+        config.persistente = 0;
+    }
+    if (config.reanudar && config.puntoControl[0] == '\0') {
+        if (rank == 0) {
+            std::cerr << "Error: --reanudar necesita --punto-control RUTA." << std::endl;
+        }
+        MPI_Finalize();
+        return 1;
+    }
+    
+    // La tabla de decisión solo la lee la raíz; reducirEnTodos despacha con ella
+    if (config.tablaDecision[0] != '\0') {
+        std::string error;
+        if (!cargarTablaDecision(config.tablaDecision, 0, MPI_COMM_WORLD, error)) {
+            if (rank == 0) {
+                std::cerr << "Error: tabla de decisión '" << config.tablaDecision << "': " << error << std::endl;
+            }
+            MPI_Finalize();
+            return 1;
+        }
+    }
+    PoolHilos pool(config.numHilos);
+    
+    // Reparto exacto de los valores: con --n-total el total no tiene por qué
+    // ser múltiplo de P; sin él cada proceso genera exactamente N valores.
+    // En la configuración distribuida N pasa a ser el mayor conteo inicial
+    RepartoCarga reparto = repartoUniforme(
+        config.nTotal > 0 ? config.nTotal : config.N * static_cast<int64_t>(numProcs), numProcs);
+    if (config.nTotal > 0) {
+        config.N = reparto.conteos[0];
+    }
+    
+    bool texto = (config.formato == FormatoSalida::Texto);
+    bool resultadoEnTodos = (config.estrategia != EstrategiaColectiva::ReduceBcast);
+    
+    // Modo resiliente: la reducción trabaja sobre su propia copia de
+    // MPI_COMM_WORLD, que se reduce cada vez que se pierde un proceso
+    std::unique_ptr<ReduccionResiliente> resiliente;
+    if (config.plazoMs > 0) {
+        resiliente.reset(new ReduccionResiliente(MPI_COMM_WORLD, config.plazoMs * 1e-3));
+    }
+    
+    // Puntos de control: un archivo compartido abierto una vez para todas las ejecuciones
+    std::unique_ptr<PuntoControl> puntoControl;
+    if (config.puntoControl[0] != '\0') {
+        puntoControl.reset(new PuntoControl(config.puntoControl, MPI_COMM_WORLD));
+        if (!puntoControl->abierto()) {
+            if (rank == 0) {
+                std::cerr << "Error: no se puede abrir el archivo de puntos de control '" << config.puntoControl
+                          << "'." << std::endl;
+            }
+            MPI_Finalize();
+            return 1;
+        }
+    }
+    
+    // Los hints efectivos se calculan en todos los procesos (cuentan los nodos)
+    std::vector<std::pair<std::string, std::string>> hints;
+    bool entrada = (config.entrada[0] != '\0');
+    if (entrada && config.lectura == ModoLectura::MpiIo) {
+        hints = hintsLectura(config.hintsIo, MPI_COMM_WORLD);
+    }
+    
+    if (rank == 0 && texto) {
+        std::cout << "=== PROGRAMA MPI: CÁLCULO DE PROMEDIO CON COMUNICACIONES COLECTIVAS ===" << std::endl;
+        std::cout << "Número total de procesos: " << numProcs << std::endl;
+        std::cout << "Hilos por proceso: " << config.numHilos << std::endl;
+        std::cout << "Suma: " << nombreModoSuma(config.modoSuma) << " (ruta SIMD " << nombreRutaSimd() << ")" << std::endl;
+        std::cout << "Estrategia colectiva: " << nombreEstrategia(config.estrategia) << std::endl;
+        if (!tablaDecisionActiva().vacia()) {
+            std::cout << "Tabla de decisión: " << config.tablaDecision << " ("
+                      << tablaDecisionActiva().entradas().size() << " entradas)" << std::endl;
+        }
+        if (config.segmentos > 0) {
+            std::cout << "Modo solapado: " << config.segmentos << " segmentos con "
+                      << (resultadoEnTodos ? "MPI_Iallreduce" : "MPI_Ireduce") << std::endl;
+        }
+        if (config.nTotal > 0) {
+            std::cout << "Valores totales: " << config.nTotal << " (entre " << reparto.conteos.back()
+                      << " y " << reparto.conteos.front() << " por proceso)";
+        } else {
+            std::cout << "Valores por proceso (N): " << config.N;
+        }
+        std::cout << ", semilla: " << config.semilla << ", iteraciones: " << config.iteraciones << std::endl;
+        if (config.balanceo) {
+            std::cout << "Balanceo de carga: reparto según el rendimiento de la generación" << std::endl;
+        }
+        if (entrada) {
+            std::cout << "Entrada: " << config.entrada << " ("
+                      << valoresEnArchivo(config.entrada, bytesTipoDato(config.tipoEntrada)) << " valores "
+                      << nombreTipoDato(config.tipoEntrada) << ", lectura " << nombreModoLectura(config.lectura);
+            for (size_t i = 0; i < hints.size(); ++i) {
+                std::cout << (i == 0 ? ", hints " : ",") << hints[i].first << "=" << hints[i].second;
+            }
+            std::cout << ")" << std::endl;
+        }
+        if (puntoControl) {
+            std::cout << "Puntos de control: " << config.puntoControl << " cada " << config.puntoControlCada
+                      << " valores por proceso" << (config.reanudar ? " (reanudando)" : "") << std::endl;
+        }
+        if (resiliente) {
+            std::cout << "Reducción resiliente: plazo de " << config.plazoMs << " ms ("
+                      << (ulfmDisponible() ? "ULFM" : "MPI_Iallreduce con MPI_Test") << ")" << std::endl;
+        }
+        std::cout << std::endl;
+    }
+    
+    // Modo jerárquico: se crean una vez los comunicadores de nodo y de líderes.
+    // El modo solapado sigue usando MPI_COMM_WORLD para sus MPI_Ireduce
+    std::unique_ptr<ComunicadorJerarquico> jerarquico;
+    if (config.jerarquico) {
+        jerarquico.reset(new ComunicadorJerarquico(MPI_COMM_WORLD, config.ranksPorNodo));
+        if (rank == 0 && texto) {
+            std::cout << "Colectivas jerárquicas: " << jerarquico->numNodos() << " nodos" << std::endl << std::endl;
+        }
+    }
+    
+    // Modo GPU: una GPU por proceso y el transporte de sus colectivas,
+    // elegidos una vez para todas las ejecuciones
+    ContextoGpu* gpu = nullptr;
+#if defined(MPI_AVANZADO_GPU)
+    std::unique_ptr<ContextoGpu> contextoGpu;
+    if (config.gpu) {
+        contextoGpu.reset(new ContextoGpu(MPI_COMM_WORLD, config.transporteGpu));
+        if (!contextoGpu->valido()) {
+            if (rank == 0) {
+                std::cerr << "Advertencia: algún proceso no tiene una GPU utilizable; se calcula en el host."
+                          << std::endl;
+            }
+            contextoGpu.reset();
+        } else {
+            gpu = contextoGpu.get();
+            if (rank == 0 && texto) {
+                std::cout << "GPU: " << gpu->nombreDispositivo() << ", transporte "
+                          << nombreTransporteGpu(gpu->transporte()) << std::endl << std::endl;
+            }
+        }
+    }
+#endif
+    
+    // Modo persistente: la reducción y la difusión se preparan una vez y cada
+    // ejecución solo las reinicia
+    std::unique_ptr<ColectivasPersistentes> persistentes;
+    if (config.persistente) {
+        persistentes = prepararColectivasPersistentes(config);
+        if (rank == 0 && texto) {
+            std::cout << "Colectivas persistentes: "
+                      << (colectivasPersistentesDisponibles() ? "MPI_*_init" : "sin soporte: no bloqueantes")
+                      << std::endl << std::endl;
+        }
+    }
+    
+    // Pasos 2 a 5, repetidos tantas veces como iteraciones se pidan; los
+    // tiempos que se informan son la media de todas ellas. Las ejecuciones de
+    // calentamiento se descartan. Con --balanceo el reparto se recalcula tras
+    // cada ejecución (también las de calentamiento) a partir del tiempo de
+    // generación de cada proceso
+    // Con --reanudar solo la primera ejecución continúa desde el punto de control
+    ResultadoEjecucion resultado;
+    std::vector<int> perdidos;
+    bool reanudar = config.reanudar != 0;
+    int64_t valoresReanudados = 0;
+    for (int iteracion = 0; iteracion < config.calentamiento; ++iteracion) {
+        resultado = ejecutarCalculo(config, pool, rank, reparto, jerarquico.get(), resiliente.get(),
+                                    puntoControl.get(), reanudar, gpu, persistentes.get());
+        valoresReanudados += resultado.valoresReanudados;
+        reanudar = false;
+        perdidos.insert(perdidos.end(), resultado.procesosPerdidos.begin(), resultado.procesosPerdidos.end());
+        if (config.balanceo) {
+            reparto = rebalancearReparto(reparto, resultado.duracionGeneracion * 1e-6, MPI_COMM_WORLD);
+        }
+    }
+    double tiempos[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    RepartoCarga repartoMedido = reparto;
+    for (int iteracion = 0; iteracion < config.iteraciones; ++iteracion) {
+        repartoMedido = reparto;
+        resultado = ejecutarCalculo(config, pool, rank, repartoMedido, jerarquico.get(), resiliente.get(),
+                                    puntoControl.get(), reanudar, gpu, persistentes.get());
+        valoresReanudados += resultado.valoresReanudados;
+        reanudar = false;
+        perdidos.insert(perdidos.end(), resultado.procesosPerdidos.begin(), resultado.procesosPerdidos.end());
+        tiempos[0] += resultado.duracionGeneracion / config.iteraciones;
+        tiempos[1] += resultado.duracionReduccion / config.iteraciones;
+        tiempos[2] += resultado.duracionBroadcast / config.iteraciones;
+        tiempos[3] += resultado.duracionPuntoControl / config.iteraciones;
+        tiempos[4] += resultado.duracionEsperaLectura / config.iteraciones;
+        if (config.balanceo && iteracion + 1 < config.iteraciones) {
+            reparto = rebalancearReparto(reparto, resultado.duracionGeneracion * 1e-6, MPI_COMM_WORLD);
+        }
+    }
+    
+    // Con --entrada el ancho de banda lo marca el proceso más lento: se
+    // reduce el máximo de la lectura, de la espera y de los fallos
+    double lectura[3] = {tiempos[0], tiempos[4], resultado.lecturaCorrecta ? 0.0 : 1.0};
+    if (entrada) {
+        double maximos[3] = {0.0, 0.0, 0.0};
+        MPI_Allreduce(lectura, maximos, 3, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        std::copy(maximos, maximos + 3, lectura);
+    }
+    if (lectura[2] != 0.0) {
+        if (rank == 0) {
+            std::cerr << "Error: la lectura del archivo de entrada '" << config.entrada
+                      << "' falló en algún proceso." << std::endl;
+        }
+        MPI_Finalize();
+        return 1;
+    }
+    
+    if (rank == 0 && texto) {
+        int64_t totalValores = repartoMedido.total();
+        std::cout << "=== RESULTADOS EN EL PROCESO RAÍZ ===" << std::endl;
+        std::cout << "Suma total de todos los procesos: " << std::fixed << std::setprecision(2) << resultado.sumaTotal << std::endl;
+        std::cout << "Número total de valores: " << totalValores << std::endl;
+        std::cout << "Promedio calculado: " << std::fixed << std::setprecision(4) << resultado.promedioFinal << std::endl;
+        if (config.reanudar) {
+            std::cout << "Reanudado desde el punto de control: " << valoresReanudados
+                      << " valores del rank 0 ya estaban sumados" << std::endl;
+        }
+        if (resiliente) {
+            std::cout << "Procesos perdidos: " << perdidos.size();
+            for (size_t i = 0; i < perdidos.size(); ++i) {
+                std::cout << (i == 0 ? " (ranks " : ", ") << perdidos[i] << (i + 1 == perdidos.size() ? ")" : "");
+            }
+            std::cout << "; valores perdidos en la última iteración: " << totalValores - resultado.valoresIncluidos
+                      << " de " << totalValores << std::endl;
+        }
+        if (config.resumen) {
+            std::cout << "Valores contados en el resumen: " << resultado.resumen.cuenta << std::endl;
+            std::cout << "Mínimo: " << std::fixed << std::setprecision(4) << resultado.resumen.minimo
+                      << ", máximo: " << resultado.resumen.maximo
+                      << ", desviación típica: " << std::sqrt(resultado.resumen.varianza()) << std::endl;
+        }
+        std::cout << "Tiempo de reducción: " << std::fixed << std::setprecision(2) << resultado.duracionReduccion << " microsegundos" << std::endl;
+        std::cout << std::endl;
+    }
+    
+    // Paso 6: Recoger el diagnóstico de cada proceso con un único MPI_Gather
+    // (omitido en modo silencioso, en los formatos estructurados y con --plazo,
+    // donde un proceso perdido bloquearía la colectiva) e imprimirlo desde la raíz
+    if (texto && !config.silencioso && !resiliente) {
+        std::vector<DiagnosticoProceso> diagnosticos = recogerDiagnosticos(resultado.diagnostico, rank, numProcs);
+        
+        if (rank == 0) {
+            std::cout << "=== DIAGNÓSTICO POR PROCESO ===" << std::endl;
+            for (int i = 0; i < numProcs; ++i) {
+                imprimirInfoProceso(i, repartoMedido.conteos[i], diagnosticos[i]);
+            }
+            if (config.balanceo) {
+                std::vector<double> generacion(numProcs);
+                for (int i = 0; i < numProcs; ++i) {
+                    generacion[i] = diagnosticos[i].duracionGeneracion;
+                }
+                std::cout << "Desequilibrio de la generación en la última iteración: " << std::fixed
+                          << std::setprecision(1) << desequilibrioCarga(generacion) * 100.0 << " %"
+                          << std::endl << std::endl;
+            }
+        }
+    }
+    
+    if (rank == 0 && texto) {
+        std::cout << "=== RESUMEN DE TIEMPOS ===";
+        if (config.iteraciones > 1) {
+            std::cout << " (media de " << config.iteraciones << " iteraciones)";
+        }
+        std::cout << std::endl;
+        if (entrada) {
+            double gigabytes = static_cast<double>(repartoMedido.total() * bytesTipoDato(config.tipoEntrada)) * 1e-9;
+            std::cout << "Tiempo de lectura y suma de datos: " << std::fixed << std::setprecision(2) << tiempos[0]
+                      << " microsegundos (máximo entre procesos: " << lectura[0] << ")" << std::endl;
+            std::cout << "Tiempo de espera de E/S: " << std::fixed << std::setprecision(2) << tiempos[4]
+                      << " microsegundos (máximo entre procesos: " << lectura[1] << ")" << std::endl;
+            std::cout << "Ancho de banda de E/S: " << std::fixed << std::setprecision(3)
+                      << (lectura[0] > 0.0 ? gigabytes / (lectura[0] * 1e-6) : 0.0) << " GB/s" << std::endl;
+        } else {
+            std::cout << "Tiempo de generación de datos: " << std::fixed << std::setprecision(2) << tiempos[0] << " microsegundos" << std::endl;
+        }
+        std::cout << "Tiempo de reducción: " << std::fixed << std::setprecision(2) << tiempos[1] << " microsegundos" << std::endl;
+        std::cout << "Tiempo de broadcast final: " << std::fixed << std::setprecision(2) << tiempos[2] << " microsegundos" << std::endl;
+        if (puntoControl) {
+            std::cout << "Tiempo de puntos de control: " << std::fixed << std::setprecision(2) << tiempos[3]
+                      << " microsegundos (" << puntoControl->escrituras() << " escrituras en total)" << std::endl;
+        }
+        std::cout << std::endl;
+        std::cout << "=== PROGRAMA COMPLETADO EXITOSAMENTE ===" << std::endl;
+    } else if (rank == 0) {
+        imprimirResultadoEstructurado(config, numProcs, resultado, tiempos);
+    }
+    
+    // Los comunicadores derivados y las peticiones persistentes se liberan
+    // antes de finalizar MPI
+    persistentes.reset();
+    jerarquico.reset();
+    resiliente.reset();
+    puntoControl.reset();
+    
+    // Finalización MPI
+    MPI_Finalize();
+    
+    return 0;
+}
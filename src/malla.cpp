@@ -0,0 +1,58 @@
+/**
+ * @file malla.cpp
+ * @brief Implementación de la malla cartesiana 2D
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "malla.h"
+
+MallaCartesiana::MallaCartesiana(MPI_Comm comm, int filas) {
+    int numProcs = 1;
+    MPI_Comm_size(comm, &numProcs);
+    
+    // Con las filas fijadas MPI_Dims_create solo elige las columnas
+    dimensiones_[0] = (filas > 0 && numProcs % filas == 0) ? filas : 0;
+    dimensiones_[1] = 0;
+    MPI_Dims_create(numProcs, 2, dimensiones_);
+    
+    int periodicas[2] = {0, 0};
+    MPI_Cart_create(comm, 2, dimensiones_, periodicas, 0, &cartesiano_);
+    
+    int rank = 0;
+    MPI_Comm_rank(cartesiano_, &rank);
+    MPI_Cart_coords(cartesiano_, rank, 2, coordenadas_);
+    
+    // La fila conserva la dimensión de las columnas y viceversa
+    int conservarFila[2] = {0, 1};
+    int conservarColumna[2] = {1, 0};
+    MPI_Cart_sub(cartesiano_, conservarFila, &fila_);
+    MPI_Cart_sub(cartesiano_, conservarColumna, &columna_);
+}
+
+MallaCartesiana::~MallaCartesiana() {
+    for (MPI_Comm* comm : {&columna_, &fila_, &cartesiano_}) {
+        if (*comm != MPI_COMM_NULL) {
+            MPI_Comm_free(comm);
+        }
+    }
+}
+
+int raizRotatoria(int iteracion, MPI_Comm comm) {
+    int tamano = 1;
+    MPI_Comm_size(comm, &tamano);
+    return iteracion % tamano;
+}
+
+int iniciarColectiva(OperacionColectiva operacion, void* envio, void* recepcion, int count, MPI_Datatype datatype,
+                     MPI_Op op, int root, MPI_Comm comm, MPI_Request* peticion) {
+    switch (operacion) {
+        case OperacionColectiva::Bcast:
+            return MPI_Ibcast(envio, count, datatype, root, comm, peticion);
+        case OperacionColectiva::Reduce:
+            return MPI_Ireduce(envio, recepcion, count, datatype, op, root, comm, peticion);
+        case OperacionColectiva::Allreduce:
+            return MPI_Iallreduce(envio, recepcion, count, datatype, op, comm, peticion);
+    }
+    return MPI_ERR_ARG;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file malla.h
+ * @brief Malla cartesiana 2D con comunicadores de fila y de columna
+ * @author Emil M
+ * @date 2025
+ *
+ * Las aplicaciones con descomposición 2D (álgebra lineal densa, stencils)
+ * no reducen sobre MPI_COMM_WORLD sino sobre cada fila y cada columna de la
+ * malla de procesos, y muchas de esas colectivas están en vuelo a la vez. La
+ * malla se crea con MPI_Dims_create y MPI_Cart_create, y los comunicadores
+ * de fila y de columna con MPI_Cart_sub; cada proceso pertenece a una fila y
+ * a una columna, de modo que sus colectivas compiten por los mismos enlaces.
+ */
+
+#ifndef MPI_AVANZADO_MALLA_H
+#define MPI_AVANZADO_MALLA_H
+
+#include "algoritmos.h"
+
+#include <mpi.h>
+
+/**
+ * @brief Topología cartesiana 2D (no periódica) y sus comunicadores de fila y columna
+ *
+ * Los ranks no se reordenan, así que el rank en la malla coincide con el del
+ * comunicador original y los procesos de una fila son consecutivos.
+ */
+class MallaCartesiana {
+public:
+    /**
+     * @brief Crea la malla (operación colectiva sobre comm)
+     * @param comm Comunicador original
+     * @param filas Número de filas (0 = el que elija MPI_Dims_create); debe dividir
+     *              al número de procesos
+     */
+    explicit MallaCartesiana(MPI_Comm comm, int filas = 0);
+    ~MallaCartesiana();
+    
+    MallaCartesiana(const MallaCartesiana&) = delete;
+    MallaCartesiana& operator=(const MallaCartesiana&) = delete;
+    
+    /**
+     * @brief Comunicador cartesiano completo
+     */
+    MPI_Comm cartesiano() const { return cartesiano_; }
+    
+    /**
+     * @brief Comunicador con los procesos de la misma fila
+     */
+    MPI_Comm fila() const { return fila_; }
+    
+    /**
+     * @brief Comunicador con los procesos de la misma columna
+     */
+    MPI_Comm columna() const { return columna_; }
+    
+    int numFilas() const { return dimensiones_[0]; }
+    int numColumnas() const { return dimensiones_[1]; }
+    int miFila() const { return coordenadas_[0]; }
+    int miColumna() const { return coordenadas_[1]; }
+
+private:
+    MPI_Comm cartesiano_ = MPI_COMM_NULL;
+    MPI_Comm fila_ = MPI_COMM_NULL;
+    MPI_Comm columna_ = MPI_COMM_NULL;
+    int dimensiones_[2] = {1, 1};
+    int coordenadas_[2] = {0, 0};
+};
+
+/**
+ * @brief Raíz rotatoria de una colectiva: cada iteración la raíz es otro proceso
+ * @param iteracion Índice de la iteración
+ * @param comm Comunicador de la colectiva
+ * @return iteracion módulo el tamaño de comm
+ */
+int raizRotatoria(int iteracion, MPI_Comm comm);
+
+/**
+ * @brief Inicia una colectiva no bloqueante
+ * @param operacion Colectiva (MPI_Ibcast, MPI_Ireduce o MPI_Iallreduce)
+ * @param envio Datos locales; en bcast, el buffer a distribuir
+ * @param recepcion Resultado de reduce y allreduce (no se usa en bcast)
+ * @param count Número de elementos
+ * @param datatype Tipo de dato de cada elemento
+ * @param op Operación de reducción (no se usa en bcast)
+ * @param root Proceso raíz (no se usa en allreduce)
+ * @param comm Comunicador
+ * @param peticion Petición que completar con MPI_Wait o MPI_Waitall
+ * @return Código de error MPI
+ */
+int iniciarColectiva(OperacionColectiva operacion, void* envio, void* recepcion, int count, MPI_Datatype datatype,
+                     MPI_Op op, int root, MPI_Comm comm, MPI_Request* peticion);
+
+#endif // MPI_AVANZADO_MALLA_H
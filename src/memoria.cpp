@@ -0,0 +1,161 @@
+/**
+ * @file memoria.cpp
+ * @brief Implementación de los buffers reutilizables
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "memoria.h"
+
+#include <mpi.h>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "hilos.h"
+
+namespace {
+
+/**
+ * @brief Tamaño de página del sistema
+ */
+int64_t tamanoPagina() {
+    static const int64_t pagina = [] {
+        long valor = sysconf(_SC_PAGESIZE);
+        return valor > 0 ? static_cast<int64_t>(valor) : int64_t(4096);
+    }();
+    return pagina;
+}
+
+/**
+ * @brief Alineación para un buffer: página enorme si es lo bastante grande
+ */
+int64_t alineacionPara(int64_t bytes) {
+    return bytes >= TAMANO_PAGINA_ENORME ? TAMANO_PAGINA_ENORME : tamanoPagina();
+}
+
+} // namespace
+
+BufferMemoria::BufferMemoria(int64_t bytes, AsignadorMemoria asignador) : asignador_(asignador) {
+    if (bytes <= 0) {
+        return;
+    }
+    int64_t alineacion = alineacionPara(bytes);
+    bytes_ = (bytes + alineacion - 1) / alineacion * alineacion;
+
+    if (asignador_ == AsignadorMemoria::MpiAllocMem) {
+        if (MPI_Alloc_mem(static_cast<MPI_Aint>(bytes_), MPI_INFO_NULL, &datos_) != MPI_SUCCESS) {
+            datos_ = nullptr;
+        }
+    } else if (posix_memalign(&datos_, static_cast<size_t>(alineacion), static_cast<size_t>(bytes_)) != 0) {
+        datos_ = nullptr;
+    }
+
+    if (datos_ == nullptr) {
+        bytes_ = 0;
+        throw std::bad_alloc();
+    }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // Solo es una sugerencia: si las páginas enormes transparentes están
+    // desactivadas el buffer sigue funcionando con páginas normales
+    if (asignador_ == AsignadorMemoria::Alineado && alineacion == TAMANO_PAGINA_ENORME) {
+        madvise(datos_, static_cast<size_t>(bytes_), MADV_HUGEPAGE);
+    }
+#endif
+}
+
+BufferMemoria::~BufferMemoria() {
+    liberar();
+}
+
+BufferMemoria::BufferMemoria(BufferMemoria&& otro) noexcept
+    : datos_(otro.datos_), bytes_(otro.bytes_), asignador_(otro.asignador_) {
+    otro.datos_ = nullptr;
+    otro.bytes_ = 0;
+}
+
+BufferMemoria& BufferMemoria::operator=(BufferMemoria&& otro) noexcept {
+    if (this != &otro) {
+        liberar();
+        std::swap(datos_, otro.datos_);
+        std::swap(bytes_, otro.bytes_);
+        asignador_ = otro.asignador_;
+    }
+    return *this;
+}
+
+void BufferMemoria::liberar() {
+    if (datos_ == nullptr) {
+        return;
+    }
+    if (asignador_ == AsignadorMemoria::MpiAllocMem) {
+        MPI_Free_mem(datos_);
+    } else {
+        std::free(datos_);
+    }
+    datos_ = nullptr;
+    bytes_ = 0;
+}
+
+void tocarPrimeraVez(void* datos, int64_t bytes, PoolHilos* hilos) {
+    char* inicio = static_cast<char*>(datos);
+    int64_t elementos = bytes / static_cast<int64_t>(sizeof(double));
+    if (hilos == nullptr || hilos->numHilos() == 1) {
+        std::memset(inicio, 0, static_cast<size_t>(bytes));
+        return;
+    }
+
+    // Mismo reparto por elementos que usan los núcleos para que cada página
+    // la toque el hilo que después la procesa
+    hilos->ejecutar([&](int hilo) {
+        std::pair<int64_t, int64_t> rango = rangoHilo(elementos, hilo, hilos->numHilos());
+        int64_t desde = rango.first * static_cast<int64_t>(sizeof(double));
+        int64_t hasta = hilo == hilos->numHilos() - 1 ? bytes : rango.second * static_cast<int64_t>(sizeof(double));
+        std::memset(inicio + desde, 0, static_cast<size_t>(hasta - desde));
+    });
+}
+
+PoolBuffers::PoolBuffers(AsignadorMemoria asignador, PoolHilos* hilos)
+    : asignador_(asignador), hilos_(hilos) {}
+
+void PoolBuffers::reservar(int ranura, int64_t elementos) {
+    if (ranura >= static_cast<int>(ranuras_.size())) {
+        ranuras_.resize(ranura + 1);
+    }
+    int64_t bytes = elementos * static_cast<int64_t>(sizeof(double));
+    if (ranuras_[ranura].bytes() >= bytes) {
+        return;
+    }
+
+    ranuras_[ranura].liberar();
+    ranuras_[ranura] = BufferMemoria(bytes, asignador_);
+    tocarPrimeraVez(ranuras_[ranura].datos(), ranuras_[ranura].bytes(), hilos_);
+}
+
+double* PoolBuffers::obtener(int ranura, int64_t elementos) {
+    reservar(ranura, elementos);
+    return static_cast<double*>(ranuras_[ranura].datos());
+}
+
+int64_t PoolBuffers::bytesReservados() const {
+    int64_t total = 0;
+    for (const BufferMemoria& buffer : ranuras_) {
+        total += buffer.bytes();
+    }
+    return total;
+}
+
+void PoolBuffers::liberar() {
+    ranuras_.clear();
+}
+
+const char* nombreAsignador(AsignadorMemoria asignador) {
+    return asignador == AsignadorMemoria::MpiAllocMem ? "mpi" : "alineado";
+}
@@ -0,0 +1,144 @@
+/**
+ * @file memoria.h
+ * @brief Buffers reutilizables, alineados a página y tocados de antemano
+ * @author Emil M
+ * @date 2025
+ *
+ * Los benchmarks reservan sus buffers una sola vez y los comparten entre
+ * fases, para que las medidas no incluyan fallos de página por primer acceso
+ * ni el registro de memoria de la red (RDMA) en las primeras iteraciones.
+ * Los buffers grandes se alinean a páginas enormes (2 MiB) y se marcan con
+ * MADV_HUGEPAGE cuando el sistema lo permite; cada hilo escribe su tramo al
+ * reservarlo para que las páginas queden en su nodo NUMA (primer contacto).
+ * Opcionalmente la memoria se obtiene con MPI_Alloc_mem, que en algunas
+ * redes la entrega ya registrada.
+ */
+
+#ifndef MPI_AVANZADO_MEMORIA_H
+#define MPI_AVANZADO_MEMORIA_H
+
+#include <cstdint>
+#include <vector>
+
+class PoolHilos;
+
+/**
+ * @brief Origen de la memoria de los buffers
+ */
+enum class AsignadorMemoria : int32_t {
+    Alineado,   ///< posix_memalign alineado a página (o a página enorme)
+    MpiAllocMem ///< MPI_Alloc_mem
+};
+
+/**
+ * @brief Tamaño de página enorme usado para alinear los buffers grandes
+ */
+const int64_t TAMANO_PAGINA_ENORME = int64_t(2) << 20;
+
+/**
+ * @brief Buffer de memoria propietario, no copiable
+ *
+ * Los buffers de MPI_Alloc_mem deben liberarse antes de MPI_Finalize.
+ */
+class BufferMemoria {
+public:
+    BufferMemoria() = default;
+
+    /**
+     * @brief Reserva un buffer
+     * @param bytes Tamaño mínimo en bytes (se redondea a la alineación)
+     * @param asignador Origen de la memoria
+     */
+    BufferMemoria(int64_t bytes, AsignadorMemoria asignador);
+    ~BufferMemoria();
+
+    BufferMemoria(const BufferMemoria&) = delete;
+    BufferMemoria& operator=(const BufferMemoria&) = delete;
+    BufferMemoria(BufferMemoria&& otro) noexcept;
+    BufferMemoria& operator=(BufferMemoria&& otro) noexcept;
+
+    /**
+     * @brief Puntero al inicio del buffer (nullptr si está vacío)
+     */
+    void* datos() const { return datos_; }
+
+    /**
+     * @brief Tamaño reservado en bytes
+     */
+    int64_t bytes() const { return bytes_; }
+
+    /**
+     * @brief Libera la memoria (el buffer queda vacío)
+     */
+    void liberar();
+
+private:
+    void* datos_ = nullptr;
+    int64_t bytes_ = 0;
+    AsignadorMemoria asignador_ = AsignadorMemoria::Alineado;
+};
+
+/**
+ * @brief Escribe cada página del buffer desde el hilo que la usará
+ * @param datos Inicio del buffer
+ * @param bytes Tamaño en bytes
+ * @param hilos Pool de hilos que reparte el buffer (nullptr = hilo actual)
+ *
+ * Cada hilo escribe el mismo tramo que después procesa rangoHilo(), de modo
+ * que con hilos fijados a núcleos las páginas quedan en su nodo NUMA.
+ */
+void tocarPrimeraVez(void* datos, int64_t bytes, PoolHilos* hilos);
+
+/**
+ * @brief Conjunto de buffers de doubles reutilizables identificados por ranura
+ *
+ * Cada ranura crece solo cuando se pide más capacidad de la que tiene; al
+ * crecer se reserva y se toca de nuevo. Reservando al principio el tamaño
+ * máximo, ninguna fase medida vuelve a reservar memoria.
+ */
+class PoolBuffers {
+public:
+    /**
+     * @brief Crea el pool
+     * @param asignador Origen de la memoria
+     * @param hilos Pool de hilos para el primer contacto (nullptr = hilo actual)
+     */
+    explicit PoolBuffers(AsignadorMemoria asignador, PoolHilos* hilos = nullptr);
+
+    /**
+     * @brief Garantiza que la ranura tenga al menos esa capacidad
+     * @param ranura Índice de la ranura
+     * @param elementos Número de doubles
+     */
+    void reservar(int ranura, int64_t elementos);
+
+    /**
+     * @brief Buffer de una ranura con al menos esa capacidad
+     * @param ranura Índice de la ranura
+     * @param elementos Número de doubles
+     * @return Puntero al buffer (estable mientras no se pida más capacidad)
+     */
+    double* obtener(int ranura, int64_t elementos);
+
+    /**
+     * @brief Bytes reservados entre todas las ranuras
+     */
+    int64_t bytesReservados() const;
+
+    /**
+     * @brief Libera todas las ranuras (obligatorio antes de MPI_Finalize con MPI_Alloc_mem)
+     */
+    void liberar();
+
+private:
+    AsignadorMemoria asignador_;
+    PoolHilos* hilos_;
+    std::vector<BufferMemoria> ranuras_;
+};
+
+/**
+ * @brief Nombre de un asignador de memoria
+ */
+const char* nombreAsignador(AsignadorMemoria asignador);
+
+#endif // MPI_AVANZADO_MEMORIA_H
@@ -0,0 +1,156 @@
+/**
+ * @file persistente.cpp
+ * @brief Implementación de las colectivas persistentes
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "persistente.h"
+
+#include <climits>
+#include <utility>
+
+#if MPI_VERSION < 4 && defined(OPEN_MPI)
+#include <mpi-ext.h>
+#endif
+
+#include "colectivas.h"
+
+#if MPI_VERSION >= 4
+#define MPI_AVANZADO_PERSISTENTES 1
+#define MPI_AVANZADO_BCAST_INIT MPI_Bcast_init
+#define MPI_AVANZADO_REDUCE_INIT MPI_Reduce_init
+#define MPI_AVANZADO_ALLREDUCE_INIT MPI_Allreduce_init
+#elif defined(OMPI_HAVE_MPI_EXT_PCOLLREQ) && OMPI_HAVE_MPI_EXT_PCOLLREQ
+#define MPI_AVANZADO_PERSISTENTES 1
+#define MPI_AVANZADO_BCAST_INIT MPIX_Bcast_init
+#define MPI_AVANZADO_REDUCE_INIT MPIX_Reduce_init
+#define MPI_AVANZADO_ALLREDUCE_INIT MPIX_Allreduce_init
+#else
+#define MPI_AVANZADO_PERSISTENTES 0
+#endif
+
+bool colectivasPersistentesDisponibles() {
+    return MPI_AVANZADO_PERSISTENTES != 0;
+}
+
+ColectivaPersistente ColectivaPersistente::bcast(void* buffer, int64_t count, MPI_Datatype datatype, int root,
+                                                 MPI_Comm comm) {
+    return ColectivaPersistente(Tipo::Bcast, nullptr, buffer, count, datatype, MPI_OP_NULL, root, comm);
+}
+
+ColectivaPersistente ColectivaPersistente::reduce(const void* sendbuf, void* recvbuf, int64_t count,
+                                                  MPI_Datatype datatype, MPI_Op op, int root, MPI_Comm comm) {
+    return ColectivaPersistente(Tipo::Reduce, sendbuf, recvbuf, count, datatype, op, root, comm);
+}
+
+ColectivaPersistente ColectivaPersistente::allreduce(const void* sendbuf, void* recvbuf, int64_t count,
+                                                     MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+    return ColectivaPersistente(Tipo::Allreduce, sendbuf, recvbuf, count, datatype, op, 0, comm);
+}
+
+ColectivaPersistente::ColectivaPersistente(Tipo tipo, const void* sendbuf, void* recvbuf, int64_t count,
+                                           MPI_Datatype datatype, MPI_Op op, int root, MPI_Comm comm)
+    : tipo_(tipo), sendbuf_(sendbuf), recvbuf_(recvbuf), count_(count), datatype_(datatype),
+      op_(op), root_(root), comm_(comm) {
+#if MPI_AVANZADO_PERSISTENTES
+    if (count_ > INT_MAX) {
+        return;
+    }
+    int conteo = static_cast<int>(count_);
+    int error = MPI_SUCCESS;
+    switch (tipo_) {
+        case Tipo::Bcast:
+            error = MPI_AVANZADO_BCAST_INIT(recvbuf_, conteo, datatype_, root_, comm_, MPI_INFO_NULL, &peticion_);
+            break;
+        case Tipo::Reduce:
+            error = MPI_AVANZADO_REDUCE_INIT(sendbuf_, recvbuf_, conteo, datatype_, op_, root_, comm_,
+                                             MPI_INFO_NULL, &peticion_);
+            break;
+        case Tipo::Allreduce:
+            error = MPI_AVANZADO_ALLREDUCE_INIT(sendbuf_, recvbuf_, conteo, datatype_, op_, comm_,
+                                                MPI_INFO_NULL, &peticion_);
+            break;
+    }
+    persistente_ = error == MPI_SUCCESS && peticion_ != MPI_REQUEST_NULL;
+#endif
+}
+
+ColectivaPersistente::~ColectivaPersistente() {
+    liberar();
+}
+
+ColectivaPersistente::ColectivaPersistente(ColectivaPersistente&& otra) noexcept
+    : tipo_(otra.tipo_), sendbuf_(otra.sendbuf_), recvbuf_(otra.recvbuf_), count_(otra.count_),
+      datatype_(otra.datatype_), op_(otra.op_), root_(otra.root_), comm_(otra.comm_),
+      peticion_(otra.peticion_), persistente_(otra.persistente_) {
+    otra.peticion_ = MPI_REQUEST_NULL;
+    otra.persistente_ = false;
+}
+
+ColectivaPersistente& ColectivaPersistente::operator=(ColectivaPersistente&& otra) noexcept {
+    if (this != &otra) {
+        liberar();
+        tipo_ = otra.tipo_;
+        sendbuf_ = otra.sendbuf_;
+        recvbuf_ = otra.recvbuf_;
+        count_ = otra.count_;
+        datatype_ = otra.datatype_;
+        op_ = otra.op_;
+        root_ = otra.root_;
+        comm_ = otra.comm_;
+        std::swap(peticion_, otra.peticion_);
+        std::swap(persistente_, otra.persistente_);
+    }
+    return *this;
+}
+
+void ColectivaPersistente::liberar() {
+    if (persistente_ && peticion_ != MPI_REQUEST_NULL) {
+        MPI_Request_free(&peticion_);
+    }
+    peticion_ = MPI_REQUEST_NULL;
+    persistente_ = false;
+}
+
+int ColectivaPersistente::iniciar() {
+    if (persistente_) {
+        return MPI_Start(&peticion_);
+    }
+    
+    // Sin colectivas persistentes: la no bloqueante equivalente, o la
+    // bloqueante de 64 bits si el conteo no cabe en un int
+    if (count_ > INT_MAX) {
+        switch (tipo_) {
+            case Tipo::Bcast:
+                return bcastGrande(recvbuf_, count_, datatype_, root_, comm_);
+            case Tipo::Reduce:
+                return reduceGrande(sendbuf_, recvbuf_, count_, datatype_, op_, root_, comm_);
+            case Tipo::Allreduce:
+                return allreduceGrande(sendbuf_, recvbuf_, count_, datatype_, op_, comm_);
+        }
+    }
+    int conteo = static_cast<int>(count_);
+    switch (tipo_) {
+        case Tipo::Bcast:
+            return MPI_Ibcast(recvbuf_, conteo, datatype_, root_, comm_, &peticion_);
+        case Tipo::Reduce:
+            return MPI_Ireduce(sendbuf_, recvbuf_, conteo, datatype_, op_, root_, comm_, &peticion_);
+        case Tipo::Allreduce:
+            return MPI_Iallreduce(sendbuf_, recvbuf_, conteo, datatype_, op_, comm_, &peticion_);
+    }
+    return MPI_SUCCESS;
+}
+
+int ColectivaPersistente::esperar() {
+    // Una petición persistente queda inactiva (no MPI_REQUEST_NULL) tras MPI_Wait
+    return MPI_Wait(&peticion_, MPI_STATUS_IGNORE);
+}
+
+int ColectivaPersistente::ejecutar() {
+    int error = iniciar();
+    if (error != MPI_SUCCESS) {
+        return error;
+    }
+    return esperar();
+}
@@ -0,0 +1,126 @@
+/**
+ * @file persistente.h
+ * @brief Colectivas persistentes que se preparan una vez y se reinician en cada iteración
+ * @author Emil M
+ * @date 2025
+ *
+ * Los bucles iterativos repiten la misma colectiva con los mismos argumentos.
+ * Con MPI-4 (o la extensión MPIX de Open MPI) la colectiva se prepara una
+ * sola vez con MPI_Bcast_init, MPI_Reduce_init o MPI_Allreduce_init y cada
+ * iteración solo hace MPI_Start y MPI_Wait, de modo que la selección del
+ * algoritmo y la reserva de recursos internos no se repiten en cada llamada.
+ * Si la biblioteca no las ofrece, o el conteo no cabe en un int, se usa la
+ * colectiva no bloqueante equivalente con la misma interfaz.
+ */
+
+#ifndef MPI_AVANZADO_PERSISTENTE_H
+#define MPI_AVANZADO_PERSISTENTE_H
+
+#include <mpi.h>
+#include <cstdint>
+
+/**
+ * @brief Indica si la biblioteca MPI ofrece colectivas persistentes
+ */
+bool colectivasPersistentesDisponibles();
+
+/**
+ * @brief Colectiva con argumentos fijos que se reinicia en cada iteración
+ *
+ * Los buffers deben permanecer vivos y en la misma dirección mientras exista
+ * el objeto. Todos los procesos deben crear e iniciar las colectivas en el
+ * mismo orden. El destructor libera la petición, por lo que debe ejecutarse
+ * antes de MPI_Finalize.
+ */
+class ColectivaPersistente {
+public:
+    /**
+     * @brief Prepara un broadcast
+     * @param buffer Buffer a distribuir (entrada en la raíz, salida en el resto)
+     * @param count Número de elementos
+     * @param datatype Tipo de dato de cada elemento
+     * @param root Rank del proceso raíz
+     * @param comm Comunicador
+     */
+    static ColectivaPersistente bcast(void* buffer, int64_t count, MPI_Datatype datatype, int root,
+                                      MPI_Comm comm);
+    
+    /**
+     * @brief Prepara una reducción hacia la raíz
+     * @param sendbuf Buffer con los datos locales
+     * @param recvbuf Buffer de resultado (solo significativo en la raíz)
+     * @param count Número de elementos
+     * @param datatype Tipo de dato de cada elemento
+     * @param op Operación de reducción
+     * @param root Rank del proceso raíz
+     * @param comm Comunicador
+     */
+    static ColectivaPersistente reduce(const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                                       MPI_Op op, int root, MPI_Comm comm);
+    
+    /**
+     * @brief Prepara una reducción con el resultado en todos los procesos
+     * @param sendbuf Buffer con los datos locales (o MPI_IN_PLACE)
+     * @param recvbuf Buffer de resultado en todos los procesos
+     * @param count Número de elementos
+     * @param datatype Tipo de dato de cada elemento
+     * @param op Operación de reducción
+     * @param comm Comunicador
+     */
+    static ColectivaPersistente allreduce(const void* sendbuf, void* recvbuf, int64_t count,
+                                          MPI_Datatype datatype, MPI_Op op, MPI_Comm comm);
+    
+    ~ColectivaPersistente();
+    
+    ColectivaPersistente(const ColectivaPersistente&) = delete;
+    ColectivaPersistente& operator=(const ColectivaPersistente&) = delete;
+    ColectivaPersistente(ColectivaPersistente&& otra) noexcept;
+    ColectivaPersistente& operator=(ColectivaPersistente&& otra) noexcept;
+    
+    /**
+     * @brief Inicia una ejecución (MPI_Start o la colectiva no bloqueante)
+     * @return Código de error MPI
+     */
+    int iniciar();
+    
+    /**
+     * @brief Espera a que termine la ejecución iniciada
+     * @return Código de error MPI
+     */
+    int esperar();
+    
+    /**
+     * @brief Inicia y espera una ejecución
+     * @return Código de error MPI
+     */
+    int ejecutar();
+    
+    /**
+     * @brief Indica si la colectiva usa una petición persistente
+     */
+    bool esPersistente() const { return persistente_; }
+
+private:
+    enum class Tipo { Bcast, Reduce, Allreduce };
+    
+    ColectivaPersistente(Tipo tipo, const void* sendbuf, void* recvbuf, int64_t count, MPI_Datatype datatype,
+                         MPI_Op op, int root, MPI_Comm comm);
+    
+    /**
+     * @brief Libera la petición persistente, si la hay
+     */
+    void liberar();
+    
+    Tipo tipo_;
+    const void* sendbuf_;
+    void* recvbuf_;
+    int64_t count_;
+    MPI_Datatype datatype_;
+    MPI_Op op_;
+    int root_;
+    MPI_Comm comm_;
+    MPI_Request peticion_ = MPI_REQUEST_NULL;
+    bool persistente_ = false;
+};
+
+#endif // MPI_AVANZADO_PERSISTENTE_H
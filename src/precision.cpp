@@ -0,0 +1,374 @@
+/**
+ * @file precision.cpp
+ * @brief Implementación de las conversiones de precisión y de la reducción bf16
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "precision.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PRECISION_X86 1
+#include <immintrin.h>
+#endif
+
+#include "ajuste.h"
+
+namespace {
+
+/**
+ * @brief Funciones de conversión de una ruta SIMD
+ */
+struct RutaConversion {
+    void (*aFloat)(const double*, float*, int64_t);
+    void (*desdeFloat)(const float*, double*, int64_t);
+    void (*aBf16)(const double*, uint16_t*, int64_t);
+    void (*desdeBf16)(const uint16_t*, double*, int64_t);
+    void (*sumarBf16)(const uint16_t*, uint16_t*, int64_t);
+    const char* nombre;
+};
+
+/**
+ * @brief Redondea un float32 a bf16 al par más cercano
+ */
+inline uint16_t floatABf16(float valor) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &valor, sizeof(bits));
+    // El redondeo podría llevar un NaN a ±inf: se trunca y se fuerza NaN silencioso
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+        return static_cast<uint16_t>((bits >> 16) | 0x0040u);
+    }
+    bits += 0x7FFFu + ((bits >> 16) & 1u);
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+/**
+ * @brief Amplía un bf16 a float32 (exacto)
+ */
+inline float bf16AFloat(uint16_t valor) {
+    uint32_t bits = static_cast<uint32_t>(valor) << 16;
+    float resultado = 0.0f;
+    std::memcpy(&resultado, &bits, sizeof(resultado));
+    return resultado;
+}
+
+void aFloatEscalar(const double* origen, float* destino, int64_t n) {
+    for (int64_t i = 0; i < n; ++i) {
+        destino[i] = static_cast<float>(origen[i]);
+    }
+}
+
+void desdeFloatEscalar(const float* origen, double* destino, int64_t n) {
+    for (int64_t i = 0; i < n; ++i) {
+        destino[i] = static_cast<double>(origen[i]);
+    }
+}
+
+void aBf16Escalar(const double* origen, uint16_t* destino, int64_t n) {
+    for (int64_t i = 0; i < n; ++i) {
+        destino[i] = floatABf16(static_cast<float>(origen[i]));
+    }
+}
+
+void desdeBf16Escalar(const uint16_t* origen, double* destino, int64_t n) {
+    for (int64_t i = 0; i < n; ++i) {
+        destino[i] = static_cast<double>(bf16AFloat(origen[i]));
+    }
+}
+
+void sumarBf16Escalar(const uint16_t* origen, uint16_t* destino, int64_t n) {
+    for (int64_t i = 0; i < n; ++i) {
+        destino[i] = floatABf16(bf16AFloat(destino[i]) + bf16AFloat(origen[i]));
+    }
+}
+
+#if defined(PRECISION_X86)
+
+/**
+ * @brief Amplía 8 bf16 a float32
+ */
+__attribute__((target("avx2")))
+inline __m256 cargarBf16AVX2(const uint16_t* origen) {
+    __m128i valores = _mm_loadu_si128(reinterpret_cast<const __m128i*>(origen));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(valores), 16));
+}
+
+/**
+ * @brief Redondea 8 float32 a bf16 (al par más cercano) y los guarda
+ */
+__attribute__((target("avx2")))
+inline void guardarBf16AVX2(uint16_t* destino, __m256 valores) {
+    __m256i bits = _mm256_castps_si256(valores);
+    
+    // Redondeo al par: sumar 0x7FFF más el bit menos significativo que se conserva
+    __m256i par = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+    __m256i redondeados =
+        _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(_mm256_set1_epi32(0x7FFF), par)), 16);
+    
+    // Los NaN se truncan como NaN silenciosos, igual que en floatABf16
+    __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7FFFFFFF)),
+                                     _mm256_set1_epi32(0x7F800000));
+    __m256i silenciosos = _mm256_or_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(0x0040));
+    bits = _mm256_blendv_epi8(redondeados, silenciosos, nan);
+    
+    // Empaquetar los 8 valores de 16 bits en los 128 bits bajos
+    __m256i empaquetado = _mm256_permute4x64_epi64(_mm256_packus_epi32(bits, bits), 0x08);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destino), _mm256_castsi256_si128(empaquetado));
+}
+
+// Los intrínsecos AVX-512 de GCC 12 inicializan su valor "indefinido" consigo
+// mismo, lo que dispara falsos avisos de -Wmaybe-uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+__attribute__((target("avx512f")))
+inline __m512 cargarBf16AVX512(const uint16_t* origen) {
+    __m256i valores = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(origen));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(valores), 16));
+}
+
+__attribute__((target("avx512f")))
+inline void guardarBf16AVX512(uint16_t* destino, __m512 valores) {
+    __m512i bits = _mm512_castps_si512(valores);
+    __m512i par = _mm512_and_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(1));
+    __m512i redondeados =
+        _mm512_srli_epi32(_mm512_add_epi32(bits, _mm512_add_epi32(_mm512_set1_epi32(0x7FFF), par)), 16);
+    __mmask16 nan = _mm512_cmpgt_epi32_mask(_mm512_and_si512(bits, _mm512_set1_epi32(0x7FFFFFFF)),
+                                            _mm512_set1_epi32(0x7F800000));
+    __m512i silenciosos = _mm512_or_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(0x0040));
+    bits = _mm512_mask_blend_epi32(nan, redondeados, silenciosos);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destino), _mm512_cvtepi32_epi16(bits));
+}
+
+__attribute__((target("avx2")))
+void aFloatAVX2(const double* origen, float* destino, int64_t n) {
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm_storeu_ps(destino + i, _mm256_cvtpd_ps(_mm256_loadu_pd(origen + i)));
+        _mm_storeu_ps(destino + i + 4, _mm256_cvtpd_ps(_mm256_loadu_pd(origen + i + 4)));
+    }
+    aFloatEscalar(origen + i, destino + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void desdeFloatAVX2(const float* origen, double* destino, int64_t n) {
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_pd(destino + i, _mm256_cvtps_pd(_mm_loadu_ps(origen + i)));
+        _mm256_storeu_pd(destino + i + 4, _mm256_cvtps_pd(_mm_loadu_ps(origen + i + 4)));
+    }
+    desdeFloatEscalar(origen + i, destino + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void aBf16AVX2(const double* origen, uint16_t* destino, int64_t n) {
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128 bajo = _mm256_cvtpd_ps(_mm256_loadu_pd(origen + i));
+        __m128 alto = _mm256_cvtpd_ps(_mm256_loadu_pd(origen + i + 4));
+        guardarBf16AVX2(destino + i, _mm256_insertf128_ps(_mm256_castps128_ps256(bajo), alto, 1));
+    }
+    aBf16Escalar(origen + i, destino + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void desdeBf16AVX2(const uint16_t* origen, double* destino, int64_t n) {
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 floats = cargarBf16AVX2(origen + i);
+        _mm256_storeu_pd(destino + i, _mm256_cvtps_pd(_mm256_castps256_ps128(floats)));
+        _mm256_storeu_pd(destino + i + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(floats, 1)));
+    }
+    desdeBf16Escalar(origen + i, destino + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void sumarBf16AVX2(const uint16_t* origen, uint16_t* destino, int64_t n) {
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        guardarBf16AVX2(destino + i, _mm256_add_ps(cargarBf16AVX2(destino + i), cargarBf16AVX2(origen + i)));
+    }
+    sumarBf16Escalar(origen + i, destino + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void aFloatAVX512(const double* origen, float* destino, int64_t n) {
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm256_storeu_ps(destino + i, _mm512_cvtpd_ps(_mm512_loadu_pd(origen + i)));
+        _mm256_storeu_ps(destino + i + 8, _mm512_cvtpd_ps(_mm512_loadu_pd(origen + i + 8)));
+    }
+    aFloatEscalar(origen + i, destino + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void desdeFloatAVX512(const float* origen, double* destino, int64_t n) {
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_pd(destino + i, _mm512_cvtps_pd(_mm256_loadu_ps(origen + i)));
+        _mm512_storeu_pd(destino + i + 8, _mm512_cvtps_pd(_mm256_loadu_ps(origen + i + 8)));
+    }
+    desdeFloatEscalar(origen + i, destino + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void aBf16AVX512(const double* origen, uint16_t* destino, int64_t n) {
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 bajo = _mm512_cvtpd_ps(_mm512_loadu_pd(origen + i));
+        __m256 alto = _mm512_cvtpd_ps(_mm512_loadu_pd(origen + i + 8));
+        __m512d combinados = _mm512_insertf64x4(_mm512_castpd256_pd512(_mm256_castps_pd(bajo)),
+                                                _mm256_castps_pd(alto), 1);
+        guardarBf16AVX512(destino + i, _mm512_castpd_ps(combinados));
+    }
+    aBf16Escalar(origen + i, destino + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void desdeBf16AVX512(const uint16_t* origen, double* destino, int64_t n) {
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512d mitades = _mm512_castps_pd(cargarBf16AVX512(origen + i));
+        _mm512_storeu_pd(destino + i, _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_castpd512_pd256(mitades))));
+        _mm512_storeu_pd(destino + i + 8, _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(mitades, 1))));
+    }
+    desdeBf16Escalar(origen + i, destino + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void sumarBf16AVX512(const uint16_t* origen, uint16_t* destino, int64_t n) {
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        guardarBf16AVX512(destino + i, _mm512_add_ps(cargarBf16AVX512(destino + i), cargarBf16AVX512(origen + i)));
+    }
+    sumarBf16Escalar(origen + i, destino + i, n - i);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
+
+/**
+ * @brief Selecciona la mejor ruta disponible en la CPU actual
+ */
+RutaConversion seleccionarRuta() {
+#if defined(PRECISION_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return {aFloatAVX512, desdeFloatAVX512, aBf16AVX512, desdeBf16AVX512, sumarBf16AVX512,
+                "AVX-512"};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return {aFloatAVX2, desdeFloatAVX2, aBf16AVX2, desdeBf16AVX2, sumarBf16AVX2, "AVX2"};
+    }
+#endif
+    return {aFloatEscalar, desdeFloatEscalar, aBf16Escalar, desdeBf16Escalar, sumarBf16Escalar, "escalar"};
+}
+
+/**
+ * @brief Ruta elegida (se resuelve una sola vez por proceso)
+ */
+const RutaConversion& rutaActual() {
+    static const RutaConversion ruta = seleccionarRuta();
+    return ruta;
+}
+
+void reducirSumaBf16(void* entrada, void* salida, int* longitud, MPI_Datatype*) {
+    rutaActual().sumarBf16(static_cast<const uint16_t*>(entrada), static_cast<uint16_t*>(salida), *longitud);
+}
+
+} // namespace
+
+int64_t bytesPorElemento(PrecisionCarga precision) {
+    switch (precision) {
+        case PrecisionCarga::Simple:
+            return static_cast<int64_t>(sizeof(float));
+        case PrecisionCarga::Bf16:
+            return static_cast<int64_t>(sizeof(uint16_t));
+        case PrecisionCarga::Doble:
+            break;
+    }
+    return static_cast<int64_t>(sizeof(double));
+}
+
+void convertirAFloat(const double* origen, float* destino, int64_t n) {
+    rutaActual().aFloat(origen, destino, n);
+}
+
+void convertirDesdeFloat(const float* origen, double* destino, int64_t n) {
+    rutaActual().desdeFloat(origen, destino, n);
+}
+
+void convertirABf16(const double* origen, uint16_t* destino, int64_t n) {
+    rutaActual().aBf16(origen, destino, n);
+}
+
+void convertirDesdeBf16(const uint16_t* origen, double* destino, int64_t n) {
+    rutaActual().desdeBf16(origen, destino, n);
+}
+
+MPI_Datatype tipoBf16() {
+    static MPI_Datatype tipo = [] {
+        MPI_Datatype nuevo;
+        MPI_Type_contiguous(1, MPI_UINT16_T, &nuevo);
+        MPI_Type_commit(&nuevo);
+        return nuevo;
+    }();
+    return tipo;
+}
+
+MPI_Op opSumaBf16() {
+    static MPI_Op op = [] {
+        MPI_Op nueva;
+        MPI_Op_create(reducirSumaBf16, 1, &nueva);
+        return nueva;
+    }();
+    return op;
+}
+
+int reducirSumaConPrecision(const double* sendbuf, double* recvbuf, int64_t count, PrecisionCarga precision,
+                            void* envioReducido, void* recepcionReducida, int root, MPI_Comm comm) {
+    if (precision == PrecisionCarga::Doble) {
+        return reduceAjustado(sendbuf, recvbuf, count, MPI_DOUBLE, MPI_SUM, root, comm);
+    }
+    
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+    int error = MPI_SUCCESS;
+    if (precision == PrecisionCarga::Simple) {
+        convertirAFloat(sendbuf, static_cast<float*>(envioReducido), count);
+        error = reduceAjustado(envioReducido, recepcionReducida, count, MPI_FLOAT, MPI_SUM, root, comm);
+        if (error == MPI_SUCCESS && rank == root) {
+            convertirDesdeFloat(static_cast<const float*>(recepcionReducida), recvbuf, count);
+        }
+    } else {
+        convertirABf16(sendbuf, static_cast<uint16_t*>(envioReducido), count);
+        error = reduceAjustado(envioReducido, recepcionReducida, count, tipoBf16(), opSumaBf16(), root, comm);
+        if (error == MPI_SUCCESS && rank == root) {
+            convertirDesdeBf16(static_cast<const uint16_t*>(recepcionReducida), recvbuf, count);
+        }
+    }
+    return error;
+}
+
+const char* nombrePrecision(PrecisionCarga precision) {
+    switch (precision) {
+        case PrecisionCarga::Simple:
+            return "simple";
+        case PrecisionCarga::Bf16:
+            return "bf16";
+        case PrecisionCarga::Doble:
+            break;
+    }
+    return "doble";
+}
+
+const char* nombreRutaConversion() {
+    return rutaActual().nombre;
+}
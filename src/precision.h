@@ -0,0 +1,99 @@
+/**
+ * @file precision.h
+ * @brief Reducciones de vectores con la carga en precisión reducida (float32 o bf16)
+ * @author Emil M
+ * @date 2025
+ *
+ * Cuando el análisis tolera menos precisión, cada proceso convierte su vector
+ * de doubles a float32 o a bf16 con un núcleo vectorizado (AVX-512, AVX2 o
+ * escalar, elegido en tiempo de ejecución), la colectiva mueve la mitad o la
+ * cuarta parte de bytes y la raíz vuelve a convertir el resultado a double.
+ * bf16 no es un tipo MPI, así que se reduce con una operación propia que
+ * acumula cada combinación en float32 y redondea una sola vez a bf16.
+ */
+
+#ifndef MPI_AVANZADO_PRECISION_H
+#define MPI_AVANZADO_PRECISION_H
+
+#include <mpi.h>
+#include <cstdint>
+
+/**
+ * @brief Precisión de la carga de una reducción
+ */
+enum class PrecisionCarga : int32_t {
+    Doble,  ///< MPI_DOUBLE, sin conversión
+    Simple, ///< float32 (MPI_FLOAT), acumulado en float32
+    Bf16    ///< bfloat16 (8 bits de mantisa), acumulado en float32 en cada combinación
+};
+
+/**
+ * @brief Todas las precisiones, en el orden en que se comparan en los benchmarks
+ */
+const PrecisionCarga PRECISIONES_CARGA[] = {PrecisionCarga::Doble, PrecisionCarga::Simple, PrecisionCarga::Bf16};
+
+/**
+ * @brief Bytes por elemento de la carga
+ */
+int64_t bytesPorElemento(PrecisionCarga precision);
+
+/**
+ * @brief Convierte doubles a float32 (redondeo al más cercano)
+ */
+void convertirAFloat(const double* origen, float* destino, int64_t n);
+
+/**
+ * @brief Convierte float32 a doubles (exacto)
+ */
+void convertirDesdeFloat(const float* origen, double* destino, int64_t n);
+
+/**
+ * @brief Convierte doubles a bf16 (redondeo al par más cercano; los NaN no se conservan)
+ */
+void convertirABf16(const double* origen, uint16_t* destino, int64_t n);
+
+/**
+ * @brief Convierte bf16 a doubles (exacto)
+ */
+void convertirDesdeBf16(const uint16_t* origen, double* destino, int64_t n);
+
+/**
+ * @brief Tipo MPI de un valor bf16 (16 bits)
+ */
+MPI_Datatype tipoBf16();
+
+/**
+ * @brief Operación MPI conmutativa que suma valores bf16 acumulando en float32
+ */
+MPI_Op opSumaBf16();
+
+/**
+ * @brief MPI_Reduce con MPI_SUM de un vector de doubles con la carga en la precisión dada
+ * @param sendbuf Vector local de doubles
+ * @param recvbuf Resultado en doubles (solo significativo en la raíz)
+ * @param count Número de elementos
+ * @param precision Precisión de la carga
+ * @param envioReducido Buffer de count * bytesPorElemento() bytes para la carga local
+ * @param recepcionReducida Buffer del mismo tamaño para el resultado reducido (solo en la raíz)
+ * @param root Rank del proceso raíz
+ * @param comm Comunicador
+ * @return Código de error MPI
+ *
+ * Con PrecisionCarga::Doble los buffers reducidos no se usan. La reducción
+ * sigue la tabla de decisión activa (ajuste.h), con el tamaño en bytes de la
+ * carga ya convertida.
+ */
+int reducirSumaConPrecision(const double* sendbuf, double* recvbuf, int64_t count, PrecisionCarga precision,
+                            void* envioReducido, void* recepcionReducida, int root, MPI_Comm comm);
+
+/**
+ * @brief Nombre de una precisión de carga
+ */
+const char* nombrePrecision(PrecisionCarga precision);
+
+/**
+ * @brief Nombre de la ruta SIMD de conversión elegida
+ */
+const char* nombreRutaConversion();
+
+#endif // MPI_AVANZADO_PRECISION_H
@@ -0,0 +1,149 @@
+/**
+ * @file puntocontrol.cpp
+ * @brief Implementación de los puntos de control con MPI_File_write_at_all
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "puntocontrol.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+const uint64_t MAGIA_PUNTO_CONTROL = 0x4d50494350543032ULL; // "MPICPT02"
+
+/**
+ * @brief Registro de un proceso en el archivo
+ */
+struct RegistroDisco {
+    uint64_t magia;
+    int64_t epoca;
+    int32_t rank;
+    int32_t relleno;
+    EstadoPuntoControl estado;
+    uint64_t comprobacion; ///< FNV-1a de los campos anteriores
+};
+
+/**
+ * @brief Suma de comprobación FNV-1a de los bytes anteriores a la suma
+ */
+uint64_t comprobacionRegistro(const RegistroDisco& registro) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&registro);
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < offsetof(RegistroDisco, comprobacion); ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Indica si dos estados pertenecen a la misma ejecución
+ */
+bool mismaIdentidad(const EstadoPuntoControl& a, const EstadoPuntoControl& b) {
+    return a.semilla == b.semilla && a.procesos == b.procesos && a.tramos == b.tramos &&
+           a.inicioGlobal == b.inicioGlobal && a.conteo == b.conteo && a.conResumen == b.conResumen &&
+           a.modoSuma == b.modoSuma;
+}
+
+} // namespace
+
+PuntoControl::PuntoControl(const std::string& ruta, MPI_Comm comm) : comm_(comm) {
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &procesos_);
+    if (MPI_File_open(comm_, ruta.c_str(), MPI_MODE_CREATE | MPI_MODE_RDWR, MPI_INFO_NULL, &archivo_) !=
+        MPI_SUCCESS) {
+        archivo_ = MPI_FILE_NULL;
+    }
+}
+
+PuntoControl::~PuntoControl() {
+    if (archivo_ != MPI_FILE_NULL) {
+        MPI_File_close(&archivo_);
+    }
+}
+
+void PuntoControl::guardar(const EstadoPuntoControl& estado) {
+    if (archivo_ == MPI_FILE_NULL) {
+        return;
+    }
+    double inicio = MPI_Wtime();
+    ++epoca_;
+    
+    RegistroDisco registro;
+    std::memset(static_cast<void*>(&registro), 0, sizeof(registro));
+    registro.magia = MAGIA_PUNTO_CONTROL;
+    registro.epoca = epoca_;
+    registro.rank = rank_;
+    registro.estado = estado;
+    registro.comprobacion = comprobacionRegistro(registro);
+    
+    // La época e va a la ranura e % 2: la anterior sigue intacta hasta que
+    // esta termina de escribirse
+    MPI_Offset desplazamiento = static_cast<MPI_Offset>((epoca_ % 2) * procesos_ + rank_) *
+                                static_cast<MPI_Offset>(sizeof(RegistroDisco));
+    MPI_File_write_at_all(archivo_, desplazamiento, &registro, static_cast<int>(sizeof(registro)), MPI_BYTE,
+                          MPI_STATUS_IGNORE);
+    MPI_File_sync(archivo_);
+    
+    ++escrituras_;
+    tiempo_ += MPI_Wtime() - inicio;
+}
+
+bool PuntoControl::cargar(EstadoPuntoControl& estado) {
+    if (archivo_ == MPI_FILE_NULL) {
+        return false;
+    }
+    double inicio = MPI_Wtime();
+    
+    // Cada proceso lee sus dos ranuras; las que no existen se leen como ceros
+    RegistroDisco ranuras[2];
+    int64_t epocas[2] = {-1, -1};
+    int ajeno = 0;
+    for (int ranura = 0; ranura < 2; ++ranura) {
+        std::memset(static_cast<void*>(&ranuras[ranura]), 0, sizeof(RegistroDisco));
+        MPI_Offset desplazamiento = static_cast<MPI_Offset>(ranura * procesos_ + rank_) *
+                                    static_cast<MPI_Offset>(sizeof(RegistroDisco));
+        MPI_File_read_at_all(archivo_, desplazamiento, &ranuras[ranura], static_cast<int>(sizeof(RegistroDisco)),
+                             MPI_BYTE, MPI_STATUS_IGNORE);
+        const RegistroDisco& registro = ranuras[ranura];
+        if (registro.magia != MAGIA_PUNTO_CONTROL || registro.comprobacion != comprobacionRegistro(registro)) {
+            continue;
+        }
+        // Un registro íntegro de otro rank (otro número de procesos) o de otra
+        // identidad es de otra ejecución
+        if (registro.rank == rank_ && registro.epoca > 0 && registro.epoca % 2 == ranura &&
+            mismaIdentidad(registro.estado, estado)) {
+            epocas[ranura] = registro.epoca;
+        } else {
+            ajeno = 1;
+        }
+    }
+    
+    // Si el trabajo cayó a mitad de una escritura, unos procesos tienen la
+    // época e y otros solo la e - 1: la más reciente común es el mínimo de
+    // las más recientes, o la anterior si alguien no la tiene
+    int64_t masReciente = std::max(epocas[0], epocas[1]);
+    int64_t comun = 0;
+    MPI_Allreduce(&masReciente, &comun, 1, MPI_INT64_T, MPI_MIN, comm_);
+    bool cargado = false;
+    for (int64_t candidata = comun; candidata > 0 && candidata >= comun - 1 && !cargado; --candidata) {
+        int tengo = (epocas[candidata % 2] == candidata) ? 1 : 0;
+        int todos = 0;
+        MPI_Allreduce(&tengo, &todos, 1, MPI_INT, MPI_LAND, comm_);
+        if (todos) {
+            estado = ranuras[candidata % 2].estado;
+            epoca_ = candidata;
+            cargado = true;
+        }
+    }
+    
+    int algunAjeno = 0;
+    MPI_Allreduce(&ajeno, &algunAjeno, 1, MPI_INT, MPI_LOR, comm_);
+    descartadoPorIdentidad_ = !cargado && algunAjeno != 0;
+    
+    tiempo_ += MPI_Wtime() - inicio;
+    return cargado;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file puntocontrol.h
+ * @brief Puntos de control del modo streaming en un archivo compartido (MPI-IO)
+ * @author Emil M
+ * @date 2025
+ *
+ * En el modo streaming el estado de cada proceso cabe en unas decenas de
+ * bytes: la suma parcial (o el resumen) y la posición del generador, que al
+ * estar basado en contador es simplemente el índice global del siguiente
+ * valor. PuntoControl guarda ese estado de todos los procesos en un único
+ * archivo con MPI_File_write_at_all, cada proceso en su desplazamiento, y lo
+ * sincroniza con MPI_File_sync.
+ *
+ * El archivo tiene dos ranuras que se alternan: la escritura de la época e
+ * nunca pisa la e - 1, así que si el trabajo cae a mitad de una escritura
+ * queda intacta la anterior. Al reanudar, cada proceso valida sus dos
+ * registros (identidad y suma de comprobación) y se toma la época más
+ * reciente que es válida en todos los procesos. La identidad incluye el modo
+ * de reducción (--resumen y --suma): reanudar con otro modo daría un
+ * resultado que solo cubre los valores procesados tras la reanudación.
+ */
+
+#ifndef MPI_AVANZADO_PUNTOCONTROL_H
+#define MPI_AVANZADO_PUNTOCONTROL_H
+
+#include <mpi.h>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "resumen.h"
+#include "suma.h"
+
+/**
+ * @brief Estado de un proceso en un punto de control
+ *
+ * Los campos de identidad los rellena quien llama antes de guardar o de
+ * cargar; al cargar solo se acepta un registro con la misma identidad.
+ */
+struct EstadoPuntoControl {
+    // Identidad de la ejecución
+    uint64_t semilla = 0;        ///< Semilla del generador
+    int32_t procesos = 0;        ///< Procesos del comunicador
+    int32_t tramos = 0;          ///< Tramos en que se divide la generación
+    int64_t inicioGlobal = 0;    ///< Índice global del primer valor del proceso
+    int64_t conteo = 0;          ///< Valores del proceso
+    int32_t conResumen = 0;      ///< 1 si se acumula el resumen (--resumen)
+    int32_t modoSuma = 0;        ///< ModoSuma de las sumas parciales (--suma)
+    
+    // Progreso
+    int32_t tramo = 0;           ///< Tramos ya sumados
+    int32_t relleno = 0;
+    int64_t procesados = 0;      ///< Valores ya sumados: el generador sigue en inicioGlobal + procesados
+    SumaCompensada suma;         ///< Suma parcial de los valores procesados
+    ResumenValores resumen;      ///< Resumen de los valores procesados (si se pidió)
+};
+
+static_assert(std::is_trivially_copyable<EstadoPuntoControl>::value,
+              "EstadoPuntoControl se escribe como bytes y debe ser trivialmente copiable");
+
+/**
+ * @brief Archivo de puntos de control compartido por los procesos de un comunicador
+ */
+class PuntoControl {
+public:
+    /**
+     * @brief Abre (o crea) el archivo (operación colectiva sobre comm)
+     * @param ruta Ruta del archivo, la misma en todos los procesos
+     * @param comm Comunicador
+     */
+    PuntoControl(const std::string& ruta, MPI_Comm comm);
+    ~PuntoControl();
+    
+    PuntoControl(const PuntoControl&) = delete;
+    PuntoControl& operator=(const PuntoControl&) = delete;
+    
+    /**
+     * @brief Indica si el archivo se abrió
+     */
+    bool abierto() const { return archivo_ != MPI_FILE_NULL; }
+    
+    /**
+     * @brief Guarda el estado de todos los procesos como una época nueva (colectiva)
+     * @param estado Estado de este proceso
+     */
+    void guardar(const EstadoPuntoControl& estado);
+    
+    /**
+     * @brief Carga la época más reciente válida en todos los procesos (colectiva)
+     * @param estado Entrada: campos de identidad esperados; salida: estado guardado
+     * @return true si hay una época común; si no, estado no se modifica
+     */
+    bool cargar(EstadoPuntoControl& estado);
+    
+    /**
+     * @brief Indica si el último cargar() encontró registros válidos de otra ejecución
+     *
+     * Es igual en todos los procesos: sirve para avisar de que el archivo se
+     * ignoró (otros procesos, N, semilla o modo) en lugar de empezar de cero
+     * sin decir nada.
+     */
+    bool descartadoPorIdentidad() const { return descartadoPorIdentidad_; }
+    
+    /**
+     * @brief Épocas guardadas o cargada la última
+     */
+    int64_t epoca() const { return epoca_; }
+    
+    /**
+     * @brief Escrituras hechas desde que se abrió el archivo
+     */
+    int escrituras() const { return escrituras_; }
+    
+    /**
+     * @brief Tiempo dentro de guardar() y cargar() en segundos
+     */
+    double tiempo() const { return tiempo_; }
+
+private:
+    MPI_Comm comm_;
+    MPI_File archivo_ = MPI_FILE_NULL;
+    int rank_ = 0;
+    int procesos_ = 1;
+    int64_t epoca_ = 0;
+    int escrituras_ = 0;
+    double tiempo_ = 0.0;
+    bool descartadoPorIdentidad_ = false;
+};
+
+#endif // MPI_AVANZADO_PUNTOCONTROL_H
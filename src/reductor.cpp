@@ -0,0 +1,187 @@
+/**
+ * @file reductor.cpp
+ * @brief Núcleos locales de Reductor<T, Op> e instanciaciones explícitas
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "reductor.h"
+
+#include "suma.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define REDUCTOR_X86 1
+#endif
+
+namespace {
+
+/**
+ * @brief Núcleo local de un tipo y una operación
+ */
+template <typename T, typename A>
+using NucleoReduccion = A (*)(const T*, int64_t);
+
+/**
+ * @brief Reduce con 64 bytes de acumuladores independientes (dos registros AVX2)
+ *
+ * Los carriles no dependen unos de otros, así que el compilador convierte el
+ * bucle interno en operaciones SIMD sin reordenar la operación de cada carril.
+ */
+template <typename T, typename Op, typename A>
+inline A reducirCarriles(const T* datos, int64_t n) {
+    constexpr int CARRILES = 64 / static_cast<int>(sizeof(A));
+    A carriles[CARRILES];
+    for (int c = 0; c < CARRILES; ++c) {
+        carriles[c] = Op::template neutro<A>();
+    }
+    int64_t i = 0;
+    for (; i + CARRILES <= n; i += CARRILES) {
+        for (int c = 0; c < CARRILES; ++c) {
+            carriles[c] = Op::aplicar(carriles[c], static_cast<A>(datos[i + c]));
+        }
+    }
+    for (; i < n; ++i) {
+        carriles[0] = Op::aplicar(carriles[0], static_cast<A>(datos[i]));
+    }
+    for (int paso = CARRILES / 2; paso > 0; paso /= 2) {
+        for (int c = 0; c < paso; ++c) {
+            carriles[c] = Op::aplicar(carriles[c], carriles[c + paso]);
+        }
+    }
+    return carriles[0];
+}
+
+template <typename T, typename Op, typename A>
+A reducirEscalar(const T* datos, int64_t n) {
+    return reducirCarriles<T, Op, A>(datos, n);
+}
+
+#if defined(REDUCTOR_X86)
+
+template <typename T, typename Op, typename A>
+__attribute__((target("avx2")))
+A reducirAVX2(const T* datos, int64_t n) {
+    return reducirCarriles<T, Op, A>(datos, n);
+}
+
+/**
+ * @brief Indica si la CPU admite la ruta AVX2 (se consulta una sola vez)
+ */
+bool cpuAVX2() {
+    static const bool soportada = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return soportada;
+}
+
+#endif
+
+/**
+ * @brief Selecciona el núcleo de la mejor ruta disponible en la CPU actual
+ */
+template <typename T, typename Op, typename A>
+NucleoReduccion<T, A> seleccionarNucleo() {
+#if defined(REDUCTOR_X86)
+    if (cpuAVX2()) {
+        return reducirAVX2<T, Op, A>;
+    }
+#endif
+    return reducirEscalar<T, Op, A>;
+}
+
+} // namespace
+
+template <typename T, typename Op>
+typename Reductor<T, Op>::Acumulado Reductor<T, Op>::local(const T* datos, int64_t n) {
+    // El núcleo se resuelve una vez por instanciación, no en cada elemento
+    static const NucleoReduccion<T, Acumulado> nucleo = seleccionarNucleo<T, Op, Acumulado>();
+    return nucleo(datos, n);
+}
+
+template <>
+double Reductor<double, OpSuma>::local(const double* datos, int64_t n) {
+    return sumarRapido(datos, n);
+}
+
+template class Reductor<int32_t, OpSuma>;
+template class Reductor<int32_t, OpMinimo>;
+template class Reductor<int32_t, OpMaximo>;
+template class Reductor<int32_t, OpProducto>;
+template class Reductor<int64_t, OpSuma>;
+template class Reductor<int64_t, OpMinimo>;
+template class Reductor<int64_t, OpMaximo>;
+template class Reductor<int64_t, OpProducto>;
+template class Reductor<float, OpSuma>;
+template class Reductor<float, OpMinimo>;
+template class Reductor<float, OpMaximo>;
+template class Reductor<float, OpProducto>;
+template class Reductor<double, OpSuma>;
+template class Reductor<double, OpMinimo>;
+template class Reductor<double, OpMaximo>;
+template class Reductor<double, OpProducto>;
+
+int64_t bytesTipoDato(TipoDato tipo) {
+    switch (tipo) {
+        case TipoDato::Int32:
+            return 4;
+        case TipoDato::Int64:
+            return 8;
+        case TipoDato::Float:
+            return 4;
+        case TipoDato::Double:
+            return 8;
+    }
+    return 8;
+}
+
+MPI_Datatype tipoMpiDato(TipoDato tipo) {
+    switch (tipo) {
+        case TipoDato::Int32:
+            return MPI_INT32_T;
+        case TipoDato::Int64:
+            return MPI_INT64_T;
+        case TipoDato::Float:
+            return MPI_FLOAT;
+        case TipoDato::Double:
+            return MPI_DOUBLE;
+    }
+    return MPI_DOUBLE;
+}
+
+const char* nombreTipoDato(TipoDato tipo) {
+    switch (tipo) {
+        case TipoDato::Int32:
+            return "int32";
+        case TipoDato::Int64:
+            return "int64";
+        case TipoDato::Float:
+            return "float";
+        case TipoDato::Double:
+            return "double";
+    }
+    return "desconocido";
+}
+
+const char* nombreOperacion(OperacionReduccion operacion) {
+    switch (operacion) {
+        case OperacionReduccion::Suma:
+            return "suma";
+        case OperacionReduccion::Minimo:
+            return "min";
+        case OperacionReduccion::Maximo:
+            return "max";
+        case OperacionReduccion::Producto:
+            return "prod";
+    }
+    return "desconocida";
+}
+
+const char* nombreRutaReductor() {
+#if defined(REDUCTOR_X86)
+    if (cpuAVX2()) {
+        return "AVX2";
+    }
+#endif
+    return "escalar";
+}
@@ -0,0 +1,319 @@
+/**
+ * @file reductor.h
+ * @brief Reducciones especializadas en tiempo de compilación por tipo de elemento y operación
+ * @author Emil M
+ * @date 2025
+ *
+ * Reductor<T, Op> asocia a cada tipo de C++ su MPI_Datatype y a cada
+ * operación su MPI_Op, su elemento neutro y su combinación escalar, de modo
+ * que el núcleo local y la colectiva se eligen al compilar y el bucle interno
+ * no despacha nada en tiempo de ejecución. Cubre int32, int64, float y double
+ * con suma, mínimo, máximo y producto.
+ *
+ * El núcleo local usa varios acumuladores independientes que el compilador
+ * vectoriza (con una versión AVX2 elegida una vez según la CPU); la suma de
+ * doubles reutiliza el núcleo SIMD de suma.h. Las sumas de int32 se acumulan
+ * en int64 y las de float en double para que el resultado no desborde ni
+ * pierda precisión con N grande.
+ */
+
+#ifndef MPI_AVANZADO_REDUCTOR_H
+#define MPI_AVANZADO_REDUCTOR_H
+
+#include <mpi.h>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "colectivas.h"
+
+/**
+ * @brief Tipo de elemento de un Reductor, para elegirlo en tiempo de ejecución
+ */
+enum class TipoDato : int32_t {
+    Int32,
+    Int64,
+    Float,
+    Double
+};
+
+/**
+ * @brief Todos los tipos de elemento, en el orden en que se comparan en los benchmarks
+ */
+const TipoDato TIPOS_DATO[] = {TipoDato::Int32, TipoDato::Int64, TipoDato::Float, TipoDato::Double};
+
+/**
+ * @brief Operación de un Reductor
+ */
+enum class OperacionReduccion : int32_t {
+    Suma,
+    Minimo,
+    Maximo,
+    Producto
+};
+
+/**
+ * @brief Todas las operaciones, en el orden en que se comparan en los benchmarks
+ */
+const OperacionReduccion OPERACIONES_REDUCCION[] = {OperacionReduccion::Suma, OperacionReduccion::Minimo,
+                                                     OperacionReduccion::Maximo, OperacionReduccion::Producto};
+
+/**
+ * @brief Correspondencia entre un tipo de C++ y su tipo MPI
+ */
+template <typename T>
+struct TipoMpi;
+
+template <>
+struct TipoMpi<int32_t> {
+    static MPI_Datatype tipo() { return MPI_INT32_T; }
+    static constexpr TipoDato dato = TipoDato::Int32;
+};
+
+template <>
+struct TipoMpi<int64_t> {
+    static MPI_Datatype tipo() { return MPI_INT64_T; }
+    static constexpr TipoDato dato = TipoDato::Int64;
+};
+
+template <>
+struct TipoMpi<float> {
+    static MPI_Datatype tipo() { return MPI_FLOAT; }
+    static constexpr TipoDato dato = TipoDato::Float;
+};
+
+template <>
+struct TipoMpi<double> {
+    static MPI_Datatype tipo() { return MPI_DOUBLE; }
+    static constexpr TipoDato dato = TipoDato::Double;
+};
+
+/**
+ * @brief Suma
+ */
+struct OpSuma {
+    static constexpr OperacionReduccion operacion = OperacionReduccion::Suma;
+    static MPI_Op mpi() { return MPI_SUM; }
+    template <typename T>
+    static constexpr T neutro() { return T(0); }
+    template <typename T>
+    static T aplicar(T a, T b) { return a + b; }
+};
+
+/**
+ * @brief Mínimo
+ */
+struct OpMinimo {
+    static constexpr OperacionReduccion operacion = OperacionReduccion::Minimo;
+    static MPI_Op mpi() { return MPI_MIN; }
+    template <typename T>
+    static constexpr T neutro() {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                    : std::numeric_limits<T>::max();
+    }
+    template <typename T>
+    static T aplicar(T a, T b) { return b < a ? b : a; }
+};
+
+/**
+ * @brief Máximo
+ */
+struct OpMaximo {
+    static constexpr OperacionReduccion operacion = OperacionReduccion::Maximo;
+    static MPI_Op mpi() { return MPI_MAX; }
+    template <typename T>
+    static constexpr T neutro() {
+        return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                                    : std::numeric_limits<T>::lowest();
+    }
+    template <typename T>
+    static T aplicar(T a, T b) { return a < b ? b : a; }
+};
+
+/**
+ * @brief Producto (en enteros, módulo 2^bits: el desbordamiento no es comportamiento indefinido)
+ */
+struct OpProducto {
+    static constexpr OperacionReduccion operacion = OperacionReduccion::Producto;
+    static MPI_Op mpi() { return MPI_PROD; }
+    template <typename T>
+    static constexpr T neutro() { return T(1); }
+    template <typename T>
+    static T aplicar(T a, T b) {
+        if constexpr (std::is_integral<T>::value) {
+            using SinSigno = typename std::make_unsigned<T>::type;
+            return static_cast<T>(static_cast<SinSigno>(a) * static_cast<SinSigno>(b));
+        } else {
+            return a * b;
+        }
+    }
+};
+
+/**
+ * @brief Tipo en que se acumula el resultado local de la operación Op sobre T
+ *
+ * Por defecto el propio T; la suma de int32 se acumula en int64 y la de
+ * float en double.
+ */
+template <typename T, typename Op>
+struct AcumuladoReduccion {
+    using tipo = T;
+};
+
+template <>
+struct AcumuladoReduccion<int32_t, OpSuma> {
+    using tipo = int64_t;
+};
+
+template <>
+struct AcumuladoReduccion<float, OpSuma> {
+    using tipo = double;
+};
+
+/**
+ * @brief Reducción de elementos T con la operación Op
+ */
+template <typename T, typename Op>
+class Reductor {
+public:
+    using Tipo = T;                                              ///< Tipo de los elementos
+    using Acumulado = typename AcumuladoReduccion<T, Op>::tipo;  ///< Tipo del resultado local
+    
+    /**
+     * @brief Tipo MPI de los elementos
+     */
+    static MPI_Datatype tipoMpi() { return TipoMpi<T>::tipo(); }
+    
+    /**
+     * @brief Operación MPI predefinida equivalente
+     */
+    static MPI_Op opMpi() { return Op::mpi(); }
+    
+    /**
+     * @brief Elemento neutro del resultado local (resultado de local() con n = 0)
+     */
+    static constexpr Acumulado neutro() { return Op::template neutro<Acumulado>(); }
+    
+    /**
+     * @brief Combina dos resultados locales
+     */
+    static Acumulado combinar(Acumulado a, Acumulado b) { return Op::aplicar(a, b); }
+    
+    /**
+     * @brief Reduce localmente n elementos con el núcleo vectorizado
+     * @param datos Puntero a los elementos
+     * @param n Número de elementos
+     * @return Resultado local en el tipo acumulado
+     */
+    static Acumulado local(const T* datos, int64_t n);
+    
+    /**
+     * @brief Reduce elemento a elemento vectores de T en la raíz (sin límite de 2^31 elementos)
+     * @return Código de error MPI
+     */
+    static int reducir(const T* envio, T* recepcion, int64_t count, int root, MPI_Comm comm) {
+        return reduceGrande(envio, recepcion, count, tipoMpi(), opMpi(), root, comm);
+    }
+    
+    /**
+     * @brief Reduce elemento a elemento vectores de T dejando el resultado en todos los procesos
+     * @return Código de error MPI
+     */
+    static int reducirEnTodos(const T* envio, T* recepcion, int64_t count, MPI_Comm comm) {
+        return allreduceGrande(envio, recepcion, count, tipoMpi(), opMpi(), comm);
+    }
+    
+    /**
+     * @brief Reduce localmente los elementos del proceso y después los resultados de todos
+     * @param datos Elementos del proceso
+     * @param n Número de elementos del proceso
+     * @param root Rank del proceso raíz
+     * @param comm Comunicador
+     * @return Resultado global (solo significativo en la raíz)
+     */
+    static Acumulado reducirGlobal(const T* datos, int64_t n, int root, MPI_Comm comm) {
+        Acumulado parcial = local(datos, n);
+        Acumulado global = neutro();
+        MPI_Reduce(&parcial, &global, 1, TipoMpi<Acumulado>::tipo(), opMpi(), root, comm);
+        return global;
+    }
+};
+
+/**
+ * @brief La suma de doubles usa el núcleo SIMD de suma.h (AVX-512, AVX2 o NEON)
+ */
+template <>
+double Reductor<double, OpSuma>::local(const double* datos, int64_t n);
+
+/**
+ * @brief Llama a funcion con un valor del tipo de C++ que corresponde a tipo
+ *
+ * Es el único despacho en tiempo de ejecución: dentro de funcion el tipo es
+ * un parámetro de plantilla, por ejemplo
+ * `conTipoDato(tipo, [&](auto valor) { using T = decltype(valor); ... })`.
+ */
+template <typename Funcion>
+void conTipoDato(TipoDato tipo, Funcion&& funcion) {
+    switch (tipo) {
+        case TipoDato::Int32:
+            funcion(int32_t());
+            break;
+        case TipoDato::Int64:
+            funcion(int64_t());
+            break;
+        case TipoDato::Float:
+            funcion(float());
+            break;
+        case TipoDato::Double:
+            funcion(double());
+            break;
+    }
+}
+
+/**
+ * @brief Llama a funcion con un valor de la estructura de operación que corresponde a operacion
+ */
+template <typename Funcion>
+void conOperacion(OperacionReduccion operacion, Funcion&& funcion) {
+    switch (operacion) {
+        case OperacionReduccion::Suma:
+            funcion(OpSuma());
+            break;
+        case OperacionReduccion::Minimo:
+            funcion(OpMinimo());
+            break;
+        case OperacionReduccion::Maximo:
+            funcion(OpMaximo());
+            break;
+        case OperacionReduccion::Producto:
+            funcion(OpProducto());
+            break;
+    }
+}
+
+/**
+ * @brief Bytes de un elemento del tipo
+ */
+int64_t bytesTipoDato(TipoDato tipo);
+
+/**
+ * @brief Tipo MPI de un elemento del tipo
+ */
+MPI_Datatype tipoMpiDato(TipoDato tipo);
+
+/**
+ * @brief Nombre de un tipo de elemento ("int32", "int64", "float" o "double")
+ */
+const char* nombreTipoDato(TipoDato tipo);
+
+/**
+ * @brief Nombre de una operación ("suma", "min", "max" o "prod")
+ */
+const char* nombreOperacion(OperacionReduccion operacion);
+
+/**
+ * @brief Nombre de la ruta del núcleo local elegida en esta CPU ("AVX2" o "escalar")
+ */
+const char* nombreRutaReductor();
+
+#endif // MPI_AVANZADO_REDUCTOR_H
@@ -0,0 +1,181 @@
+/**
+ * @file reparto.cpp
+ * @brief Implementación del reparto exacto y del reequilibrado de carga
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "reparto.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+/**
+ * @brief Rellena los desplazamientos como suma prefija de los conteos
+ */
+void calcularDesplazamientos(RepartoCarga& reparto) {
+    reparto.desplazamientos.assign(reparto.conteos.size(), 0);
+    int64_t acumulado = 0;
+    for (size_t i = 0; i < reparto.conteos.size(); ++i) {
+        reparto.desplazamientos[i] = acumulado;
+        acumulado += reparto.conteos[i];
+    }
+}
+
+#if MPI_VERSION < 4
+/**
+ * @brief Copia conteos y desplazamientos a int si todos caben
+ */
+bool repartoEnInt(const RepartoCarga& reparto, std::vector<int>& conteos, std::vector<int>& desplazamientos) {
+    if (reparto.total() > INT_MAX) {
+        return false;
+    }
+    conteos.assign(reparto.conteos.begin(), reparto.conteos.end());
+    desplazamientos.assign(reparto.desplazamientos.begin(), reparto.desplazamientos.end());
+    return true;
+}
+#endif
+
+} // namespace
+
+RepartoCarga repartoUniforme(int64_t total, int numProcs) {
+    RepartoCarga reparto;
+    reparto.conteos.assign(numProcs, total / numProcs);
+    for (int64_t i = 0; i < total % numProcs; ++i) {
+        ++reparto.conteos[i];
+    }
+    calcularDesplazamientos(reparto);
+    return reparto;
+}
+
+RepartoCarga repartoPonderado(int64_t total, const std::vector<double>& pesos) {
+    const int numProcs = static_cast<int>(pesos.size());
+    double sumaPesos = 0.0;
+    for (double peso : pesos) {
+        sumaPesos += std::max(peso, 0.0);
+    }
+    if (!(sumaPesos > 0.0) || !std::isfinite(sumaPesos)) {
+        return repartoUniforme(total, numProcs);
+    }
+    
+    // Parte entera de cada cuota y, para el resto, el mayor resto primero
+    // (los empates favorecen al rank menor para que el resultado sea determinista)
+    RepartoCarga reparto;
+    reparto.conteos.assign(numProcs, 0);
+    std::vector<double> restos(numProcs, 0.0);
+    int64_t asignados = 0;
+    for (int i = 0; i < numProcs; ++i) {
+        double cuota = static_cast<double>(total) * (std::max(pesos[i], 0.0) / sumaPesos);
+        double entera = std::floor(cuota);
+        reparto.conteos[i] = std::min(static_cast<int64_t>(entera), total - asignados);
+        restos[i] = cuota - entera;
+        asignados += reparto.conteos[i];
+    }
+    
+    std::vector<int> orden(numProcs);
+    std::iota(orden.begin(), orden.end(), 0);
+    std::stable_sort(orden.begin(), orden.end(), [&](int a, int b) { return restos[a] > restos[b]; });
+    for (int64_t i = 0; asignados < total; ++i) {
+        ++reparto.conteos[orden[i % numProcs]];
+        ++asignados;
+    }
+    
+    calcularDesplazamientos(reparto);
+    return reparto;
+}
+
+RepartoCarga rebalancearReparto(const RepartoCarga& actual, double segundosLocales, MPI_Comm comm,
+                                double suavizado) {
+    const int numProcs = static_cast<int>(actual.conteos.size());
+    std::vector<double> segundos(numProcs, 0.0);
+    MPI_Allgather(&segundosLocales, 1, MPI_DOUBLE, segundos.data(), 1, MPI_DOUBLE, comm);
+    
+    // Rendimiento en elementos por segundo de los procesos que tenían trabajo
+    std::vector<double> rendimientos(numProcs, 0.0);
+    double sumaMedidos = 0.0;
+    int medidos = 0;
+    for (int i = 0; i < numProcs; ++i) {
+        if (actual.conteos[i] > 0 && segundos[i] > 0.0) {
+            rendimientos[i] = static_cast<double>(actual.conteos[i]) / segundos[i];
+            sumaMedidos += rendimientos[i];
+            ++medidos;
+        }
+    }
+    if (medidos == 0) {
+        return actual;
+    }
+    double rendimientoMedio = sumaMedidos / medidos;
+    double sumaRendimientos = 0.0;
+    for (int i = 0; i < numProcs; ++i) {
+        if (rendimientos[i] <= 0.0) {
+            rendimientos[i] = rendimientoMedio;
+        }
+        sumaRendimientos += rendimientos[i];
+    }
+    
+    // Mezcla de la fracción actual y la proporcional al rendimiento. Todos
+    // los procesos hacen el mismo cálculo sobre los mismos datos, así que el
+    // reparto resultante es idéntico sin más comunicación
+    const double total = static_cast<double>(actual.total());
+    const double alfa = std::min(std::max(suavizado, 0.0), 1.0);
+    std::vector<double> pesos(numProcs, 0.0);
+    for (int i = 0; i < numProcs; ++i) {
+        double fraccionActual = total > 0.0 ? static_cast<double>(actual.conteos[i]) / total : 0.0;
+        pesos[i] = (1.0 - alfa) * fraccionActual + alfa * rendimientos[i] / sumaRendimientos;
+    }
+    return repartoPonderado(actual.total(), pesos);
+}
+
+double desequilibrioCarga(const std::vector<double>& segundos) {
+    if (segundos.empty()) {
+        return 0.0;
+    }
+    double maximo = *std::max_element(segundos.begin(), segundos.end());
+    double media = std::accumulate(segundos.begin(), segundos.end(), 0.0) / static_cast<double>(segundos.size());
+    return media > 0.0 ? maximo / media - 1.0 : 0.0;
+}
+
+int scattervReparto(const void* sendbuf, void* recvbuf, const RepartoCarga& reparto,
+                    MPI_Datatype datatype, int root, MPI_Comm comm) {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+#if MPI_VERSION >= 4
+    std::vector<MPI_Count> conteos(reparto.conteos.begin(), reparto.conteos.end());
+    std::vector<MPI_Aint> desplazamientos(reparto.desplazamientos.begin(), reparto.desplazamientos.end());
+    return MPI_Scatterv_c(sendbuf, conteos.data(), desplazamientos.data(), datatype, recvbuf,
+                          conteos[rank], datatype, root, comm);
+#else
+    // Antes de MPI-4 los conteos y desplazamientos de MPI_Scatterv son int
+    std::vector<int> conteos;
+    std::vector<int> desplazamientos;
+    if (!repartoEnInt(reparto, conteos, desplazamientos)) {
+        return MPI_ERR_COUNT;
+    }
+    return MPI_Scatterv(sendbuf, conteos.data(), desplazamientos.data(), datatype, recvbuf,
+                        conteos[rank], datatype, root, comm);
+#endif
+}
+
+int gathervReparto(const void* sendbuf, void* recvbuf, const RepartoCarga& reparto,
+                   MPI_Datatype datatype, int root, MPI_Comm comm) {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+#if MPI_VERSION >= 4
+    std::vector<MPI_Count> conteos(reparto.conteos.begin(), reparto.conteos.end());
+    std::vector<MPI_Aint> desplazamientos(reparto.desplazamientos.begin(), reparto.desplazamientos.end());
+    return MPI_Gatherv_c(sendbuf, conteos[rank], datatype, recvbuf, conteos.data(),
+                         desplazamientos.data(), datatype, root, comm);
+#else
+    std::vector<int> conteos;
+    std::vector<int> desplazamientos;
+    if (!repartoEnInt(reparto, conteos, desplazamientos)) {
+        return MPI_ERR_COUNT;
+    }
+    return MPI_Gatherv(sendbuf, conteos[rank], datatype, recvbuf, conteos.data(),
+                       desplazamientos.data(), datatype, root, comm);
+#endif
+}
@@ -0,0 +1,102 @@
+/**
+ * @file reparto.h
+ * @brief Reparto exacto de N elementos entre procesos con carga variable
+ * @author Emil M
+ * @date 2025
+ *
+ * Un reparto es el par de vectores conteos/desplazamientos de MPI_Scatterv:
+ * el proceso i se encarga de los elementos globales
+ * [desplazamientos[i], desplazamientos[i] + conteos[i]) y la suma de los
+ * conteos es exactamente N, sin relleno. Los conteos pueden ponderarse por el
+ * rendimiento medido de cada proceso y recalcularse entre iteraciones para
+ * llevar trabajo de los procesos lentos a los rápidos.
+ */
+
+#ifndef MPI_AVANZADO_REPARTO_H
+#define MPI_AVANZADO_REPARTO_H
+
+#include <mpi.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Conteos y desplazamientos (en elementos) de cada proceso
+ */
+struct RepartoCarga {
+    std::vector<int64_t> conteos;         ///< Elementos de cada proceso
+    std::vector<int64_t> desplazamientos; ///< Primer elemento global de cada proceso
+    
+    /**
+     * @brief Número total de elementos repartidos
+     */
+    int64_t total() const {
+        return conteos.empty() ? 0 : desplazamientos.back() + conteos.back();
+    }
+};
+
+/**
+ * @brief Reparte total elementos lo más uniformemente posible
+ * @param total Número total de elementos
+ * @param numProcs Número de procesos
+ * @return Reparto en el que los primeros total % numProcs procesos tienen uno más
+ */
+RepartoCarga repartoUniforme(int64_t total, int numProcs);
+
+/**
+ * @brief Reparte total elementos en proporción a unos pesos
+ * @param total Número total de elementos
+ * @param pesos Peso no negativo de cada proceso (si todos son 0, reparto uniforme)
+ * @return Reparto exacto por el método del mayor resto
+ */
+RepartoCarga repartoPonderado(int64_t total, const std::vector<double>& pesos);
+
+/**
+ * @brief Recalcula el reparto según el rendimiento medido en la última iteración
+ * @param actual Reparto usado en la iteración medida (el mismo en todos los procesos)
+ * @param segundosLocales Tiempo que tardó este proceso en procesar su parte
+ * @param comm Comunicador (operación colectiva: un MPI_Allgather)
+ * @param suavizado Fracción en [0, 1] del nuevo reparto que se toma del
+ *                  rendimiento medido; el resto se conserva del actual para no
+ *                  oscilar por el ruido de una sola medida
+ * @return Nuevo reparto, idéntico en todos los procesos
+ *
+ * El rendimiento de cada proceso es conteos[i] / segundos[i]. Un proceso sin
+ * elementos no tiene medida y se le asigna el rendimiento medio del resto.
+ */
+RepartoCarga rebalancearReparto(const RepartoCarga& actual, double segundosLocales, MPI_Comm comm,
+                                double suavizado = 0.5);
+
+/**
+ * @brief Desequilibrio de un conjunto de tiempos por proceso
+ * @param segundos Tiempo de cada proceso
+ * @return max / media - 1 (0 = perfectamente equilibrado)
+ */
+double desequilibrioCarga(const std::vector<double>& segundos);
+
+/**
+ * @brief MPI_Scatterv con los conteos y desplazamientos de un reparto
+ * @param sendbuf Datos completos (solo significativo en la raíz)
+ * @param recvbuf Buffer local de al menos reparto.conteos[rank] elementos
+ * @param reparto Reparto (el mismo en todos los procesos)
+ * @param datatype Tipo de dato de cada elemento
+ * @param root Proceso raíz
+ * @param comm Comunicador
+ * @return Código de error MPI (MPI_ERR_COUNT si no cabe en int antes de MPI-4)
+ */
+int scattervReparto(const void* sendbuf, void* recvbuf, const RepartoCarga& reparto,
+                    MPI_Datatype datatype, int root, MPI_Comm comm);
+
+/**
+ * @brief MPI_Gatherv con los conteos y desplazamientos de un reparto
+ * @param sendbuf Datos locales (reparto.conteos[rank] elementos)
+ * @param recvbuf Buffer completo (solo significativo en la raíz)
+ * @param reparto Reparto (el mismo en todos los procesos)
+ * @param datatype Tipo de dato de cada elemento
+ * @param root Proceso raíz
+ * @param comm Comunicador
+ * @return Código de error MPI (MPI_ERR_COUNT si no cabe en int antes de MPI-4)
+ */
+int gathervReparto(const void* sendbuf, void* recvbuf, const RepartoCarga& reparto,
+                   MPI_Datatype datatype, int root, MPI_Comm comm);
+
+#endif // MPI_AVANZADO_REPARTO_H
@@ -0,0 +1,430 @@
+/**
+ * @file resiliencia.cpp
+ * @brief Implementación de la reducción resiliente (ULFM o plazos con MPI_Test)
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "resiliencia.h"
+
+#include <algorithm>
+#include <thread>
+
+#if defined(__has_include)
+#if __has_include(<mpi-ext.h>)
+#include <mpi-ext.h>
+#endif
+#endif
+
+// Open MPI y MPICH declaran MPIX_ERR_PROC_FAILED solo si se compilaron con ULFM
+#if defined(MPIX_ERR_PROC_FAILED)
+#define MPI_AVANZADO_ULFM 1
+#endif
+
+namespace {
+
+const int ETIQUETA_CONTRIBUCION = 7301;
+const int ETIQUETA_RESULTADO = 7302;
+const int ETIQUETA_GRUPO = 7303;
+
+// Contribución: suma, cuenta y época. Resultado: suma, cuenta, procesos
+// incluidos, completa (0 o 1), época y una máscara de incluidos por rank
+const int CAMPOS_CONTRIBUCION = 3;
+const int CAMPOS_RESULTADO = 5;
+
+} // namespace
+
+bool ulfmDisponible() {
+#ifdef MPI_AVANZADO_ULFM
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool esperarConPlazo(MPI_Request* peticion, double plazo, int* codigo) {
+    double limite = MPI_Wtime() + plazo;
+    while (true) {
+        int hecho = 0;
+        int error = MPI_Test(peticion, &hecho, MPI_STATUS_IGNORE);
+        if (codigo != nullptr) {
+            *codigo = error;
+        }
+        if (error != MPI_SUCCESS) {
+            return false;
+        }
+        if (hecho) {
+            return true;
+        }
+        if (MPI_Wtime() >= limite) {
+            return false;
+        }
+        // Con más procesos que núcleos el proceso esperado necesita la CPU
+        std::this_thread::yield();
+    }
+}
+
+ReduccionResiliente::ReduccionResiliente(MPI_Comm comm, double plazo) : plazo_(plazo) {
+    MPI_Comm_group(comm, &grupoOriginal_);
+    MPI_Comm copia;
+    MPI_Comm_dup(comm, &copia);
+    reemplazarComunicadores(copia);
+}
+
+ReduccionResiliente::~ReduccionResiliente() {
+    // Un proceso que llegó tarde pero sigue vivo acaba entrando en la colectiva
+    // abandonada: se le da un plazo más para que se complete. Lo que siga
+    // pendiente (un proceso caído sin ULFM) no se completará nunca: sus
+    // buffers y sus comunicadores se dejan sin liberar
+    bool pendientes = false;
+    for (PeticionAbandonada& abandonada : abandonadas_) {
+        bool hechas = true;
+        for (MPI_Request& peticion : abandonada.peticiones) {
+            hechas &= esperarConPlazo(&peticion, plazo_);
+        }
+        if (!hechas) {
+            abandonada.buffer.release();
+            pendientes = true;
+        }
+    }
+    if (!pendientes) {
+        for (MPI_Comm& retirado : retirados_) {
+            MPI_Comm_free(&retirado);
+        }
+        if (colectiva_ != MPI_COMM_NULL) {
+            MPI_Comm_free(&recuperacion_);
+            MPI_Comm_free(&colectiva_);
+        }
+    }
+    MPI_Group_free(&grupoOriginal_);
+}
+
+void ReduccionResiliente::reemplazarComunicadores(MPI_Comm nuevo) {
+    // Los comunicadores anteriores pueden tener colectivas abandonadas: se
+    // liberan en el destructor, cuando ya no queda ninguna pendiente
+    if (colectiva_ != MPI_COMM_NULL) {
+        retirados_.push_back(colectiva_);
+        retirados_.push_back(recuperacion_);
+    }
+    colectiva_ = nuevo;
+    MPI_Comm_set_errhandler(colectiva_, MPI_ERRORS_RETURN);
+    MPI_Comm_dup(colectiva_, &recuperacion_);
+    MPI_Comm_set_errhandler(recuperacion_, MPI_ERRORS_RETURN);
+    MPI_Comm_size(colectiva_, &procesosVivos_);
+}
+
+std::vector<int> ReduccionResiliente::rangosOriginales(MPI_Comm comm) const {
+    MPI_Group grupo;
+    MPI_Comm_group(comm, &grupo);
+    int tamano = 0;
+    MPI_Group_size(grupo, &tamano);
+    std::vector<int> locales(tamano);
+    std::vector<int> originales(tamano);
+    for (int i = 0; i < tamano; ++i) {
+        locales[i] = i;
+    }
+    MPI_Group_translate_ranks(grupo, tamano, locales.data(), grupoOriginal_, originales.data());
+    MPI_Group_free(&grupo);
+    return originales;
+}
+
+void ReduccionResiliente::abandonar(PeticionAbandonada peticion) {
+    int hechas = 0;
+    MPI_Testall(static_cast<int>(peticion.peticiones.size()), peticion.peticiones.data(), &hechas,
+                MPI_STATUSES_IGNORE);
+    if (!hechas) {
+        abandonadas_.push_back(std::move(peticion));
+    }
+}
+
+ResultadoResiliente ReduccionResiliente::reducir(double suma, int64_t cuenta) {
+    ResultadoResiliente resultado;
+    if (participa_ && leerAvisosAtrasados()) {
+        participa_ = false;
+    }
+    if (!participa_) {
+        resultado.estado = EstadoResiliente::Excluido;
+        return resultado;
+    }
+    
+    // Las peticiones abandonadas que ya terminaron liberan sus buffers
+    abandonadas_.erase(std::remove_if(abandonadas_.begin(), abandonadas_.end(),
+                                      [](PeticionAbandonada& abandonada) {
+                                          int hechas = 0;
+                                          MPI_Testall(static_cast<int>(abandonada.peticiones.size()),
+                                                      abandonada.peticiones.data(), &hechas,
+                                                      MPI_STATUSES_IGNORE);
+                                          return hechas != 0;
+                                      }),
+                       abandonadas_.end());
+    ++epoca_;
+#ifdef MPI_AVANZADO_ULFM
+    return reducirUlfm(suma, cuenta);
+#else
+    return reducirConPlazo(suma, cuenta);
+#endif
+}
+
+#ifdef MPI_AVANZADO_ULFM
+ResultadoResiliente ReduccionResiliente::reducirUlfm(double suma, int64_t cuenta) {
+    ResultadoResiliente resultado;
+    std::vector<int> iniciales = rangosOriginales(colectiva_);
+    double envio[2] = {suma, static_cast<double>(cuenta)};
+    double recepcion[2] = {0.0, 0.0};
+    
+    while (true) {
+        int codigo = MPI_Allreduce(envio, recepcion, 2, MPI_DOUBLE, MPI_SUM, colectiva_);
+        
+        // Un fallo durante la colectiva puede verse solo en algunos procesos:
+        // se acuerda entre todos si el resultado vale antes de usarlo
+        int correcto = (codigo == MPI_SUCCESS) ? 1 : 0;
+        int acuerdo = MPIX_Comm_agree(colectiva_, &correcto);
+        if (acuerdo == MPI_SUCCESS && correcto) {
+            break;
+        }
+        
+        // Revocar despierta a los procesos que sigan dentro de colectivas del
+        // comunicador; shrink crea otro solo con los vivos
+        MPIX_Comm_revoke(colectiva_);
+        MPIX_Comm_revoke(recuperacion_);
+        MPI_Comm reducido;
+        if (MPIX_Comm_shrink(colectiva_, &reducido) != MPI_SUCCESS) {
+            resultado.estado = EstadoResiliente::SinRaiz;
+            return resultado;
+        }
+        reemplazarComunicadores(reducido);
+    }
+    
+    std::vector<int> finales = rangosOriginales(colectiva_);
+    for (int original : iniciales) {
+        if (std::find(finales.begin(), finales.end(), original) == finales.end()) {
+            resultado.procesosPerdidos.push_back(original);
+        }
+    }
+    resultado.suma = recepcion[0];
+    resultado.cuenta = static_cast<int64_t>(recepcion[1]);
+    resultado.procesosIncluidos = procesosVivos_;
+    resultado.estado = resultado.procesosPerdidos.empty() ? EstadoResiliente::Completa
+                                                          : EstadoResiliente::Reducida;
+    return resultado;
+}
+#endif
+
+bool ReduccionResiliente::leerAvisosAtrasados() {
+    int rank = 0;
+    MPI_Comm_rank(recuperacion_, &rank);
+    if (rank == 0) {
+        return false;
+    }
+    
+    // Un proceso que completó la colectiva tarde pudo quedar excluido por la
+    // raíz sin saberlo: el aviso es un resultado de una época ya terminada
+    std::vector<double> aviso(CAMPOS_RESULTADO + procesosVivos_);
+    while (true) {
+        int hay = 0;
+        MPI_Iprobe(0, ETIQUETA_RESULTADO, recuperacion_, &hay, MPI_STATUS_IGNORE);
+        if (!hay) {
+            return false;
+        }
+        MPI_Recv(aviso.data(), static_cast<int>(aviso.size()), MPI_DOUBLE, 0, ETIQUETA_RESULTADO, recuperacion_,
+                 MPI_STATUS_IGNORE);
+        if (aviso[CAMPOS_RESULTADO + rank] == 0.0) {
+            return true;
+        }
+    }
+}
+
+ResultadoResiliente ReduccionResiliente::reducirConPlazo(double suma, int64_t cuenta) {
+    ResultadoResiliente resultado;
+    int rank = 0;
+    MPI_Comm_rank(colectiva_, &rank);
+    const int P = procesosVivos_;
+    std::vector<int> originales = rangosOriginales(colectiva_);
+    
+    // Intento normal: MPI_Iallreduce consultada con MPI_Test hasta el plazo
+    PeticionAbandonada colectiva;
+    colectiva.buffer.reset(new double[4]{suma, static_cast<double>(cuenta), 0.0, 0.0});
+    colectiva.peticiones.assign(1, MPI_REQUEST_NULL);
+    int codigo = MPI_Iallreduce(colectiva.buffer.get(), colectiva.buffer.get() + 2, 2, MPI_DOUBLE, MPI_SUM,
+                                colectiva_, &colectiva.peticiones[0]);
+    if (codigo == MPI_SUCCESS && esperarConPlazo(&colectiva.peticiones[0], plazo_, &codigo) &&
+        codigo == MPI_SUCCESS) {
+        if (leerAvisosAtrasados()) {
+            participa_ = false;
+            resultado.estado = EstadoResiliente::Excluido;
+            return resultado;
+        }
+        resultado.suma = colectiva.buffer[2];
+        resultado.cuenta = static_cast<int64_t>(colectiva.buffer[3]);
+        resultado.procesosIncluidos = P;
+        return resultado;
+    }
+    
+    // Recuperación: la raíz recoge las contribuciones que lleguen dentro de
+    // otro plazo y envía el resultado a todos, hayan respondido o no
+    const double epoca = static_cast<double>(epoca_);
+    PeticionAbandonada respuesta;
+    respuesta.buffer.reset(new double[CAMPOS_RESULTADO + P]());
+    double* datos = respuesta.buffer.get();
+    
+    if (rank == 0) {
+        std::vector<double> contribuciones(CAMPOS_CONTRIBUCION * P);
+        std::vector<MPI_Request> recepciones(P, MPI_REQUEST_NULL);
+        std::vector<char> responde(P, 0);
+        responde[0] = 1;
+        for (int p = 1; p < P; ++p) {
+            MPI_Irecv(&contribuciones[CAMPOS_CONTRIBUCION * p], CAMPOS_CONTRIBUCION, MPI_DOUBLE, p,
+                      ETIQUETA_CONTRIBUCION, recuperacion_, &recepciones[p]);
+        }
+        
+        // Una colectiva que falló al lanzarse no puede completarse después
+        bool colectivaViva = (codigo == MPI_SUCCESS);
+        bool completa = false;
+        double limite = MPI_Wtime() + plazo_;
+        while (!completa && MPI_Wtime() < limite) {
+            bool pendientes = false;
+            for (int p = 1; p < P; ++p) {
+                if (recepciones[p] == MPI_REQUEST_NULL) {
+                    continue;
+                }
+                int hecho = 0;
+                if (MPI_Test(&recepciones[p], &hecho, MPI_STATUS_IGNORE) != MPI_SUCCESS) {
+                    recepciones[p] = MPI_REQUEST_NULL;
+                } else if (hecho && contribuciones[CAMPOS_CONTRIBUCION * p + 2] != epoca) {
+                    // Contribución atrasada de una recuperación anterior
+                    MPI_Irecv(&contribuciones[CAMPOS_CONTRIBUCION * p], CAMPOS_CONTRIBUCION, MPI_DOUBLE, p,
+                              ETIQUETA_CONTRIBUCION, recuperacion_, &recepciones[p]);
+                    pendientes = true;
+                } else if (hecho) {
+                    responde[p] = 1;
+                } else {
+                    pendientes = true;
+                }
+            }
+            // Si la colectiva termina mientras tanto, todos participaron
+            int hecho = 0;
+            completa = colectivaViva &&
+                       MPI_Test(&colectiva.peticiones[0], &hecho, MPI_STATUS_IGNORE) == MPI_SUCCESS && hecho;
+            if (!pendientes) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        
+        for (int p = 1; p < P; ++p) {
+            if (recepciones[p] == MPI_REQUEST_NULL) {
+                continue;
+            }
+            MPI_Status estado;
+            MPI_Cancel(&recepciones[p]);
+            MPI_Wait(&recepciones[p], &estado);
+            int cancelada = 0;
+            MPI_Test_cancelled(&estado, &cancelada);
+            if (!cancelada && contribuciones[CAMPOS_CONTRIBUCION * p + 2] == epoca) {
+                responde[p] = 1;
+            }
+        }
+        
+        if (completa) {
+            datos[0] = colectiva.buffer[2];
+            datos[1] = colectiva.buffer[3];
+            datos[2] = P;
+            datos[3] = 1.0;
+            std::fill(datos + CAMPOS_RESULTADO, datos + CAMPOS_RESULTADO + P, 1.0);
+        } else {
+            contribuciones[0] = suma;
+            contribuciones[1] = static_cast<double>(cuenta);
+            for (int p = 0; p < P; ++p) {
+                if (responde[p]) {
+                    datos[0] += contribuciones[CAMPOS_CONTRIBUCION * p];
+                    datos[1] += contribuciones[CAMPOS_CONTRIBUCION * p + 1];
+                    datos[2] += 1.0;
+                    datos[CAMPOS_RESULTADO + p] = 1.0;
+                }
+            }
+            // Si respondieron todos no hay nadie que excluir
+            datos[3] = (datos[2] == P) ? 1.0 : 0.0;
+        }
+        datos[4] = epoca;
+        
+        respuesta.peticiones.assign(P - 1, MPI_REQUEST_NULL);
+        for (int p = 1; p < P; ++p) {
+            MPI_Isend(datos, CAMPOS_RESULTADO + P, MPI_DOUBLE, p, ETIQUETA_RESULTADO, recuperacion_,
+                      &respuesta.peticiones[p - 1]);
+        }
+    } else {
+        PeticionAbandonada envio;
+        envio.buffer.reset(new double[CAMPOS_CONTRIBUCION]{suma, static_cast<double>(cuenta), epoca});
+        envio.peticiones.assign(1, MPI_REQUEST_NULL);
+        MPI_Isend(envio.buffer.get(), CAMPOS_CONTRIBUCION, MPI_DOUBLE, 0, ETIQUETA_CONTRIBUCION, recuperacion_,
+                  &envio.peticiones[0]);
+        
+        // La raíz espera un plazo más a las contribuciones antes de responder;
+        // los resultados de épocas anteriores se descartan
+        respuesta.peticiones.assign(1, MPI_REQUEST_NULL);
+        bool recibida = false;
+        double limite = MPI_Wtime() + 2.0 * plazo_;
+        while (!recibida && MPI_Wtime() < limite) {
+            MPI_Irecv(datos, CAMPOS_RESULTADO + P, MPI_DOUBLE, 0, ETIQUETA_RESULTADO, recuperacion_,
+                      &respuesta.peticiones[0]);
+            recibida = esperarConPlazo(&respuesta.peticiones[0], limite - MPI_Wtime()) && datos[4] == epoca;
+        }
+        if (respuesta.peticiones[0] != MPI_REQUEST_NULL) {
+            MPI_Cancel(&respuesta.peticiones[0]);
+            MPI_Wait(&respuesta.peticiones[0], MPI_STATUS_IGNORE);
+        }
+        abandonar(std::move(envio));
+        if (!recibida) {
+            abandonar(std::move(colectiva));
+            participa_ = false;
+            resultado.estado = EstadoResiliente::SinRaiz;
+            return resultado;
+        }
+    }
+    if (datos[3] != 0.0) {
+        // Todos entraron en la colectiva (la completó o respondieron todos):
+        // termina en cuanto avanza, así que no queda pendiente
+        MPI_Wait(&colectiva.peticiones[0], MPI_STATUS_IGNORE);
+    } else {
+        abandonar(std::move(colectiva));
+    }
+    
+    resultado.suma = datos[0];
+    resultado.cuenta = static_cast<int64_t>(datos[1]);
+    resultado.procesosIncluidos = static_cast<int>(datos[2]);
+    if (datos[3] != 0.0) {
+        abandonar(std::move(respuesta));
+        return resultado;
+    }
+    
+    std::vector<int> incluidos;
+    for (int p = 0; p < P; ++p) {
+        if (datos[CAMPOS_RESULTADO + p] != 0.0) {
+            incluidos.push_back(p);
+        } else {
+            resultado.procesosPerdidos.push_back(originales[p]);
+        }
+    }
+    if (datos[CAMPOS_RESULTADO + rank] == 0.0) {
+        abandonar(std::move(respuesta));
+        participa_ = false;
+        resultado.estado = EstadoResiliente::Excluido;
+        return resultado;
+    }
+    
+    // Los incluidos crean un comunicador sin los perdidos; MPI_Comm_create_group
+    // solo es colectiva sobre el grupo nuevo, así que los excluidos no participan
+    MPI_Group grupoActual;
+    MPI_Group grupoVivos;
+    MPI_Comm_group(recuperacion_, &grupoActual);
+    MPI_Group_incl(grupoActual, static_cast<int>(incluidos.size()), incluidos.data(), &grupoVivos);
+    MPI_Comm reducido;
+    MPI_Comm_create_group(recuperacion_, grupoVivos, ETIQUETA_GRUPO, &reducido);
+    MPI_Group_free(&grupoVivos);
+    MPI_Group_free(&grupoActual);
+    abandonar(std::move(respuesta));
+    reemplazarComunicadores(reducido);
+    
+    resultado.estado = EstadoResiliente::Reducida;
+    return resultado;
+}
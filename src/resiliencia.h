@@ -0,0 +1,145 @@
+/**
+ * @file resiliencia.h
+ * @brief Reducción que sobrevive a la caída o al bloqueo de procesos
+ * @author Emil M
+ * @date 2025
+ *
+ * Con el manejador de errores por defecto la caída de un proceso aborta el
+ * trabajo o, peor, deja al resto bloqueado en MPI_Reduce hasta que el gestor
+ * de colas lo mata. ReduccionResiliente trabaja sobre copias del comunicador
+ * con MPI_ERRORS_RETURN y, cuando la biblioteca ofrece las extensiones ULFM
+ * (MPIX_Comm_revoke, MPIX_Comm_shrink, MPIX_Comm_agree), revoca el
+ * comunicador ante un fallo, lo reduce a los supervivientes y repite la
+ * reducción sin los datos perdidos.
+ *
+ * Sin ULFM la reducción se lanza con MPI_Iallreduce y se consulta con
+ * MPI_Test hasta un plazo. Si vence, la raíz recoge por punto a punto las
+ * contribuciones que lleguen dentro de un segundo plazo, calcula el resultado
+ * con ellas, lo envía a todos y los procesos que respondieron crean un
+ * comunicador sin los que no lo hicieron. Este camino no distingue un proceso
+ * caído de uno bloqueado; uno que llega tarde recibe el mismo resultado
+ * parcial y queda excluido de las reducciones siguientes. La raíz (rank 0 del
+ * comunicador) no puede fallar en este modo.
+ */
+
+#ifndef MPI_AVANZADO_RESILIENCIA_H
+#define MPI_AVANZADO_RESILIENCIA_H
+
+#include <mpi.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Indica si la biblioteca se compiló con las extensiones ULFM
+ */
+bool ulfmDisponible();
+
+/**
+ * @brief Espera una petición hasta un plazo consultándola con MPI_Test
+ * @param peticion Petición (MPI_REQUEST_NULL al completarse)
+ * @param plazo Segundos de espera como máximo
+ * @param codigo Código de error de MPI_Test (MPI_SUCCESS si no hubo error)
+ * @return true si se completó dentro del plazo
+ */
+bool esperarConPlazo(MPI_Request* peticion, double plazo, int* codigo = nullptr);
+
+/**
+ * @brief Situación del proceso tras una reducción resiliente
+ */
+enum class EstadoResiliente {
+    Completa, ///< Participaron todos los procesos del comunicador
+    Reducida, ///< Se perdieron procesos; el resultado es de los supervivientes
+    Excluido, ///< Este proceso llegó tarde: recibió el resultado pero ya no participa
+    SinRaiz   ///< La raíz no respondió dentro del plazo: no hay resultado
+};
+
+/**
+ * @brief Resultado de una reducción resiliente
+ */
+struct ResultadoResiliente {
+    double suma = 0.0;                  ///< Suma de las contribuciones incluidas
+    int64_t cuenta = 0;                 ///< Valores incluidos
+    int procesosIncluidos = 0;          ///< Procesos cuya contribución se sumó
+    std::vector<int> procesosPerdidos;  ///< Ranks del comunicador original perdidos en esta reducción
+    EstadoResiliente estado = EstadoResiliente::Completa;
+    
+    double media() const { return cuenta > 0 ? suma / static_cast<double>(cuenta) : 0.0; }
+};
+
+/**
+ * @brief Suma y cuenta globales que excluyen a los procesos que fallan
+ *
+ * Las reducciones son colectivas sobre el comunicador vigente, que empieza
+ * siendo una copia de comm y se va reduciendo con cada pérdida.
+ *
+ * Limitación sin ULFM: MPI no permite cancelar una colectiva, así que la
+ * MPI_Iallreduce que vence el plazo queda abandonada. Si al final todos
+ * contribuyeron se completa en el momento; si no, se conserva con su buffer
+ * y el destructor espera un plazo más a que el proceso atrasado entre en
+ * ella. Un proceso bloqueado la completa así; uno caído no la completará
+ * nunca, y la petición llega pendiente a MPI_Finalize (lo que el estándar
+ * considera erróneo): en ese caso el destructor no libera sus buffers ni sus
+ * comunicadores. Con ULFM la reducción es bloqueante y no quedan peticiones.
+ */
+class ReduccionResiliente {
+public:
+    /**
+     * @brief Prepara la reducción (operación colectiva sobre comm)
+     * @param comm Comunicador original; su rank 0 es la raíz de la recuperación
+     * @param plazo Segundos que se espera a cada fase antes de dar procesos por perdidos
+     */
+    ReduccionResiliente(MPI_Comm comm, double plazo);
+    ~ReduccionResiliente();
+    
+    ReduccionResiliente(const ReduccionResiliente&) = delete;
+    ReduccionResiliente& operator=(const ReduccionResiliente&) = delete;
+    
+    /**
+     * @brief Reduce la suma y la cuenta locales entre los procesos vivos
+     * @param suma Suma parcial local
+     * @param cuenta Valores que resume la suma local
+     * @return Resultado en todos los procesos que siguen en el comunicador
+     */
+    ResultadoResiliente reducir(double suma, int64_t cuenta);
+    
+    /**
+     * @brief Procesos del comunicador vigente
+     */
+    int procesosVivos() const { return procesosVivos_; }
+    
+    /**
+     * @brief false si este proceso quedó fuera del comunicador
+     */
+    bool participa() const { return participa_; }
+    
+    /**
+     * @brief Comunicador vigente (MPI_COMM_NULL si este proceso quedó fuera)
+     */
+    MPI_Comm comunicador() const { return colectiva_; }
+
+private:
+    struct PeticionAbandonada {
+        std::vector<MPI_Request> peticiones;
+        std::unique_ptr<double[]> buffer;
+    };
+    
+    ResultadoResiliente reducirUlfm(double suma, int64_t cuenta);
+    ResultadoResiliente reducirConPlazo(double suma, int64_t cuenta);
+    bool leerAvisosAtrasados();
+    void abandonar(PeticionAbandonada peticion);
+    void reemplazarComunicadores(MPI_Comm nuevo);
+    std::vector<int> rangosOriginales(MPI_Comm comm) const;
+    
+    double plazo_;
+    MPI_Group grupoOriginal_ = MPI_GROUP_NULL;
+    MPI_Comm colectiva_ = MPI_COMM_NULL;    ///< Reducciones
+    MPI_Comm recuperacion_ = MPI_COMM_NULL; ///< Punto a punto de la recuperación
+    int procesosVivos_ = 0;
+    bool participa_ = true;
+    int epoca_ = 0; ///< Reducciones hechas: distingue los mensajes atrasados de la recuperación
+    std::vector<PeticionAbandonada> abandonadas_;
+    std::vector<MPI_Comm> retirados_; ///< Comunicadores sustituidos tras una pérdida
+};
+
+#endif // MPI_AVANZADO_RESILIENCIA_H
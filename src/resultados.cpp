@@ -0,0 +1,492 @@
+/**
+ * @file resultados.cpp
+ * @brief Implementación del almacén de resultados y de la comparación entre ejecuciones
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "resultados.h"
+#include "suma.h"
+
+#include <mpi.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <unistd.h>
+
+#ifndef MPI_AVANZADO_GIT
+#define MPI_AVANZADO_GIT "desconocido"
+#endif
+#ifndef MPI_AVANZADO_OPCIONES
+#define MPI_AVANZADO_OPCIONES ""
+#endif
+
+namespace {
+
+std::string escaparJson(const std::string& texto) {
+    std::string escapado;
+    for (char c : texto) {
+        switch (c) {
+            case '"':
+                escapado += "\\\"";
+                break;
+            case '\\':
+                escapado += "\\\\";
+                break;
+            case '\n':
+                escapado += "\\n";
+                break;
+            case '\t':
+                escapado += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char codigo[8];
+                    std::snprintf(codigo, sizeof(codigo), "\\u%04x", static_cast<unsigned char>(c));
+                    escapado += codigo;
+                } else {
+                    escapado += c;
+                }
+        }
+    }
+    return escapado;
+}
+
+std::string numeroJson(double valor) {
+    char texto[32];
+    std::snprintf(texto, sizeof(texto), "%.9g", std::isfinite(valor) ? valor : 0.0);
+    return texto;
+}
+
+/**
+ * @brief Campos de un objeto JSON plano (valores de texto o escalares sin comillas)
+ */
+using CamposJson = std::map<std::string, std::string>;
+
+void saltarEspacios(const std::string& linea, size_t& pos) {
+    while (pos < linea.size() && (linea[pos] == ' ' || linea[pos] == '\t' || linea[pos] == '\r')) {
+        ++pos;
+    }
+}
+
+bool leerCadena(const std::string& linea, size_t& pos, std::string& cadena) {
+    if (pos >= linea.size() || linea[pos] != '"') {
+        return false;
+    }
+    cadena.clear();
+    for (++pos; pos < linea.size(); ++pos) {
+        char c = linea[pos];
+        if (c == '"') {
+            ++pos;
+            return true;
+        }
+        if (c != '\\') {
+            cadena += c;
+            continue;
+        }
+        if (++pos >= linea.size()) {
+            return false;
+        }
+        switch (linea[pos]) {
+            case 'n':
+                cadena += '\n';
+                break;
+            case 't':
+                cadena += '\t';
+                break;
+            case 'u':
+                // Solo se escriben caracteres de control: basta con leer el código ASCII
+                if (pos + 4 >= linea.size()) {
+                    return false;
+                }
+                cadena += static_cast<char>(std::strtol(linea.substr(pos + 1, 4).c_str(), nullptr, 16));
+                pos += 4;
+                break;
+            default:
+                cadena += linea[pos];
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Analiza un objeto JSON de un solo nivel
+ */
+bool analizarObjeto(const std::string& linea, CamposJson& campos) {
+    size_t pos = 0;
+    saltarEspacios(linea, pos);
+    if (pos >= linea.size() || linea[pos] != '{') {
+        return false;
+    }
+    ++pos;
+    saltarEspacios(linea, pos);
+    if (pos < linea.size() && linea[pos] == '}') {
+        return true;
+    }
+    while (pos < linea.size()) {
+        std::string clave;
+        saltarEspacios(linea, pos);
+        if (!leerCadena(linea, pos, clave)) {
+            return false;
+        }
+        saltarEspacios(linea, pos);
+        if (pos >= linea.size() || linea[pos] != ':') {
+            return false;
+        }
+        ++pos;
+        saltarEspacios(linea, pos);
+        
+        std::string valor;
+        if (pos < linea.size() && linea[pos] == '"') {
+            if (!leerCadena(linea, pos, valor)) {
+                return false;
+            }
+        } else {
+            size_t fin = linea.find_first_of(",}", pos);
+            if (fin == std::string::npos) {
+                return false;
+            }
+            valor = linea.substr(pos, fin - pos);
+            while (!valor.empty() && (valor.back() == ' ' || valor.back() == '\t')) {
+                valor.pop_back();
+            }
+            pos = fin;
+        }
+        campos[clave] = valor;
+        
+        saltarEspacios(linea, pos);
+        if (pos >= linea.size()) {
+            return false;
+        }
+        if (linea[pos] == '}') {
+            return true;
+        }
+        if (linea[pos] != ',') {
+            return false;
+        }
+        ++pos;
+    }
+    return false;
+}
+
+std::string texto(const CamposJson& campos, const char* clave) {
+    auto campo = campos.find(clave);
+    return campo != campos.end() ? campo->second : std::string();
+}
+
+bool numero(const CamposJson& campos, const char* clave, double& valor) {
+    auto campo = campos.find(clave);
+    if (campo == campos.end() || campo->second.empty()) {
+        return false;
+    }
+    char* fin = nullptr;
+    valor = std::strtod(campo->second.c_str(), &fin);
+    return *fin == '\0';
+}
+
+bool entero(const CamposJson& campos, const char* clave, int64_t& valor) {
+    double leido = 0.0;
+    if (!numero(campos, clave, leido)) {
+        return false;
+    }
+    valor = static_cast<int64_t>(leido);
+    return true;
+}
+
+/**
+ * @brief Fracción continua de la beta incompleta (Lentz modificado)
+ */
+double fraccionBeta(double a, double b, double x) {
+    const double minimo = 1e-300;
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    d = 1.0 / (std::fabs(d) < minimo ? minimo : d);
+    double resultado = d;
+    for (int m = 1; m <= 300; ++m) {
+        // Término par
+        double numerador = m * (b - m) * x / ((a + 2.0 * m - 1.0) * (a + 2.0 * m));
+        d = 1.0 + numerador * d;
+        d = 1.0 / (std::fabs(d) < minimo ? minimo : d);
+        c = 1.0 + numerador / c;
+        c = std::fabs(c) < minimo ? minimo : c;
+        resultado *= d * c;
+        
+        // Término impar
+        numerador = -(a + m) * (a + b + m) * x / ((a + 2.0 * m) * (a + 2.0 * m + 1.0));
+        d = 1.0 + numerador * d;
+        d = 1.0 / (std::fabs(d) < minimo ? minimo : d);
+        c = 1.0 + numerador / c;
+        c = std::fabs(c) < minimo ? minimo : c;
+        double delta = d * c;
+        resultado *= delta;
+        if (std::fabs(delta - 1.0) < 1e-12) {
+            break;
+        }
+    }
+    return resultado;
+}
+
+/**
+ * @brief Beta incompleta regularizada I_x(a, b)
+ */
+double betaIncompleta(double a, double b, double x) {
+    if (x <= 0.0) {
+        return 0.0;
+    }
+    if (x >= 1.0) {
+        return 1.0;
+    }
+    double logFactor = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) +
+                       b * std::log(1.0 - x);
+    double factor = std::exp(logFactor);
+    // La fracción converge rápido por debajo de la media; por encima se usa la simetría
+    if (x < (a + 1.0) / (a + b + 2.0)) {
+        return factor * fraccionBeta(a, b, x) / a;
+    }
+    return 1.0 - factor * fraccionBeta(b, a, 1.0 - x) / b;
+}
+
+std::string claveRegistro(const RegistroResultado& registro) {
+    return registro.operacion + "|" + std::to_string(registro.tamano) + "|" + std::to_string(registro.procesos) +
+           "|" + std::to_string(registro.hilos);
+}
+
+} // namespace
+
+MetadatosEjecucion recogerMetadatos(const std::string& programa, int procesos, int hilos, int iteraciones,
+                                    int calentamiento) {
+    MetadatosEjecucion metadatos;
+    metadatos.programa = programa;
+    metadatos.procesos = procesos;
+    metadatos.hilos = hilos;
+    metadatos.iteraciones = iteraciones;
+    metadatos.calentamiento = calentamiento;
+    
+    std::time_t ahora = std::time(nullptr);
+    std::tm utc{};
+    gmtime_r(&ahora, &utc);
+    char fecha[32];
+    std::strftime(fecha, sizeof(fecha), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    metadatos.fecha = fecha;
+    
+    char host[256] = {};
+    if (gethostname(host, sizeof(host) - 1) == 0) {
+        metadatos.host = host;
+    }
+    
+    int version = 0;
+    int subversion = 0;
+    MPI_Get_version(&version, &subversion);
+    metadatos.versionMpi = std::to_string(version) + "." + std::to_string(subversion);
+    char biblioteca[MPI_MAX_LIBRARY_VERSION_STRING] = {};
+    int longitud = 0;
+    MPI_Get_library_version(biblioteca, &longitud);
+    // La longitud de algunas bibliotecas incluye el terminador
+    metadatos.bibliotecaMpi = std::string(biblioteca, std::strlen(biblioteca));
+    size_t salto = metadatos.bibliotecaMpi.find_first_of("\r\n");
+    if (salto != std::string::npos) {
+        metadatos.bibliotecaMpi.resize(salto);
+    }
+    while (!metadatos.bibliotecaMpi.empty() && metadatos.bibliotecaMpi.back() == ',') {
+        metadatos.bibliotecaMpi.pop_back();
+    }
+    
+    metadatos.git = MPI_AVANZADO_GIT;
+#if defined(__clang__)
+    metadatos.compilador = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    metadatos.compilador = std::string("gcc ") + __VERSION__;
+#else
+    metadatos.compilador = "desconocido";
+#endif
+    metadatos.opciones = MPI_AVANZADO_OPCIONES;
+    metadatos.rutaSimd = nombreRutaSimd();
+    return metadatos;
+}
+
+std::string cabeceraCsvResultados() {
+    return std::string("Operacion,TamañoDatos,NumProcesos,NumHilos,") + cabeceraEstadisticas() +
+           ",Bytes,AnchoBanda(GB/s),AnchoBandaBus(GB/s)";
+}
+
+std::string filaCsv(const RegistroResultado& registro) {
+    return registro.operacion + "," + std::to_string(registro.tamano) + "," +
+           std::to_string(registro.procesos) + "," +
+           std::to_string(registro.hilos) + "," +
+           columnasEstadisticas(registro.estadisticas) + "," +
+           std::to_string(registro.bytes) + "," +
+           std::to_string(registro.anchoBanda) + "," +
+           std::to_string(registro.anchoBandaBus);
+}
+
+void escribirJsonLineas(std::ostream& salida, const MetadatosEjecucion& metadatos,
+                        const std::vector<RegistroResultado>& registros) {
+    salida << "{\"tipo\":\"metadatos\""
+           << ",\"programa\":\"" << escaparJson(metadatos.programa) << "\""
+           << ",\"fecha\":\"" << escaparJson(metadatos.fecha) << "\""
+           << ",\"host\":\"" << escaparJson(metadatos.host) << "\""
+           << ",\"version_mpi\":\"" << escaparJson(metadatos.versionMpi) << "\""
+           << ",\"biblioteca_mpi\":\"" << escaparJson(metadatos.bibliotecaMpi) << "\""
+           << ",\"git\":\"" << escaparJson(metadatos.git) << "\""
+           << ",\"compilador\":\"" << escaparJson(metadatos.compilador) << "\""
+           << ",\"opciones\":\"" << escaparJson(metadatos.opciones) << "\""
+           << ",\"ruta_simd\":\"" << escaparJson(metadatos.rutaSimd) << "\""
+           << ",\"procesos\":" << metadatos.procesos
+           << ",\"hilos\":" << metadatos.hilos
+           << ",\"iteraciones\":" << metadatos.iteraciones
+           << ",\"calentamiento\":" << metadatos.calentamiento << "}\n";
+    
+    for (const RegistroResultado& registro : registros) {
+        const EstadisticasTiempo& estadisticas = registro.estadisticas;
+        salida << "{\"tipo\":\"resultado\""
+               << ",\"operacion\":\"" << escaparJson(registro.operacion) << "\""
+               << ",\"tamano\":" << registro.tamano
+               << ",\"procesos\":" << registro.procesos
+               << ",\"hilos\":" << registro.hilos
+               << ",\"muestras\":" << estadisticas.muestras
+               << ",\"media_us\":" << numeroJson(estadisticas.media)
+               << ",\"minimo_us\":" << numeroJson(estadisticas.minimo)
+               << ",\"mediana_us\":" << numeroJson(estadisticas.mediana)
+               << ",\"p95_us\":" << numeroJson(estadisticas.p95)
+               << ",\"p99_us\":" << numeroJson(estadisticas.p99)
+               << ",\"maximo_us\":" << numeroJson(estadisticas.maximo)
+               << ",\"desviacion_us\":" << numeroJson(estadisticas.desviacion)
+               << ",\"bytes\":" << registro.bytes
+               << ",\"ancho_banda_gbs\":" << numeroJson(registro.anchoBanda)
+               << ",\"ancho_banda_bus_gbs\":" << numeroJson(registro.anchoBandaBus) << "}\n";
+    }
+}
+
+bool leerJsonLineas(std::istream& entrada, MetadatosEjecucion& metadatos, std::vector<RegistroResultado>& registros,
+                    std::string& error) {
+    std::string linea;
+    int numeroLinea = 0;
+    while (std::getline(entrada, linea)) {
+        ++numeroLinea;
+        if (linea.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        CamposJson campos;
+        if (!analizarObjeto(linea, campos)) {
+            error = "línea " + std::to_string(numeroLinea) + ": objeto JSON no válido";
+            return false;
+        }
+        
+        std::string tipo = texto(campos, "tipo");
+        if (tipo == "metadatos") {
+            metadatos.programa = texto(campos, "programa");
+            metadatos.fecha = texto(campos, "fecha");
+            metadatos.host = texto(campos, "host");
+            metadatos.versionMpi = texto(campos, "version_mpi");
+            metadatos.bibliotecaMpi = texto(campos, "biblioteca_mpi");
+            metadatos.git = texto(campos, "git");
+            metadatos.compilador = texto(campos, "compilador");
+            metadatos.opciones = texto(campos, "opciones");
+            metadatos.rutaSimd = texto(campos, "ruta_simd");
+            int64_t valor = 0;
+            metadatos.procesos = entero(campos, "procesos", valor) ? static_cast<int>(valor) : 0;
+            metadatos.hilos = entero(campos, "hilos", valor) ? static_cast<int>(valor) : 0;
+            metadatos.iteraciones = entero(campos, "iteraciones", valor) ? static_cast<int>(valor) : 0;
+            metadatos.calentamiento = entero(campos, "calentamiento", valor) ? static_cast<int>(valor) : 0;
+            continue;
+        }
+        if (tipo != "resultado") {
+            // Tipos de línea de versiones futuras
+            continue;
+        }
+        
+        RegistroResultado registro;
+        EstadisticasTiempo& estadisticas = registro.estadisticas;
+        int64_t procesos = 0;
+        int64_t hilos = 0;
+        int64_t muestras = 0;
+        registro.operacion = texto(campos, "operacion");
+        bool completo = !registro.operacion.empty() && entero(campos, "tamano", registro.tamano) &&
+                        entero(campos, "procesos", procesos) && entero(campos, "hilos", hilos) &&
+                        entero(campos, "muestras", muestras) && numero(campos, "media_us", estadisticas.media) &&
+                        numero(campos, "desviacion_us", estadisticas.desviacion);
+        if (!completo) {
+            error = "línea " + std::to_string(numeroLinea) +
+                    ": faltan operacion, tamano, procesos, hilos, muestras, media_us o desviacion_us";
+            return false;
+        }
+        registro.procesos = static_cast<int>(procesos);
+        registro.hilos = static_cast<int>(hilos);
+        estadisticas.muestras = static_cast<int>(muestras);
+        numero(campos, "minimo_us", estadisticas.minimo);
+        numero(campos, "mediana_us", estadisticas.mediana);
+        numero(campos, "p95_us", estadisticas.p95);
+        numero(campos, "p99_us", estadisticas.p99);
+        numero(campos, "maximo_us", estadisticas.maximo);
+        entero(campos, "bytes", registro.bytes);
+        numero(campos, "ancho_banda_gbs", registro.anchoBanda);
+        numero(campos, "ancho_banda_bus_gbs", registro.anchoBandaBus);
+        registros.push_back(registro);
+    }
+    return true;
+}
+
+double valorPWelch(double mediaA, double desviacionA, int muestrasA, double mediaB, double desviacionB,
+                   int muestrasB) {
+    if (muestrasA < 2 || muestrasB < 2) {
+        return 1.0;
+    }
+    double varianzaA = desviacionA * desviacionA / muestrasA;
+    double varianzaB = desviacionB * desviacionB / muestrasB;
+    double varianza = varianzaA + varianzaB;
+    if (varianza <= 0.0) {
+        return mediaA == mediaB ? 1.0 : 0.0;
+    }
+    double t = (mediaA - mediaB) / std::sqrt(varianza);
+    // Grados de libertad de Welch-Satterthwaite
+    double libertad = varianza * varianza /
+                      (varianzaA * varianzaA / (muestrasA - 1) + varianzaB * varianzaB / (muestrasB - 1));
+    return betaIncompleta(libertad / 2.0, 0.5, libertad / (libertad + t * t));
+}
+
+std::vector<ComparacionResultado> compararResultados(const std::vector<RegistroResultado>& base,
+                                                     const std::vector<RegistroResultado>& nuevo, double umbral,
+                                                     double alfa) {
+    std::map<std::string, const RegistroResultado*> indice;
+    for (const RegistroResultado& registro : nuevo) {
+        indice[claveRegistro(registro)] = &registro;
+    }
+    
+    std::vector<ComparacionResultado> comparaciones;
+    for (const RegistroResultado& registro : base) {
+        auto encontrado = indice.find(claveRegistro(registro));
+        if (encontrado == indice.end()) {
+            continue;
+        }
+        ComparacionResultado comparacion;
+        comparacion.base = registro;
+        comparacion.nuevo = *encontrado->second;
+        const EstadisticasTiempo& antes = comparacion.base.estadisticas;
+        const EstadisticasTiempo& despues = comparacion.nuevo.estadisticas;
+        comparacion.cambio = antes.media > 0.0 ? (despues.media - antes.media) / antes.media : 0.0;
+        comparacion.valorP = valorPWelch(antes.media, antes.desviacion, antes.muestras, despues.media,
+                                         despues.desviacion, despues.muestras);
+        if (comparacion.valorP < alfa && std::fabs(comparacion.cambio) > umbral) {
+            comparacion.veredicto = comparacion.cambio > 0.0 ? Veredicto::Regresion : Veredicto::Mejora;
+        }
+        comparaciones.push_back(comparacion);
+    }
+    return comparaciones;
+}
+
+const char* nombreVeredicto(Veredicto veredicto) {
+    switch (veredicto) {
+        case Veredicto::SinCambio:
+            return "sin cambio";
+        case Veredicto::Regresion:
+            return "regresión";
+        case Veredicto::Mejora:
+            return "mejora";
+    }
+    return "desconocido";
+}
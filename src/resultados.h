@@ -0,0 +1,138 @@
+/**
+ * @file resultados.h
+ * @brief Resultados de benchmark en JSON lines con metadatos y comparación entre ejecuciones
+ * @author Emil M
+ * @date 2025
+ *
+ * El CSV de mpi_benchmark no dice en qué máquina, con qué biblioteca MPI ni
+ * con qué compilación se midió. Junto a él se escribe un archivo JSON lines:
+ * la primera línea es un objeto "metadatos" (programa, fecha, host, versión
+ * MPI, commit, compilador y opciones) y cada una de las siguientes un
+ * "resultado" con las estadísticas completas de una fila. mpi_comparar lee dos
+ * archivos y marca como regresión las filas cuyo tiempo medio empeora más de
+ * un umbral relativo con una diferencia estadísticamente significativa
+ * (prueba t de Welch sobre media, desviación y muestras de cada fila).
+ */
+
+#ifndef MPI_AVANZADO_RESULTADOS_H
+#define MPI_AVANZADO_RESULTADOS_H
+
+#include "estadisticas.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Contexto de una ejecución
+ */
+struct MetadatosEjecucion {
+    std::string programa;      ///< Ejecutable que produjo los resultados
+    std::string fecha;         ///< Fecha y hora UTC (ISO 8601)
+    std::string host;          ///< Nombre del host de la raíz
+    std::string versionMpi;    ///< Versión del estándar (MPI_Get_version)
+    std::string bibliotecaMpi; ///< Primera línea de MPI_Get_library_version
+    std::string git;           ///< Commit en el momento de configurar CMake
+    std::string compilador;    ///< Compilador y versión
+    std::string opciones;      ///< Opciones de compilación
+    std::string rutaSimd;      ///< Ruta SIMD del núcleo de suma
+    int procesos = 1;
+    int hilos = 1;
+    int iteraciones = 0;
+    int calentamiento = 0;
+};
+
+/**
+ * @brief Recoge los metadatos de esta ejecución (no requiere MPI_Init)
+ */
+MetadatosEjecucion recogerMetadatos(const std::string& programa, int procesos, int hilos, int iteraciones,
+                                    int calentamiento);
+
+/**
+ * @brief Una fila de resultados
+ */
+struct RegistroResultado {
+    std::string operacion;           ///< Nombre ("MPI_Bcast", "Plano:MPI_Reduce"...)
+    int64_t tamano = 0;              ///< Elementos
+    int procesos = 1;
+    int hilos = 1;
+    EstadisticasTiempo estadisticas; ///< Tiempos por iteración (μs)
+    int64_t bytes = 0;               ///< Bytes de la colectiva (0 si el ancho de banda no aplica)
+    double anchoBanda = 0.0;         ///< GB/s algorítmicos (con la mediana)
+    double anchoBandaBus = 0.0;      ///< GB/s de bus
+};
+
+/**
+ * @brief Cabecera del CSV de resultados
+ */
+std::string cabeceraCsvResultados();
+
+/**
+ * @brief Fila CSV de un registro, en el orden de cabeceraCsvResultados()
+ */
+std::string filaCsv(const RegistroResultado& registro);
+
+/**
+ * @brief Escribe los metadatos y los registros en formato JSON lines
+ */
+void escribirJsonLineas(std::ostream& salida, const MetadatosEjecucion& metadatos,
+                        const std::vector<RegistroResultado>& registros);
+
+/**
+ * @brief Lee un archivo JSON lines escrito por escribirJsonLineas
+ * @param entrada Flujo de entrada
+ * @param metadatos Metadatos leídos (vacíos si el archivo no los tiene)
+ * @param registros Registros leídos
+ * @param error Descripción del primer error encontrado
+ * @return true si todas las líneas son válidas
+ */
+bool leerJsonLineas(std::istream& entrada, MetadatosEjecucion& metadatos, std::vector<RegistroResultado>& registros,
+                    std::string& error);
+
+/**
+ * @brief Valor p bilateral de la prueba t de Welch entre dos muestras resumidas
+ * @return Probabilidad de una diferencia de medias igual o mayor si las medias
+ *         fueran iguales (1 si no hay muestras suficientes o varianza)
+ */
+double valorPWelch(double mediaA, double desviacionA, int muestrasA, double mediaB, double desviacionB,
+                   int muestrasB);
+
+/**
+ * @brief Resultado de comparar una fila entre dos ejecuciones
+ */
+enum class Veredicto {
+    SinCambio, ///< Diferencia por debajo del umbral o no significativa
+    Regresion, ///< Más lento, por encima del umbral y significativo
+    Mejora     ///< Más rápido, por encima del umbral y significativo
+};
+
+/**
+ * @brief Comparación de una fila presente en ambas ejecuciones
+ */
+struct ComparacionResultado {
+    RegistroResultado base;
+    RegistroResultado nuevo;
+    double cambio = 0.0; ///< Cambio relativo del tiempo medio (0.1 = 10 % más lento)
+    double valorP = 1.0; ///< Valor p de Welch
+    Veredicto veredicto = Veredicto::SinCambio;
+};
+
+/**
+ * @brief Compara las filas comunes (misma operación, tamaño, procesos e hilos)
+ * @param base Registros de referencia
+ * @param nuevo Registros de la ejecución a evaluar
+ * @param umbral Cambio relativo mínimo para ser regresión o mejora
+ * @param alfa Nivel de significación
+ * @return Una comparación por fila de base que también está en nuevo, en el orden de base
+ */
+std::vector<ComparacionResultado> compararResultados(const std::vector<RegistroResultado>& base,
+                                                     const std::vector<RegistroResultado>& nuevo, double umbral,
+                                                     double alfa);
+
+/**
+ * @brief Nombre de un veredicto ("sin cambio", "regresión", "mejora")
+ */
+const char* nombreVeredicto(Veredicto veredicto);
+
+#endif // MPI_AVANZADO_RESULTADOS_H
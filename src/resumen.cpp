@@ -0,0 +1,104 @@
+/**
+ * @file resumen.cpp
+ * @brief Implementación del resumen estadístico reducible
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "resumen.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "suma.h"
+
+static_assert(std::is_standard_layout<ResumenValores>::value,
+              "ResumenValores debe tener disposición estándar para describirlo con offsetof");
+
+namespace {
+
+void reducirResumen(void* entrada, void* salida, int* longitud, MPI_Datatype*) {
+    const ResumenValores* origen = static_cast<const ResumenValores*>(entrada);
+    ResumenValores* destino = static_cast<ResumenValores*>(salida);
+    for (int i = 0; i < *longitud; ++i) {
+        combinarResumen(destino[i], origen[i]);
+    }
+}
+
+} // namespace
+
+ResumenValores resumirValores(const double* datos, int64_t n) {
+    ResumenValores resumen;
+    if (n <= 0) {
+        return resumen;
+    }
+    
+    // La media del bloque se obtiene con el núcleo vectorizado y las
+    // desviaciones se acumulan respecto de ella, sin la cancelación de
+    // la fórmula sum(x^2) - n * media^2
+    resumen.cuenta = n;
+    resumen.media = sumarRapido(datos, n) / static_cast<double>(n);
+    double m2 = 0.0;
+    double minimo = datos[0];
+    double maximo = datos[0];
+    for (int64_t i = 0; i < n; ++i) {
+        double desviacion = datos[i] - resumen.media;
+        m2 += desviacion * desviacion;
+        minimo = std::min(minimo, datos[i]);
+        maximo = std::max(maximo, datos[i]);
+    }
+    resumen.m2 = m2;
+    resumen.minimo = minimo;
+    resumen.maximo = maximo;
+    return resumen;
+}
+
+void combinarResumen(ResumenValores& acumulado, const ResumenValores& parcial) {
+    if (parcial.cuenta == 0) {
+        return;
+    }
+    if (acumulado.cuenta == 0) {
+        acumulado = parcial;
+        return;
+    }
+    
+    double cuentaA = static_cast<double>(acumulado.cuenta);
+    double cuentaB = static_cast<double>(parcial.cuenta);
+    double total = cuentaA + cuentaB;
+    double delta = parcial.media - acumulado.media;
+    
+    acumulado.media += delta * (cuentaB / total);
+    acumulado.m2 += parcial.m2 + delta * delta * (cuentaA * cuentaB / total);
+    acumulado.cuenta += parcial.cuenta;
+    acumulado.minimo = std::min(acumulado.minimo, parcial.minimo);
+    acumulado.maximo = std::max(acumulado.maximo, parcial.maximo);
+}
+
+MPI_Datatype tipoResumenValores() {
+    static MPI_Datatype tipo = [] {
+        int longitudes[2] = {1, 4};
+        MPI_Aint desplazamientos[2] = {static_cast<MPI_Aint>(offsetof(ResumenValores, cuenta)),
+                                       static_cast<MPI_Aint>(offsetof(ResumenValores, media))};
+        MPI_Datatype tipos[2] = {MPI_INT64_T, MPI_DOUBLE};
+        MPI_Datatype estructura;
+        MPI_Type_create_struct(2, longitudes, desplazamientos, tipos, &estructura);
+        
+        // La extensión debe coincidir con sizeof para enviar vectores de resúmenes
+        MPI_Datatype nuevo;
+        MPI_Type_create_resized(estructura, 0, static_cast<MPI_Aint>(sizeof(ResumenValores)), &nuevo);
+        MPI_Type_commit(&nuevo);
+        MPI_Type_free(&estructura);
+        return nuevo;
+    }();
+    return tipo;
+}
+
+MPI_Op opResumenValores() {
+    static MPI_Op op = [] {
+        MPI_Op nueva;
+        MPI_Op_create(reducirResumen, 1, &nueva);
+        return nueva;
+    }();
+    return op;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file resumen.h
+ * @brief Resumen estadístico de los valores (cuenta, media, M2, mínimo y máximo) reducible con MPI
+ * @author Emil M
+ * @date 2025
+ *
+ * Cada proceso resume sus valores en un ResumenValores y una sola colectiva
+ * con un tipo derivado y una operación propia los combina con la fórmula de
+ * Chan et al. (la generalización por bloques del algoritmo de Welford). Como
+ * el resumen lleva su propia cuenta, la media y la varianza son correctas
+ * aunque cada proceso tenga un número distinto de valores, y no hacen falta
+ * colectivas adicionales para el mínimo, el máximo o la varianza.
+ */
+
+#ifndef MPI_AVANZADO_RESUMEN_H
+#define MPI_AVANZADO_RESUMEN_H
+
+#include <mpi.h>
+#include <cstdint>
+
+/**
+ * @brief Resumen de un conjunto de valores
+ *
+ * M2 es la suma de los cuadrados de las desviaciones respecto de la media.
+ * Un resumen con cuenta 0 es el elemento neutro de la combinación.
+ */
+struct ResumenValores {
+    int64_t cuenta = 0;   ///< Número de valores
+    double media = 0.0;   ///< Media de los valores
+    double m2 = 0.0;      ///< Suma de (valor - media)^2
+    double minimo = 0.0;  ///< Valor mínimo (solo válido si cuenta > 0)
+    double maximo = 0.0;  ///< Valor máximo (solo válido si cuenta > 0)
+    
+    /**
+     * @brief Suma de los valores
+     */
+    double suma() const { return media * static_cast<double>(cuenta); }
+    
+    /**
+     * @brief Varianza muestral (0 si hay menos de dos valores)
+     */
+    double varianza() const { return cuenta > 1 ? m2 / static_cast<double>(cuenta - 1) : 0.0; }
+};
+
+/**
+ * @brief Resume un bloque de valores en dos pasadas (la segunda, sobre datos en caché)
+ * @param datos Puntero a los valores
+ * @param n Número de valores
+ * @return Resumen del bloque
+ */
+ResumenValores resumirValores(const double* datos, int64_t n);
+
+/**
+ * @brief Combina un resumen parcial con el acumulado (fórmula de Chan)
+ * @param acumulado Resumen que recibe la combinación
+ * @param parcial Resumen a añadir
+ */
+void combinarResumen(ResumenValores& acumulado, const ResumenValores& parcial);
+
+/**
+ * @brief Tipo MPI para ResumenValores (un MPI_INT64_T y cuatro MPI_DOUBLE)
+ */
+MPI_Datatype tipoResumenValores();
+
+/**
+ * @brief Operación MPI conmutativa que combina resúmenes
+ */
+MPI_Op opResumenValores();
+
+#endif // MPI_AVANZADO_RESUMEN_H
@@ -0,0 +1,63 @@
+/**
+ * @file solapamiento.cpp
+ * @brief Implementación de la reducción segmentada no bloqueante
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "solapamiento.h"
+
+#include <cstdlib>
+
+ReduccionSolapada::ReduccionSolapada(int segmentos, ModoSuma modo, int raiz, MPI_Comm comm, bool enTodos)
+    : modo_(modo), raiz_(raiz), comm_(comm), enTodos_(enTodos),
+      locales_(segmentos), globales_(segmentos),
+      peticiones_(segmentos, MPI_REQUEST_NULL) {}
+
+void ReduccionSolapada::publicar(int segmento, const SumaCompensada& parcial) {
+    // En modo compensado se reduce el par doble-doble completo
+    locales_[segmento] = SumaCompensada{parcial.total(), 0.0};
+    void* envio = &locales_[segmento].suma;
+    void* recepcion = &globales_[segmento].suma;
+    MPI_Datatype tipo = MPI_DOUBLE;
+    MPI_Op op = MPI_SUM;
+    
+    if (modo_ == ModoSuma::Compensada) {
+        locales_[segmento] = parcial;
+        envio = &locales_[segmento];
+        recepcion = &globales_[segmento];
+        tipo = tipoSumaCompensada();
+        op = opSumaCompensada();
+    }
+    
+    if (enTodos_) {
+        MPI_Iallreduce(envio, recepcion, 1, tipo, op, comm_, &peticiones_[segmento]);
+    } else {
+        MPI_Ireduce(envio, recepcion, 1, tipo, op, raiz_, comm_, &peticiones_[segmento]);
+    }
+    
+    // Dar oportunidad de progreso a las reducciones ya publicadas
+    int completadas = 0;
+    MPI_Testall(segmento + 1, peticiones_.data(), &completadas, MPI_STATUSES_IGNORE);
+}
+
+SumaCompensada ReduccionSolapada::esperar() {
+    double inicio = MPI_Wtime();
+    MPI_Waitall(static_cast<int>(peticiones_.size()), peticiones_.data(), MPI_STATUSES_IGNORE);
+    tiempoEspera_ = MPI_Wtime() - inicio;
+    
+    SumaCompensada total;
+    for (const SumaCompensada& segmento : globales_) {
+        acumularCompensado(total, segmento);
+    }
+    return total;
+}
+
+int leerNumSegmentos() {
+    const char* valor = std::getenv(VARIABLE_SEGMENTOS);
+    if (valor == nullptr) {
+        return 0;
+    }
+    int segmentos = std::atoi(valor);
+    return segmentos > 0 ? segmentos : 0;
+}
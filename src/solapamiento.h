@@ -0,0 +1,89 @@
+/**
+ * @file solapamiento.h
+ * @brief Reducción segmentada que solapa cómputo y comunicación
+ * @author Emil M
+ * @date 2025
+ * 
+ * En el modo segmentado cada proceso divide su trabajo en segmentos. Al
+ * terminar un segmento publica su suma parcial con MPI_Ireduce y continúa
+ * con el siguiente, de modo que la latencia de las reducciones queda oculta
+ * detrás del cómputo. Al final solo se espera a las peticiones pendientes.
+ * Con la estrategia allreduce se publica MPI_Iallreduce en su lugar.
+ */
+
+#ifndef MPI_AVANZADO_SOLAPAMIENTO_H
+#define MPI_AVANZADO_SOLAPAMIENTO_H
+
+#include <mpi.h>
+#include <vector>
+
+#include "suma.h"
+
+/**
+ * @brief Variable de entorno con el número de segmentos del modo solapado
+ *
+ * Un valor de 0 (por defecto) usa el modo bloqueante original.
+ */
+const char* const VARIABLE_SEGMENTOS = "MPI_AVANZADO_SEGMENTOS";
+
+/**
+ * @brief Reducción de sumas parciales publicada segmento a segmento
+ *
+ * Los buffers de cada segmento permanecen vivos hasta esperar(), como exige
+ * MPI para las operaciones no bloqueantes.
+ */
+class ReduccionSolapada {
+public:
+    /**
+     * @brief Prepara la reducción
+     * @param segmentos Número de segmentos que se publicarán
+     * @param modo Modo de suma (el modo compensado reduce pares doble-doble)
+     * @param raiz Rank que recibe el resultado
+     * @param comm Comunicador
+     * @param enTodos Si es true se usa MPI_Iallreduce y el resultado queda en
+     *                todos los procesos (no hace falta difundirlo después)
+     */
+    ReduccionSolapada(int segmentos, ModoSuma modo, int raiz, MPI_Comm comm, bool enTodos = false);
+    
+    ReduccionSolapada(const ReduccionSolapada&) = delete;
+    ReduccionSolapada& operator=(const ReduccionSolapada&) = delete;
+    
+    /**
+     * @brief Publica la suma parcial de un segmento con MPI_Ireduce o MPI_Iallreduce
+     * @param segmento Índice del segmento en [0, segmentos)
+     * @param parcial Suma parcial local del segmento
+     *
+     * Después de publicar se comprueba el estado de las peticiones con
+     * MPI_Testall para que la biblioteca avance las reducciones pendientes.
+     */
+    void publicar(int segmento, const SumaCompensada& parcial);
+    
+    /**
+     * @brief Espera todas las reducciones y combina los segmentos en orden
+     * @return Suma global (en la raíz, o en todos los procesos si enTodos)
+     */
+    SumaCompensada esperar();
+    
+    /**
+     * @brief Tiempo bloqueado en esperar() en segundos
+     */
+    double tiempoEspera() const { return tiempoEspera_; }
+
+private:
+    ModoSuma modo_;
+    int raiz_;
+    MPI_Comm comm_;
+    bool enTodos_;
+    std::vector<SumaCompensada> locales_;
+    std::vector<SumaCompensada> globales_;
+    std::vector<MPI_Request> peticiones_;
+    double tiempoEspera_ = 0.0;
+};
+
+/**
+ * @brief Lee el número de segmentos de la variable de entorno
+ * @return Número de segmentos (0 si no está definida o no es válida)
+ */
+int leerNumSegmentos();
+
+#endif // MPI_AVANZADO_SOLAPAMIENTO_H
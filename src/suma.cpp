@@ -0,0 +1,335 @@
+/**
+ * @file suma.cpp
+ * @brief Implementación del núcleo de suma vectorizado con despacho por CPU
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "suma.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SUMA_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define SUMA_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Par de funciones de suma de una ruta SIMD
+ */
+struct RutaSuma {
+    double (*rapida)(const double*, int64_t);
+    SumaCompensada (*compensada)(const double*, int64_t);
+    const char* nombre;
+};
+
+/**
+ * @brief Paso compensado (TwoSum) sobre un acumulador escalar
+ *
+ * A diferencia de Kahan clásico, TwoSum recupera el error exacto de cada
+ * suma aunque el valor añadido sea mayor que el acumulado.
+ */
+inline void pasoCompensado(double& suma, double& correccion, double valor) {
+    double t = suma + valor;
+    double bp = t - suma;
+    correccion += (suma - (t - bp)) + (valor - bp);
+    suma = t;
+}
+
+/**
+ * @brief Combina los carriles compensados (suma, corrección) y la cola escalar
+ * @param sumas Sumas por carril
+ * @param correcciones Errores de redondeo acumulados por carril
+ * @param carriles Número de carriles
+ * @param datos Valores restantes que no llenan un vector
+ * @param cola Número de valores restantes
+ */
+SumaCompensada combinarCarriles(const double* sumas, const double* correcciones, int carriles,
+                                const double* datos, int64_t cola) {
+    SumaCompensada resultado;
+    for (int i = 0; i < carriles; ++i) {
+        acumularCompensado(resultado, SumaCompensada{sumas[i], correcciones[i]});
+    }
+    
+    double suma = 0.0;
+    double correccion = 0.0;
+    for (int64_t i = 0; i < cola; ++i) {
+        pasoCompensado(suma, correccion, datos[i]);
+    }
+    acumularCompensado(resultado, SumaCompensada{suma, correccion});
+    return resultado;
+}
+
+double sumarRapidoEscalar(const double* datos, int64_t n) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += datos[i];
+        s1 += datos[i + 1];
+        s2 += datos[i + 2];
+        s3 += datos[i + 3];
+    }
+    for (; i < n; ++i) {
+        s0 += datos[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+SumaCompensada sumarCompensadoEscalar(const double* datos, int64_t n) {
+    double sumas[2] = {0.0, 0.0};
+    double correcciones[2] = {0.0, 0.0};
+    int64_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        pasoCompensado(sumas[0], correcciones[0], datos[i]);
+        pasoCompensado(sumas[1], correcciones[1], datos[i + 1]);
+    }
+    return combinarCarriles(sumas, correcciones, 2, datos + i, n - i);
+}
+
+#if defined(SUMA_X86)
+
+__attribute__((target("avx2")))
+double sumarRapidoAVX2(const double* datos, int64_t n) {
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd();
+    __m256d s3 = _mm256_setzero_pd();
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_add_pd(s0, _mm256_loadu_pd(datos + i));
+        s1 = _mm256_add_pd(s1, _mm256_loadu_pd(datos + i + 4));
+        s2 = _mm256_add_pd(s2, _mm256_loadu_pd(datos + i + 8));
+        s3 = _mm256_add_pd(s3, _mm256_loadu_pd(datos + i + 12));
+    }
+    __m256d s = _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3));
+    
+    alignas(32) double carriles[4];
+    _mm256_store_pd(carriles, s);
+    return (carriles[0] + carriles[1]) + (carriles[2] + carriles[3]) + sumarRapidoEscalar(datos + i, n - i);
+}
+
+__attribute__((target("avx2")))
+SumaCompensada sumarCompensadoAVX2(const double* datos, int64_t n) {
+    __m256d s0 = _mm256_setzero_pd(), c0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd(), c1 = _mm256_setzero_pd();
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d x0 = _mm256_loadu_pd(datos + i);
+        __m256d x1 = _mm256_loadu_pd(datos + i + 4);
+        __m256d t0 = _mm256_add_pd(s0, x0);
+        __m256d t1 = _mm256_add_pd(s1, x1);
+        __m256d bp0 = _mm256_sub_pd(t0, s0);
+        __m256d bp1 = _mm256_sub_pd(t1, s1);
+        c0 = _mm256_add_pd(c0, _mm256_add_pd(_mm256_sub_pd(s0, _mm256_sub_pd(t0, bp0)), _mm256_sub_pd(x0, bp0)));
+        c1 = _mm256_add_pd(c1, _mm256_add_pd(_mm256_sub_pd(s1, _mm256_sub_pd(t1, bp1)), _mm256_sub_pd(x1, bp1)));
+        s0 = t0;
+        s1 = t1;
+    }
+    
+    alignas(32) double sumas[8];
+    alignas(32) double correcciones[8];
+    _mm256_store_pd(sumas, s0);
+    _mm256_store_pd(sumas + 4, s1);
+    _mm256_store_pd(correcciones, c0);
+    _mm256_store_pd(correcciones + 4, c1);
+    return combinarCarriles(sumas, correcciones, 8, datos + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+double sumarRapidoAVX512(const double* datos, int64_t n) {
+    __m512d s0 = _mm512_setzero_pd();
+    __m512d s1 = _mm512_setzero_pd();
+    __m512d s2 = _mm512_setzero_pd();
+    __m512d s3 = _mm512_setzero_pd();
+    int64_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_add_pd(s0, _mm512_loadu_pd(datos + i));
+        s1 = _mm512_add_pd(s1, _mm512_loadu_pd(datos + i + 8));
+        s2 = _mm512_add_pd(s2, _mm512_loadu_pd(datos + i + 16));
+        s3 = _mm512_add_pd(s3, _mm512_loadu_pd(datos + i + 24));
+    }
+    __m512d s = _mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3));
+    
+    alignas(64) double carriles[8];
+    _mm512_store_pd(carriles, s);
+    double total = ((carriles[0] + carriles[1]) + (carriles[2] + carriles[3])) +
+                   ((carriles[4] + carriles[5]) + (carriles[6] + carriles[7]));
+    return total + sumarRapidoEscalar(datos + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+SumaCompensada sumarCompensadoAVX512(const double* datos, int64_t n) {
+    __m512d s0 = _mm512_setzero_pd(), c0 = _mm512_setzero_pd();
+    __m512d s1 = _mm512_setzero_pd(), c1 = _mm512_setzero_pd();
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512d x0 = _mm512_loadu_pd(datos + i);
+        __m512d x1 = _mm512_loadu_pd(datos + i + 8);
+        __m512d t0 = _mm512_add_pd(s0, x0);
+        __m512d t1 = _mm512_add_pd(s1, x1);
+        __m512d bp0 = _mm512_sub_pd(t0, s0);
+        __m512d bp1 = _mm512_sub_pd(t1, s1);
+        c0 = _mm512_add_pd(c0, _mm512_add_pd(_mm512_sub_pd(s0, _mm512_sub_pd(t0, bp0)), _mm512_sub_pd(x0, bp0)));
+        c1 = _mm512_add_pd(c1, _mm512_add_pd(_mm512_sub_pd(s1, _mm512_sub_pd(t1, bp1)), _mm512_sub_pd(x1, bp1)));
+        s0 = t0;
+        s1 = t1;
+    }
+    
+    alignas(64) double sumas[16];
+    alignas(64) double correcciones[16];
+    _mm512_store_pd(sumas, s0);
+    _mm512_store_pd(sumas + 8, s1);
+    _mm512_store_pd(correcciones, c0);
+    _mm512_store_pd(correcciones + 8, c1);
+    return combinarCarriles(sumas, correcciones, 16, datos + i, n - i);
+}
+
+#elif defined(SUMA_NEON)
+
+double sumarRapidoNEON(const double* datos, int64_t n) {
+    float64x2_t s0 = vdupq_n_f64(0.0);
+    float64x2_t s1 = vdupq_n_f64(0.0);
+    float64x2_t s2 = vdupq_n_f64(0.0);
+    float64x2_t s3 = vdupq_n_f64(0.0);
+    int64_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s0 = vaddq_f64(s0, vld1q_f64(datos + i));
+        s1 = vaddq_f64(s1, vld1q_f64(datos + i + 2));
+        s2 = vaddq_f64(s2, vld1q_f64(datos + i + 4));
+        s3 = vaddq_f64(s3, vld1q_f64(datos + i + 6));
+    }
+    float64x2_t s = vaddq_f64(vaddq_f64(s0, s1), vaddq_f64(s2, s3));
+    return (vgetq_lane_f64(s, 0) + vgetq_lane_f64(s, 1)) + sumarRapidoEscalar(datos + i, n - i);
+}
+
+SumaCompensada sumarCompensadoNEON(const double* datos, int64_t n) {
+    float64x2_t s0 = vdupq_n_f64(0.0), c0 = vdupq_n_f64(0.0);
+    float64x2_t s1 = vdupq_n_f64(0.0), c1 = vdupq_n_f64(0.0);
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float64x2_t x0 = vld1q_f64(datos + i);
+        float64x2_t x1 = vld1q_f64(datos + i + 2);
+        float64x2_t t0 = vaddq_f64(s0, x0);
+        float64x2_t t1 = vaddq_f64(s1, x1);
+        float64x2_t bp0 = vsubq_f64(t0, s0);
+        float64x2_t bp1 = vsubq_f64(t1, s1);
+        c0 = vaddq_f64(c0, vaddq_f64(vsubq_f64(s0, vsubq_f64(t0, bp0)), vsubq_f64(x0, bp0)));
+        c1 = vaddq_f64(c1, vaddq_f64(vsubq_f64(s1, vsubq_f64(t1, bp1)), vsubq_f64(x1, bp1)));
+        s0 = t0;
+        s1 = t1;
+    }
+    
+    double sumas[4];
+    double correcciones[4];
+    vst1q_f64(sumas, s0);
+    vst1q_f64(sumas + 2, s1);
+    vst1q_f64(correcciones, c0);
+    vst1q_f64(correcciones + 2, c1);
+    return combinarCarriles(sumas, correcciones, 4, datos + i, n - i);
+}
+
+#endif
+
+/**
+ * @brief Selecciona la mejor ruta disponible en la CPU actual
+ */
+RutaSuma seleccionarRuta() {
+#if defined(SUMA_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return {sumarRapidoAVX512, sumarCompensadoAVX512, "AVX-512"};
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return {sumarRapidoAVX2, sumarCompensadoAVX2, "AVX2"};
+    }
+#elif defined(SUMA_NEON)
+    return {sumarRapidoNEON, sumarCompensadoNEON, "NEON"};
+#endif
+    return {sumarRapidoEscalar, sumarCompensadoEscalar, "escalar"};
+}
+
+/**
+ * @brief Ruta elegida (se resuelve una sola vez por proceso)
+ */
+const RutaSuma& rutaActual() {
+    static const RutaSuma ruta = seleccionarRuta();
+    return ruta;
+}
+
+void reducirSumaCompensada(void* entrada, void* salida, int* longitud, MPI_Datatype*) {
+    const SumaCompensada* origen = static_cast<const SumaCompensada*>(entrada);
+    SumaCompensada* destino = static_cast<SumaCompensada*>(salida);
+    for (int i = 0; i < *longitud; ++i) {
+        acumularCompensado(destino[i], origen[i]);
+    }
+}
+
+} // namespace
+
+double sumarRapido(const double* datos, int64_t n) {
+    return rutaActual().rapida(datos, n);
+}
+
+SumaCompensada sumarCompensado(const double* datos, int64_t n) {
+    return rutaActual().compensada(datos, n);
+}
+
+double sumarValores(const double* datos, int64_t n, ModoSuma modo) {
+    if (modo == ModoSuma::Compensada) {
+        return sumarCompensado(datos, n).total();
+    }
+    return sumarRapido(datos, n);
+}
+
+void acumularCompensado(SumaCompensada& acumulado, const SumaCompensada& parcial) {
+    // TwoSum de Knuth sobre las partes principales; el error se lleva a la corrección
+    double s = acumulado.suma + parcial.suma;
+    double bp = s - acumulado.suma;
+    double error = (acumulado.suma - (s - bp)) + (parcial.suma - bp);
+    double correccion = acumulado.compensacion + parcial.compensacion + error;
+    
+    // Renormalizar para que |compensacion| quede por debajo de ulp(suma)
+    acumulado.suma = s + correccion;
+    acumulado.compensacion = correccion - (acumulado.suma - s);
+}
+
+const char* nombreRutaSimd() {
+    return rutaActual().nombre;
+}
+
+ModoSuma leerModoSuma() {
+    const char* valor = std::getenv(VARIABLE_MODO_SUMA);
+    if (valor != nullptr && std::strcmp(valor, "compensada") == 0) {
+        return ModoSuma::Compensada;
+    }
+    return ModoSuma::Rapida;
+}
+
+const char* nombreModoSuma(ModoSuma modo) {
+    return modo == ModoSuma::Compensada ? "compensada" : "rapida";
+}
+
+MPI_Datatype tipoSumaCompensada() {
+    static MPI_Datatype tipo = [] {
+        MPI_Datatype nuevo;
+        MPI_Type_contiguous(2, MPI_DOUBLE, &nuevo);
+        MPI_Type_commit(&nuevo);
+        return nuevo;
+    }();
+    return tipo;
+}
+
+MPI_Op opSumaCompensada() {
+    static MPI_Op op = [] {
+        MPI_Op nueva;
+        MPI_Op_create(reducirSumaCompensada, 1, &nueva);
+        return nueva;
+    }();
+    return op;
+}
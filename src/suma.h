@@ -0,0 +1,110 @@
+/**
+ * @file suma.h
+ * @brief Núcleo de suma compartido, vectorizado y numéricamente robusto
+ * @author Emil M
+ * @date 2025
+ * 
+ * La suma escalar `suma += valor` es una cadena de dependencias que el
+ * compilador no puede vectorizar sin relajar la semántica de punto flotante.
+ * Este núcleo usa varios acumuladores independientes con rutas explícitas
+ * AVX-512, AVX2 y NEON, elegidas en tiempo de ejecución según la CPU.
+ * 
+ * El modo compensado (TwoSum por carril y combinación doble-doble) reduce el
+ * error de redondeo a O(ε) independientemente de N, de modo que el promedio
+ * no depende en la práctica del número de procesos ni del orden de la suma.
+ */
+
+#ifndef MPI_AVANZADO_SUMA_H
+#define MPI_AVANZADO_SUMA_H
+
+#include <mpi.h>
+#include <cstdint>
+
+/**
+ * @brief Variable de entorno para seleccionar el modo de suma
+ *
+ * Valores aceptados: `rapida` (por defecto) y `compensada`.
+ */
+const char* const VARIABLE_MODO_SUMA = "MPI_AVANZADO_SUMA";
+
+/**
+ * @brief Modo de suma
+ */
+enum class ModoSuma {
+    Rapida,     ///< Varios acumuladores SIMD, máximo rendimiento
+    Compensada  ///< Suma compensada (TwoSum + doble-doble), reproducible
+};
+
+/**
+ * @brief Suma representada como par doble-doble (valor + corrección)
+ */
+struct SumaCompensada {
+    double suma = 0.0;          ///< Aproximación principal de la suma
+    double compensacion = 0.0;  ///< Error de redondeo acumulado
+    
+    /**
+     * @brief Valor de la suma redondeado a double
+     */
+    double total() const { return suma + compensacion; }
+};
+
+/**
+ * @brief Suma rápida con varios acumuladores SIMD
+ * @param datos Puntero a los valores
+ * @param n Número de valores
+ * @return Suma de los valores
+ */
+double sumarRapido(const double* datos, int64_t n);
+
+/**
+ * @brief Suma compensada (estilo Kahan, con TwoSum) por carril SIMD
+ * @param datos Puntero a los valores
+ * @param n Número de valores
+ * @return Suma en formato doble-doble
+ */
+SumaCompensada sumarCompensado(const double* datos, int64_t n);
+
+/**
+ * @brief Suma los valores en el modo indicado
+ * @param datos Puntero a los valores
+ * @param n Número de valores
+ * @param modo Modo de suma
+ * @return Suma de los valores redondeada a double
+ */
+double sumarValores(const double* datos, int64_t n, ModoSuma modo = ModoSuma::Rapida);
+
+/**
+ * @brief Acumula una suma compensada en otra sin perder la corrección
+ * @param acumulado Suma de destino
+ * @param parcial Suma a añadir
+ */
+void acumularCompensado(SumaCompensada& acumulado, const SumaCompensada& parcial);
+
+/**
+ * @brief Nombre de la ruta SIMD seleccionada en esta CPU
+ * @return "AVX-512", "AVX2", "NEON" o "escalar"
+ */
+const char* nombreRutaSimd();
+
+/**
+ * @brief Lee el modo de suma de la variable de entorno
+ * @return Modo de suma (rápida si no está definida)
+ */
+ModoSuma leerModoSuma();
+
+/**
+ * @brief Nombre legible del modo de suma
+ */
+const char* nombreModoSuma(ModoSuma modo);
+
+/**
+ * @brief Tipo MPI para SumaCompensada (dos MPI_DOUBLE contiguos)
+ */
+MPI_Datatype tipoSumaCompensada();
+
+/**
+ * @brief Operación MPI conmutativa que suma pares SumaCompensada
+ */
+MPI_Op opSumaCompensada();
+
+#endif // MPI_AVANZADO_SUMA_H
@@ -1,262 +1,1684 @@
-/**
- * @file test.cpp
- * @brief Programa de pruebas para validar la corrección de las operaciones colectivas
- * @author Emil M
- * @date 2025
- * 
- * Este programa realiza pruebas unitarias para:
- * - Validar que MPI_Bcast funciona correctamente
- * - Validar que MPI_Reduce funciona correctamente
- * - Validar que el cálculo del promedio es correcto
- * - Verificar la sincronización entre procesos
- */
-
-#include <mpi.h>
-#include <iostream>
-#include <vector>
-#include <random>
-#include <cmath>
-#include <cassert>
-
-/**
- * @brief Prueba la funcionalidad de MPI_Bcast
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- * @return true si la prueba pasa, false en caso contrario
- */
-bool testBroadcast(int rank, int numProcs) {
-    std::cout << "Proceso " << rank << ": Ejecutando prueba de MPI_Bcast..." << std::endl;
-    
-    int valorOriginal = 42;
-    int valorRecibido = 0;
-    
-    // El proceso raíz inicializa el valor
-    if (rank == 0) {
-        valorRecibido = valorOriginal;
-    }
-    
-    // Broadcast del valor
-    MPI_Bcast(&valorRecibido, 1, MPI_INT, 0, MPI_COMM_WORLD);
-    
-    // Verificar que todos los procesos recibieron el valor correcto
-    bool resultado = (valorRecibido == valorOriginal);
-    
-    std::cout << "Proceso " << rank << ": Valor recibido = " << valorRecibido 
-              << " (esperado = " << valorOriginal << ")" << std::endl;
-    
-    return resultado;
-}
-
-/**
- * @brief Prueba la funcionalidad de MPI_Reduce
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- * @return true si la prueba pasa, false en caso contrario
- */
-bool testReduce(int rank, int numProcs) {
-    std::cout << "Proceso " << rank << ": Ejecutando prueba de MPI_Reduce..." << std::endl;
-    
-    double valorLocal = static_cast<double>(rank + 1);
-    double sumaTotal = 0.0;
-    
-    // Calcular la suma esperada
-    double sumaEsperada = 0.0;
-    for (int i = 0; i < numProcs; ++i) {
-        sumaEsperada += (i + 1);
-    }
-    
-    // Reduce para sumar todos los valores
-    MPI_Reduce(&valorLocal, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-    
-    bool resultado = true;
-    if (rank == 0) {
-        resultado = (std::abs(sumaTotal - sumaEsperada) < 1e-10);
-        std::cout << "Proceso " << rank << ": Suma total = " << sumaTotal 
-                  << " (esperada = " << sumaEsperada << ")" << std::endl;
-    }
-    
-    return resultado;
-}
-
-/**
- * @brief Prueba el cálculo del promedio con valores conocidos
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- * @return true si la prueba pasa, false en caso contrario
- */
-bool testPromedio(int rank, int numProcs) {
-    std::cout << "Proceso " << rank << ": Ejecutando prueba de cálculo de promedio..." << std::endl;
-    
-    // Usar valores conocidos para facilitar la verificación
-    std::vector<double> valores = {1.0, 2.0, 3.0, 4.0, 5.0};
-    int N = valores.size();
-    
-    // Calcular suma parcial
-    double sumaParcial = 0.0;
-    for (double valor : valores) {
-        sumaParcial += valor;
-    }
-    
-    // Ajustar la suma parcial según el rank para simular diferentes procesos
-    sumaParcial += rank * N * 10.0;
-    
-    double sumaTotal = 0.0;
-    double promedioFinal = 0.0;
-    
-    // MPI_Reduce
-    MPI_Reduce(&sumaParcial, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-    
-    // Calcular promedio en proceso raíz
-    if (rank == 0) {
-        promedioFinal = sumaTotal / (N * numProcs);
-        
-        // Calcular el promedio esperado
-        double sumaEsperada = 0.0;
-        for (int i = 0; i < numProcs; ++i) {
-            double sumaLocal = 0.0;
-            for (double valor : valores) {
-                sumaLocal += valor;
-            }
-            sumaLocal += i * N * 10.0;
-            sumaEsperada += sumaLocal;
-        }
-        double promedioEsperado = sumaEsperada / (N * numProcs);
-        
-        bool resultado = (std::abs(promedioFinal - promedioEsperado) < 1e-10);
-        std::cout << "Proceso " << rank << ": Promedio calculado = " << promedioFinal 
-                  << " (esperado = " << promedioEsperado << ")" << std::endl;
-        
-        return resultado;
-    }
-    
-    return true;
-}
-
-/**
- * @brief Prueba la sincronización entre procesos
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- * @return true si la prueba pasa, false en caso contrario
- */
-bool testSincronizacion(int rank, int numProcs) {
-    std::cout << "Proceso " << rank << ": Ejecutando prueba de sincronización..." << std::endl;
-    
-    // Simular trabajo de diferentes duraciones
-    int trabajo = rank + 1;
-    for (int i = 0; i < trabajo * 1000; ++i) {
-        // Trabajo simulado
-        volatile double x = std::sqrt(static_cast<double>(i));
-    }
-    
-    // Punto de sincronización
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    // Si llegamos aquí, la sincronización funcionó
-    std::cout << "Proceso " << rank << ": Sincronización completada exitosamente" << std::endl;
-    
-    return true;
-}
-
-/**
- * @brief Prueba completa del programa principal con valores aleatorios
- * @param rank Rank del proceso actual
- * @param numProcs Número total de procesos
- * @return true si la prueba pasa, false en caso contrario
- */
-bool testProgramaCompleto(int rank, int numProcs) {
-    std::cout << "Proceso " << rank << ": Ejecutando prueba completa del programa..." << std::endl;
-    
-    int N = 100;
-    std::vector<double> valores(N);
-    double sumaParcial = 0.0;
-    double sumaTotal = 0.0;
-    double promedioFinal = 0.0;
-    
-    // Generar valores aleatorios con semilla fija para reproducibilidad
-    std::mt19937 generador(rank + 42);
-    std::uniform_real_distribution<double> distribucion(0.0, 100.0);
-    
-    for (int i = 0; i < N; ++i) {
-        valores[i] = distribucion(generador);
-        sumaParcial += valores[i];
-    }
-    
-    // MPI_Reduce
-    MPI_Reduce(&sumaParcial, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-    
-    // Calcular promedio en proceso raíz
-    if (rank == 0) {
-        promedioFinal = sumaTotal / (N * numProcs);
-        
-        // Verificar que el promedio está en un rango razonable (0-100)
-        bool resultado = (promedioFinal >= 0.0 && promedioFinal <= 100.0);
-        std::cout << "Proceso " << rank << ": Promedio final = " << promedioFinal 
-                  << " (rango válido: 0-100)" << std::endl;
-        
-        return resultado;
-    }
-    
-    return true;
-}
-
-int main(int argc, char** argv) {
-    MPI_Init(&argc, &argv);
-    
-    int rank, numProcs;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
-    
-    if (rank == 0) {
-        std::cout << "=== PRUEBAS DE COMUNICACIONES COLECTIVAS MPI ===" << std::endl;
-        std::cout << "Número de procesos: " << numProcs << std::endl;
-        std::cout << std::endl;
-    }
-    
-    // Sincronizar antes de comenzar las pruebas
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    bool todasLasPruebasPasan = true;
-    
-    // Ejecutar todas las pruebas
-    todasLasPruebasPasan &= testBroadcast(rank, numProcs);
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    todasLasPruebasPasan &= testReduce(rank, numProcs);
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    todasLasPruebasPasan &= testPromedio(rank, numProcs);
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    todasLasPruebasPasan &= testSincronizacion(rank, numProcs);
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    todasLasPruebasPasan &= testProgramaCompleto(rank, numProcs);
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    // Verificar resultados globales
-    int resultadoGlobal = todasLasPruebasPasan ? 1 : 0;
-    int resultadoTotal = 0;
-    
-    MPI_Reduce(&resultadoGlobal, &resultadoTotal, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-    
-    // Sincronizar antes de imprimir resultados finales
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    if (rank == 0) {
-        std::cout << std::endl << "=== RESULTADOS DE LAS PRUEBAS ===" << std::endl;
-        if (resultadoTotal == numProcs) {
-            std::cout << "✅ TODAS LAS PRUEBAS PASARON EXITOSAMENTE" << std::endl;
-        } else {
-            std::cout << "❌ ALGUNAS PRUEBAS FALLARON" << std::endl;
-            std::cout << "Procesos que pasaron las pruebas: " << resultadoTotal << "/" << numProcs << std::endl;
-        }
-        std::cout << std::endl;
-    }
-    
-    // Sincronizar antes de finalizar
-    MPI_Barrier(MPI_COMM_WORLD);
-    
-    MPI_Finalize();
-    
-    return (resultadoTotal == numProcs) ? 0 : 1;
+/**
+ * @file test.cpp
+ * @brief Programa de pruebas para validar la corrección de las operaciones colectivas
+ * @author Emil M
+ * @date 2025
+ * 
+ * Este programa realiza pruebas unitarias para:
+ * - Validar que MPI_Bcast funciona correctamente
+ * - Validar que MPI_Reduce funciona correctamente
+ * - Validar que el cálculo del promedio es correcto
+ * - Verificar la sincronización entre procesos
+ */
+
+#include <mpi.h>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <unistd.h>
+
+#include "ajuste.h"
+#include "aleatorio.h"
+#include "algoritmos.h"
+#include "colectivas.h"
+#include "desfase.h"
+#include "entrada.h"
+#include "escalado.h"
+#include "estadisticas.h"
+#include "gpu.h"
+#include "jerarquia.h"
+#include "malla.h"
+#include "memoria.h"
+#include "persistente.h"
+#include "precision.h"
+#include "reductor.h"
+#include "puntocontrol.h"
+#include "reparto.h"
+#include "resiliencia.h"
+#include "resultados.h"
+#include "resumen.h"
+#include "suma.h"
+#include "usomemoria.h"
+
+/**
+ * @brief Prueba la funcionalidad de MPI_Bcast
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testBroadcast(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de MPI_Bcast..." << std::endl;
+    
+    int valorOriginal = 42;
+    int valorRecibido = 0;
+    
+    // El proceso raíz inicializa el valor
+    if (rank == 0) {
+        valorRecibido = valorOriginal;
+    }
+    
+    // Broadcast del valor
+    MPI_Bcast(&valorRecibido, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    
+    // Verificar que todos los procesos recibieron el valor correcto
+    bool resultado = (valorRecibido == valorOriginal);
+    
+    std::cout << "Proceso " << rank << ": Valor recibido = " << valorRecibido 
+              << " (esperado = " << valorOriginal << ")" << std::endl;
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba la funcionalidad de MPI_Reduce
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testReduce(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de MPI_Reduce..." << std::endl;
+    
+    double valorLocal = static_cast<double>(rank + 1);
+    double sumaTotal = 0.0;
+    
+    // Calcular la suma esperada
+    double sumaEsperada = 0.0;
+    for (int i = 0; i < numProcs; ++i) {
+        sumaEsperada += (i + 1);
+    }
+    
+    // Reduce para sumar todos los valores
+    MPI_Reduce(&valorLocal, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    
+    bool resultado = true;
+    if (rank == 0) {
+        resultado = (std::abs(sumaTotal - sumaEsperada) < 1e-10);
+        std::cout << "Proceso " << rank << ": Suma total = " << sumaTotal 
+                  << " (esperada = " << sumaEsperada << ")" << std::endl;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba el cálculo del promedio con valores conocidos
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testPromedio(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de cálculo de promedio..." << std::endl;
+    
+    // Usar valores conocidos para facilitar la verificación
+    std::vector<double> valores = {1.0, 2.0, 3.0, 4.0, 5.0};
+    int N = valores.size();
+    
+    // Calcular suma parcial
+    double sumaParcial = 0.0;
+    for (double valor : valores) {
+        sumaParcial += valor;
+    }
+    
+    // Ajustar la suma parcial según el rank para simular diferentes procesos
+    sumaParcial += rank * N * 10.0;
+    
+    double sumaTotal = 0.0;
+    double promedioFinal = 0.0;
+    
+    // MPI_Reduce
+    MPI_Reduce(&sumaParcial, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    
+    // Calcular promedio en proceso raíz
+    if (rank == 0) {
+        promedioFinal = sumaTotal / (N * numProcs);
+        
+        // Calcular el promedio esperado
+        double sumaEsperada = 0.0;
+        for (int i = 0; i < numProcs; ++i) {
+            double sumaLocal = 0.0;
+            for (double valor : valores) {
+                sumaLocal += valor;
+            }
+            sumaLocal += i * N * 10.0;
+            sumaEsperada += sumaLocal;
+        }
+        double promedioEsperado = sumaEsperada / (N * numProcs);
+        
+        bool resultado = (std::abs(promedioFinal - promedioEsperado) < 1e-10);
+        std::cout << "Proceso " << rank << ": Promedio calculado = " << promedioFinal 
+                  << " (esperado = " << promedioEsperado << ")" << std::endl;
+        
+        return resultado;
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Prueba la sincronización entre procesos
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testSincronizacion(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de sincronización..." << std::endl;
+    
+    // Simular trabajo de diferentes duraciones
+    int trabajo = rank + 1;
+    for (int i = 0; i < trabajo * 1000; ++i) {
+        // Trabajo simulado
+        volatile double x = std::sqrt(static_cast<double>(i));
+    }
+    
+    // Punto de sincronización
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    // Si llegamos aquí, la sincronización funcionó
+    std::cout << "Proceso " << rank << ": Sincronización completada exitosamente" << std::endl;
+    
+    return true;
+}
+
+/**
+ * @brief Prueba completa del programa principal con valores aleatorios
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testProgramaCompleto(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba completa del programa..." << std::endl;
+    
+    int N = 100;
+    std::vector<double> valores(N);
+    double sumaParcial = 0.0;
+    double sumaTotal = 0.0;
+    double promedioFinal = 0.0;
+    
+    // Generar valores aleatorios con semilla fija para reproducibilidad
+    std::mt19937 generador(rank + 42);
+    std::uniform_real_distribution<double> distribucion(0.0, 100.0);
+    
+    for (int i = 0; i < N; ++i) {
+        valores[i] = distribucion(generador);
+        sumaParcial += valores[i];
+    }
+    
+    // MPI_Reduce
+    MPI_Reduce(&sumaParcial, &sumaTotal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    
+    // Calcular promedio en proceso raíz
+    if (rank == 0) {
+        promedioFinal = sumaTotal / (N * numProcs);
+        
+        // Verificar que el promedio está en un rango razonable (0-100)
+        bool resultado = (promedioFinal >= 0.0 && promedioFinal <= 100.0);
+        std::cout << "Proceso " << rank << ": Promedio final = " << promedioFinal 
+                  << " (rango válido: 0-100)" << std::endl;
+        
+        return resultado;
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Prueba el núcleo de suma vectorizado y el modo compensado
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testNucleoSuma(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba del núcleo de suma ("
+              << nombreRutaSimd() << ")..." << std::endl;
+    
+    bool resultado = true;
+    
+    // Enteros consecutivos: la suma es exacta en double, incluidas las colas
+    // que no llenan un vector completo
+    std::vector<int64_t> longitudes = {0, 1, 3, 7, 15, 16, 17, 31, 33, 1000, 1001};
+    for (int64_t n : longitudes) {
+        std::vector<double> valores(n);
+        for (int64_t i = 0; i < n; ++i) {
+            valores[i] = static_cast<double>(i + 1);
+        }
+        double esperada = static_cast<double>(n * (n + 1) / 2);
+        resultado &= (sumarRapido(valores.data(), n) == esperada);
+        resultado &= (sumarCompensado(valores.data(), n).total() == esperada);
+    }
+    
+    // Cancelación catastrófica: la suma ingenua pierde todos los unos
+    std::vector<double> cancelacion(1002, 1.0);
+    cancelacion.front() = 1e16;
+    cancelacion.back() = -1e16;
+    double compensada = sumarCompensado(cancelacion.data(), static_cast<int64_t>(cancelacion.size())).total();
+    resultado &= (compensada == 1000.0);
+    
+    // Reducción MPI del par doble-doble: la raíz aporta 1e16 que se cancela al final
+    std::vector<double> local = {1.0};
+    if (rank == 0) {
+        local.push_back(1e16);
+    }
+    SumaCompensada parcial = sumarCompensado(local.data(), static_cast<int64_t>(local.size()));
+    SumaCompensada global;
+    MPI_Reduce(&parcial, &global, 1, tipoSumaCompensada(), opSumaCompensada(), 0, MPI_COMM_WORLD);
+    
+    if (rank == 0) {
+        acumularCompensado(global, SumaCompensada{-1e16, 0.0});
+        resultado &= (global.total() == static_cast<double>(numProcs));
+        std::cout << "Proceso " << rank << ": Suma compensada global = " << global.total()
+                  << " (esperada = " << numProcs << ")" << std::endl;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba el generador basado en contador (Philox4x32-10)
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testGeneradorContador(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba del generador Philox..." << std::endl;
+    
+    // Vectores de respuesta conocida de Random123
+    GeneradorPhilox::Contador ceros = GeneradorPhilox::philox({0, 0, 0, 0}, {0, 0});
+    GeneradorPhilox::Contador unos = GeneradorPhilox::philox(
+        {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, {0xffffffffu, 0xffffffffu});
+    bool resultado = (ceros == GeneradorPhilox::Contador{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}) &&
+                     (unos == GeneradorPhilox::Contador{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu});
+    
+    // El conjunto global es el mismo se genere de una vez o repartido entre
+    // procesos: cada proceso genera su tramo y lo compara con el valor directo
+    const int64_t porProceso = 1001;
+    GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+    uint64_t inicio = static_cast<uint64_t>(rank) * porProceso + 3;
+    std::vector<double> tramo(porProceso);
+    generador.generar(inicio, porProceso, tramo.data());
+    
+    for (int64_t i = 0; i < porProceso; ++i) {
+        double esperado = 100.0 * generador.uniforme(inicio + i);
+        resultado &= (tramo[i] == esperado && tramo[i] >= 0.0 && tramo[i] < 100.0);
+    }
+    
+    // Suma global del tramo repartido frente a la generación en un solo proceso
+    double sumaLocal = sumarCompensado(tramo.data(), porProceso).total();
+    double sumaGlobal = 0.0;
+    MPI_Reduce(&sumaLocal, &sumaGlobal, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    
+    if (rank == 0) {
+        std::vector<double> completo(porProceso * numProcs);
+        generador.generar(3, static_cast<int64_t>(completo.size()), completo.data());
+        double esperada = 0.0;
+        for (int p = 0; p < numProcs; ++p) {
+            esperada += sumarCompensado(completo.data() + p * porProceso, porProceso).total();
+        }
+        resultado &= (std::abs(sumaGlobal - esperada) < 1e-6);
+        std::cout << "Proceso " << rank << ": Suma global = " << sumaGlobal
+                  << " (esperada = " << esperada << ")" << std::endl;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba que todas las estrategias colectivas dejan la misma reducción en todos los procesos
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testEstrategiasColectivas(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de estrategias colectivas..." << std::endl;
+    
+    // Tamaño no divisible entre el número de procesos para probar los restos
+    const int64_t n = 7 * numProcs + 3;
+    std::vector<double> local(n);
+    for (int64_t i = 0; i < n; ++i) {
+        local[i] = static_cast<double>(rank + 1 + i);
+    }
+    
+    bool resultado = true;
+    for (EstrategiaColectiva estrategia : ESTRATEGIAS_COLECTIVAS) {
+        std::vector<double> global(n, -1.0);
+        reducirEnTodos(local.data(), global.data(), n, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, estrategia);
+        
+        bool correcta = true;
+        for (int64_t i = 0; i < n; ++i) {
+            double esperado = numProcs * (numProcs + 1) / 2.0 + static_cast<double>(numProcs) * i;
+            correcta &= (global[i] == esperado);
+        }
+        if (!correcta) {
+            std::cout << "Proceso " << rank << ": Estrategia " << nombreEstrategia(estrategia)
+                      << " produjo un resultado incorrecto" << std::endl;
+        }
+        resultado &= correcta;
+    }
+    
+    // Más de INT_MAX elementos no caben en los desplazamientos int del
+    // allgatherv aunque cada bloque sí quepa: se pasa a allreduce
+    const int64_t limite = std::numeric_limits<int>::max();
+    resultado &= estrategiaEfectiva(EstrategiaColectiva::ReduceScatterAllgather, limite) ==
+                 EstrategiaColectiva::ReduceScatterAllgather;
+    resultado &= estrategiaEfectiva(EstrategiaColectiva::ReduceScatterAllgather, limite + 1) ==
+                 EstrategiaColectiva::Allreduce;
+    resultado &= estrategiaEfectiva(EstrategiaColectiva::ReduceScatterAllgather, 4 * limite) ==
+                 EstrategiaColectiva::Allreduce;
+    resultado &= estrategiaEfectiva(EstrategiaColectiva::ReduceBcast, 4 * limite) ==
+                 EstrategiaColectiva::ReduceBcast;
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba las estadísticas de tiempo y el máximo entre procesos por iteración
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testEstadisticas(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de estadísticas de tiempo..." << std::endl;
+    
+    // Muestras 1..100 desordenadas: percentiles con interpolación lineal conocidos
+    std::vector<double> muestras;
+    for (int i = 100; i >= 1; --i) {
+        muestras.push_back(static_cast<double>(i));
+    }
+    EstadisticasTiempo estadisticas = calcularEstadisticas(muestras);
+    bool resultado = estadisticas.muestras == 100 && estadisticas.minimo == 1.0 &&
+                     estadisticas.maximo == 100.0 && estadisticas.media == 50.5 &&
+                     estadisticas.mediana == 50.5 &&
+                     std::abs(estadisticas.p95 - 95.05) < 1e-12 &&
+                     std::abs(estadisticas.p99 - 99.01) < 1e-12 &&
+                     std::abs(estadisticas.desviacion - std::sqrt(841.6666666666666)) < 1e-9;
+    
+    // La muestra de cada iteración es la del proceso más lento
+    std::vector<double> locales = {static_cast<double>(rank), static_cast<double>(-rank), 7.0};
+    std::vector<double> maximos = maximoPorIteracion(locales, 0, MPI_COMM_WORLD);
+    if (rank == 0) {
+        resultado &= maximos.size() == 3 && maximos[0] == numProcs - 1 && maximos[1] == 0.0 && maximos[2] == 7.0;
+        std::cout << "Proceso " << rank << ": Mediana = " << estadisticas.mediana << ", p99 = "
+                  << estadisticas.p99 << " (esperados 50.5 y 99.01)" << std::endl;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba el pool de buffers alineados y su reutilización
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testPoolBuffers(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba del pool de buffers..." << std::endl;
+    
+    bool resultado = true;
+    for (AsignadorMemoria asignador : {AsignadorMemoria::Alineado, AsignadorMemoria::MpiAllocMem}) {
+        PoolBuffers buffers(asignador);
+        
+        // Un buffer grande se alinea a página enorme y llega ya tocado (a cero)
+        int64_t grande = TAMANO_PAGINA_ENORME / static_cast<int64_t>(sizeof(double));
+        double* datos = buffers.obtener(0, grande);
+        bool correcto = datos != nullptr && buffers.bytesReservados() >= TAMANO_PAGINA_ENORME;
+        if (asignador == AsignadorMemoria::Alineado) {
+            correcto &= reinterpret_cast<uintptr_t>(datos) % TAMANO_PAGINA_ENORME == 0;
+        }
+        correcto &= datos[0] == 0.0 && datos[grande - 1] == 0.0;
+        
+        // Pedir menos capacidad reutiliza el mismo buffer
+        datos[0] = static_cast<double>(rank);
+        correcto &= buffers.obtener(0, 10) == datos && datos[0] == rank;
+        
+        // Los buffers se pueden usar directamente en las colectivas
+        double* recepcion = buffers.obtener(1, 1);
+        MPI_Allreduce(datos, recepcion, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        correcto &= recepcion[0] == numProcs * (numProcs - 1) / 2.0;
+        
+        if (!correcto) {
+            std::cout << "Proceso " << rank << ": Falló el asignador " << nombreAsignador(asignador) << std::endl;
+        }
+        resultado &= correcto;
+        buffers.liberar();
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba las colectivas jerárquicas con nodos reales y emulados
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testJerarquia(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de colectivas jerárquicas..." << std::endl;
+    
+    const int64_t elementos = 1000;
+    bool resultado = true;
+    for (int ranksPorNodo : {0, 1, 2}) {
+        ComunicadorJerarquico jerarquico(MPI_COMM_WORLD, ranksPorNodo);
+        bool correcto = true;
+        if (ranksPorNodo > 0) {
+            correcto &= jerarquico.numNodos() == (numProcs + ranksPorNodo - 1) / ranksPorNodo;
+            correcto &= jerarquico.esLider() == (rank % ranksPorNodo == 0);
+        }
+        
+        std::vector<double> locales(elementos);
+        for (int64_t i = 0; i < elementos; ++i) {
+            locales[i] = static_cast<double>(rank + i);
+        }
+        
+        // La suma del elemento i es sum(rank) + P*i
+        std::vector<double> suma(elementos, -1.0);
+        jerarquico.reduce(locales.data(), suma.data(), elementos, MPI_DOUBLE, MPI_SUM);
+        double sumaRanks = numProcs * (numProcs - 1) / 2.0;
+        if (rank == 0) {
+            for (int64_t i = 0; i < elementos; ++i) {
+                correcto &= suma[i] == sumaRanks + static_cast<double>(numProcs) * i;
+            }
+        }
+        
+        std::vector<double> todos(elementos, -1.0);
+        jerarquico.allreduce(locales.data(), todos.data(), elementos, MPI_DOUBLE, MPI_SUM);
+        for (int64_t i = 0; i < elementos; ++i) {
+            correcto &= todos[i] == sumaRanks + static_cast<double>(numProcs) * i;
+        }
+        
+        std::vector<double> difundidos(elementos, rank == 0 ? 3.5 : 0.0);
+        jerarquico.bcast(difundidos.data(), elementos, MPI_DOUBLE);
+        correcto &= difundidos.front() == 3.5 && difundidos.back() == 3.5;
+        
+        if (!correcto) {
+            std::cout << "Proceso " << rank << ": Falló con " << ranksPorNodo << " ranks por nodo" << std::endl;
+        }
+        resultado &= correcto;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba el broadcast sobre la ventana de memoria compartida del nodo
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testBufferNodoCompartido(int rank, int /* numProcs */) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de la ventana compartida del nodo..." << std::endl;
+    
+    const int64_t elementos = 4096;
+    bool resultado = true;
+    for (int ranksPorNodo : {0, 2}) {
+        ComunicadorJerarquico jerarquico(MPI_COMM_WORLD, ranksPorNodo);
+        BufferNodoCompartido compartido(jerarquico, elementos * static_cast<int64_t>(sizeof(double)));
+        double* datos = static_cast<double*>(compartido.datos());
+        bool correcto = datos != nullptr;
+        
+        // Dos difusiones seguidas: la segunda no debe pisar a lectores de la primera
+        for (int ronda = 1; ronda <= 2; ++ronda) {
+            compartido.esperarLectores();
+            if (rank == 0) {
+                for (int64_t i = 0; i < elementos; ++i) {
+                    datos[i] = static_cast<double>(ronda * i);
+                }
+            }
+            compartido.difundir(elementos, MPI_DOUBLE);
+            for (int64_t i = 0; i < elementos; ++i) {
+                correcto &= datos[i] == static_cast<double>(ronda * i);
+            }
+        }
+        
+        if (!correcto) {
+            std::cout << "Proceso " << rank << ": Falló con " << ranksPorNodo << " ranks por nodo" << std::endl;
+        }
+        resultado &= correcto;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba las colectivas persistentes reiniciadas en varias iteraciones
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testColectivasPersistentes(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de colectivas persistentes..." << std::endl;
+    
+    double local = 0.0;
+    double suma = 0.0;
+    double todos = 0.0;
+    double difundido = 0.0;
+    ColectivaPersistente reduccion = ColectivaPersistente::reduce(&local, &suma, 1, MPI_DOUBLE, MPI_SUM, 0,
+                                                                  MPI_COMM_WORLD);
+    ColectivaPersistente reduccionEnTodos = ColectivaPersistente::allreduce(&local, &todos, 1, MPI_DOUBLE,
+                                                                            MPI_SUM, MPI_COMM_WORLD);
+    ColectivaPersistente difusion = ColectivaPersistente::bcast(&difundido, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    bool resultado = reduccion.esPersistente() == colectivasPersistentesDisponibles();
+    
+    // Los buffers se releen en cada inicio: cambiar su contenido cambia el resultado
+    for (int iter = 1; iter <= 3; ++iter) {
+        local = static_cast<double>(iter * (rank + 1));
+        reduccion.ejecutar();
+        reduccionEnTodos.ejecutar();
+        if (rank == 0) {
+            difundido = suma;
+        }
+        difusion.ejecutar();
+        
+        double esperado = iter * numProcs * (numProcs + 1) / 2.0;
+        resultado &= todos == esperado && difundido == esperado;
+    }
+    
+    if (rank == 0) {
+        std::cout << "Proceso " << rank << ": Colectivas persistentes "
+                  << (reduccion.esPersistente() ? "nativas" : "emuladas con no bloqueantes") << std::endl;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba la reducción fusionada del resumen con un número distinto de valores por proceso
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testResumenValores(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba del resumen estadístico..." << std::endl;
+    
+    // El proceso p tiene 1000 * (p + 1) + 7 valores consecutivos del generador
+    auto cuentaProceso = [](int p) { return int64_t(1000) * (p + 1) + 7; };
+    int64_t inicio = 0;
+    for (int p = 0; p < rank; ++p) {
+        inicio += cuentaProceso(p);
+    }
+    int64_t total = inicio;
+    for (int p = rank; p < numProcs; ++p) {
+        total += cuentaProceso(p);
+    }
+    
+    GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+    std::vector<double> locales(cuentaProceso(rank));
+    generador.generar(static_cast<uint64_t>(inicio), static_cast<int64_t>(locales.size()), locales.data(), 0.0, 100.0);
+    
+    // Resumir en dos bloques desiguales para ejercitar también la combinación local
+    int64_t corte = static_cast<int64_t>(locales.size()) / 3;
+    ResumenValores local = resumirValores(locales.data(), corte);
+    combinarResumen(local, resumirValores(locales.data() + corte, static_cast<int64_t>(locales.size()) - corte));
+    
+    ResumenValores global;
+    MPI_Allreduce(&local, &global, 1, tipoResumenValores(), opResumenValores(), MPI_COMM_WORLD);
+    
+    // Referencia en dos pasadas sobre todos los valores
+    std::vector<double> todos(total);
+    generador.generar(0, total, todos.data(), 0.0, 100.0);
+    double suma = 0.0;
+    for (double valor : todos) {
+        suma += valor;
+    }
+    double media = suma / static_cast<double>(total);
+    double m2 = 0.0;
+    for (double valor : todos) {
+        m2 += (valor - media) * (valor - media);
+    }
+    
+    MPI_Aint limiteInferior = 0;
+    MPI_Aint extension = 0;
+    MPI_Type_get_extent(tipoResumenValores(), &limiteInferior, &extension);
+    bool resultado = extension == static_cast<MPI_Aint>(sizeof(ResumenValores)) &&
+                     global.cuenta == total &&
+                     std::abs(global.media - media) < 1e-12 * media &&
+                     std::abs(global.m2 - m2) < 1e-9 * m2 &&
+                     global.minimo == *std::min_element(todos.begin(), todos.end()) &&
+                     global.maximo == *std::max_element(todos.begin(), todos.end());
+    
+    if (rank == 0) {
+        std::cout << "Proceso " << rank << ": Media = " << global.media << " (esperada " << media
+                  << "), varianza = " << global.varianza() << " con " << global.cuenta << " valores" << std::endl;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba las conversiones de precisión y la reducción con carga reducida
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testPrecisionReducida(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de precisión reducida..." << std::endl;
+    
+    // Las rutas SIMD deben coincidir con el redondeo escalar, incluida la cola
+    const int64_t elementos = 1003;
+    std::vector<double> valores(elementos);
+    GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+    generador.generar(static_cast<uint64_t>(rank) * elementos, elementos, valores.data(), -100.0, 100.0);
+    
+    std::vector<float> simples(elementos);
+    std::vector<uint16_t> bf16(elementos);
+    std::vector<double> vuelta(elementos);
+    convertirAFloat(valores.data(), simples.data(), elementos);
+    convertirABf16(valores.data(), bf16.data(), elementos);
+    bool resultado = true;
+    for (int64_t i = 0; i < elementos; ++i) {
+        resultado &= simples[i] == static_cast<float>(valores[i]);
+    }
+    convertirDesdeBf16(bf16.data(), vuelta.data(), elementos);
+    for (int64_t i = 0; i < elementos; ++i) {
+        // bf16 conserva 8 bits de mantisa: error relativo de redondeo <= 2^-8
+        resultado &= std::abs(vuelta[i] - valores[i]) <= std::abs(valores[i]) * (1.0 / 256.0);
+    }
+    // 1 + 2^-8 está justo entre dos bf16: el redondeo al par lo deja en 1
+    double empate = 1.0 + 1.0 / 256.0;
+    uint16_t redondeado = 0;
+    convertirABf16(&empate, &redondeado, 1);
+    resultado &= redondeado == 0x3F80;
+    
+    // Un NaN con los bits bajos a uno no debe acabar en ±inf ni cambiar de signo
+    // (17 valores: pasan por la ruta SIMD y por la cola escalar)
+    const uint64_t bitsNan = 0x7FFFFFFFFFFFFFFFull;
+    std::vector<double> nanes(17);
+    for (double& nan : nanes) {
+        std::memcpy(&nan, &bitsNan, sizeof(nan));
+    }
+    std::vector<uint16_t> nanesBf16(nanes.size());
+    convertirABf16(nanes.data(), nanesBf16.data(), static_cast<int64_t>(nanes.size()));
+    for (uint16_t nan : nanesBf16) {
+        resultado &= (nan & 0x8000) == 0 && (nan & 0x7FFF) > 0x7F80 && (nan & 0x0040) != 0;
+    }
+    
+    // El proceso p aporta p + 1 a cada elemento: la suma es exacta en las tres precisiones
+    std::vector<double> aportes(elementos, static_cast<double>(rank + 1));
+    std::vector<double> suma(elementos, 0.0);
+    std::vector<double> envio(elementos);
+    std::vector<double> recepcion(elementos);
+    for (PrecisionCarga precision : PRECISIONES_CARGA) {
+        reducirSumaConPrecision(aportes.data(), suma.data(), elementos, precision, envio.data(), recepcion.data(),
+                                0, MPI_COMM_WORLD);
+        if (rank == 0) {
+            bool correcto = true;
+            for (int64_t i = 0; i < elementos; ++i) {
+                correcto &= suma[i] == numProcs * (numProcs + 1) / 2.0;
+            }
+            if (!correcto) {
+                std::cout << "Proceso " << rank << ": Falló la reducción " << nombrePrecision(precision) << std::endl;
+            }
+            resultado &= correcto;
+        }
+    }
+    
+    if (rank == 0) {
+        std::cout << "Proceso " << rank << ": Conversión con la ruta " << nombreRutaConversion() << std::endl;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba el reparto exacto, el reequilibrado y MPI_Scatterv/Gatherv con conteos desiguales
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testRepartoCarga(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba del reparto de carga..." << std::endl;
+    
+    // Un total que no es múltiplo de P se reparte sin relleno y sin huecos
+    const int64_t total = 100003;
+    RepartoCarga uniforme = repartoUniforme(total, numProcs);
+    bool resultado = uniforme.total() == total;
+    for (int i = 0; i < numProcs; ++i) {
+        resultado &= uniforme.conteos[i] - uniforme.conteos[numProcs - 1] <= 1;
+    }
+    
+    // Ponderado: cuotas proporcionales a los pesos salvo por el redondeo
+    std::vector<double> pesos(numProcs);
+    for (int i = 0; i < numProcs; ++i) {
+        pesos[i] = static_cast<double>(i + 1);
+    }
+    RepartoCarga ponderado = repartoPonderado(total, pesos);
+    double sumaPesos = numProcs * (numProcs + 1) / 2.0;
+    resultado &= ponderado.total() == total;
+    for (int i = 0; i < numProcs; ++i) {
+        double cuota = static_cast<double>(total) * pesos[i] / sumaPesos;
+        resultado &= std::abs(static_cast<double>(ponderado.conteos[i]) - cuota) < 1.0;
+        resultado &= i == 0 || ponderado.desplazamientos[i] == ponderado.desplazamientos[i - 1] + ponderado.conteos[i - 1];
+    }
+    
+    // El proceso r simula ser r + 1 veces más lento: tras un reequilibrado
+    // completo sus tiempos quedan igualados
+    auto segundosSimulados = [&](const RepartoCarga& reparto) {
+        return static_cast<double>(reparto.conteos[rank]) * (rank + 1) * 1e-8;
+    };
+    RepartoCarga equilibrado = rebalancearReparto(uniforme, segundosSimulados(uniforme), MPI_COMM_WORLD, 1.0);
+    std::vector<double> antes(numProcs);
+    std::vector<double> despues(numProcs);
+    for (int i = 0; i < numProcs; ++i) {
+        antes[i] = static_cast<double>(uniforme.conteos[i]) * (i + 1);
+        despues[i] = static_cast<double>(equilibrado.conteos[i]) * (i + 1);
+    }
+    resultado &= equilibrado.total() == total;
+    resultado &= desequilibrioCarga(despues) < 1e-3;
+    resultado &= numProcs == 1 || equilibrado.conteos[0] > equilibrado.conteos[numProcs - 1];
+    
+    // Ida y vuelta con MPI_Scatterv / MPI_Gatherv usando el reparto desigual
+    GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+    std::vector<double> completos(rank == 0 ? total : 0);
+    if (rank == 0) {
+        generador.generar(0, total, completos.data());
+    }
+    std::vector<double> locales(equilibrado.conteos[rank]);
+    resultado &= scattervReparto(completos.data(), locales.data(), equilibrado, MPI_DOUBLE, 0,
+                                 MPI_COMM_WORLD) == MPI_SUCCESS;
+    std::vector<double> esperados(equilibrado.conteos[rank]);
+    generador.generar(static_cast<uint64_t>(equilibrado.desplazamientos[rank]), equilibrado.conteos[rank],
+                      esperados.data());
+    resultado &= locales == esperados;
+    
+    std::vector<double> recogidos(rank == 0 ? total : 0);
+    resultado &= gathervReparto(locales.data(), recogidos.data(), equilibrado, MPI_DOUBLE, 0,
+                                MPI_COMM_WORLD) == MPI_SUCCESS;
+    if (rank == 0) {
+        resultado &= recogidos == completos;
+        std::cout << "Proceso " << rank << ": Desequilibrio simulado " << desequilibrioCarga(antes) * 100.0
+                  << " % -> " << desequilibrioCarga(despues) * 100.0 << " %" << std::endl;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba los tamaños, subcomunicadores y métricas del estudio de escalabilidad
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testEscalado(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba del estudio de escalabilidad..." << std::endl;
+    
+    bool resultado = tamanosEscalado(6, 0) == std::vector<int>{1, 2, 4, 6};
+    resultado &= tamanosEscalado(8, 0) == std::vector<int>{1, 2, 4, 8};
+    resultado &= tamanosEscalado(8, 3) == std::vector<int>{1, 2, 3};
+    resultado &= tamanosEscalado(1, 0) == std::vector<int>{1};
+    
+    // Fuerte: T1 = 100, T4 = 30 -> S = 10/3, E = 5/6, Karp-Flatt = (0.3 - 0.25) / 0.75
+    MetricasEscalado fuerte = metricasEscalado(100.0, 30.0, 4, false);
+    resultado &= std::abs(fuerte.aceleracion - 10.0 / 3.0) < 1e-12;
+    resultado &= std::abs(fuerte.eficiencia - 5.0 / 6.0) < 1e-12;
+    resultado &= std::abs(fuerte.karpFlatt - 0.05 / 0.75) < 1e-12;
+    // Débil con tiempo constante: escalado perfecto
+    MetricasEscalado debil = metricasEscalado(100.0, 100.0, 4, true);
+    resultado &= debil.aceleracion == 4.0 && debil.eficiencia == 1.0 && std::abs(debil.karpFlatt) < 1e-12;
+    
+    // El subcomunicador contiene exactamente los primeros p ranks
+    int p = (numProcs + 1) / 2;
+    MPI_Comm sub = subcomunicadorEscalado(MPI_COMM_WORLD, p);
+    resultado &= (sub != MPI_COMM_NULL) == (rank < p);
+    if (sub != MPI_COMM_NULL) {
+        int tamano = 0;
+        int rankSub = 0;
+        MPI_Comm_size(sub, &tamano);
+        MPI_Comm_rank(sub, &rankSub);
+        resultado &= tamano == p && rankSub == rank;
+        MPI_Comm_free(&sub);
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba la medición de memoria, su reducción entre procesos y el perfil por fases
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testUsoMemoria(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba del uso de memoria..." << std::endl;
+    
+    // Reservar y tocar 64 MiB debe notarse en el RSS actual (no solo en el pico)
+    const int64_t bytes = int64_t(64) << 20;
+    MuestraMemoria antes = medirMemoria();
+    std::vector<char> bloque(bytes, 1);
+    MuestraMemoria despues = medirMemoria();
+    MuestraMemoria diferencia = diferenciaMemoria(despues, antes);
+    bool resultado = antes.rss > 0.0 && despues.pico > 0.0;
+    resultado &= diferencia.rss >= 0.9 * static_cast<double>(bytes) / 1024.0;
+    
+    // Reducción de una muestra conocida: el proceso p aporta p + 1 en todos los campos
+    double valor = static_cast<double>(rank + 1);
+    MuestraMemoria sintetica = {valor, valor, valor, valor};
+    ReduccionMemoria reduccion = reducirMemoria(sintetica, 0, MPI_COMM_WORLD);
+    if (rank == 0) {
+        resultado &= reduccion.minimo.rss == 1.0 && reduccion.maximo.pss == numProcs &&
+                     reduccion.suma.mpi == numProcs * (numProcs + 1) / 2.0 &&
+                     reduccion.rankMaximoRss == numProcs - 1;
+    }
+    
+    // El perfil imprime una fila por fase en la raíz
+    PerfilMemoria perfil;
+    perfil.marcar("reserva");
+    bloque.clear();
+    bloque.shrink_to_fit();
+    perfil.marcar("liberación");
+    std::ostringstream salida;
+    perfil.imprimir(0, MPI_COMM_WORLD, salida);
+    if (rank == 0) {
+        resultado &= salida.str().find("reserva") != std::string::npos &&
+                     salida.str().find("liberación") != std::string::npos;
+        std::cout << "Proceso " << rank << ": Incremento de RSS al tocar 64 MiB: " << diferencia.rss
+                  << " KB, variables MPI_T de memoria: " << variablesMemoriaMpi().size() << std::endl;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba los algoritmos colectivos propios y la tabla de decisión
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testAlgoritmosColectivos(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de los algoritmos colectivos..." << std::endl;
+    
+    // Valores enteros: la suma es exacta en cualquier orden de reducción.
+    // 70000 doubles ocupan varios segmentos de la cadena; 5 y 1 son menos
+    // elementos que procesos con P grande
+    bool resultado = true;
+    for (int64_t count : {int64_t(1), int64_t(5), int64_t(1000), int64_t(70000)}) {
+        std::vector<double> local(count);
+        std::vector<double> suma(count);
+        std::vector<double> maximo(count);
+        for (int64_t i = 0; i < count; ++i) {
+            local[i] = rank * 1000.0 + static_cast<double>(i % 97);
+            suma[i] = 1000.0 * numProcs * (numProcs - 1) / 2.0 + numProcs * static_cast<double>(i % 97);
+            maximo[i] = (numProcs - 1) * 1000.0 + static_cast<double>(i % 97);
+        }
+        
+        for (int root : {0, numProcs - 1}) {
+            for (AlgoritmoColectiva algoritmo : algoritmosDe(OperacionColectiva::Bcast)) {
+                std::vector<double> buffer = (rank == root) ? suma : std::vector<double>(count, -1.0);
+                resultado &= bcastAlgoritmo(algoritmo, buffer.data(), count, MPI_DOUBLE, root,
+                                            MPI_COMM_WORLD) == MPI_SUCCESS && buffer == suma;
+            }
+            for (AlgoritmoColectiva algoritmo : algoritmosDe(OperacionColectiva::Reduce)) {
+                std::vector<double> recepcion(count, -1.0);
+                resultado &= reduceAlgoritmo(algoritmo, local.data(), recepcion.data(), count, MPI_DOUBLE,
+                                             MPI_SUM, root, MPI_COMM_WORLD) == MPI_SUCCESS;
+                if (rank == root) {
+                    resultado &= recepcion == suma;
+                }
+                
+                // MPI_IN_PLACE en la raíz con otra operación
+                std::vector<double> enSitio = local;
+                resultado &= reduceAlgoritmo(algoritmo, rank == root ? MPI_IN_PLACE : local.data(), enSitio.data(),
+                                             count, MPI_DOUBLE, MPI_MAX, root, MPI_COMM_WORLD) == MPI_SUCCESS;
+                if (rank == root) {
+                    resultado &= enSitio == maximo;
+                }
+            }
+        }
+        for (AlgoritmoColectiva algoritmo : algoritmosDe(OperacionColectiva::Allreduce)) {
+            std::vector<double> recepcion(count, -1.0);
+            resultado &= allreduceAlgoritmo(algoritmo, local.data(), recepcion.data(), count, MPI_DOUBLE,
+                                            MPI_SUM, MPI_COMM_WORLD) == MPI_SUCCESS && recepcion == suma;
+            std::vector<double> enSitio = local;
+            resultado &= allreduceAlgoritmo(algoritmo, MPI_IN_PLACE, enSitio.data(), count, MPI_DOUBLE, MPI_MAX,
+                                            MPI_COMM_WORLD) == MPI_SUCCESS && enSitio == maximo;
+        }
+    }
+    
+    // Un algoritmo que no existe para la colectiva se rechaza sin comunicar
+    double valor = 0.0;
+    resultado &= bcastAlgoritmo(AlgoritmoColectiva::Rabenseifner, &valor, 1, MPI_DOUBLE, 0,
+                                MPI_COMM_WORLD) == MPI_ERR_ARG;
+    
+    // Compresión del barrido: binomial hasta 64 B, cadena a partir de 256 B;
+    // el límite es la media geométrica, 128 B
+    TablaDecision tabla;
+    tabla.agregarBarrido(OperacionColectiva::Bcast, 4, {16, 64, 256, 1024},
+                         {AlgoritmoColectiva::Binomial, AlgoritmoColectiva::Binomial, AlgoritmoColectiva::Cadena,
+                          AlgoritmoColectiva::Cadena});
+    tabla.agregarBarrido(OperacionColectiva::Bcast, 2, {16}, {AlgoritmoColectiva::ScatterAllgather});
+    resultado &= tabla.entradas().size() == 3 && tabla.entradas()[0].bytesHasta == 128 &&
+                 tabla.entradas()[1].bytesHasta == 0;
+    resultado &= tabla.elegir(OperacionColectiva::Bcast, 4, 128) == AlgoritmoColectiva::Binomial;
+    resultado &= tabla.elegir(OperacionColectiva::Bcast, 6, 129) == AlgoritmoColectiva::Cadena;
+    resultado &= tabla.elegir(OperacionColectiva::Bcast, 3, 1 << 20) == AlgoritmoColectiva::ScatterAllgather;
+    resultado &= tabla.elegir(OperacionColectiva::Bcast, 1, 8) == AlgoritmoColectiva::ScatterAllgather;
+    resultado &= tabla.elegir(OperacionColectiva::Reduce, 4, 8) == AlgoritmoColectiva::Biblioteca;
+    
+    // Ida y vuelta por el formato de archivo, y errores de lectura
+    std::stringstream archivo;
+    tabla.escribir(archivo);
+    TablaDecision leida;
+    std::string error;
+    resultado &= TablaDecision::leer(archivo, leida, error) && leida.entradas().size() == 3 &&
+                 leida.elegir(OperacionColectiva::Bcast, 4, 100) == AlgoritmoColectiva::Binomial;
+    std::istringstream invalida("reduce 4 0 scatter-allgather\n");
+    resultado &= !TablaDecision::leer(invalida, leida, error) && error.find("línea 1") != std::string::npos;
+    
+    // Con una tabla activa, reducirEnTodos despacha a los algoritmos elegidos
+    TablaDecision activa;
+    activa.agregar({OperacionColectiva::Reduce, 1, 0, AlgoritmoColectiva::Rabenseifner});
+    activa.agregar({OperacionColectiva::Bcast, 1, 0, AlgoritmoColectiva::Cadena});
+    activa.agregar({OperacionColectiva::Allreduce, 1, 0, AlgoritmoColectiva::DobladoRecursivo});
+    establecerTablaDecision(activa);
+    for (EstrategiaColectiva estrategia : {EstrategiaColectiva::ReduceBcast, EstrategiaColectiva::Allreduce}) {
+        double propio = rank + 1.0;
+        double total = 0.0;
+        reducirEnTodos(&propio, &total, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, estrategia);
+        resultado &= total == numProcs * (numProcs + 1) / 2.0;
+    }
+    establecerTablaDecision(TablaDecision());
+    
+    // El camino reduce + bcast de mpi_promedio (un valor por proceso) cambia
+    // de algoritmo al activar una tabla leída del formato de archivo
+    resultado &= algoritmoAjustado(OperacionColectiva::Reduce, 1, MPI_DOUBLE, MPI_COMM_WORLD) ==
+                 AlgoritmoColectiva::Biblioteca;
+    std::istringstream archivoPromedio("reduce 1 0 cadena\nbcast 1 0 binomial\n");
+    TablaDecision promedio;
+    resultado &= TablaDecision::leer(archivoPromedio, promedio, error);
+    establecerTablaDecision(promedio);
+    resultado &= algoritmoAjustado(OperacionColectiva::Reduce, 1, MPI_DOUBLE, MPI_COMM_WORLD) ==
+                 AlgoritmoColectiva::Cadena;
+    resultado &= algoritmoAjustado(OperacionColectiva::Bcast, 1, MPI_DOUBLE, MPI_COMM_WORLD) ==
+                 AlgoritmoColectiva::Binomial;
+    double propio = rank + 1.0;
+    double total = 0.0;
+    double media = 0.0;
+    resultado &= reduceAjustado(&propio, &total, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD) == MPI_SUCCESS;
+    if (rank == 0) {
+        media = total / numProcs;
+    }
+    resultado &= bcastAjustado(&media, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD) == MPI_SUCCESS;
+    resultado &= media == (numProcs + 1) / 2.0;
+    establecerTablaDecision(TablaDecision());
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba la malla cartesiana y las colectivas concurrentes de fila y columna
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testMallaCartesiana(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de la malla cartesiana..." << std::endl;
+    
+    bool resultado = true;
+    for (int filas : {0, numProcs}) {
+        MallaCartesiana malla(MPI_COMM_WORLD, filas);
+        int tamanoFila = 0;
+        int tamanoColumna = 0;
+        int rankFila = 0;
+        MPI_Comm_size(malla.fila(), &tamanoFila);
+        MPI_Comm_size(malla.columna(), &tamanoColumna);
+        MPI_Comm_rank(malla.fila(), &rankFila);
+        resultado &= malla.numFilas() * malla.numColumnas() == numProcs;
+        resultado &= tamanoFila == malla.numColumnas() && tamanoColumna == malla.numFilas();
+        resultado &= rankFila == malla.miColumna();
+        // Sin reordenar, los procesos de una fila son consecutivos
+        resultado &= rank == malla.miFila() * malla.numColumnas() + malla.miColumna();
+        if (filas > 0) {
+            resultado &= malla.numFilas() == numProcs;
+        }
+        
+        // Reduce en la fila y allreduce en la columna a la vez, con raíz rotatoria
+        for (int iteracion = 0; iteracion < 3; ++iteracion) {
+            double propioFila = rank + 1.0;
+            double propioColumna = rank + 1.0;
+            double sumaFila = -1.0;
+            double sumaColumna = -1.0;
+            int raiz = raizRotatoria(iteracion, malla.fila());
+            MPI_Request peticiones[2];
+            iniciarColectiva(OperacionColectiva::Reduce, &propioFila, &sumaFila, 1, MPI_DOUBLE, MPI_SUM, raiz,
+                             malla.fila(), &peticiones[0]);
+            iniciarColectiva(OperacionColectiva::Allreduce, &propioColumna, &sumaColumna, 1, MPI_DOUBLE, MPI_SUM,
+                             0, malla.columna(), &peticiones[1]);
+            MPI_Waitall(2, peticiones, MPI_STATUSES_IGNORE);
+            
+            // Fila f: ranks f*C .. f*C+C-1; columna c: ranks c, c+C, ...
+            const int C = malla.numColumnas();
+            const int R = malla.numFilas();
+            double esperadaFila = C * (malla.miFila() * C + 1.0) + C * (C - 1) / 2.0;
+            double esperadaColumna = R * (malla.miColumna() + 1.0) + C * R * (R - 1) / 2.0;
+            resultado &= sumaColumna == esperadaColumna;
+            if (rankFila == raiz) {
+                resultado &= sumaFila == esperadaFila;
+            }
+        }
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba el reloj sincronizado y el desglose de espera y transferencia
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testDesfaseColectiva(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba del desfase de llegada..." << std::endl;
+    
+    bool resultado = true;
+    RelojSincronizado reloj(MPI_COMM_WORLD, 8);
+    resultado &= reloj.error() >= 0.0;
+    if (rank == 0) {
+        resultado &= reloj.desfase() == 0.0 && reloj.error() == 0.0;
+    }
+    // Todos los procesos comparten reloj en esta máquina
+    resultado &= std::fabs(reloj.desfase()) < 1e-2;
+    
+    // Marcas sintéticas: el proceso p llega p ms tarde y todos salen a la vez
+    // medio milisegundo después de la última llegada
+    const double base = 100.0;
+    double llegada = base + rank * 1e-3;
+    double salida = base + (numProcs - 1) * 1e-3 + 0.5e-3;
+    DesgloseColectiva desglose = desglosarColectiva(llegada, salida, 0, MPI_COMM_WORLD);
+    if (rank == 0) {
+        resultado &= desglose.rankTardio == numProcs - 1;
+        resultado &= std::fabs(desglose.desfase - (numProcs - 1) * 1e3) < 1e-3;
+        resultado &= std::fabs(desglose.esperaMedia - (numProcs - 1) * 1e3 / 2.0) < 1e-3;
+        resultado &= std::fabs(desglose.transferencia - 500.0) < 1e-3;
+        resultado &= std::fabs(desglose.dentroMedio - (desglose.esperaMedia + 500.0)) < 1e-3;
+        
+        DesgloseColectiva otro = desglose;
+        otro.transferencia = 1500.0;
+        DesgloseColectiva media = promedioDesgloses({desglose, desglose, otro});
+        resultado &= media.rankTardio == numProcs - 1;
+        resultado &= std::fabs(media.transferencia - 2500.0 / 3.0) < 1e-3;
+    }
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba el almacén de resultados y la comparación entre ejecuciones
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testResultados(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba del almacén de resultados..." << std::endl;
+    
+    bool resultado = true;
+    MetadatosEjecucion metadatos = recogerMetadatos("mpi_test", numProcs, 1, 10, 2);
+    resultado &= !metadatos.versionMpi.empty() && !metadatos.fecha.empty() && !metadatos.compilador.empty();
+    metadatos.host = "nodo \"a\"\tuno";
+    
+    RegistroResultado registro;
+    registro.operacion = "Plano:MPI_Reduce";
+    registro.tamano = 1024;
+    registro.procesos = numProcs;
+    registro.estadisticas.muestras = 10;
+    registro.estadisticas.media = 10.0;
+    registro.estadisticas.mediana = 9.5;
+    registro.estadisticas.desviacion = 1.0;
+    registro.bytes = 8192;
+    RegistroResultado otro = registro;
+    otro.operacion = "MPI_Bcast";
+    
+    // Ida y vuelta por JSON lines
+    std::stringstream flujo;
+    escribirJsonLineas(flujo, metadatos, {registro, otro});
+    MetadatosEjecucion leidos;
+    std::vector<RegistroResultado> registros;
+    std::string error;
+    resultado &= leerJsonLineas(flujo, leidos, registros, error);
+    resultado &= leidos.host == metadatos.host && leidos.bibliotecaMpi == metadatos.bibliotecaMpi;
+    resultado &= leidos.procesos == numProcs && leidos.iteraciones == 10;
+    resultado &= registros.size() == 2 && registros[0].operacion == registro.operacion;
+    resultado &= registros.size() == 2 && registros[0].tamano == 1024 && registros[0].bytes == 8192 &&
+                 registros[0].estadisticas.muestras == 10 && registros[0].estadisticas.mediana == 9.5;
+    
+    std::stringstream roto("{\"tipo\":\"resultado\",\"operacion\":\"MPI_Bcast\"}\n");
+    resultado &= !leerJsonLineas(roto, leidos, registros, error) && !error.empty();
+    
+    // Welch: medias 10 y 12, desviación 1, 10 muestras -> t = 4.47 con 18 grados de libertad
+    double p = valorPWelch(10.0, 1.0, 10, 12.0, 1.0, 10);
+    resultado &= std::fabs(p - 2.9456e-4) < 1e-6;
+    resultado &= std::fabs(valorPWelch(10.0, 1.0, 10, 10.0, 1.0, 10) - 1.0) < 1e-12;
+    resultado &= valorPWelch(10.0, 1.0, 1, 12.0, 1.0, 10) == 1.0;
+    
+    RegistroResultado lento = registro;
+    lento.estadisticas.media = 12.0;
+    RegistroResultado poco = registro;
+    poco.operacion = "MPI_Bcast";
+    poco.estadisticas.media = 10.2;
+    std::vector<ComparacionResultado> comparaciones = compararResultados({registro, otro}, {poco, lento}, 0.05, 0.01);
+    resultado &= comparaciones.size() == 2;
+    if (comparaciones.size() == 2) {
+        resultado &= comparaciones[0].veredicto == Veredicto::Regresion;
+        resultado &= std::fabs(comparaciones[0].cambio - 0.2) < 1e-12;
+        resultado &= comparaciones[1].veredicto == Veredicto::SinCambio;
+    }
+    comparaciones = compararResultados({lento}, {registro}, 0.05, 0.01);
+    resultado &= comparaciones.size() == 1 && comparaciones[0].veredicto == Veredicto::Mejora;
+    
+    return resultado;
+}
+
+/**
+ * @brief Prueba la reducción resiliente con un proceso que no llega a tiempo
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testReduccionResiliente(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de la reducción resiliente..." << std::endl;
+    
+    bool resultado = true;
+    const double plazo = 0.1;
+    ReduccionResiliente reduccion(MPI_COMM_WORLD, plazo);
+    
+    // Todos a tiempo: suma y cuenta completas en todos los procesos
+    ResultadoResiliente completa = reduccion.reducir(rank + 1.0, 1);
+    resultado &= completa.estado == EstadoResiliente::Completa;
+    resultado &= completa.suma == numProcs * (numProcs + 1) / 2.0 && completa.cuenta == numProcs;
+    resultado &= completa.procesosIncluidos == numProcs && completa.procesosPerdidos.empty();
+    
+    if (numProcs > 1) {
+        // El último proceso llega tres plazos tarde: el resto termina sin él
+        // y él recibe el resultado parcial y queda fuera
+        if (rank == numProcs - 1) {
+            usleep(static_cast<useconds_t>(3.0 * plazo * 1e6));
+        }
+        ResultadoResiliente parcial = reduccion.reducir(rank + 1.0, 1);
+        ResultadoResiliente siguiente = reduccion.reducir(rank + 1.0, 1);
+        if (rank == numProcs - 1) {
+            resultado &= parcial.estado == EstadoResiliente::Excluido && !reduccion.participa();
+            resultado &= siguiente.estado == EstadoResiliente::Excluido;
+        } else {
+            resultado &= parcial.estado == EstadoResiliente::Reducida && reduccion.participa();
+            resultado &= parcial.suma == (numProcs - 1) * numProcs / 2.0 && parcial.cuenta == numProcs - 1;
+            resultado &= parcial.procesosPerdidos == std::vector<int>{numProcs - 1};
+            resultado &= reduccion.procesosVivos() == numProcs - 1;
+            resultado &= siguiente.estado == EstadoResiliente::Completa && siguiente.cuenta == numProcs - 1;
+        }
+    }
+    
+    MPI_Barrier(MPI_COMM_WORLD);
+    return resultado;
+}
+
+/**
+ * @brief Prueba los puntos de control en un archivo compartido y la recuperación tras una escritura rota
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testPuntoControl(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de los puntos de control..." << std::endl;
+    
+    bool resultado = true;
+    const char* ruta = "mpi_test_punto_control.bin";
+    if (rank == 0) {
+        MPI_File_delete(ruta, MPI_INFO_NULL);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    EstadoPuntoControl identidad;
+    identidad.semilla = 42;
+    identidad.procesos = numProcs;
+    identidad.tramos = 4;
+    identidad.inicioGlobal = rank * 1000;
+    identidad.conteo = 1000;
+    {
+        PuntoControl archivo(ruta, MPI_COMM_WORLD);
+        resultado &= archivo.abierto();
+        
+        // Un archivo nuevo no tiene ninguna época
+        EstadoPuntoControl vacio = identidad;
+        resultado &= !archivo.cargar(vacio) && vacio.tramo == 0 && !archivo.descartadoPorIdentidad();
+        
+        for (int tramo = 1; tramo <= 3; ++tramo) {
+            EstadoPuntoControl estado = identidad;
+            estado.tramo = tramo;
+            estado.procesados = tramo * 250;
+            estado.suma = SumaCompensada{rank + tramo * 0.5, 1e-17};
+            archivo.guardar(estado);
+        }
+        resultado &= archivo.escrituras() == 3 && archivo.epoca() == 3;
+    }
+    
+    // Se reanuda la última época, con la suma y la posición exactas
+    {
+        PuntoControl archivo(ruta, MPI_COMM_WORLD);
+        EstadoPuntoControl estado = identidad;
+        resultado &= archivo.cargar(estado) && archivo.epoca() == 3;
+        resultado &= estado.tramo == 3 && estado.procesados == 750;
+        resultado &= estado.suma.suma == rank + 1.5 && estado.suma.compensacion == 1e-17;
+        
+        // Otra semilla es otra ejecución: no se acepta
+        EstadoPuntoControl ajeno = identidad;
+        ajeno.semilla = 43;
+        resultado &= !archivo.cargar(ajeno) && archivo.descartadoPorIdentidad();
+        
+        // Tampoco otro modo de reducción: el resumen o la suma guardados no
+        // cubrirían los valores ya procesados
+        EstadoPuntoControl resumido = identidad;
+        resumido.conResumen = 1;
+        resultado &= !archivo.cargar(resumido) && resumido.tramo == 0 && archivo.descartadoPorIdentidad();
+        EstadoPuntoControl compensada = identidad;
+        compensada.modoSuma = static_cast<int32_t>(ModoSuma::Compensada);
+        resultado &= !archivo.cargar(compensada) && compensada.tramo == 0 && archivo.descartadoPorIdentidad();
+        
+        resultado &= archivo.cargar(estado) && !archivo.descartadoPorIdentidad();
+    }
+    
+    // Escritura rota: el último proceso no llegó a escribir bien la época 3,
+    // así que todos vuelven a la 2
+    {
+        PuntoControl archivo(ruta, MPI_COMM_WORLD);
+        MPI_Offset tamano = 0;
+        MPI_File manejador;
+        MPI_File_open(MPI_COMM_WORLD, ruta, MPI_MODE_RDWR, MPI_INFO_NULL, &manejador);
+        MPI_File_get_size(manejador, &tamano);
+        MPI_Offset registro = tamano / (2 * numProcs);
+        if (rank == numProcs - 1) {
+            char basura[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+            MPI_File_write_at(manejador, (numProcs + rank) * registro + 40, basura, 8, MPI_BYTE, MPI_STATUS_IGNORE);
+        }
+        MPI_File_close(&manejador);
+        
+        EstadoPuntoControl estado = identidad;
+        resultado &= archivo.cargar(estado) && archivo.epoca() == 2;
+        resultado &= estado.tramo == 2 && estado.procesados == 500 && estado.suma.suma == rank + 1.0;
+    }
+    
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (rank == 0) {
+        MPI_File_delete(ruta, MPI_INFO_NULL);
+    }
+    return resultado;
+}
+
+/**
+ * @brief Prueba la lectura por bloques del archivo de entrada con MPI-IO y con mmap
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testEntradaParalela(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de la lectura paralela de la entrada..." << std::endl;
+    
+    bool resultado = true;
+    const char* ruta = "mpi_test_entrada.bin";
+    
+    // El valor i es i / 2: las sumas de cualquier tramo son exactas
+    const int64_t total = 1000 + 7 * numProcs;
+    RepartoCarga reparto = repartoUniforme(total, numProcs);
+    const int64_t inicio = reparto.desplazamientos[rank];
+    const int64_t conteo = reparto.conteos[rank];
+    std::vector<double> propios(conteo);
+    for (int64_t i = 0; i < conteo; ++i) {
+        propios[i] = (inicio + i) * 0.5;
+    }
+    MPI_File archivo;
+    MPI_File_open(MPI_COMM_WORLD, ruta, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &archivo);
+    MPI_File_set_size(archivo, 0);
+    MPI_File_write_at_all(archivo, inicio * static_cast<MPI_Offset>(sizeof(double)), propios.data(),
+                          static_cast<int>(conteo), MPI_DOUBLE, MPI_STATUS_IGNORE);
+    MPI_File_close(&archivo);
+    MPI_Barrier(MPI_COMM_WORLD);
+    resultado &= valoresEnArchivo(ruta) == total;
+    
+    // Bloques pequeños para que haya varias rondas y un último bloque parcial
+    const double esperada = 0.25 * (2 * inicio + conteo - 1) * conteo;
+    for (ModoLectura modo : {ModoLectura::MpiIo, ModoLectura::Mmap}) {
+        double suma = 0.0;
+        int64_t siguiente = inicio;
+        bool enOrden = true;
+        EstadisticasLectura lectura = leerPorBloques(
+            ruta, modo, inicio, conteo, "", MPI_COMM_WORLD, [&](const double* valores, int64_t cantidad) {
+                for (int64_t i = 0; i < cantidad; ++i) {
+                    enOrden &= valores[i] == siguiente * 0.5;
+                    suma += valores[i];
+                    ++siguiente;
+                }
+            }, 64);
+        resultado &= lectura.correcta && enOrden && suma == esperada && siguiente == inicio + conteo;
+        resultado &= lectura.bytes == conteo * static_cast<int64_t>(sizeof(double));
+        resultado &= lectura.bloques == static_cast<int>((conteo + 63) / 64);
+    }
+    
+    // Un tamaño que no es múltiplo del valor (p. ej. un --tipo equivocado) se rechaza
+    MPI_File_open(MPI_COMM_WORLD, ruta, MPI_MODE_WRONLY, MPI_INFO_NULL, &archivo);
+    MPI_File_set_size(archivo, total * static_cast<MPI_Offset>(sizeof(double)) - 3);
+    MPI_File_close(&archivo);
+    MPI_Barrier(MPI_COMM_WORLD);
+    resultado &= valoresEnArchivo(ruta) == -1;
+    resultado &= valoresEnArchivo(ruta, 1) == total * static_cast<int64_t>(sizeof(double)) - 3;
+    
+    // Un archivo que no existe se informa en todos los procesos
+    EstadisticasLectura ausente = leerPorBloques("mpi_test_entrada_ausente.bin", ModoLectura::MpiIo, inicio, conteo,
+                                                 "", MPI_COMM_WORLD, [](const double*, int64_t) {});
+    resultado &= !ausente.correcta && ausente.bytes == 0;
+    
+    // Los hints indicados sustituyen a los por defecto y se añaden al final
+    std::vector<std::pair<std::string, std::string>> hints = hintsLectura("cb_nodes=7,striping_factor=4",
+                                                                           MPI_COMM_WORLD);
+    auto valorHint = [&](const std::string& clave) {
+        for (const std::pair<std::string, std::string>& hint : hints) {
+            if (hint.first == clave) {
+                return hint.second;
+            }
+        }
+        return std::string();
+    };
+    resultado &= valorHint("romio_cb_read") == "enable" && valorHint("cb_nodes") == "7";
+    resultado &= valorHint("striping_factor") == "4" && hints.back().first == "striping_factor";
+    
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (rank == 0) {
+        MPI_File_delete(ruta, MPI_INFO_NULL);
+    }
+    return resultado;
+}
+
+/**
+ * @brief Prueba los Reductor<T, Op> de todos los tipos y operaciones y la lectura de una entrada de int32
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testReductorTipado(int rank, int numProcs) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba de los reductores por tipo y operación..." << std::endl;
+    
+    bool resultado = true;
+    
+    // Núcleo local frente al plegado escalar, con una cola que no llena los carriles
+    for (TipoDato tipo : TIPOS_DATO) {
+        for (OperacionReduccion operacion : OPERACIONES_REDUCCION) {
+            conTipoDato(tipo, [&](auto muestra) {
+                conOperacion(operacion, [&](auto op) {
+                    using T = decltype(muestra);
+                    using Op = decltype(op);
+                    using R = Reductor<T, Op>;
+                    std::vector<T> valores(37);
+                    typename R::Acumulado esperado = R::neutro();
+                    for (size_t i = 0; i < valores.size(); ++i) {
+                        valores[i] = static_cast<T>(static_cast<int>(i % 11) - 3 + (i % 2 == 0 ? 5 : 0));
+                        esperado = R::combinar(esperado, static_cast<typename R::Acumulado>(valores[i]));
+                    }
+                    resultado &= R::local(valores.data(), static_cast<int64_t>(valores.size())) == esperado;
+                    resultado &= R::local(valores.data(), 0) == R::neutro();
+                    
+                    // Reducción global de un valor por proceso: rank + 1
+                    T propio = static_cast<T>(rank + 1);
+                    typename R::Acumulado global = R::reducirGlobal(&propio, 1, 0, MPI_COMM_WORLD);
+                    if (rank == 0) {
+                        typename R::Acumulado referencia = R::neutro();
+                        for (int p = 1; p <= numProcs; ++p) {
+                            referencia = R::combinar(referencia, static_cast<typename R::Acumulado>(p));
+                        }
+                        resultado &= global == referencia;
+                    }
+                });
+            });
+        }
+    }
+    
+    // La suma de int32 se acumula en int64 y la de float en double
+    std::vector<int32_t> grandes(100, std::numeric_limits<int32_t>::max());
+    resultado &= Reductor<int32_t, OpSuma>::local(grandes.data(), 100) ==
+                 100 * static_cast<int64_t>(std::numeric_limits<int32_t>::max());
+    std::vector<float> flotantes(1 << 20, 1.0f);
+    flotantes[0] = 16777216.0f;
+    resultado &= Reductor<float, OpSuma>::local(flotantes.data(), 1 << 20) == 16777216.0 + (1 << 20) - 1;
+    resultado &= Reductor<float, OpMinimo>::local(flotantes.data(), 0) == std::numeric_limits<float>::infinity();
+    
+    // Reducción elemento a elemento de vectores
+    std::vector<int64_t> envio = {rank, -rank, 7};
+    std::vector<int64_t> recepcion(3, 0);
+    Reductor<int64_t, OpMaximo>::reducirEnTodos(envio.data(), recepcion.data(), 3, MPI_COMM_WORLD);
+    resultado &= recepcion[0] == numProcs - 1 && recepcion[1] == 0 && recepcion[2] == 7;
+    
+    // Entrada de int32: cada proceso escribe y lee un tramo distinto del que escribió
+    const char* ruta = "mpi_test_entrada_int32.bin";
+    const int64_t porProceso = 301;
+    std::vector<int32_t> propios(porProceso);
+    for (int64_t i = 0; i < porProceso; ++i) {
+        propios[i] = static_cast<int32_t>(rank * porProceso + i) - 1000;
+    }
+    MPI_File archivo;
+    MPI_File_open(MPI_COMM_WORLD, ruta, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &archivo);
+    MPI_File_set_size(archivo, 0);
+    MPI_File_write_at_all(archivo, rank * porProceso * static_cast<MPI_Offset>(sizeof(int32_t)), propios.data(),
+                          static_cast<int>(porProceso), MPI_INT32_T, MPI_STATUS_IGNORE);
+    MPI_File_close(&archivo);
+    MPI_Barrier(MPI_COMM_WORLD);
+    resultado &= valoresEnArchivo(ruta, sizeof(int32_t)) == porProceso * numProcs;
+    
+    int lector = (rank + 1) % numProcs;
+    int64_t primero = lector * porProceso - 1000;
+    int64_t esperada = porProceso * primero + porProceso * (porProceso - 1) / 2;
+    for (ModoLectura modo : {ModoLectura::MpiIo, ModoLectura::Mmap}) {
+        int64_t suma = 0;
+        EstadisticasLectura lectura = leerValoresPorBloques(
+            ruta, modo, MPI_INT32_T, lector * porProceso, porProceso, "", MPI_COMM_WORLD,
+            [&](const void* valores, int64_t cantidad) {
+                suma += Reductor<int32_t, OpSuma>::local(static_cast<const int32_t*>(valores), cantidad);
+            }, 50);
+        resultado &= lectura.correcta && suma == esperada;
+        resultado &= lectura.bytes == porProceso * static_cast<int64_t>(sizeof(int32_t));
+    }
+    
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (rank == 0) {
+        MPI_File_delete(ruta, MPI_INFO_NULL);
+    }
+    return resultado;
+}
+
+/**
+ * @brief Prueba la detección de MPI consciente de la GPU y, con GPU, la generación y la suma en el dispositivo
+ * @param rank Rank del proceso actual
+ * @param numProcs Número total de procesos
+ * @return true si la prueba pasa, false en caso contrario
+ */
+bool testModoGpu(int rank, int /* numProcs */) {
+    std::cout << "Proceso " << rank << ": Ejecutando prueba del modo GPU..." << std::endl;
+    
+    bool resultado = true;
+    
+    // La variable de entorno manda sobre lo que informe la biblioteca
+    const char* previa = std::getenv(VARIABLE_MPI_GPU);
+    std::string guardada = previa != nullptr ? previa : "";
+    setenv(VARIABLE_MPI_GPU, "1", 1);
+    resultado &= mpiAdmiteGpu();
+    setenv(VARIABLE_MPI_GPU, "0", 1);
+    resultado &= !mpiAdmiteGpu();
+    if (previa != nullptr) {
+        setenv(VARIABLE_MPI_GPU, guardada.c_str(), 1);
+    } else {
+        unsetenv(VARIABLE_MPI_GPU);
+    }
+    
+    resultado &= std::string(nombreTransporteGpu(TransporteGpu::Auto)) == "auto";
+    resultado &= std::string(nombreTransporteGpu(TransporteGpu::Copia)) == "copia";
+    resultado &= std::string(nombreTransporteGpu(TransporteGpu::MpiGpu)) == "mpi";
+    resultado &= std::string(nombreTransporteGpu(TransporteGpu::Nccl)) == "nccl";
+    
+#if defined(MPI_AVANZADO_GPU)
+    // Los valores del dispositivo son los del host y las colectivas dan lo
+    // mismo con todos los transportes
+    ContextoGpu gpu(MPI_COMM_WORLD, TransporteGpu::Auto);
+    if (gpu.valido()) {
+        const int64_t n = 1001;
+        std::vector<double> host(n);
+        std::vector<double> copia(n);
+        GeneradorPhilox generador(SEMILLA_POR_DEFECTO);
+        generador.generar(rank * n + 1, n, host.data());
+        
+        double* datos = gpu.reservar(n);
+        double* suma = gpu.reservar(2);
+        gpu.generar(SEMILLA_POR_DEFECTO, rank * n + 1, n, datos);
+        gpu.copiarAHost(copia.data(), datos, n);
+        resultado &= copia == host;
+        
+        double sumas[2] = {0.0, 0.0};
+        gpu.sumar(datos, n, suma);
+        gpu.generarYSumar(SEMILLA_POR_DEFECTO, rank * n + 1, n, suma + 1);
+        gpu.copiarAHost(sumas, suma, 2);
+        double esperada = sumarCompensado(host.data(), n).total();
+        resultado &= sumas[0] == sumas[1] && std::abs(sumas[0] - esperada) < 1e-9 * esperada;
+        
+        double globalHost = 0.0;
+        MPI_Allreduce(&sumas[0], &globalHost, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        for (TransporteGpu transporte : gpu.transportesDisponibles()) {
+            double global = 0.0;
+            gpu.reduce(suma, suma + 1, 1, 0, transporte);
+            gpu.bcast(suma + 1, 1, 0, transporte);
+            gpu.copiarAHost(&global, suma + 1, 1);
+            resultado &= std::abs(global - globalHost) < 1e-9 * globalHost;
+        }
+        gpu.liberar(datos);
+        gpu.liberar(suma);
+    }
+#endif
+    
+    return resultado;
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    
+    int rank, numProcs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+    
+    if (rank == 0) {
+        std::cout << "=== PRUEBAS DE COMUNICACIONES COLECTIVAS MPI ===" << std::endl;
+        std::cout << "Número de procesos: " << numProcs << std::endl;
+        std::cout << std::endl;
+    }
+    
+    // Sincronizar antes de comenzar las pruebas
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    bool todasLasPruebasPasan = true;
+    
+    // Ejecutar todas las pruebas
+    todasLasPruebasPasan &= testBroadcast(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testReduce(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testPromedio(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testSincronizacion(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testProgramaCompleto(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testNucleoSuma(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testGeneradorContador(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testEstrategiasColectivas(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testEstadisticas(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testPoolBuffers(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testJerarquia(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testBufferNodoCompartido(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testColectivasPersistentes(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testResumenValores(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testPrecisionReducida(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testRepartoCarga(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testEscalado(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testUsoMemoria(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testAlgoritmosColectivos(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testMallaCartesiana(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testDesfaseColectiva(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testResultados(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testReduccionResiliente(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testPuntoControl(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testEntradaParalela(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testReductorTipado(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    todasLasPruebasPasan &= testModoGpu(rank, numProcs);
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    // Verificar resultados globales
+    int resultadoGlobal = todasLasPruebasPasan ? 1 : 0;
+    int resultadoTotal = 0;
+    
+    MPI_Reduce(&resultadoGlobal, &resultadoTotal, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+    
+    // Sincronizar antes de imprimir resultados finales
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    if (rank == 0) {
+        std::cout << std::endl << "=== RESULTADOS DE LAS PRUEBAS ===" << std::endl;
+        if (resultadoTotal == numProcs) {
+            std::cout << "✅ TODAS LAS PRUEBAS PASARON EXITOSAMENTE" << std::endl;
+        } else {
+            std::cout << "❌ ALGUNAS PRUEBAS FALLARON" << std::endl;
+            std::cout << "Procesos que pasaron las pruebas: " << resultadoTotal << "/" << numProcs << std::endl;
+        }
+        std::cout << std::endl;
+    }
+    
+    // Sincronizar antes de finalizar
+    MPI_Barrier(MPI_COMM_WORLD);
+    
+    MPI_Finalize();
+    
+    return (resultadoTotal == numProcs) ? 0 : 1;
 } 
\ No newline at end of file
@@ -0,0 +1,527 @@
+/**
+ * @file traza.cpp
+ * @brief Implementación de la biblioteca de interposición PMPI
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "traza.h"
+
+#include <mpi.h>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Una llamada trazada
+ */
+struct EventoTraza {
+    const char* nombre = ""; ///< Nombre de la función MPI (literal)
+    double inicio = 0.0;     ///< Entrada en μs desde el origen
+    double fin = 0.0;        ///< Salida en μs desde el origen
+    int64_t bytes = 0;       ///< Bytes que aporta este proceso
+    int raiz = -1;           ///< Raíz de la colectiva (-1 si no tiene)
+    int procesos = 0;        ///< Tamaño del comunicador (0 si no aplica)
+    int muestra = -1;        ///< Índice de la muestra MPI_T tomada a la salida (-1 = sin cambios)
+};
+
+/**
+ * @brief Variable MPI_T muestreada tras cada colectiva
+ */
+struct VariableTraza {
+    std::string nombre;
+    MPI_T_pvar_handle handle = MPI_T_PVAR_HANDLE_NULL;
+    MPI_Datatype tipo = MPI_DATATYPE_NULL;
+    int elementos = 1; ///< Las variables ligadas a un comunicador tienen un valor por proceso
+};
+
+/**
+ * @brief Estado de la traza de este proceso (se crea en MPI_Init y se vuelca en MPI_Finalize)
+ */
+struct EstadoTraza {
+    bool activa = false;
+    double origen = 0.0;
+    int rank = 0;
+    long descartados = 0;
+    std::vector<EventoTraza> eventos;
+    
+    MPI_T_pvar_session sesion = MPI_T_PVAR_SESSION_NULL;
+    std::vector<VariableTraza> variables;
+    std::vector<double> muestras;  ///< variables.size() valores por muestra
+    std::vector<double> ultimaMuestra;
+};
+
+EstadoTraza& estado() {
+    static EstadoTraza traza;
+    return traza;
+}
+
+/**
+ * @brief Indica si una variable MPI_T describe las colas de mensajes o el protocolo de envío
+ *
+ * Open MPI registra las variables de todas las MTL (mtl_psm2_tx_eager_num...)
+ * aunque no se hayan seleccionado, y reservar un handle de una MTL inactiva
+ * aborta el proceso; solo se aceptan cuando la PML es cm, la única que las usa.
+ */
+bool variableInteresante(const char* nombre) {
+    if (std::strncmp(nombre, "mtl_", 4) == 0) {
+        const char* pml = std::getenv("OMPI_MCA_pml");
+        if (pml == nullptr || std::strcmp(pml, "cm") != 0) {
+            return false;
+        }
+    }
+    const char* claves[] = {"unexpected", "posted_recvq", "eager", "rndv", "rendezvous"};
+    for (const char* clave : claves) {
+        if (std::strstr(nombre, clave) != nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Abre la sesión MPI_T y reserva las variables de colas y protocolo
+ *
+ * Se aceptan las variables globales al proceso y las ligadas a un
+ * comunicador (se ligan a MPI_COMM_WORLD y se suman sus valores por proceso).
+ * Algunas bibliotecas registran la misma variable varias veces: solo se
+ * reserva la primera.
+ */
+void abrirVariables(EstadoTraza& traza) {
+    int provisto = 0;
+    if (MPI_T_init_thread(MPI_THREAD_SINGLE, &provisto) != MPI_SUCCESS ||
+        MPI_T_pvar_session_create(&traza.sesion) != MPI_SUCCESS) {
+        return;
+    }
+    int numVariables = 0;
+    MPI_T_pvar_get_num(&numVariables);
+    for (int i = 0; i < numVariables; ++i) {
+        char nombre[256];
+        char descripcion[256];
+        int longitudNombre = sizeof(nombre);
+        int longitudDescripcion = sizeof(descripcion);
+        int verbosidad = 0;
+        int clase = 0;
+        int ligadura = 0;
+        int soloLectura = 0;
+        int continua = 0;
+        int atomica = 0;
+        MPI_Datatype tipo = MPI_DATATYPE_NULL;
+        MPI_T_enum enumeracion = MPI_T_ENUM_NULL;
+        if (MPI_T_pvar_get_info(i, nombre, &longitudNombre, &verbosidad, &clase, &tipo, &enumeracion, descripcion,
+                                &longitudDescripcion, &ligadura, &soloLectura, &continua, &atomica) != MPI_SUCCESS) {
+            continue;
+        }
+        if (!variableInteresante(nombre) ||
+            (ligadura != MPI_T_BIND_NO_OBJECT && ligadura != MPI_T_BIND_MPI_COMM)) {
+            continue;
+        }
+        bool repetida = false;
+        for (const VariableTraza& existente : traza.variables) {
+            repetida |= existente.nombre == nombre;
+        }
+        if (repetida) {
+            continue;
+        }
+        
+        VariableTraza variable;
+        variable.nombre = nombre;
+        variable.tipo = tipo;
+        MPI_Comm mundo = MPI_COMM_WORLD;
+        void* objeto = (ligadura == MPI_T_BIND_MPI_COMM) ? &mundo : nullptr;
+        if (MPI_T_pvar_handle_alloc(traza.sesion, i, objeto, &variable.handle, &variable.elementos) != MPI_SUCCESS) {
+            continue;
+        }
+        if (!continua) {
+            MPI_T_pvar_start(traza.sesion, variable.handle);
+        }
+        traza.variables.push_back(variable);
+    }
+    traza.ultimaMuestra.assign(traza.variables.size(), -1.0);
+}
+
+/**
+ * @brief Suma los elementos de una variable MPI_T
+ */
+double leerVariable(EstadoTraza& traza, VariableTraza& variable) {
+    std::vector<unsigned char> valores(static_cast<size_t>(variable.elementos) * 8);
+    if (MPI_T_pvar_read(traza.sesion, variable.handle, valores.data()) != MPI_SUCCESS) {
+        return 0.0;
+    }
+    double suma = 0.0;
+    for (int i = 0; i < variable.elementos; ++i) {
+        if (variable.tipo == MPI_DOUBLE) {
+            double leido = 0.0;
+            std::memcpy(&leido, valores.data() + i * sizeof(double), sizeof(leido));
+            suma += leido;
+        } else if (variable.tipo == MPI_UNSIGNED || variable.tipo == MPI_INT) {
+            unsigned int leido = 0;
+            std::memcpy(&leido, valores.data() + i * sizeof(unsigned int), sizeof(leido));
+            suma += static_cast<double>(leido);
+        } else {
+            unsigned long long leido = 0;
+            std::memcpy(&leido, valores.data() + i * sizeof(unsigned long long), sizeof(leido));
+            suma += static_cast<double>(leido);
+        }
+    }
+    return suma;
+}
+
+/**
+ * @brief Toma una muestra MPI_T si algún valor cambió
+ * @return Índice de la muestra o -1 si nada cambió
+ */
+int muestrear(EstadoTraza& traza) {
+    if (traza.variables.empty()) {
+        return -1;
+    }
+    bool cambio = false;
+    for (size_t i = 0; i < traza.variables.size(); ++i) {
+        double valor = leerVariable(traza, traza.variables[i]);
+        cambio |= valor != traza.ultimaMuestra[i];
+        traza.ultimaMuestra[i] = valor;
+    }
+    if (!cambio) {
+        return -1;
+    }
+    traza.muestras.insert(traza.muestras.end(), traza.ultimaMuestra.begin(), traza.ultimaMuestra.end());
+    return static_cast<int>(traza.muestras.size() / traza.variables.size()) - 1;
+}
+
+void iniciarTraza() {
+    EstadoTraza& traza = estado();
+    PMPI_Comm_rank(MPI_COMM_WORLD, &traza.rank);
+    abrirVariables(traza);
+    // Origen común: todos los procesos salen de la barrera casi a la vez
+    PMPI_Barrier(MPI_COMM_WORLD);
+    traza.origen = PMPI_Wtime();
+    traza.activa = true;
+}
+
+/**
+ * @brief Bytes de count elementos del tipo (0 con MPI_DATATYPE_NULL)
+ */
+int64_t bytesDe(int count, MPI_Datatype tipo) {
+    if (tipo == MPI_DATATYPE_NULL || count <= 0) {
+        return 0;
+    }
+    int tamano = 0;
+    PMPI_Type_size(tipo, &tamano);
+    return static_cast<int64_t>(count) * tamano;
+}
+
+/**
+ * @brief Suma de un vector de conteos del comunicador
+ */
+int64_t bytesDe(const int conteos[], MPI_Datatype tipo, MPI_Comm comm) {
+    int procesos = 0;
+    PMPI_Comm_size(comm, &procesos);
+    int64_t total = 0;
+    for (int i = 0; i < procesos; ++i) {
+        total += bytesDe(conteos[i], tipo);
+    }
+    return total;
+}
+
+/**
+ * @brief Ejecuta una llamada PMPI y la anota
+ * @param nombre Nombre de la función MPI (literal)
+ * @param bytes Bytes que aporta el proceso
+ * @param raiz Raíz (-1 si no tiene)
+ * @param comm Comunicador (MPI_COMM_NULL si no aplica)
+ * @param llamada Llamada a la función PMPI_*
+ */
+template <typename Llamada>
+int trazar(const char* nombre, int64_t bytes, int raiz, MPI_Comm comm, Llamada&& llamada) {
+    EstadoTraza& traza = estado();
+    if (!traza.activa) {
+        return llamada();
+    }
+    double inicio = PMPI_Wtime();
+    int error = llamada();
+    double fin = PMPI_Wtime();
+    
+    if (static_cast<long>(traza.eventos.size()) >= MAXIMO_EVENTOS_TRAZA) {
+        ++traza.descartados;
+        return error;
+    }
+    EventoTraza evento;
+    evento.nombre = nombre;
+    evento.inicio = (inicio - traza.origen) * 1e6;
+    evento.fin = (fin - traza.origen) * 1e6;
+    evento.bytes = bytes;
+    evento.raiz = raiz;
+    if (comm != MPI_COMM_NULL) {
+        PMPI_Comm_size(comm, &evento.procesos);
+    }
+    evento.muestra = muestrear(traza);
+    traza.eventos.push_back(evento);
+    return error;
+}
+
+/**
+ * @brief Eventos de este proceso en formato Chrome Trace (objetos separados por comas)
+ * @param limite Bytes máximos del texto; los eventos que no caben se omiten
+ * @param omitidos Salida: eventos omitidos por el límite
+ */
+std::string serializarEventos(const EstadoTraza& traza, int64_t limite, long& omitidos) {
+    std::string texto;
+    std::string evento;
+    char linea[512];
+    std::snprintf(linea, sizeof(linea),
+                  "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"rank %d\"}},\n",
+                  traza.rank, traza.rank);
+    texto += linea;
+    omitidos = 0;
+    for (const EventoTraza& actual : traza.eventos) {
+        std::snprintf(linea, sizeof(linea),
+                      "{\"name\":\"%s\",\"cat\":\"mpi\",\"ph\":\"X\",\"pid\":%d,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f,"
+                      "\"args\":{\"bytes\":%lld,\"raiz\":%d,\"procesos\":%d}},\n",
+                      actual.nombre, traza.rank, actual.inicio, actual.fin - actual.inicio,
+                      static_cast<long long>(actual.bytes), actual.raiz, actual.procesos);
+        evento = linea;
+        if (actual.muestra >= 0) {
+            std::snprintf(linea, sizeof(linea), "{\"name\":\"MPI_T\",\"ph\":\"C\",\"pid\":%d,\"ts\":%.3f,\"args\":{",
+                          traza.rank, actual.fin);
+            evento += linea;
+            for (size_t i = 0; i < traza.variables.size(); ++i) {
+                double valor = traza.muestras[actual.muestra * traza.variables.size() + i];
+                std::snprintf(linea, sizeof(linea), "%s\"%s\":%.0f", i > 0 ? "," : "",
+                              traza.variables[i].nombre.c_str(), valor);
+                evento += linea;
+            }
+            evento += "}},\n";
+        }
+        if (static_cast<int64_t>(texto.size() + evento.size()) > limite) {
+            ++omitidos;
+            continue;
+        }
+        texto += evento;
+    }
+    return texto;
+}
+
+/**
+ * @brief Reúne los eventos en la raíz y escribe el archivo de traza
+ */
+void volcarTraza() {
+    EstadoTraza& traza = estado();
+    traza.activa = false;
+    
+    int procesos = 1;
+    PMPI_Comm_size(MPI_COMM_WORLD, &procesos);
+    // PMPI_Gatherv usa desplazamientos int: si el total no cabe, cada proceso
+    // se limita a una parte igual de INT_MAX y omite los eventos que sobran
+    long omitidos = 0;
+    std::string propio = serializarEventos(traza, INT_MAX, omitidos);
+    int64_t longitudPropia = static_cast<int64_t>(propio.size());
+    int64_t longitudTotal = 0;
+    PMPI_Allreduce(&longitudPropia, &longitudTotal, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+    if (longitudTotal > INT_MAX) {
+        propio = serializarEventos(traza, INT_MAX / procesos, omitidos);
+    }
+    traza.descartados += omitidos;
+    int longitud = static_cast<int>(propio.size());
+    std::vector<int> longitudes(procesos);
+    PMPI_Gather(&longitud, 1, MPI_INT, longitudes.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+    long eventos = static_cast<long>(traza.eventos.size());
+    long totalEventos = 0;
+    long totalDescartados = 0;
+    PMPI_Reduce(&eventos, &totalEventos, 1, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    PMPI_Reduce(&traza.descartados, &totalDescartados, 1, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    
+    std::vector<int> desplazamientos(procesos, 0);
+    std::vector<char> todo;
+    if (traza.rank == 0) {
+        int64_t total = 0;
+        for (int p = 0; p < procesos; ++p) {
+            desplazamientos[p] = static_cast<int>(total);
+            total += longitudes[p];
+        }
+        todo.resize(static_cast<size_t>(total));
+    }
+    PMPI_Gatherv(propio.data(), longitud, MPI_CHAR, todo.data(), longitudes.data(), desplazamientos.data(),
+                 MPI_CHAR, 0, MPI_COMM_WORLD);
+    if (traza.rank != 0) {
+        return;
+    }
+    
+    const char* variable = std::getenv(VARIABLE_TRAZA);
+    std::string ruta = (variable != nullptr && variable[0] != '\0') ? variable : "traza_mpi.json";
+    std::FILE* archivo = std::fopen(ruta.c_str(), "w");
+    if (archivo == nullptr) {
+        std::fprintf(stderr, "Traza MPI: no se puede escribir %s\n", ruta.c_str());
+        return;
+    }
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", archivo);
+    std::fwrite(todo.data(), 1, todo.size(), archivo);
+    // Evento final sin coma detrás para que el JSON sea válido
+    std::fprintf(archivo, "{\"name\":\"fin\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"ts\":%.3f}\n]}\n",
+                 (PMPI_Wtime() - traza.origen) * 1e6);
+    std::fclose(archivo);
+    std::fprintf(stderr, "Traza MPI: %ld eventos de %d procesos (%zu variables MPI_T) en %s", totalEventos, procesos,
+                 traza.variables.size(), ruta.c_str());
+    if (totalDescartados > 0) {
+        std::fprintf(stderr, "; %ld eventos descartados por superar el máximo del buffer o del volcado",
+                     totalDescartados);
+    }
+    std::fprintf(stderr, "\n");
+}
+
+} // namespace
+
+// ============================================================================
+// Inicialización y finalización
+// ============================================================================
+
+int MPI_Init(int* argc, char*** argv) {
+    int error = PMPI_Init(argc, argv);
+    if (error == MPI_SUCCESS) {
+        iniciarTraza();
+    }
+    return error;
+}
+
+int MPI_Init_thread(int* argc, char*** argv, int required, int* provided) {
+    int error = PMPI_Init_thread(argc, argv, required, provided);
+    if (error == MPI_SUCCESS) {
+        iniciarTraza();
+    }
+    return error;
+}
+
+int MPI_Finalize(void) {
+    if (estado().activa) {
+        volcarTraza();
+    }
+    return PMPI_Finalize();
+}
+
+// ============================================================================
+// Colectivas bloqueantes
+// ============================================================================
+
+int MPI_Barrier(MPI_Comm comm) {
+    return trazar("MPI_Barrier", 0, -1, comm, [&] { return PMPI_Barrier(comm); });
+}
+
+int MPI_Bcast(void* buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+    return trazar("MPI_Bcast", bytesDe(count, datatype), root, comm,
+                  [&] { return PMPI_Bcast(buffer, count, datatype, root, comm); });
+}
+
+int MPI_Reduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+               MPI_Comm comm) {
+    return trazar("MPI_Reduce", bytesDe(count, datatype), root, comm,
+                  [&] { return PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm); });
+}
+
+int MPI_Allreduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+    return trazar("MPI_Allreduce", bytesDe(count, datatype), -1, comm,
+                  [&] { return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+int MPI_Reduce_scatter(const void* sendbuf, void* recvbuf, const int recvcounts[], MPI_Datatype datatype,
+                       MPI_Op op, MPI_Comm comm) {
+    return trazar("MPI_Reduce_scatter", bytesDe(recvcounts, datatype, comm), -1, comm,
+                  [&] { return PMPI_Reduce_scatter(sendbuf, recvbuf, recvcounts, datatype, op, comm); });
+}
+
+int MPI_Reduce_scatter_block(const void* sendbuf, void* recvbuf, int recvcount, MPI_Datatype datatype, MPI_Op op,
+                             MPI_Comm comm) {
+    int procesos = 0;
+    PMPI_Comm_size(comm, &procesos);
+    return trazar("MPI_Reduce_scatter_block", bytesDe(recvcount, datatype) * procesos, -1, comm,
+                  [&] { return PMPI_Reduce_scatter_block(sendbuf, recvbuf, recvcount, datatype, op, comm); });
+}
+
+int MPI_Allgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+    return trazar("MPI_Allgather", bytesDe(sendcount, sendtype), -1, comm, [&] {
+        return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+    });
+}
+
+int MPI_Allgatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+    return trazar("MPI_Allgatherv", bytesDe(sendcount, sendtype), -1, comm, [&] {
+        return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+    });
+}
+
+int MPI_Gather(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+               MPI_Datatype recvtype, int root, MPI_Comm comm) {
+    return trazar("MPI_Gather", bytesDe(sendcount, sendtype), root, comm, [&] {
+        return PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+    });
+}
+
+int MPI_Gatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, const int recvcounts[],
+                const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm) {
+    return trazar("MPI_Gatherv", bytesDe(sendcount, sendtype), root, comm, [&] {
+        return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+    });
+}
+
+int MPI_Scatter(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+    return trazar("MPI_Scatter", bytesDe(recvcount, recvtype), root, comm, [&] {
+        return PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+    });
+}
+
+int MPI_Scatterv(const void* sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype,
+                 void* recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+    return trazar("MPI_Scatterv", bytesDe(recvcount, recvtype), root, comm, [&] {
+        return PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+    });
+}
+
+int MPI_Alltoall(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                 MPI_Datatype recvtype, MPI_Comm comm) {
+    int procesos = 0;
+    PMPI_Comm_size(comm, &procesos);
+    return trazar("MPI_Alltoall", bytesDe(sendcount, sendtype) * procesos, -1, comm, [&] {
+        return PMPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+    });
+}
+
+// ============================================================================
+// Colectivas no bloqueantes y su finalización
+// ============================================================================
+
+int MPI_Ibarrier(MPI_Comm comm, MPI_Request* request) {
+    return trazar("MPI_Ibarrier", 0, -1, comm, [&] { return PMPI_Ibarrier(comm, request); });
+}
+
+int MPI_Ibcast(void* buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm, MPI_Request* request) {
+    return trazar("MPI_Ibcast", bytesDe(count, datatype), root, comm,
+                  [&] { return PMPI_Ibcast(buffer, count, datatype, root, comm, request); });
+}
+
+int MPI_Ireduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+                MPI_Comm comm, MPI_Request* request) {
+    return trazar("MPI_Ireduce", bytesDe(count, datatype), root, comm,
+                  [&] { return PMPI_Ireduce(sendbuf, recvbuf, count, datatype, op, root, comm, request); });
+}
+
+int MPI_Iallreduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                   MPI_Request* request) {
+    return trazar("MPI_Iallreduce", bytesDe(count, datatype), -1, comm,
+                  [&] { return PMPI_Iallreduce(sendbuf, recvbuf, count, datatype, op, comm, request); });
+}
+
+int MPI_Wait(MPI_Request* request, MPI_Status* status) {
+    return trazar("MPI_Wait", 0, -1, MPI_COMM_NULL, [&] { return PMPI_Wait(request, status); });
+}
+
+int MPI_Waitall(int count, MPI_Request array_of_requests[], MPI_Status* array_of_statuses) {
+    return trazar("MPI_Waitall", 0, -1, MPI_COMM_NULL,
+                  [&] { return PMPI_Waitall(count, array_of_requests, array_of_statuses); });
+}
@@ -0,0 +1,41 @@
+/**
+ * @file traza.h
+ * @brief Biblioteca de interposición PMPI que traza las colectivas de cada proceso
+ * @author Emil M
+ * @date 2025
+ *
+ * libmpi_traza define MPI_Bcast, MPI_Reduce, MPI_Allreduce y el resto de
+ * colectivas (bloqueantes y no bloqueantes, además de MPI_Wait y
+ * MPI_Waitall) y reenvía cada llamada a su versión PMPI_*. Por cada llamada
+ * anota, en el proceso que la hace, el instante de entrada y de salida, los
+ * bytes que aporta el proceso, la raíz y el tamaño del comunicador. Tras cada
+ * colectiva lee además las variables de rendimiento MPI_T de la biblioteca
+ * relacionadas con la cola de mensajes inesperados, las recepciones pendientes
+ * y los envíos eager/rendezvous (las que existan).
+ *
+ * En MPI_Finalize la raíz reúne los eventos de todos los procesos y escribe un
+ * archivo en formato Chrome Trace (JSON, se abre con chrome://tracing o
+ * Perfetto): un proceso de la línea de tiempo por rank, un evento "X" por
+ * colectiva y un contador "C" cuando cambia alguna variable MPI_T. Los
+ * instantes se miden desde una barrera al final de MPI_Init, por lo que los
+ * ranks quedan alineados con el error de esa barrera (unos microsegundos en
+ * un nodo).
+ *
+ * Se usa sin recompilar con LD_PRELOAD=libmpi_traza.so, o enlazada en
+ * mpi_promedio, mpi_benchmark y mpi_analysis con -DMPI_AVANZADO_TRAZA=ON.
+ */
+
+#ifndef MPI_AVANZADO_TRAZA_H
+#define MPI_AVANZADO_TRAZA_H
+
+/**
+ * @brief Variable de entorno con la ruta del archivo de traza (por defecto traza_mpi.json)
+ */
+const char* const VARIABLE_TRAZA = "MPI_AVANZADO_TRAZA";
+
+/**
+ * @brief Máximo de eventos que se guardan por proceso; los siguientes se cuentan pero no se guardan
+ */
+const long MAXIMO_EVENTOS_TRAZA = 1L << 20;
+
+#endif // MPI_AVANZADO_TRAZA_H
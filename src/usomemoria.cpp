@@ -0,0 +1,321 @@
+/**
+ * @file usomemoria.cpp
+ * @brief Implementación de la medición del uso de memoria
+ * @author Emil M
+ * @date 2025
+ */
+
+#include "usomemoria.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Memoria residente actual en KB según /proc/self/statm (-1 si no existe)
+ */
+double leerRss() {
+    std::FILE* archivo = std::fopen("/proc/self/statm", "r");
+    if (archivo == nullptr) {
+        return -1.0;
+    }
+    long total = 0;
+    long residentes = 0;
+    int leidos = std::fscanf(archivo, "%ld %ld", &total, &residentes);
+    std::fclose(archivo);
+    if (leidos != 2) {
+        return -1.0;
+    }
+    return static_cast<double>(residentes) * static_cast<double>(sysconf(_SC_PAGESIZE)) / 1024.0;
+}
+
+/**
+ * @brief Suma los campos "Pss:" (en KB) de un archivo de /proc (-1 si no existe)
+ */
+double sumarPss(const char* ruta) {
+    std::FILE* archivo = std::fopen(ruta, "r");
+    if (archivo == nullptr) {
+        return -1.0;
+    }
+    char linea[256];
+    double total = 0.0;
+    bool encontrado = false;
+    while (std::fgets(linea, sizeof(linea), archivo) != nullptr) {
+        long kb = 0;
+        if (std::strncmp(linea, "Pss:", 4) == 0 && std::sscanf(linea + 4, "%ld", &kb) == 1) {
+            total += static_cast<double>(kb);
+            encontrado = true;
+        }
+    }
+    std::fclose(archivo);
+    return encontrado ? total : -1.0;
+}
+
+/**
+ * @brief PSS del proceso: smaps_rollup (Linux >= 4.14) ya trae el total
+ */
+double leerPss() {
+    double pss = sumarPss("/proc/self/smaps_rollup");
+    return pss >= 0.0 ? pss : sumarPss("/proc/self/smaps");
+}
+
+/**
+ * @brief Pico de memoria residente en KB (ru_maxrss)
+ */
+double leerPico() {
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) {
+        return -1.0;
+    }
+    return static_cast<double>(uso.ru_maxrss);
+}
+
+/**
+ * @brief Variable MPI_T de memoria con su handle ya reservado
+ */
+struct VariableMpiT {
+    std::string nombre;
+    MPI_T_pvar_handle handle = MPI_T_PVAR_HANDLE_NULL;
+    MPI_Datatype tipo = MPI_DATATYPE_NULL;
+};
+
+/**
+ * @brief Sesión MPI_T con las variables de memoria encontradas
+ *
+ * Se crea la primera vez que se usa y no se libera, igual que los tipos y
+ * operaciones MPI propios del proyecto: se necesita hasta el final del programa.
+ */
+struct SesionMemoriaMpiT {
+    MPI_T_pvar_session sesion = MPI_T_PVAR_SESSION_NULL;
+    std::vector<VariableMpiT> variables;
+    
+    SesionMemoriaMpiT() {
+        int provisto = 0;
+        if (MPI_T_init_thread(MPI_THREAD_SINGLE, &provisto) != MPI_SUCCESS) {
+            return;
+        }
+        if (MPI_T_pvar_session_create(&sesion) != MPI_SUCCESS) {
+            return;
+        }
+        
+        int numVariables = 0;
+        MPI_T_pvar_get_num(&numVariables);
+        for (int i = 0; i < numVariables; ++i) {
+            char nombre[256];
+            char descripcion[256];
+            int longitudNombre = sizeof(nombre);
+            int longitudDescripcion = sizeof(descripcion);
+            int verbosidad = 0;
+            int clase = 0;
+            int ligadura = 0;
+            int soloLectura = 0;
+            int continua = 0;
+            int atomica = 0;
+            MPI_Datatype tipo = MPI_DATATYPE_NULL;
+            MPI_T_enum enumeracion = MPI_T_ENUM_NULL;
+            if (MPI_T_pvar_get_info(i, nombre, &longitudNombre, &verbosidad, &clase, &tipo, &enumeracion,
+                                    descripcion, &longitudDescripcion, &ligadura, &soloLectura, &continua,
+                                    &atomica) != MPI_SUCCESS) {
+                continue;
+            }
+            
+            // Niveles, tamaños o máximos globales al proceso medidos en bytes
+            bool claseMemoria = clase == MPI_T_PVAR_CLASS_LEVEL || clase == MPI_T_PVAR_CLASS_SIZE ||
+                                clase == MPI_T_PVAR_CLASS_HIGHWATERMARK;
+            if (!claseMemoria || ligadura != MPI_T_BIND_NO_OBJECT || std::strstr(nombre, "bytes") == nullptr) {
+                continue;
+            }
+            
+            VariableMpiT variable;
+            variable.nombre = nombre;
+            variable.tipo = tipo;
+            int elementos = 0;
+            if (MPI_T_pvar_handle_alloc(sesion, i, nullptr, &variable.handle, &elementos) != MPI_SUCCESS) {
+                continue;
+            }
+            if (elementos != 1) {
+                MPI_T_pvar_handle_free(sesion, &variable.handle);
+                continue;
+            }
+            if (!continua) {
+                MPI_T_pvar_start(sesion, variable.handle);
+            }
+            variables.push_back(variable);
+        }
+    }
+    
+    /**
+     * @brief Suma en KB de todas las variables (-1 si no hay ninguna)
+     */
+    double leerKb() {
+        if (variables.empty()) {
+            return -1.0;
+        }
+        double bytes = 0.0;
+        for (VariableMpiT& variable : variables) {
+            // Los tipos posibles de una variable de un solo elemento caben en 8 bytes
+            unsigned char valor[16] = {};
+            if (MPI_T_pvar_read(sesion, variable.handle, valor) != MPI_SUCCESS) {
+                continue;
+            }
+            if (variable.tipo == MPI_DOUBLE) {
+                double leido = 0.0;
+                std::memcpy(&leido, valor, sizeof(leido));
+                bytes += leido;
+            } else if (variable.tipo == MPI_UNSIGNED || variable.tipo == MPI_INT) {
+                unsigned int leido = 0;
+                std::memcpy(&leido, valor, sizeof(leido));
+                bytes += static_cast<double>(leido);
+            } else if (variable.tipo == MPI_UNSIGNED_LONG) {
+                unsigned long leido = 0;
+                std::memcpy(&leido, valor, sizeof(leido));
+                bytes += static_cast<double>(leido);
+            } else {
+                unsigned long long leido = 0;
+                std::memcpy(&leido, valor, sizeof(leido));
+                bytes += static_cast<double>(leido);
+            }
+        }
+        return bytes / 1024.0;
+    }
+};
+
+/**
+ * @brief Sesión MPI_T compartida por todas las mediciones
+ */
+SesionMemoriaMpiT& sesionMemoria() {
+    static SesionMemoriaMpiT sesion;
+    return sesion;
+}
+
+/**
+ * @brief Diferencia de un campo (0 si la medida no está disponible)
+ */
+double restarCampo(double despues, double antes) {
+    return (despues < 0.0 || antes < 0.0) ? 0.0 : despues - antes;
+}
+
+/**
+ * @brief Espacios que faltan para que un texto UTF-8 ocupe el ancho dado
+ */
+size_t relleno(const std::string& texto, size_t ancho) {
+    size_t visibles = 0;
+    for (unsigned char caracter : texto) {
+        visibles += (caracter & 0xC0) != 0x80 ? 1 : 0;
+    }
+    return visibles < ancho ? ancho - visibles : 0;
+}
+
+/**
+ * @brief Escribe un valor en KB o "-" si la medida no está disponible
+ */
+void escribirCampo(std::ostream& salida, int ancho, double valor, bool disponible) {
+    if (disponible) {
+        salida << std::setw(ancho) << valor;
+    } else {
+        salida << std::setw(ancho) << "-";
+    }
+}
+
+} // namespace
+
+MuestraMemoria medirMemoria() {
+    MuestraMemoria muestra;
+    muestra.rss = leerRss();
+    muestra.pss = leerPss();
+    muestra.pico = leerPico();
+    muestra.mpi = sesionMemoria().leerKb();
+    return muestra;
+}
+
+std::vector<std::string> variablesMemoriaMpi() {
+    std::vector<std::string> nombres;
+    for (const VariableMpiT& variable : sesionMemoria().variables) {
+        nombres.push_back(variable.nombre);
+    }
+    return nombres;
+}
+
+MuestraMemoria diferenciaMemoria(const MuestraMemoria& despues, const MuestraMemoria& antes) {
+    MuestraMemoria diferencia;
+    diferencia.rss = restarCampo(despues.rss, antes.rss);
+    diferencia.pss = restarCampo(despues.pss, antes.pss);
+    diferencia.pico = restarCampo(despues.pico, antes.pico);
+    diferencia.mpi = restarCampo(despues.mpi, antes.mpi);
+    return diferencia;
+}
+
+ReduccionMemoria reducirMemoria(const MuestraMemoria& local, int root, MPI_Comm comm) {
+    ReduccionMemoria reduccion;
+    MPI_Reduce(&local, &reduccion.minimo, DOUBLES_MUESTRA_MEMORIA, MPI_DOUBLE, MPI_MIN, root, comm);
+    MPI_Reduce(&local, &reduccion.maximo, DOUBLES_MUESTRA_MEMORIA, MPI_DOUBLE, MPI_MAX, root, comm);
+    MPI_Reduce(&local, &reduccion.suma, DOUBLES_MUESTRA_MEMORIA, MPI_DOUBLE, MPI_SUM, root, comm);
+    
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+    struct {
+        double valor;
+        int rank;
+    } propio = {local.rss, rank}, maximo = {0.0, 0};
+    MPI_Reduce(&propio, &maximo, 1, MPI_DOUBLE_INT, MPI_MAXLOC, root, comm);
+    reduccion.rankMaximoRss = maximo.rank;
+    return reduccion;
+}
+
+PerfilMemoria::PerfilMemoria() : inicial_(medirMemoria()) {}
+
+void PerfilMemoria::marcar(const std::string& fase) {
+    fases_.push_back(fase);
+    muestras_.push_back(medirMemoria());
+}
+
+void PerfilMemoria::imprimir(int root, MPI_Comm comm, std::ostream& salida) const {
+    int rank = 0;
+    int numProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &numProcs);
+    
+    if (rank == root) {
+        salida << "Memoria en KB por fase (" << numProcs << " procesos; incremento respecto a la fase anterior)"
+               << std::endl;
+        // Cabecera escrita a mano: setw cuenta bytes y las tildes ocupan dos
+        salida << "Fase             RSS mín   RSS máx    RSS suma  ΔRSS mín  ΔRSS máx    rank  ΔRSS suma"
+               << "    PSS suma  Pico máx    MPI máx" << std::endl;
+    }
+    
+    // Todos los procesos ejecutan el mismo binario en el mismo tipo de nodo,
+    // así que la disponibilidad de cada medida es la de la raíz
+    const bool hayRss = inicial_.rss >= 0.0;
+    const bool hayPss = inicial_.pss >= 0.0;
+    const bool hayPico = inicial_.pico >= 0.0;
+    const bool hayMpi = inicial_.mpi >= 0.0;
+    
+    MuestraMemoria anterior = inicial_;
+    for (size_t i = 0; i < fases_.size(); ++i) {
+        ReduccionMemoria absoluta = reducirMemoria(muestras_[i], root, comm);
+        ReduccionMemoria incremento = reducirMemoria(diferenciaMemoria(muestras_[i], anterior), root, comm);
+        anterior = muestras_[i];
+        if (rank != root) {
+            continue;
+        }
+        salida << fases_[i] << std::string(relleno(fases_[i], 14), ' ') << std::fixed << std::setprecision(0);
+        escribirCampo(salida, 10, absoluta.minimo.rss, hayRss);
+        escribirCampo(salida, 10, absoluta.maximo.rss, hayRss);
+        escribirCampo(salida, 12, absoluta.suma.rss, hayRss);
+        escribirCampo(salida, 10, incremento.minimo.rss, hayRss);
+        escribirCampo(salida, 10, incremento.maximo.rss, hayRss);
+        salida << std::setw(8) << incremento.rankMaximoRss;
+        escribirCampo(salida, 11, incremento.suma.rss, hayRss);
+        escribirCampo(salida, 12, absoluta.suma.pss, hayPss);
+        escribirCampo(salida, 10, absoluta.maximo.pico, hayPico);
+        escribirCampo(salida, 11, absoluta.maximo.mpi, hayMpi);
+        salida << std::endl;
+    }
+}
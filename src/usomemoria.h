@@ -0,0 +1,118 @@
+/**
+ * @file usomemoria.h
+ * @brief Medición del uso de memoria por proceso y por fase
+ * @author Emil M
+ * @date 2025
+ *
+ * ru_maxrss solo da el pico de toda la vida del proceso. Aquí se mide además
+ * la memoria residente actual (/proc/self/statm), la proporcional (PSS, de
+ * /proc/self/smaps_rollup o smaps), que reparte las páginas compartidas entre
+ * los procesos que las usan, y la memoria que la propia biblioteca MPI
+ * declara a través de sus variables de rendimiento MPI_T. Las muestras se
+ * toman al final de cada fase y se reducen (mínimo, máximo y suma) entre
+ * todos los procesos para saber qué fase y qué rank se salen del presupuesto.
+ */
+
+#ifndef MPI_AVANZADO_USOMEMORIA_H
+#define MPI_AVANZADO_USOMEMORIA_H
+
+#include <mpi.h>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Muestra del uso de memoria de un proceso (en KB)
+ *
+ * Solo contiene doubles para poder reducirse campo a campo como MPI_DOUBLE.
+ * Un valor negativo indica que la medida no está disponible.
+ */
+struct MuestraMemoria {
+    double rss = 0.0;  ///< Memoria residente actual
+    double pss = 0.0;  ///< Memoria proporcional (PSS)
+    double pico = 0.0; ///< Pico de memoria residente (ru_maxrss)
+    double mpi = 0.0;  ///< Memoria declarada por la biblioteca MPI (MPI_T)
+};
+
+const int DOUBLES_MUESTRA_MEMORIA = sizeof(MuestraMemoria) / sizeof(double);
+static_assert(sizeof(MuestraMemoria) == DOUBLES_MUESTRA_MEMORIA * sizeof(double),
+              "MuestraMemoria debe contener solo doubles");
+
+/**
+ * @brief Mide el uso de memoria actual del proceso
+ * @return Muestra con RSS, PSS, pico y memoria MPI
+ */
+MuestraMemoria medirMemoria();
+
+/**
+ * @brief Variables MPI_T de memoria que se suman en MuestraMemoria::mpi
+ * @return Nombres de las variables (vacío si la biblioteca no expone ninguna)
+ *
+ * Se eligen las variables de rendimiento sin objeto asociado, de clase
+ * nivel, tamaño o máximo, cuyo nombre indica bytes reservados.
+ */
+std::vector<std::string> variablesMemoriaMpi();
+
+/**
+ * @brief Diferencia campo a campo entre dos muestras
+ * @param despues Muestra posterior
+ * @param antes Muestra anterior
+ * @return despues - antes (0 en los campos no disponibles)
+ */
+MuestraMemoria diferenciaMemoria(const MuestraMemoria& despues, const MuestraMemoria& antes);
+
+/**
+ * @brief Mínimo, máximo y suma de una muestra entre los procesos
+ */
+struct ReduccionMemoria {
+    MuestraMemoria minimo;
+    MuestraMemoria maximo;
+    MuestraMemoria suma;
+    int rankMaximoRss = 0; ///< Rank con el mayor valor de rss
+};
+
+/**
+ * @brief Reduce una muestra entre todos los procesos del comunicador
+ * @param local Muestra del proceso
+ * @param root Proceso que recibe el resultado
+ * @param comm Comunicador
+ * @return Mínimo, máximo y suma (solo significativos en la raíz)
+ */
+ReduccionMemoria reducirMemoria(const MuestraMemoria& local, int root, MPI_Comm comm);
+
+/**
+ * @brief Perfil de memoria por fases
+ *
+ * Cada llamada a marcar() toma una muestra y la asocia al final de una fase;
+ * imprimir() reduce, para cada fase, la muestra absoluta y el incremento
+ * respecto a la fase anterior. Todos los procesos deben marcar las mismas
+ * fases en el mismo orden.
+ */
+class PerfilMemoria {
+public:
+    /**
+     * @brief Crea el perfil tomando la muestra inicial
+     */
+    PerfilMemoria();
+    
+    /**
+     * @brief Cierra una fase tomando una muestra
+     * @param fase Nombre de la fase
+     */
+    void marcar(const std::string& fase);
+    
+    /**
+     * @brief Imprime el perfil reducido entre todos los procesos
+     * @param root Proceso que imprime
+     * @param comm Comunicador (operación colectiva)
+     * @param salida Flujo de salida (solo se usa en la raíz)
+     */
+    void imprimir(int root, MPI_Comm comm, std::ostream& salida) const;
+
+private:
+    MuestraMemoria inicial_;
+    std::vector<std::string> fases_;
+    std::vector<MuestraMemoria> muestras_;
+};
+
+#endif // MPI_AVANZADO_USOMEMORIA_H